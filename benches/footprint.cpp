@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) 2024, RPTU Kaiserslautern-Landau
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ * OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <DRAMPower/simconfig/simconfig.h>
+#include <DRAMPower/memspec/MemSpecDDR5.h>
+#include <DRAMPower/memspec/MemSpecLPDDR5.h>
+#include <DRAMPower/standards/ddr5/DDR5.h>
+#include <DRAMPower/standards/lpddr5/LPDDR5.h>
+#include <DRAMUtils/memspec/MemSpec.h>
+
+#include "perf_counters.h"
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+// Number of instances constructed per iteration
+constexpr std::size_t INSTANCES = 1000;
+
+template <typename MemSpec>
+MemSpec loadMemSpec(const std::string& file)
+{
+    auto memspeccontainer = DRAMUtils::parse_memspec_from_file(std::string{DRAMPOWER_BENCHMARK_CONFIGS_DIR"/"} + file);
+    if (!memspeccontainer)
+    {
+        throw std::runtime_error("Failed to parse memspec from file");
+    }
+    return MemSpec::from_memspec(*memspeccontainer);
+}
+
+DRAMPower::config::SimConfig simConfig(bool togglingRate)
+{
+    DRAMPower::config::SimConfig config;
+    if (togglingRate) {
+        config.toggleRateDefinition = DRAMUtils::Config::ToggleRateDefinition{
+            0.5, // togglingRateRead
+            0.5, // togglingRateWrite
+            0.5, // dutyCycleRead
+            0.5, // dutyCycleWrite
+            DRAMUtils::Config::TogglingRateIdlePattern::L, // idlePatternRead
+            DRAMUtils::Config::TogglingRateIdlePattern::L  // idlePatternWrite
+        };
+    }
+    return config;
+}
+
+// Memory held by one freshly constructed instance: the object and its heap allocations.
+// Hosts simulating thousands of channels keep one instance per channel alive.
+template <typename Standard, typename MemSpec>
+void footprint(benchmark::State& state, const std::string& file, bool togglingRate)
+{
+    const MemSpec memspec = loadMemSpec<MemSpec>(file);
+    const DRAMPower::config::SimConfig config = simConfig(togglingRate);
+    std::vector<std::unique_ptr<Standard>> instances;
+    instances.reserve(INSTANCES);
+    int64_t bytes = 0;
+    for (auto _ : state)
+    {
+        const int64_t start = DRAMPower::benches::liveBytes();
+        for (std::size_t i = 0; i < INSTANCES; ++i) {
+            instances.push_back(std::make_unique<Standard>(memspec, config));
+        }
+        bytes += DRAMPower::benches::liveBytes() - start;
+        instances.clear();
+    }
+    const double iterations = static_cast<double>(state.iterations());
+    state.counters["bytes/instance"] = static_cast<double>(bytes) / (iterations * INSTANCES);
+    state.counters["sizeof"] = static_cast<double>(sizeof(Standard));
+}
+
+void ddr5Footprint(benchmark::State& state, const std::string& file, bool togglingRate)
+{
+    footprint<DRAMPower::DDR5, DRAMPower::MemSpecDDR5>(state, file, togglingRate);
+}
+
+void lpddr5Footprint(benchmark::State& state, const std::string& file, bool togglingRate)
+{
+    footprint<DRAMPower::LPDDR5, DRAMPower::MemSpecLPDDR5>(state, file, togglingRate);
+}
+
+} // namespace
+
+BENCHMARK_CAPTURE(ddr5Footprint, bus, std::string{"ddr5.json"}, false)->Unit(benchmark::kMicrosecond)->Iterations(10);
+BENCHMARK_CAPTURE(ddr5Footprint, togglingRate, std::string{"ddr5.json"}, true)->Unit(benchmark::kMicrosecond)->Iterations(10);
+BENCHMARK_CAPTURE(lpddr5Footprint, bus, std::string{"lpddr5.json"}, false)->Unit(benchmark::kMicrosecond)->Iterations(10);
+BENCHMARK_CAPTURE(lpddr5Footprint, togglingRate, std::string{"lpddr5.json"}, true)->Unit(benchmark::kMicrosecond)->Iterations(10);
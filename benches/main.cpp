@@ -34,10 +34,29 @@
  *    Marco Mörz
  */
 
+#include "perf_counters.h"
+
 #include <benchmark/benchmark.h>
 
+#include <cstdlib>
+#include <string_view>
+
 int main(int argc, char** argv)
 {
+    // Hardware performance counters: --perf_counters or DRAMPOWER_BENCH_PERF=1
+    const char* env = std::getenv("DRAMPOWER_BENCH_PERF");
+    bool perfCounters = nullptr != env && std::string_view{env} != "0";
+    int remaining = 1;
+    for (int i = 1; i < argc; ++i) {
+        if (std::string_view{argv[i]} == "--perf_counters") {
+            perfCounters = true;
+            continue;
+        }
+        argv[remaining++] = argv[i];
+    }
+    argc = remaining;
+    DRAMPower::benches::enablePerfCounters(perfCounters);
+
     ::benchmark::Initialize(&argc, argv);
     ::benchmark::RunSpecifiedBenchmarks();
     return 0;
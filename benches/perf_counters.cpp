@@ -0,0 +1,268 @@
+/*
+ * Copyright (c) 2024, RPTU Kaiserslautern-Landau
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ * OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "perf_counters.h"
+
+#include <array>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <utility>
+
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <cstring>
+#endif
+
+namespace {
+
+std::atomic<bool> g_perfEnabled{false};
+std::atomic<uint64_t> g_allocations{0};
+std::atomic<uint64_t> g_allocatedBytes{0};
+std::atomic<int64_t> g_liveBytes{0};
+
+void* countedAlloc(std::size_t size) {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    g_allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+    void* ptr = std::malloc(0 == size ? 1 : size);
+#if defined(__GLIBC__)
+    if (nullptr != ptr) {
+        g_liveBytes.fetch_add(static_cast<int64_t>(malloc_usable_size(ptr)), std::memory_order_relaxed);
+    }
+#endif
+    return ptr;
+}
+
+void countedFree(void* ptr) {
+#if defined(__GLIBC__)
+    if (nullptr != ptr) {
+        g_liveBytes.fetch_sub(static_cast<int64_t>(malloc_usable_size(ptr)), std::memory_order_relaxed);
+    }
+#endif
+    std::free(ptr);
+}
+
+#if defined(__linux__)
+struct EventConfig {
+    uint32_t type;
+    uint64_t config;
+};
+
+constexpr std::array<EventConfig, static_cast<std::size_t>(DRAMPower::benches::PerfEvent::COUNT)> EVENTS = {{
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+    {PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+}};
+
+int openEvent(const EventConfig& event) {
+    perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = event.type;
+    attr.config = event.config;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    // Calling thread on any cpu
+    return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+}
+#endif
+
+} // namespace
+
+// Counting allocator hook
+void* operator new(std::size_t size) {
+    if (void* ptr = countedAlloc(size)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+void* operator new[](std::size_t size) {
+    if (void* ptr = countedAlloc(size)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    return countedAlloc(size);
+}
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    return countedAlloc(size);
+}
+void operator delete(void* ptr) noexcept {
+    countedFree(ptr);
+}
+void operator delete[](void* ptr) noexcept {
+    countedFree(ptr);
+}
+void operator delete(void* ptr, std::size_t) noexcept {
+    countedFree(ptr);
+}
+void operator delete[](void* ptr, std::size_t) noexcept {
+    countedFree(ptr);
+}
+void operator delete(void* ptr, const std::nothrow_t&) noexcept {
+    countedFree(ptr);
+}
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept {
+    countedFree(ptr);
+}
+
+namespace DRAMPower::benches {
+
+void enablePerfCounters(bool enable) {
+    g_perfEnabled = enable;
+}
+
+bool perfCountersEnabled() {
+    return g_perfEnabled;
+}
+
+uint64_t allocationCount() {
+    return g_allocations.load(std::memory_order_relaxed);
+}
+
+uint64_t allocatedBytes() {
+    return g_allocatedBytes.load(std::memory_order_relaxed);
+}
+
+int64_t liveBytes() {
+    return g_liveBytes.load(std::memory_order_relaxed);
+}
+
+PerfScope::PerfScope(benchmark::State& state, std::size_t commandsPerIteration, std::size_t payloadBytesPerIteration)
+    : m_state(state)
+    , m_commands(commandsPerIteration)
+    , m_payloadBytes(payloadBytesPerIteration)
+{
+    m_fds.fill(-1);
+#if defined(__linux__)
+    if (perfCountersEnabled()) {
+        for (std::size_t i = 0; i < m_fds.size(); ++i) {
+            m_fds[i] = openEvent(EVENTS[i]);
+        }
+        for (int fd : m_fds) {
+            if (fd >= 0) {
+                ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+                ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+            }
+        }
+    }
+#endif
+    m_allocationsStart = allocationCount();
+    m_allocatedBytesStart = allocatedBytes();
+}
+
+PerfScope::~PerfScope() {
+    if (!m_reported) {
+        report();
+    }
+}
+
+PerfValues PerfScope::stop() {
+    PerfValues values;
+    values.allocations = allocationCount() - m_allocationsStart;
+    values.allocatedBytes = allocatedBytes() - m_allocatedBytesStart;
+#if defined(__linux__)
+    for (std::size_t i = 0; i < m_fds.size(); ++i) {
+        if (m_fds[i] < 0) {
+            continue;
+        }
+        ioctl(m_fds[i], PERF_EVENT_IOC_DISABLE, 0);
+        uint64_t value = 0;
+        values.valid[i] = sizeof(value) == read(m_fds[i], &value, sizeof(value));
+        values.events[i] = value;
+        close(m_fds[i]);
+        m_fds[i] = -1;
+    }
+#endif
+    return values;
+}
+
+void PerfScope::report() {
+    m_reported = true;
+    PerfValues values = stop();
+
+    const double iterations = static_cast<double>(m_state.iterations());
+    const double commands = iterations * static_cast<double>(m_commands);
+    const double bytes = iterations * static_cast<double>(m_payloadBytes);
+    auto perCommand = [commands](uint64_t value) {
+        return 0.0 == commands ? 0.0 : static_cast<double>(value) / commands;
+    };
+    auto perByte = [bytes](uint64_t value) {
+        return 0.0 == bytes ? 0.0 : static_cast<double>(value) / bytes;
+    };
+    auto event = [&values](PerfEvent e) -> std::pair<bool, uint64_t> {
+        std::size_t i = static_cast<std::size_t>(e);
+        return {values.valid[i], values.events[i]};
+    };
+
+    m_state.counters["allocs/cmd"] = perCommand(values.allocations);
+    m_state.counters["alloc_bytes/cmd"] = perCommand(values.allocatedBytes);
+
+    if (!perfCountersEnabled()) {
+        return;
+    }
+    auto [instructionsValid, instructions] = event(PerfEvent::Instructions);
+    auto [cyclesValid, cycles] = event(PerfEvent::Cycles);
+    if (instructionsValid) {
+        m_state.counters["instructions/cmd"] = perCommand(instructions);
+        m_state.counters["instructions/byte"] = perByte(instructions);
+    }
+    if (cyclesValid) {
+        m_state.counters["cycles/cmd"] = perCommand(cycles);
+        m_state.counters["cycles/byte"] = perByte(cycles);
+    }
+    if (instructionsValid && cyclesValid && 0 != cycles) {
+        m_state.counters["IPC"] = static_cast<double>(instructions) / static_cast<double>(cycles);
+    }
+    if (auto [valid, value] = event(PerfEvent::L1DMisses); valid) {
+        m_state.counters["L1D_misses/cmd"] = perCommand(value);
+    }
+    if (auto [valid, value] = event(PerfEvent::LLCMisses); valid) {
+        m_state.counters["LLC_misses/cmd"] = perCommand(value);
+    }
+    if (auto [valid, value] = event(PerfEvent::BranchMisses); valid) {
+        m_state.counters["branch_misses/cmd"] = perCommand(value);
+    }
+}
+
+} // namespace DRAMPower::benches
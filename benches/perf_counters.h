@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2024, RPTU Kaiserslautern-Landau
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ * OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef BENCHES_PERF_COUNTERS_H
+#define BENCHES_PERF_COUNTERS_H
+
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace DRAMPower::benches {
+
+// Hardware events collected with perf_event_open
+enum class PerfEvent : std::size_t {
+    Instructions = 0,
+    Cycles,
+    L1DMisses,
+    LLCMisses,
+    BranchMisses,
+    COUNT,
+};
+
+struct PerfValues {
+    std::array<uint64_t, static_cast<std::size_t>(PerfEvent::COUNT)> events{};
+    std::array<bool, static_cast<std::size_t>(PerfEvent::COUNT)> valid{};
+    uint64_t allocations = 0;
+    uint64_t allocatedBytes = 0;
+};
+
+// Enables the collection of the hardware counters for all benchmarks.
+// The allocation counters are always collected.
+void enablePerfCounters(bool enable);
+bool perfCountersEnabled();
+
+// Number of allocations and allocated bytes since program start (counting operator new)
+uint64_t allocationCount();
+uint64_t allocatedBytes();
+// Bytes held by live allocations including the allocator overhead (glibc only, 0 elsewhere)
+int64_t liveBytes();
+
+// Counts the hardware events and allocations of the calling thread while alive.
+// The constructor starts the counters, report() stops them and adds the
+// values per simulated command and per payload byte to the benchmark counters.
+class PerfScope {
+public:
+    PerfScope(benchmark::State& state, std::size_t commandsPerIteration, std::size_t payloadBytesPerIteration);
+    ~PerfScope();
+
+    PerfScope(const PerfScope&) = delete;
+    PerfScope& operator=(const PerfScope&) = delete;
+
+    void report();
+
+private:
+    PerfValues stop();
+
+    benchmark::State& m_state;
+    std::size_t m_commands;
+    std::size_t m_payloadBytes;
+    std::array<int, static_cast<std::size_t>(PerfEvent::COUNT)> m_fds;
+    uint64_t m_allocationsStart;
+    uint64_t m_allocatedBytesStart;
+    bool m_reported = false;
+};
+
+} // namespace DRAMPower::benches
+
+#endif /* BENCHES_PERF_COUNTERS_H */
@@ -45,6 +45,8 @@
 
 #include <DRAMPower/cli/run.hpp>
 
+#include "perf_counters.h"
+
 #include <benchmark/benchmark.h>
 #include <filesystem>
 #include <iostream>
@@ -85,6 +87,15 @@ public:
     void TearDown(::benchmark::State&) {
         commandlist.clear();
     }
+
+    std::size_t payloadBytes() const {
+        std::size_t bytes = 0;
+        for (const auto &command : commandlist) {
+            bytes += command.first.sz_bits / 8;
+        }
+        return bytes;
+    }
+
     std::unique_ptr<DRAMPower::MemSpecLPDDR4> memspec;
     CommandList_t commandlist;
 };
@@ -92,11 +103,13 @@ public:
 BENCHMARK_DEFINE_F(LPDDR4_Bench, lpddr4PowerSimulation)(benchmark::State& state)
 {
     auto rdbuf = std::cout.rdbuf(nullptr);
+    DRAMPower::benches::PerfScope perf(state, commandlist.size(), payloadBytes());
     for (auto _ : state)
     {
         std::unique_ptr<BaseDDR_t> ddr = std::make_unique<DRAMPower::LPDDR4>(*memspec);
         DRAMPower::DRAMPowerCLI::runCommands(ddr, commandlist);
     }
+    perf.report();
     std::cout.rdbuf(rdbuf);
 }
 
@@ -105,6 +118,7 @@ BENCHMARK_REGISTER_F(LPDDR4_Bench, lpddr4PowerSimulation)->Unit(benchmark::kMicr
 BENCHMARK_DEFINE_F(LPDDR4_Bench, lpddr4PowerSimulationToggling)(benchmark::State& state)
 {
     auto rdbuf = std::cout.rdbuf(nullptr);
+    DRAMPower::benches::PerfScope perf(state, commandlist.size(), payloadBytes());
     for (auto _ : state)
     {
         auto trd = DRAMUtils::Config::ToggleRateDefinition{
@@ -118,6 +132,7 @@ BENCHMARK_DEFINE_F(LPDDR4_Bench, lpddr4PowerSimulationToggling)(benchmark::State
         std::unique_ptr<BaseDDR_t> ddr = std::make_unique<DRAMPower::LPDDR4>(*memspec, DRAMPower::config::SimConfig{trd});
         DRAMPower::DRAMPowerCLI::runCommands(ddr, commandlist);
     }
+    perf.report();
     std::cout.rdbuf(rdbuf);
 }
 
@@ -0,0 +1,150 @@
+#include "core_energy_coefficients.h"
+
+#include <DRAMPower/Exceptions.h>
+
+using namespace DRAMPower;
+
+const std::array<uint64_t command_stats_t::*, CoreEnergyCoefficients::numberOfCounters> CoreEnergyCoefficients::s_counters = {
+    &command_stats_t::act,
+    &command_stats_t::pre,
+    &command_stats_t::reads,
+    &command_stats_t::writes,
+    &command_stats_t::refAllBank,
+    &command_stats_t::refPerBank,
+    &command_stats_t::refPerTwoBanks,
+    &command_stats_t::refDualBanks,
+    &command_stats_t::refSameBank,
+    &command_stats_t::readAuto,
+    &command_stats_t::writeAuto,
+};
+
+const std::array<uint64_t cycles_t::*, CoreEnergyCoefficients::numberOfCycles> CoreEnergyCoefficients::s_cycles = {
+    &cycles_t::act,
+    &cycles_t::pre,
+    &cycles_t::powerDownAct,
+    &cycles_t::powerDownPre,
+    &cycles_t::selfRefresh,
+    &cycles_t::deepSleepMode,
+};
+
+CoreEnergyCoefficients::CoreEnergyCoefficients(const calc_t &calcCoreEnergy, const SimulationStats &stats)
+{
+    if (stats.bank.empty() || stats.rank_total.empty()) {
+        throw Exception("CoreEnergyCoefficients: stats without banks or ranks");
+    }
+    // Zero stats with the shape of the memory
+    SimulationStats zero = stats;
+    zero -= stats;
+    const double zeroEnergy = calcCoreEnergy(zero).total();
+
+    // All banks and ranks share the coefficients, the first bank and rank are probed
+    for (std::size_t i = 0; i < numberOfCounters; ++i) {
+        SimulationStats unit = zero;
+        unit.bank.front().counter.*s_counters[i] = 1;
+        m_counter[i] = calcCoreEnergy(unit).total() - zeroEnergy;
+    }
+    for (std::size_t i = 0; i < numberOfCycles; ++i) {
+        SimulationStats unit = zero;
+        unit.bank.front().cycles.*s_cycles[i] = 1;
+        m_bankCycles[i] = calcCoreEnergy(unit).total() - zeroEnergy;
+        unit = zero;
+        unit.rank_total.front().cycles.*s_cycles[i] = 1;
+        m_rankCycles[i] = calcCoreEnergy(unit).total() - zeroEnergy;
+    }
+}
+
+double CoreEnergyCoefficients::getCounterEnergy(uint64_t command_stats_t::* counter) const
+{
+    for (std::size_t i = 0; i < numberOfCounters; ++i) {
+        if (s_counters[i] == counter) {
+            return m_counter[i];
+        }
+    }
+    return 0.0;
+}
+
+double CoreEnergyCoefficients::getBankCycleEnergy(uint64_t cycles_t::* cycles) const
+{
+    for (std::size_t i = 0; i < numberOfCycles; ++i) {
+        if (s_cycles[i] == cycles) {
+            return m_bankCycles[i];
+        }
+    }
+    return 0.0;
+}
+
+double CoreEnergyCoefficients::getRankCycleEnergy(uint64_t cycles_t::* cycles) const
+{
+    for (std::size_t i = 0; i < numberOfCycles; ++i) {
+        if (s_cycles[i] == cycles) {
+            return m_rankCycles[i];
+        }
+    }
+    return 0.0;
+}
+
+CoreEnergyCoefficients::rank_energy_t CoreEnergyCoefficients::evaluate(const Rank &rank, timestamp_t timestamp) const
+{
+    const auto count = [timestamp](const interval_t &interval) {
+        return static_cast<double>(interval.get_count_at(timestamp));
+    };
+    const auto open = [](const interval_t &interval) {
+        return interval.is_open() ? 1.0 : 0.0;
+    };
+
+    // Same layout as the getWindowStats of the cores. Self refresh includes the deep sleep mode.
+    const double duration = static_cast<double>(timestamp);
+    const double act = count(rank.cycles.act);
+    const double powerDownAct = count(rank.cycles.powerDownAct);
+    const double powerDownPre = count(rank.cycles.powerDownPre);
+    const double sref = count(rank.cycles.sref);
+    const double deepSleepMode = count(rank.cycles.deepSleepMode);
+    const double inactive = powerDownAct + powerDownPre + sref;
+
+    const double actRate = open(rank.cycles.act);
+    const double powerDownActRate = open(rank.cycles.powerDownAct);
+    const double powerDownPreRate = open(rank.cycles.powerDownPre);
+    const double srefRate = open(rank.cycles.sref);
+    const double deepSleepModeRate = open(rank.cycles.deepSleepMode);
+    const double inactiveRate = powerDownActRate + powerDownPreRate + srefRate;
+
+    // Banks
+    std::array<double, numberOfCounters> counters{};
+    double bankAct = 0.0;
+    double bankActRate = 0.0;
+    for (const Bank &bank : rank.banks) {
+        for (std::size_t i = 0; i < numberOfCounters; ++i) {
+            counters[i] += static_cast<double>(bank.counter.*s_counters[i]);
+        }
+        bankAct += count(bank.cycles.act);
+        bankActRate += open(bank.cycles.act);
+    }
+    const double banks = static_cast<double>(rank.banks.size());
+
+    // act, pre, powerDownAct, powerDownPre, selfRefresh, deepSleepMode
+    const std::array<double, numberOfCycles> rankCycles = {
+        act, duration - (act + inactive), powerDownAct, powerDownPre, sref - deepSleepMode, deepSleepMode,
+    };
+    const std::array<double, numberOfCycles> rankRates = {
+        actRate, 1.0 - (actRate + inactiveRate), powerDownActRate, powerDownPreRate,
+        srefRate - deepSleepModeRate, deepSleepModeRate,
+    };
+    const std::array<double, numberOfCycles> bankCycles = {
+        bankAct, banks * duration - (bankAct + banks * inactive), banks * powerDownAct, banks * powerDownPre,
+        banks * (sref - deepSleepMode), banks * deepSleepMode,
+    };
+    const std::array<double, numberOfCycles> bankRates = {
+        bankActRate, banks - (bankActRate + banks * inactiveRate), banks * powerDownActRate, banks * powerDownPreRate,
+        banks * (srefRate - deepSleepModeRate), banks * deepSleepModeRate,
+    };
+
+    rank_energy_t result;
+    for (std::size_t i = 0; i < numberOfCounters; ++i) {
+        result.energy += m_counter[i] * counters[i];
+    }
+    for (std::size_t i = 0; i < numberOfCycles; ++i) {
+        result.energy += m_rankCycles[i] * rankCycles[i] + m_bankCycles[i] * bankCycles[i];
+        result.power += m_rankCycles[i] * rankRates[i] + m_bankCycles[i] * bankRates[i];
+    }
+    return result;
+}
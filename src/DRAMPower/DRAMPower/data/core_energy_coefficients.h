@@ -0,0 +1,74 @@
+#ifndef DRAMPOWER_DATA_CORE_ENERGY_COEFFICIENTS_H
+#define DRAMPOWER_DATA_CORE_ENERGY_COEFFICIENTS_H
+
+#include <DRAMPower/Types.h>
+#include <DRAMPower/data/energy.h>
+#include <DRAMPower/data/stats.h>
+#include <DRAMPower/dram/Rank.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <type_traits>
+
+namespace DRAMPower {
+
+// Core energy per unit of every field of the bank and rank stats.
+// The core energy of all standards is linear in the stats, the coefficients are probed once from the
+// core energy calculation of the memspec. With the coefficients the energy of a rank is evaluated
+// directly from its state, without building SimulationStats for the whole memory.
+class CoreEnergyCoefficients {
+// Public type definitions
+public:
+    using calc_t = std::function<energy_t(const SimulationStats&)>;
+
+    // Energy rate of a rank in its current state
+    struct rank_energy_t {
+        // Energy up to the evaluated timestamp
+        double energy = 0.0;
+        // Energy per cycle after the evaluated timestamp until the next state change
+        double power = 0.0;
+    };
+
+// Public constructors
+public:
+    CoreEnergyCoefficients() = default;
+    // stats only provides the number of ranks and banks
+    CoreEnergyCoefficients(const calc_t &calcCoreEnergy, const SimulationStats &stats);
+
+    // dram only has to provide calcCoreEnergyStats
+    template <typename DRAM, typename = std::enable_if_t<!std::is_convertible_v<const DRAM&, calc_t>>>
+    CoreEnergyCoefficients(const DRAM &dram, const SimulationStats &stats)
+        : CoreEnergyCoefficients(calc_t{[&dram](const SimulationStats &s) {
+            return dram.calcCoreEnergyStats(s);
+        }}, stats)
+    {}
+
+// Public member functions
+public:
+    // Energy of one command counted in a bank (e.g. counter.act for ACT)
+    double getCounterEnergy(uint64_t command_stats_t::* counter) const;
+    // Energy of one cycle of a bank or rank in the given state (e.g. cycles.act)
+    double getBankCycleEnergy(uint64_t cycles_t::* cycles) const;
+    double getRankCycleEnergy(uint64_t cycles_t::* cycles) const;
+
+    // Core energy of a rank including its banks at timestamp.
+    // Valid for timestamps after the latest state change of the rank.
+    rank_energy_t evaluate(const Rank &rank, timestamp_t timestamp) const;
+
+// Private member variables
+private:
+    static constexpr std::size_t numberOfCounters = 11;
+    static constexpr std::size_t numberOfCycles = 6;
+    static const std::array<uint64_t command_stats_t::*, numberOfCounters> s_counters;
+    static const std::array<uint64_t cycles_t::*, numberOfCycles> s_cycles;
+
+    std::array<double, numberOfCounters> m_counter{};
+    std::array<double, numberOfCycles> m_bankCycles{};
+    std::array<double, numberOfCycles> m_rankCycles{};
+};
+
+} // namespace DRAMPower
+
+#endif /* DRAMPOWER_DATA_CORE_ENERGY_COEFFICIENTS_H */
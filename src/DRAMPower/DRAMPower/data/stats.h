@@ -8,6 +8,7 @@
 
 #include "DRAMUtils/util/json_utils.h"
 
+#include <cassert>
 #include <cstdint>
 
 namespace DRAMPower
@@ -82,6 +83,38 @@ namespace DRAMPower
 			writeAuto += rhs.writeAuto;
 			return *this;
 		}
+
+		// operator -=
+		command_stats_t& operator-=(const command_stats_t& rhs) {
+			act -= rhs.act;
+			pre -= rhs.pre;
+			reads -= rhs.reads;
+			writes -= rhs.writes;
+			refAllBank -= rhs.refAllBank;
+			refPerBank -= rhs.refPerBank;
+			refPerTwoBanks -= rhs.refPerTwoBanks;
+			refDualBanks -= rhs.refDualBanks;
+			refSameBank -= rhs.refSameBank;
+			readAuto -= rhs.readAuto;
+			writeAuto -= rhs.writeAuto;
+			return *this;
+		}
+
+		// operator *=
+		command_stats_t& operator*=(uint64_t rhs) {
+			act *= rhs;
+			pre *= rhs;
+			reads *= rhs;
+			writes *= rhs;
+			refAllBank *= rhs;
+			refPerBank *= rhs;
+			refPerTwoBanks *= rhs;
+			refDualBanks *= rhs;
+			refSameBank *= rhs;
+			readAuto *= rhs;
+			writeAuto *= rhs;
+			return *this;
+		}
 	};
 	NLOHMANN_JSONIFY_ALL_THINGS(command_stats_t, act, pre, reads, writes, refAllBank, refPerBank, refPerTwoBanks, refDualBanks, refSameBank, readAuto, writeAuto);
 
@@ -131,6 +164,27 @@ namespace DRAMPower
 			deepSleepMode += rhs.deepSleepMode;
 			return *this;
 		}
+
+		cycles_t& operator-=(const cycles_t& rhs) {
+			act -= rhs.act;
+			pre -= rhs.pre;
+			powerDownAct -= rhs.powerDownAct;
+			powerDownPre -= rhs.powerDownPre;
+			selfRefresh -= rhs.selfRefresh;
+			deepSleepMode -= rhs.deepSleepMode;
+			return *this;
+		}
+
+		// operator *=
+		cycles_t& operator*=(uint64_t rhs) {
+			act *= rhs;
+			pre *= rhs;
+			powerDownAct *= rhs;
+			powerDownPre *= rhs;
+			selfRefresh *= rhs;
+			deepSleepMode *= rhs;
+			return *this;
+		}
 	};
 	NLOHMANN_JSONIFY_ALL_THINGS(cycles_t, act, pre, powerDownAct, powerDownPre, selfRefresh, deepSleepMode);
 
@@ -179,6 +233,28 @@ namespace DRAMPower
 			writeSeamless += rhs.writeSeamless;
 			return *this;
 		}
+
+		// operator -=
+		prepos_t& operator-=(const prepos_t& rhs) {
+			readMerged -= rhs.readMerged;
+			readMergedTime -= rhs.readMergedTime;
+			writeMerged -= rhs.writeMerged;
+			writeMergedTime -= rhs.writeMergedTime;
+			readSeamless -= rhs.readSeamless;
+			writeSeamless -= rhs.writeSeamless;
+			return *this;
+		}
+
+		// operator *=
+		prepos_t& operator*=(uint64_t rhs) {
+			readMerged *= rhs;
+			readMergedTime *= rhs;
+			writeMerged *= rhs;
+			writeMergedTime *= rhs;
+			readSeamless *= rhs;
+			writeSeamless *= rhs;
+			return *this;
+		}
 	};
 	NLOHMANN_JSONIFY_ALL_THINGS(prepos_t, readMerged, readMergedTime, writeMerged, writeMergedTime, readSeamless, writeSeamless);
 
@@ -214,6 +290,22 @@ namespace DRAMPower
 			prepos += rhs.prepos;
 			return *this;
 		}
+
+		// operator -=
+		CycleStats& operator-=(const CycleStats& rhs) {
+			counter -= rhs.counter;
+			cycles -= rhs.cycles;
+			prepos -= rhs.prepos;
+			return *this;
+		}
+
+		// operator *=
+		CycleStats& operator*=(uint64_t rhs) {
+			counter *= rhs;
+			cycles *= rhs;
+			prepos *= rhs;
+			return *this;
+		}
 	};
 	NLOHMANN_JSONIFY_ALL_THINGS(CycleStats, counter, cycles, prepos);
 
@@ -221,8 +313,52 @@ namespace DRAMPower
     {
         util::bus_stats_t read;
         util::bus_stats_t write;
+        // Activity the stats are derived from
+        toggling_activity_t readActivity;
+        toggling_activity_t writeActivity;
     };
-	NLOHMANN_JSONIFY_ALL_THINGS(TogglingStats, read, write);
+	NLOHMANN_JSONIFY_ALL_THINGS(TogglingStats, read, write, readActivity, writeActivity);
+
+	// Data bus stats of one device of the rank
+	struct DeviceStats
+	{
+		util::bus_stats_t readBus;
+		util::bus_stats_t writeBus;
+		util::bus_stats_t readDBI;
+		util::bus_stats_t writeDBI;
+
+		bool operator==(const DeviceStats& other) const {
+			return readBus == other.readBus &&
+				writeBus == other.writeBus &&
+				readDBI == other.readDBI &&
+				writeDBI == other.writeDBI;
+		}
+
+		DeviceStats& operator+=(const DeviceStats& rhs) {
+			readBus += rhs.readBus;
+			writeBus += rhs.writeBus;
+			readDBI += rhs.readDBI;
+			writeDBI += rhs.writeDBI;
+			return *this;
+		}
+
+		DeviceStats& operator-=(const DeviceStats& rhs) {
+			readBus -= rhs.readBus;
+			writeBus -= rhs.writeBus;
+			readDBI -= rhs.readDBI;
+			writeDBI -= rhs.writeDBI;
+			return *this;
+		}
+
+		DeviceStats& operator*=(uint64_t rhs) {
+			readBus *= rhs;
+			writeBus *= rhs;
+			readDBI *= rhs;
+			writeDBI *= rhs;
+			return *this;
+		}
+	};
+	NLOHMANN_JSONIFY_ALL_THINGS(DeviceStats, readBus, writeBus, readDBI, writeDBI);
 
 	struct SimulationStats
 	{
@@ -243,6 +379,20 @@ namespace DRAMPower
 		std::vector<CycleStats> bank;
 		std::vector<CycleStats> rank_total;
 
+		// Per device data bus stats, only filled with SimConfig::deviceBusStats in the bus mode
+		std::vector<DeviceStats> devices;
+
+		// Stats with only the data bus stats of device (e.g. for calcInterfaceEnergyStats)
+		SimulationStats getDeviceStats(std::size_t device) const {
+			SimulationStats stats;
+			const DeviceStats& deviceStats = devices.at(device);
+			stats.readBus = deviceStats.readBus;
+			stats.writeBus = deviceStats.writeBus;
+			stats.readDBI = deviceStats.readDBI;
+			stats.writeDBI = deviceStats.writeDBI;
+			return stats;
+		}
+
 		// Operator ==
 		bool operator==(const SimulationStats& other) const {
 			// Compare banks
@@ -277,10 +427,13 @@ namespace DRAMPower
 				writeDBI == other.writeDBI &&
 				togglingStats.read == other.togglingStats.read &&
 				togglingStats.write == other.togglingStats.write &&
+				togglingStats.readActivity == other.togglingStats.readActivity &&
+				togglingStats.writeActivity == other.togglingStats.writeActivity &&
 				readDQSStats == other.readDQSStats &&
 				writeDQSStats == other.writeDQSStats &&
 				banksEqual &&
-				rank_totalEqual;
+				rank_totalEqual &&
+				devices == other.devices;
 		}
 
 		SimulationStats& operator+=(const SimulationStats& rhs) {
@@ -302,6 +455,15 @@ namespace DRAMPower
 				rank_total.insert(rank_total.end(), rhs.rank_total.begin() + min_rank_total, rhs.rank_total.end());
 			}
 
+			std::size_t min_devices = std::min(devices.size(), rhs.devices.size());
+			for (std::size_t i = 0; i < min_devices; ++i)
+			{
+				devices[i] += rhs.devices[i];
+			}
+			if (devices.size() < rhs.devices.size()) {
+				devices.insert(devices.end(), rhs.devices.begin() + min_devices, rhs.devices.end());
+			}
+
 			commandBus += rhs.commandBus;
 			readBus += rhs.readBus;
 			writeBus += rhs.writeBus;
@@ -311,12 +473,77 @@ namespace DRAMPower
 			writeDBI += rhs.writeDBI;
 			togglingStats.read += rhs.togglingStats.read;
 			togglingStats.write += rhs.togglingStats.write;
+			togglingStats.readActivity += rhs.togglingStats.readActivity;
+			togglingStats.writeActivity += rhs.togglingStats.writeActivity;
 			readDQSStats += rhs.readDQSStats;
 			writeDQSStats += rhs.writeDQSStats;
 			return *this;
 		}
+
+		// Both stats must have the same number of banks and ranks
+		SimulationStats& operator-=(const SimulationStats& rhs) {
+			assert(bank.size() == rhs.bank.size() && rank_total.size() == rhs.rank_total.size());
+			for (std::size_t i = 0; i < bank.size(); ++i)
+			{
+				bank[i] -= rhs.bank[i];
+			}
+			for (std::size_t i = 0; i < rank_total.size(); ++i)
+			{
+				rank_total[i] -= rhs.rank_total[i];
+			}
+			assert(devices.size() == rhs.devices.size());
+			for (std::size_t i = 0; i < devices.size(); ++i)
+			{
+				devices[i] -= rhs.devices[i];
+			}
+
+			commandBus -= rhs.commandBus;
+			readBus -= rhs.readBus;
+			writeBus -= rhs.writeBus;
+			clockStats -= rhs.clockStats;
+			wClockStats -= rhs.wClockStats;
+			readDBI -= rhs.readDBI;
+			writeDBI -= rhs.writeDBI;
+			togglingStats.read -= rhs.togglingStats.read;
+			togglingStats.write -= rhs.togglingStats.write;
+			togglingStats.readActivity -= rhs.togglingStats.readActivity;
+			togglingStats.writeActivity -= rhs.togglingStats.writeActivity;
+			readDQSStats -= rhs.readDQSStats;
+			writeDQSStats -= rhs.writeDQSStats;
+			return *this;
+		}
+
+		SimulationStats& operator*=(uint64_t rhs) {
+			for (auto& stats : bank)
+			{
+				stats *= rhs;
+			}
+			for (auto& stats : rank_total)
+			{
+				stats *= rhs;
+			}
+			for (auto& stats : devices)
+			{
+				stats *= rhs;
+			}
+
+			commandBus *= rhs;
+			readBus *= rhs;
+			writeBus *= rhs;
+			clockStats *= rhs;
+			wClockStats *= rhs;
+			readDBI *= rhs;
+			writeDBI *= rhs;
+			togglingStats.read *= rhs;
+			togglingStats.write *= rhs;
+			togglingStats.readActivity *= rhs;
+			togglingStats.writeActivity *= rhs;
+			readDQSStats *= rhs;
+			writeDQSStats *= rhs;
+			return *this;
+		}
 	};
-	NLOHMANN_JSONIFY_ALL_THINGS(SimulationStats, commandBus, readBus, writeBus, clockStats, wClockStats, readDBI, writeDBI, togglingStats, readDQSStats, writeDQSStats, bank, rank_total);
+	NLOHMANN_JSONIFY_ALL_THINGS(SimulationStats, commandBus, readBus, writeBus, clockStats, wClockStats, readDBI, writeDBI, togglingStats, readDQSStats, writeDQSStats, bank, rank_total, devices);
 };
 
 
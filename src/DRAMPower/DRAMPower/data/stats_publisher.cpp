@@ -0,0 +1,159 @@
+#include "stats_publisher.h"
+
+#include <DRAMPower/Exceptions.h>
+
+#include <cstring>
+#include <sstream>
+#include <string>
+
+using namespace DRAMPower;
+
+namespace {
+
+// Slot layout: publication, timestamp, command count, number of stats bytes, stats bytes
+constexpr std::size_t HEADER_WORDS = 4;
+
+void serializeCycleStats(std::ostream& stream, const std::vector<CycleStats>& stats) {
+    uint64_t size = stats.size();
+    stream.write(reinterpret_cast<const char *>(&size), sizeof(size));
+    for (const auto& entry : stats) {
+        entry.serialize(stream);
+    }
+}
+
+void deserializeCycleStats(std::istream& stream, std::vector<CycleStats>& stats) {
+    uint64_t size = 0;
+    stream.read(reinterpret_cast<char *>(&size), sizeof(size));
+    stats.resize(size);
+    for (auto& entry : stats) {
+        entry.deserialize(stream);
+    }
+}
+
+} // namespace
+
+StatsPublisher::StatsPublisher()
+    : StatsPublisher(Config{})
+{}
+
+StatsPublisher::StatsPublisher(Config config)
+    : m_config(config)
+{}
+
+bool StatsPublisher::due(uint64_t commandCount, timestamp_t timestamp) const {
+    return (0 != m_config.commandInterval && commandCount - m_lastCommandCount >= m_config.commandInterval)
+        || (0 != m_config.timeInterval && timestamp - m_lastTimestamp >= m_config.timeInterval);
+}
+
+void StatsPublisher::serializeStats(std::ostream& stream, const SimulationStats& stats) {
+    stats.commandBus.serialize(stream);
+    stats.readBus.serialize(stream);
+    stats.writeBus.serialize(stream);
+    stats.clockStats.serialize(stream);
+    stats.wClockStats.serialize(stream);
+    stats.readDBI.serialize(stream);
+    stats.writeDBI.serialize(stream);
+    stats.togglingStats.read.serialize(stream);
+    stats.togglingStats.write.serialize(stream);
+    stats.togglingStats.readActivity.serialize(stream);
+    stats.togglingStats.writeActivity.serialize(stream);
+    stats.readDQSStats.serialize(stream);
+    stats.writeDQSStats.serialize(stream);
+    serializeCycleStats(stream, stats.bank);
+    serializeCycleStats(stream, stats.rank_total);
+}
+
+void StatsPublisher::deserializeStats(std::istream& stream, SimulationStats& stats) {
+    stats.commandBus.deserialize(stream);
+    stats.readBus.deserialize(stream);
+    stats.writeBus.deserialize(stream);
+    stats.clockStats.deserialize(stream);
+    stats.wClockStats.deserialize(stream);
+    stats.readDBI.deserialize(stream);
+    stats.writeDBI.deserialize(stream);
+    stats.togglingStats.read.deserialize(stream);
+    stats.togglingStats.write.deserialize(stream);
+    stats.togglingStats.readActivity.deserialize(stream);
+    stats.togglingStats.writeActivity.deserialize(stream);
+    stats.readDQSStats.deserialize(stream);
+    stats.writeDQSStats.deserialize(stream);
+    deserializeCycleStats(stream, stats.bank);
+    deserializeCycleStats(stream, stats.rank_total);
+}
+
+void StatsPublisher::allocate(std::size_t words) {
+    // Only called before the first publication, no reader accesses the slots yet
+    for (auto& slot : m_slots) {
+        slot.words = std::vector<std::atomic<uint64_t>>(words);
+    }
+}
+
+void StatsPublisher::publish(const SimulationStats& stats, timestamp_t timestamp, uint64_t commandCount) {
+    std::ostringstream stream;
+    serializeStats(stream, stats);
+    const std::string bytes = stream.str();
+
+    const uint64_t publications = m_publications.load(std::memory_order_relaxed);
+    m_buffer.assign(HEADER_WORDS + (bytes.size() + sizeof(uint64_t) - 1) / sizeof(uint64_t), 0);
+    m_buffer[0] = publications + 1;
+    m_buffer[1] = timestamp;
+    m_buffer[2] = commandCount;
+    m_buffer[3] = bytes.size();
+    std::memcpy(m_buffer.data() + HEADER_WORDS, bytes.data(), bytes.size());
+
+    if (0 == publications) {
+        allocate(m_buffer.size());
+    } else if (m_buffer.size() > m_slots[0].words.size()) {
+        // The slots cannot grow while readers may access them
+        throw Exception("StatsPublisher: the size of the published stats must not grow");
+    }
+
+    // Write the slot which doesn't hold the latest snapshot
+    Slot& slot = m_slots[publications % m_slots.size()];
+    const uint64_t sequence = slot.sequence.load(std::memory_order_relaxed);
+    slot.sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    for (std::size_t i = 0; i < m_buffer.size(); ++i) {
+        slot.words[i].store(m_buffer[i], std::memory_order_relaxed);
+    }
+    slot.sequence.store(sequence + 2, std::memory_order_release);
+    m_publications.store(publications + 1, std::memory_order_release);
+
+    m_lastCommandCount = commandCount;
+    m_lastTimestamp = timestamp;
+}
+
+std::optional<StatsSnapshot> StatsPublisher::latest() const {
+    std::vector<uint64_t> words;
+    while (true) {
+        const uint64_t publications = m_publications.load(std::memory_order_acquire);
+        if (0 == publications) {
+            return std::nullopt;
+        }
+        const Slot& slot = m_slots[(publications - 1) % m_slots.size()];
+        const uint64_t sequence = slot.sequence.load(std::memory_order_acquire);
+        if (sequence & 1) {
+            // Slot is being written
+            continue;
+        }
+        words.resize(slot.words.size());
+        for (std::size_t i = 0; i < words.size(); ++i) {
+            words[i] = slot.words[i].load(std::memory_order_relaxed);
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (sequence != slot.sequence.load(std::memory_order_relaxed)) {
+            // Overwritten during the copy
+            continue;
+        }
+
+        StatsSnapshot snapshot;
+        snapshot.sequence = words[0];
+        snapshot.timestamp = words[1];
+        snapshot.commandCount = words[2];
+        std::string bytes(words[3], '\0');
+        std::memcpy(bytes.data(), words.data() + HEADER_WORDS, bytes.size());
+        std::istringstream stream(bytes);
+        deserializeStats(stream, snapshot.stats);
+        return snapshot;
+    }
+}
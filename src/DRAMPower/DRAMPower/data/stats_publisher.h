@@ -0,0 +1,97 @@
+#ifndef DRAMPOWER_DATA_STATS_PUBLISHER_H
+#define DRAMPOWER_DATA_STATS_PUBLISHER_H
+
+#include <DRAMPower/Types.h>
+#include <DRAMPower/data/stats.h>
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <optional>
+#include <ostream>
+#include <vector>
+
+namespace DRAMPower {
+
+struct StatsSnapshot {
+    // Number of the publication starting at 1
+    uint64_t sequence = 0;
+    // Simulation time and number of simulated commands of the stats
+    timestamp_t timestamp = 0;
+    uint64_t commandCount = 0;
+    SimulationStats stats;
+};
+
+// Publishes consistent snapshots of the cumulative simulation stats to other threads.
+// A single writer (the simulation thread) publishes, any number of readers can fetch the
+// latest snapshot concurrently. The snapshot is double-buffered and every buffer is
+// guarded by a sequence lock. The writer never waits for readers. A reader copies the slot of
+// the latest snapshot and retries if the writer started to overwrite it in the meantime, which
+// happens from the second publication after the one being read. While the writer is in the middle
+// of writing that slot (odd sequence number), the reader spins.
+// The energy of a snapshot can be computed with calcCoreEnergyStats and
+// calcInterfaceEnergyStats, which only read the memspec of the simulated memory.
+class StatsPublisher {
+// Public type definitions
+public:
+    struct Config {
+        // Publish every commandInterval commands (0: disabled)
+        uint64_t commandInterval = 0;
+        // Publish if timeInterval clock cycles passed since the last publication (0: disabled)
+        timestamp_t timeInterval = 0;
+    };
+
+// Private type definitions
+private:
+    struct Slot {
+        std::atomic<uint64_t> sequence{0};
+        std::vector<std::atomic<uint64_t>> words;
+    };
+
+// Public constructors
+public:
+    StatsPublisher();
+    explicit StatsPublisher(Config config);
+
+    StatsPublisher(const StatsPublisher&) = delete;
+    StatsPublisher& operator=(const StatsPublisher&) = delete;
+
+// Public member functions
+public:
+    const Config& getConfig() const { return m_config; }
+
+    // Writer thread
+    bool due(uint64_t commandCount, timestamp_t timestamp) const;
+    // The slots are sized by the first publication. Throws an Exception if the serialized stats
+    // are larger than that, e.g. if the publisher is shared with a memory with more ranks or banks.
+    void publish(const SimulationStats& stats, timestamp_t timestamp, uint64_t commandCount);
+
+    // Any thread
+    uint64_t publications() const { return m_publications.load(std::memory_order_acquire); }
+    std::optional<StatsSnapshot> latest() const;
+
+    // Flat representation of the stats
+    static void serializeStats(std::ostream& stream, const SimulationStats& stats);
+    static void deserializeStats(std::istream& stream, SimulationStats& stats);
+
+// Private member functions
+private:
+    void allocate(std::size_t words);
+
+// Private member variables
+private:
+    Config m_config;
+    std::array<Slot, 2> m_slots;
+    std::atomic<uint64_t> m_publications{0};
+
+    // Only accessed by the writer
+    uint64_t m_lastCommandCount = 0;
+    timestamp_t m_lastTimestamp = 0;
+    std::vector<uint64_t> m_buffer;
+};
+
+} // namespace DRAMPower
+
+#endif /* DRAMPOWER_DATA_STATS_PUBLISHER_H */
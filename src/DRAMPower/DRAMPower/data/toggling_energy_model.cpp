@@ -0,0 +1,172 @@
+#include "toggling_energy_model.h"
+
+#include <DRAMPower/Exceptions.h>
+
+using namespace DRAMPower;
+using DRAMUtils::Config::TogglingRateIdlePattern;
+
+namespace {
+
+interface_energy_info_t scaled(const interface_energy_info_t &energy, double factor)
+{
+    interface_energy_info_t result;
+    result.controller.dynamicEnergy = energy.controller.dynamicEnergy * factor;
+    result.controller.staticEnergy = energy.controller.staticEnergy * factor;
+    result.dram.dynamicEnergy = energy.dram.dynamicEnergy * factor;
+    result.dram.staticEnergy = energy.dram.staticEnergy * factor;
+    return result;
+}
+
+interface_energy_info_t difference(const interface_energy_info_t &lhs, const interface_energy_info_t &rhs)
+{
+    return lhs + scaled(rhs, -1.0);
+}
+
+void checkIdlePattern(TogglingRateIdlePattern idlePattern)
+{
+    if (TogglingRateIdlePattern::L != idlePattern && TogglingRateIdlePattern::H != idlePattern) {
+        throw Exception("Invalid TogglingRateIdlePattern");
+    }
+}
+
+} // namespace
+
+void TogglingSweep::push_back(const DRAMUtils::Config::ToggleRateDefinition &definition)
+{
+    togglingRateRead.push_back(definition.togglingRateRead);
+    togglingRateWrite.push_back(definition.togglingRateWrite);
+    dutyCycleRead.push_back(definition.dutyCycleRead);
+    dutyCycleWrite.push_back(definition.dutyCycleWrite);
+    idlePatternRead.push_back(definition.idlePatternRead);
+    idlePatternWrite.push_back(definition.idlePatternWrite);
+}
+
+TogglingSweep TogglingSweep::grid(const std::vector<double> &togglingRates,
+    const std::vector<double> &dutyCycles,
+    const std::vector<TogglingRateIdlePattern> &idlePatterns)
+{
+    TogglingSweep sweep;
+    for (double togglingRate : togglingRates) {
+        for (double dutyCycle : dutyCycles) {
+            for (TogglingRateIdlePattern idlePattern : idlePatterns) {
+                sweep.push_back({togglingRate, togglingRate, dutyCycle, dutyCycle, idlePattern, idlePattern});
+            }
+        }
+    }
+    return sweep;
+}
+
+TogglingEnergyModel::TogglingEnergyModel(const calc_t &calcInterfaceEnergy, const SimulationStats &stats)
+    : m_readActivity(stats.togglingStats.readActivity)
+    , m_writeActivity(stats.togglingStats.writeActivity)
+{
+    // Zero stats with the shape of the run
+    SimulationStats zero = stats;
+    zero -= stats;
+    const interface_energy_info_t zeroEnergy = calcInterfaceEnergy(zero);
+
+    SimulationStats fixed = stats;
+    fixed.togglingStats = TogglingStats{};
+    m_fixed = calcInterfaceEnergy(fixed);
+
+    // Energy of a single unit of a toggling stats field
+    auto probe = [&](util::bus_stats_t TogglingStats::* direction, uint64_t util::bus_stats_t::* field) {
+        SimulationStats unit = zero;
+        (unit.togglingStats.*direction).*field = 1;
+        return difference(calcInterfaceEnergy(unit), zeroEnergy);
+    };
+    auto probeDirection = [&](util::bus_stats_t TogglingStats::* direction, Coefficients &coefficients) {
+        coefficients.one = probe(direction, &util::bus_stats_t::ones);
+        coefficients.zero = probe(direction, &util::bus_stats_t::zeroes);
+        // ones_to_zeroes = zeroes_to_ones = bits * togglingRate / 2, bit_changes = bits * togglingRate
+        coefficients.toggle = scaled(probe(direction, &util::bus_stats_t::ones_to_zeroes), 0.5);
+        coefficients.toggle += scaled(probe(direction, &util::bus_stats_t::zeroes_to_ones), 0.5);
+        coefficients.toggle += probe(direction, &util::bus_stats_t::bit_changes);
+    };
+    probeDirection(&TogglingStats::read, m_read);
+    probeDirection(&TogglingStats::write, m_write);
+}
+
+interface_energy_info_t TogglingEnergyModel::evaluateDirection(const Coefficients &coefficients,
+    const toggling_activity_t &activity, double togglingRate, double dutyCycle,
+    TogglingRateIdlePattern idlePattern) const
+{
+    checkIdlePattern(idlePattern);
+    const double bits = static_cast<double>(activity.bits);
+    const double idle = static_cast<double>(activity.idle);
+    double ones = bits * dutyCycle;
+    double zeroes = bits * (1 - dutyCycle);
+    if (TogglingRateIdlePattern::H == idlePattern) {
+        ones += idle;
+    } else {
+        zeroes += idle;
+    }
+    interface_energy_info_t result = scaled(coefficients.one, ones);
+    result += scaled(coefficients.zero, zeroes);
+    result += scaled(coefficients.toggle, bits * togglingRate);
+    return result;
+}
+
+interface_energy_info_t TogglingEnergyModel::evaluate(const DRAMUtils::Config::ToggleRateDefinition &definition) const
+{
+    interface_energy_info_t result = m_fixed;
+    result += evaluateDirection(m_read, m_readActivity,
+        definition.togglingRateRead, definition.dutyCycleRead, definition.idlePatternRead);
+    result += evaluateDirection(m_write, m_writeActivity,
+        definition.togglingRateWrite, definition.dutyCycleWrite, definition.idlePatternWrite);
+    return result;
+}
+
+double TogglingEnergyModel::evaluateTotal(const DRAMUtils::Config::ToggleRateDefinition &definition) const
+{
+    return evaluate(definition).total();
+}
+
+std::vector<double> TogglingEnergyModel::evaluateTotal(const TogglingSweep &sweep) const
+{
+    const std::size_t n = sweep.size();
+    if (sweep.togglingRateWrite.size() != n || sweep.dutyCycleRead.size() != n || sweep.dutyCycleWrite.size() != n
+        || sweep.idlePatternRead.size() != n || sweep.idlePatternWrite.size() != n) {
+        throw Exception("TogglingSweep: all vectors must have the same size");
+    }
+    for (std::size_t i = 0; i < n; ++i) {
+        checkIdlePattern(sweep.idlePatternRead[i]);
+        checkIdlePattern(sweep.idlePatternWrite[i]);
+    }
+
+    // E = fixed + zeroes + (ones - zeroes) * dutyCycle + toggle * togglingRate + idle(pattern) per direction
+    struct Terms {
+        double zeroes;
+        double dutyCycle;
+        double togglingRate;
+        double idleL;
+        double idleH;
+    };
+    auto terms = [](const Coefficients &coefficients, const toggling_activity_t &activity) {
+        const double bits = static_cast<double>(activity.bits);
+        const double idle = static_cast<double>(activity.idle);
+        const double one = coefficients.one.total();
+        const double zero = coefficients.zero.total();
+        return Terms{zero * bits, (one - zero) * bits, coefficients.toggle.total() * bits, zero * idle, one * idle};
+    };
+    const Terms read = terms(m_read, m_readActivity);
+    const Terms write = terms(m_write, m_writeActivity);
+    const double base = m_fixed.total() + read.zeroes + write.zeroes;
+
+    std::vector<double> result(n);
+    const double *togglingRateRead = sweep.togglingRateRead.data();
+    const double *togglingRateWrite = sweep.togglingRateWrite.data();
+    const double *dutyCycleRead = sweep.dutyCycleRead.data();
+    const double *dutyCycleWrite = sweep.dutyCycleWrite.data();
+    const TogglingRateIdlePattern *idlePatternRead = sweep.idlePatternRead.data();
+    const TogglingRateIdlePattern *idlePatternWrite = sweep.idlePatternWrite.data();
+    double *out = result.data();
+    for (std::size_t i = 0; i < n; ++i) {
+        const double idleRead = TogglingRateIdlePattern::H == idlePatternRead[i] ? read.idleH : read.idleL;
+        const double idleWrite = TogglingRateIdlePattern::H == idlePatternWrite[i] ? write.idleH : write.idleL;
+        out[i] = base
+            + read.dutyCycle * dutyCycleRead[i] + read.togglingRate * togglingRateRead[i] + idleRead
+            + write.dutyCycle * dutyCycleWrite[i] + write.togglingRate * togglingRateWrite[i] + idleWrite;
+    }
+    return result;
+}
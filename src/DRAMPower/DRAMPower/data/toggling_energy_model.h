@@ -0,0 +1,96 @@
+#ifndef DRAMPOWER_DATA_TOGGLING_ENERGY_MODEL_H
+#define DRAMPOWER_DATA_TOGGLING_ENERGY_MODEL_H
+
+#include <DRAMPower/data/energy.h>
+#include <DRAMPower/data/stats.h>
+
+#include <DRAMUtils/config/toggling_rate.h>
+
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+#include <vector>
+
+namespace DRAMPower {
+
+// Toggling rate definitions of a sweep in structure of arrays layout.
+// All vectors have the same size, one entry per point.
+struct TogglingSweep {
+    std::vector<double> togglingRateRead;
+    std::vector<double> togglingRateWrite;
+    std::vector<double> dutyCycleRead;
+    std::vector<double> dutyCycleWrite;
+    std::vector<DRAMUtils::Config::TogglingRateIdlePattern> idlePatternRead;
+    std::vector<DRAMUtils::Config::TogglingRateIdlePattern> idlePatternWrite;
+
+    std::size_t size() const { return togglingRateRead.size(); }
+    void push_back(const DRAMUtils::Config::ToggleRateDefinition &definition);
+
+    // Cartesian product of the axes. Read and write use the same values.
+    static TogglingSweep grid(const std::vector<double> &togglingRates,
+        const std::vector<double> &dutyCycles,
+        const std::vector<DRAMUtils::Config::TogglingRateIdlePattern> &idlePatterns);
+};
+
+// Interface energy of a completed run as a function of the toggling rate definition.
+// In toggling rate mode the toggling stats are linear in the transferred and idle bit times
+// of the toggling handles (TogglingStats::readActivity and writeActivity) and the interface
+// energy is linear in the stats. The model probes the interface calculation of the memory
+// once per stats field and evaluates any toggling rate definition without re-simulating
+// the trace. The result matches a simulation with the same definition up to the rounding
+// of the simulated counters to whole bits.
+class TogglingEnergyModel {
+// Public type definitions
+public:
+    using calc_t = std::function<interface_energy_info_t(const SimulationStats&)>;
+
+// Private type definitions
+private:
+    // Energy per bit time
+    struct Coefficients {
+        interface_energy_info_t one;
+        interface_energy_info_t zero;
+        // Per bit time and unit toggling rate
+        interface_energy_info_t toggle;
+    };
+
+// Public constructors
+public:
+    TogglingEnergyModel(const calc_t &calcInterfaceEnergy, const SimulationStats &stats);
+
+    // dram only has to provide calcInterfaceEnergyStats
+    template <typename DRAM, typename = std::enable_if_t<!std::is_convertible_v<const DRAM&, calc_t>>>
+    TogglingEnergyModel(const DRAM &dram, const SimulationStats &stats)
+        : TogglingEnergyModel(calc_t{[&dram](const SimulationStats &s) {
+            return dram.calcInterfaceEnergyStats(s);
+        }}, stats)
+    {}
+
+// Public member functions
+public:
+    interface_energy_info_t evaluate(const DRAMUtils::Config::ToggleRateDefinition &definition) const;
+    double evaluateTotal(const DRAMUtils::Config::ToggleRateDefinition &definition) const;
+    // Total interface energy of every point of the sweep
+    std::vector<double> evaluateTotal(const TogglingSweep &sweep) const;
+
+    // Interface energy without the toggling handles
+    const interface_energy_info_t &getFixedEnergy() const { return m_fixed; }
+
+// Private member functions
+private:
+    interface_energy_info_t evaluateDirection(const Coefficients &coefficients,
+        const toggling_activity_t &activity, double togglingRate, double dutyCycle,
+        DRAMUtils::Config::TogglingRateIdlePattern idlePattern) const;
+
+// Private member variables
+private:
+    interface_energy_info_t m_fixed;
+    Coefficients m_read;
+    Coefficients m_write;
+    toggling_activity_t m_readActivity;
+    toggling_activity_t m_writeActivity;
+};
+
+} // namespace DRAMPower
+
+#endif /* DRAMPOWER_DATA_TOGGLING_ENERGY_MODEL_H */
@@ -0,0 +1,683 @@
+#ifndef DRAMPOWER_DRAM_CORE_H
+#define DRAMPOWER_DRAM_CORE_H
+
+#include "DRAMPower/util/Deserialize.h"
+#include "DRAMPower/util/Serialize.h"
+#include <DRAMPower/Exceptions.h>
+#include <DRAMPower/Types.h>
+#include <DRAMPower/command/CmdType.h>
+#include <DRAMPower/data/stats.h>
+#include <DRAMPower/dram/Geometry.h>
+#include <DRAMPower/dram/Rank.h>
+#include <DRAMPower/util/ImplicitCommandHandler.h>
+#include <DRAMPower/util/RegisterHelper.h>
+#include <DRAMPower/util/delta_checkpoint.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace DRAMPower {
+
+namespace internal {
+    template<typename Core>
+    class TestAccessor;
+}
+
+// How the active intervals of the banks and the rank are suspended and resumed by power-down
+enum class PowerDownModel {
+    // Activity follows the active bank state. Both power-down modes close the active intervals,
+    // the exit resumes the banks which are still active. The rank interval is started if not running.
+    ActiveBanks,
+    // Activity follows the rank state. Active power-down closes the active intervals, the exit
+    // resumes the banks whose interval was closed at entry and the rank if any bank was resumed.
+    InterruptedBanks,
+    // Like InterruptedBanks, but the exit always resumes the rank interval
+    InterruptedBanksAndRank,
+};
+
+/** Core engine shared by all standards
+ * Policy describes the standard:
+ *   memspec_t, timings_t, command_t        memspec, core timings constructed from it and command type
+ *   perBankRefresh                         REFB
+ *   sameBankRefresh                        REFSB and PRESB (one bank in every bank group)
+ *   perTwoBankRefresh                      REFP2B (bank and bank + perTwoBankOffset)
+ *   dualBankRefresh                        REFDB (bank and dbank of the command)
+ *   deepSleepMode                          DSMEN and DSMEX
+ *   powerDownModel                         see PowerDownModel
+ *   tRFC(timings), tRCD(timings)           all bank refresh time and activate delay
+ *   tRFCbank(timings)                      refresh time of the bank refresh commands above
+ *   supportsPerTwoBankRefresh(timings)     REFP2B is valid for the bank architecture
+ * Ranks, banks and bank groups are sized by Geometry. Handlers of unsupported commands are
+ * discarded at compile time.
+ */
+template <typename Policy, typename Geometry = DynamicGeometry>
+class BasicCore : public util::Serialize, public util::Deserialize {
+// Friend classes
+friend class internal::TestAccessor<BasicCore>;
+
+// Public type definitions
+public:
+    using policy_t = Policy;
+    using geometry_t = Geometry;
+    using memspec_t = typename Policy::memspec_t;
+    using timings_t = typename Policy::timings_t;
+    using command_t = typename Policy::command_t;
+
+// Public constructors
+public:
+    BasicCore(const memspec_t& memSpec)
+        : m_memSpec(memSpec)
+        , m_ranks(Geometry::makeRanks(memSpec.numberOfRanks, memSpec.numberOfBanks, memSpec.numberOfBankGroups))
+    {}
+
+// Public member functions
+public:
+// Member functions
+    void doCommand(const command_t& cmd);
+    // Executes the implicit commands up to timestamp and calls onExecuted with the timestamp of each one.
+    // doCommand executes the implicit commands up to its own timestamp first.
+    template <typename Func>
+    void processImplicitCommands(timestamp_t timestamp, Func&& onExecuted) {
+        m_implicitCommandHandler.processImplicitCommandQueue(*this, timestamp, m_last_command_time, std::forward<Func>(onExecuted));
+    }
+    // Changes whenever implicit commands were executed, also by isIdle and getWindowStats
+    uint64_t implicitCommandsExecuted() const { return m_implicitCommandHandler.executedCount(); }
+    timestamp_t getLastCommandTime() const;
+    const typename Geometry::ranks_t& getRanks() const { return m_ranks; }
+    bool isSerializable() const;
+    bool isIdle(timestamp_t timestamp);
+    void getWindowStats(timestamp_t timestamp, SimulationStats &stats);
+// Overrides
+    void serialize(std::ostream& stream) const override;
+    void deserialize(std::istream& stream) override;
+    // Delta checkpoints
+    void serializeDelta(std::ostream& stream);
+    void deserializeDelta(std::istream& stream);
+    void clearDelta();
+
+// Private member functions
+private:
+    // Constant for a fixed geometry
+    std::size_t rankCount() const { return Geometry::ranks(m_memSpec.numberOfRanks); }
+    std::size_t bankCount() const { return Geometry::banks(m_memSpec.numberOfBanks); }
+    void startRankActivity(Rank& rank, timestamp_t timestamp);
+    void handleAct(Rank& rank, Bank& bank, timestamp_t timestamp);
+    void handlePre(Rank& rank, Bank& bank, timestamp_t timestamp);
+    void handlePreAll(Rank& rank, timestamp_t timestamp);
+    void handlePreSameBank(Rank& rank, std::size_t bank_id, timestamp_t timestamp);
+    void handleRead(Rank& rank, Bank& bank, timestamp_t timestamp);
+    void handleWrite(Rank& rank, Bank& bank, timestamp_t timestamp);
+    void handleReadAuto(std::size_t rank_idx, std::size_t bank_idx, timestamp_t timestamp);
+    void handleWriteAuto(std::size_t rank_idx, std::size_t bank_idx, timestamp_t timestamp);
+    void handleAutoPrecharge(std::size_t rank_idx, std::size_t bank_idx, timestamp_t timestamp, uint64_t offset);
+    void handleRefAll(std::size_t rank_idx, timestamp_t timestamp);
+    void handleRefPerBank(std::size_t rank_idx, std::size_t bank_idx, timestamp_t timestamp);
+    void handleRefSameBank(std::size_t rank_idx, std::size_t bank_id, timestamp_t timestamp);
+    void handleRefPerTwoBanks(std::size_t rank_idx, std::size_t bank_idx, timestamp_t timestamp);
+    void handleRefDualBanks(std::size_t rank_idx, std::size_t bank_idx1, std::size_t bank_idx2, timestamp_t timestamp);
+    void handleRefreshOnBank(std::size_t rank_idx, std::size_t bank_idx, timestamp_t timestamp, uint64_t timing,
+                             uint64_t& counter);
+    void handleSelfRefreshEntry(std::size_t rank_idx, timestamp_t timestamp);
+    void handleSelfRefreshExit(Rank& rank, timestamp_t timestamp);
+    void handlePowerDownActEntry(std::size_t rank_idx, timestamp_t timestamp);
+    void handlePowerDownActExit(std::size_t rank_idx, timestamp_t timestamp);
+    void handlePowerDownPreEntry(std::size_t rank_idx, timestamp_t timestamp);
+    void handlePowerDownPreExit(std::size_t rank_idx, timestamp_t timestamp);
+    void handleDSMEntry(Rank& rank, timestamp_t timestamp);
+    void handleDSMExit(Rank& rank, timestamp_t timestamp);
+
+    timestamp_t earliestPossiblePowerDownEntryTime(Rank& rank) const;
+
+// Private member variables
+private:
+    timings_t m_memSpec;
+    typename Geometry::ranks_t m_ranks;
+    ImplicitCommandHandler<BasicCore> m_implicitCommandHandler;
+    timestamp_t m_last_command_time = 0;
+    util::RankDeltaTracker m_deltaTracker{m_ranks};
+};
+
+template <typename Policy, typename Geometry>
+void BasicCore<Policy, Geometry>::doCommand(const command_t& cmd) {
+    m_deltaTracker.markCommand(cmd);
+    m_implicitCommandHandler.processImplicitCommandQueue(*this, cmd.timestamp, m_last_command_time);
+    m_last_command_time = std::max(cmd.timestamp, m_last_command_time);
+    switch(cmd.type) {
+        case CmdType::ACT:
+            util::coreHelpers::bankHandler(cmd, m_ranks, this, &BasicCore::handleAct);
+            break;
+        case CmdType::PRE:
+            util::coreHelpers::bankHandler(cmd, m_ranks, this, &BasicCore::handlePre);
+            break;
+        case CmdType::PREA:
+            util::coreHelpers::rankHandler(cmd, m_ranks, this, &BasicCore::handlePreAll);
+            break;
+        case CmdType::RD:
+            util::coreHelpers::bankHandler(cmd, m_ranks, this, &BasicCore::handleRead);
+            break;
+        case CmdType::RDA:
+            util::coreHelpers::bankHandlerIdx(cmd, m_ranks, this, &BasicCore::handleReadAuto);
+            break;
+        case CmdType::WR:
+            util::coreHelpers::bankHandler(cmd, m_ranks, this, &BasicCore::handleWrite);
+            break;
+        case CmdType::WRA:
+            util::coreHelpers::bankHandlerIdx(cmd, m_ranks, this, &BasicCore::handleWriteAuto);
+            break;
+        case CmdType::REFA:
+            util::coreHelpers::rankHandlerIdx(cmd, m_ranks, this, &BasicCore::handleRefAll);
+            break;
+        case CmdType::REFB:
+            if constexpr (Policy::perBankRefresh) {
+                util::coreHelpers::bankHandlerIdx(cmd, m_ranks, this, &BasicCore::handleRefPerBank);
+            } else {
+                assert(false && "Unsupported command");
+            }
+            break;
+        case CmdType::PRESB:
+            if constexpr (Policy::sameBankRefresh) {
+                util::coreHelpers::bankGroupHandler(cmd, m_ranks, this, &BasicCore::handlePreSameBank);
+            } else {
+                assert(false && "Unsupported command");
+            }
+            break;
+        case CmdType::REFSB:
+            if constexpr (Policy::sameBankRefresh) {
+                util::coreHelpers::bankGroupHandlerIdx(cmd, m_ranks, this, &BasicCore::handleRefSameBank);
+            } else {
+                assert(false && "Unsupported command");
+            }
+            break;
+        case CmdType::REFP2B:
+            if constexpr (Policy::perTwoBankRefresh) {
+                if (!Policy::supportsPerTwoBankRefresh(m_memSpec)) {
+                    throw Exception(std::string("REFP2B command is not supported for this bank architecture: ") + CmdTypeUtil::to_string(CmdType::REFP2B));
+                }
+                util::coreHelpers::bankGroupHandlerIdx(cmd, m_ranks, this, &BasicCore::handleRefPerTwoBanks);
+            } else {
+                assert(false && "Unsupported command");
+            }
+            break;
+        case CmdType::REFDB:
+            if constexpr (Policy::dualBankRefresh) {
+                assert(m_ranks.size() > cmd.targetCoordinate.rank);
+                auto& rank = m_ranks.at(cmd.targetCoordinate.rank);
+                assert(rank.banks.size() > cmd.targetCoordinate.bank);
+                assert(rank.banks.size() > cmd.targetCoordinate.dbank);
+                if (cmd.targetCoordinate.bank >= rank.banks.size() || cmd.targetCoordinate.dbank >= rank.banks.size()) {
+                    throw std::invalid_argument("Invalid bank target coordinate");
+                }
+                handleRefDualBanks(cmd.targetCoordinate.rank, cmd.targetCoordinate.bank, cmd.targetCoordinate.dbank, cmd.timestamp);
+            } else {
+                assert(false && "Unsupported command");
+            }
+            break;
+        case CmdType::SREFEN:
+            util::coreHelpers::rankHandlerIdx(cmd, m_ranks, this, &BasicCore::handleSelfRefreshEntry);
+            break;
+        case CmdType::SREFEX:
+            util::coreHelpers::rankHandler(cmd, m_ranks, this, &BasicCore::handleSelfRefreshExit);
+            break;
+        case CmdType::PDEA:
+            util::coreHelpers::rankHandlerIdx(cmd, m_ranks, this, &BasicCore::handlePowerDownActEntry);
+            break;
+        case CmdType::PDEP:
+            util::coreHelpers::rankHandlerIdx(cmd, m_ranks, this, &BasicCore::handlePowerDownPreEntry);
+            break;
+        case CmdType::PDXA:
+            util::coreHelpers::rankHandlerIdx(cmd, m_ranks, this, &BasicCore::handlePowerDownActExit);
+            break;
+        case CmdType::PDXP:
+            util::coreHelpers::rankHandlerIdx(cmd, m_ranks, this, &BasicCore::handlePowerDownPreExit);
+            break;
+        case CmdType::DSMEN:
+            if constexpr (Policy::deepSleepMode) {
+                util::coreHelpers::rankHandler(cmd, m_ranks, this, &BasicCore::handleDSMEntry);
+            } else {
+                assert(false && "Unsupported command");
+            }
+            break;
+        case CmdType::DSMEX:
+            if constexpr (Policy::deepSleepMode) {
+                util::coreHelpers::rankHandler(cmd, m_ranks, this, &BasicCore::handleDSMExit);
+            } else {
+                assert(false && "Unsupported command");
+            }
+            break;
+        case CmdType::NOP:
+        case CmdType::END_OF_SIMULATION:
+            break;
+        default:
+            assert(false && "Unsupported command");
+            break;
+    }
+}
+
+template <typename Policy, typename Geometry>
+timestamp_t BasicCore<Policy, Geometry>::getLastCommandTime() const {
+    return m_last_command_time;
+}
+
+template <typename Policy, typename Geometry>
+bool BasicCore<Policy, Geometry>::isSerializable() const {
+    return 0 == m_implicitCommandHandler.implicitCommandCount();
+}
+
+template <typename Policy, typename Geometry>
+bool BasicCore<Policy, Geometry>::isIdle(timestamp_t timestamp) {
+    // A core is idle if a freshly constructed core would behave identically for all commands issued at or after timestamp
+    m_implicitCommandHandler.processImplicitCommandQueue(*this, timestamp, m_last_command_time);
+    if (0 != m_implicitCommandHandler.implicitCommandCount()) {
+        return false;
+    }
+    for (auto& rank : m_ranks) {
+        if (!rank.isIdle(timestamp) || earliestPossiblePowerDownEntryTime(rank) > timestamp) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <typename Policy, typename Geometry>
+void BasicCore<Policy, Geometry>::startRankActivity(Rank &rank, timestamp_t timestamp) {
+    // Must be called before the bank is set active
+    if constexpr (Policy::powerDownModel == PowerDownModel::ActiveBanks) {
+        rank.cycles.act.start_interval_if_not_running(timestamp);
+    } else {
+        if (!rank.isActive(timestamp)) {
+            rank.cycles.act.start_interval(timestamp);
+        }
+    }
+}
+
+template <typename Policy, typename Geometry>
+void BasicCore<Policy, Geometry>::handleAct(Rank &rank, Bank &bank, timestamp_t timestamp) {
+    auto bank_idx = rank.bankIndex(bank);
+    bank.counter.act++;
+
+    bank.cycles.act.start_interval(timestamp);
+    rank.updateBankTimestamps(bank_idx);
+
+    startRankActivity(rank, timestamp);
+    rank.setBankActive(bank_idx);
+}
+
+template <typename Policy, typename Geometry>
+void BasicCore<Policy, Geometry>::handlePre(Rank &rank, Bank &bank, timestamp_t timestamp) {
+    // bank.counter.pre counts the transitions to the precharged state, not the PRE commands
+    auto bank_idx = rank.bankIndex(bank);
+    if (!rank.isBankActive(bank_idx))
+        return;
+
+    bank.counter.pre++;
+    bank.cycles.act.close_interval(timestamp);
+    bank.latestPre = timestamp;
+    rank.setBankPrecharged(bank_idx);
+    rank.updateBankTimestamps(bank_idx);
+
+    if (!rank.isActive(timestamp)) {
+        rank.cycles.act.close_interval(timestamp);
+    }
+}
+
+template <typename Policy, typename Geometry>
+void BasicCore<Policy, Geometry>::handlePreAll(Rank &rank, timestamp_t timestamp) {
+    // Precharged banks are skipped by handlePre
+    rank.forEachActiveBank([this, &rank, timestamp](std::size_t bank_idx) {
+        handlePre(rank, rank.banks[bank_idx], timestamp);
+    });
+}
+
+template <typename Policy, typename Geometry>
+void BasicCore<Policy, Geometry>::handlePreSameBank(Rank &rank, std::size_t bank_id, timestamp_t timestamp) {
+    if constexpr (Policy::sameBankRefresh) {
+        auto bank_id_inside_bg = bank_id % m_memSpec.banksPerGroup;
+        for (unsigned bank_group = 0; bank_group < Geometry::bankGroups(m_memSpec.numberOfBankGroups); bank_group++) {
+            auto& bank = rank.banks[bank_group * m_memSpec.banksPerGroup + bank_id_inside_bg];
+            handlePre(rank, bank, timestamp);
+        }
+    }
+}
+
+template <typename Policy, typename Geometry>
+void BasicCore<Policy, Geometry>::handleRead(Rank&, Bank &bank, timestamp_t) {
+    ++bank.counter.reads;
+}
+
+template <typename Policy, typename Geometry>
+void BasicCore<Policy, Geometry>::handleWrite(Rank&, Bank &bank, timestamp_t) {
+    ++bank.counter.writes;
+}
+
+template <typename Policy, typename Geometry>
+void BasicCore<Policy, Geometry>::handleReadAuto(std::size_t rank_idx, std::size_t bank_idx, timestamp_t timestamp) {
+    ++m_ranks[rank_idx].banks[bank_idx].counter.readAuto;
+    handleAutoPrecharge(rank_idx, bank_idx, timestamp, m_memSpec.prechargeOffsetRD);
+}
+
+template <typename Policy, typename Geometry>
+void BasicCore<Policy, Geometry>::handleWriteAuto(std::size_t rank_idx, std::size_t bank_idx, timestamp_t timestamp) {
+    ++m_ranks[rank_idx].banks[bank_idx].counter.writeAuto;
+    handleAutoPrecharge(rank_idx, bank_idx, timestamp, m_memSpec.prechargeOffsetWR);
+}
+
+template <typename Policy, typename Geometry>
+void BasicCore<Policy, Geometry>::handleAutoPrecharge(std::size_t rank_idx, std::size_t bank_idx, timestamp_t timestamp, uint64_t offset) {
+    auto& bank = m_ranks[rank_idx].banks[bank_idx];
+
+    auto minBankActiveTime = bank.cycles.act.get_start() + m_memSpec.tRAS;
+    auto minAccessActiveTime = timestamp + offset;
+
+    auto delayed_timestamp = std::max(minBankActiveTime, minAccessActiveTime);
+
+    // Execute PRE after minimum active time
+    m_implicitCommandHandler.addImplicitCommand(delayed_timestamp, [rank_idx, bank_idx, delayed_timestamp](BasicCore& self) {
+        auto& rank = self.m_ranks[rank_idx];
+        auto& bank = rank.banks[bank_idx];
+        self.handlePre(rank, bank, delayed_timestamp);
+    });
+}
+
+template <typename Policy, typename Geometry>
+void BasicCore<Policy, Geometry>::handleRefAll(std::size_t rank_idx, timestamp_t timestamp) {
+    auto& rank = m_ranks[rank_idx];
+    for (std::size_t bank_idx = 0; bank_idx < bankCount(); ++bank_idx) {
+        auto& counter = rank.banks[bank_idx].counter.refAllBank;
+        handleRefreshOnBank(rank_idx, bank_idx, timestamp, Policy::tRFC(m_memSpec), counter);
+    }
+    rank.endRefreshTime = timestamp + Policy::tRFC(m_memSpec);
+}
+
+template <typename Policy, typename Geometry>
+void BasicCore<Policy, Geometry>::handleRefPerBank(std::size_t rank_idx, std::size_t bank_idx, timestamp_t timestamp) {
+    if constexpr (Policy::perBankRefresh) {
+        auto& counter = m_ranks[rank_idx].banks[bank_idx].counter.refPerBank;
+        handleRefreshOnBank(rank_idx, bank_idx, timestamp, Policy::tRFCbank(m_memSpec), counter);
+    }
+}
+
+template <typename Policy, typename Geometry>
+void BasicCore<Policy, Geometry>::handleRefSameBank(std::size_t rank_idx, std::size_t bank_id, timestamp_t timestamp) {
+    if constexpr (Policy::sameBankRefresh) {
+        auto bank_id_inside_bg = bank_id % m_memSpec.banksPerGroup;
+        for (unsigned bank_group = 0; bank_group < Geometry::bankGroups(m_memSpec.numberOfBankGroups); bank_group++) {
+            std::size_t bank_idx = bank_group * m_memSpec.banksPerGroup + bank_id_inside_bg;
+            auto& counter = m_ranks[rank_idx].banks[bank_idx].counter.refSameBank;
+            handleRefreshOnBank(rank_idx, bank_idx, timestamp, Policy::tRFCbank(m_memSpec), counter);
+        }
+    }
+}
+
+template <typename Policy, typename Geometry>
+void BasicCore<Policy, Geometry>::handleRefPerTwoBanks(std::size_t rank_idx, std::size_t bank_idx, timestamp_t timestamp) {
+    if constexpr (Policy::perTwoBankRefresh) {
+        auto& rank = m_ranks[rank_idx];
+        std::size_t bank_2_idx = (bank_idx + m_memSpec.perTwoBankOffset) % 16;
+        auto& counter1 = rank.banks[bank_idx].counter.refPerTwoBanks;
+        auto& counter2 = rank.banks[bank_2_idx].counter.refPerTwoBanks;
+        handleRefreshOnBank(rank_idx, bank_idx, timestamp, Policy::tRFCbank(m_memSpec), counter1);
+        handleRefreshOnBank(rank_idx, bank_2_idx, timestamp, Policy::tRFCbank(m_memSpec), counter2);
+    }
+}
+
+template <typename Policy, typename Geometry>
+void BasicCore<Policy, Geometry>::handleRefDualBanks(std::size_t rank_idx, std::size_t bank_idx1, std::size_t bank_idx2, timestamp_t timestamp) {
+    if constexpr (Policy::dualBankRefresh) {
+        auto& rank = m_ranks[rank_idx];
+        auto& counter1 = rank.banks[bank_idx1].counter.refDualBanks;
+        auto& counter2 = rank.banks[bank_idx2].counter.refDualBanks;
+        handleRefreshOnBank(rank_idx, bank_idx1, timestamp, Policy::tRFCbank(m_memSpec), counter1);
+        handleRefreshOnBank(rank_idx, bank_idx2, timestamp, Policy::tRFCbank(m_memSpec), counter2);
+        // TODO rank.endRefreshTime?
+    }
+}
+
+template <typename Policy, typename Geometry>
+void BasicCore<Policy, Geometry>::handleRefreshOnBank(std::size_t rank_idx, std::size_t bank_idx, timestamp_t timestamp, uint64_t timing, uint64_t &counter) {
+    ++counter;
+    auto& rank = m_ranks[rank_idx];
+    auto& bank = rank.banks[bank_idx];
+
+    startRankActivity(rank, timestamp);
+    rank.setBankActive(bank_idx);
+
+    auto timestamp_end = timestamp + timing;
+    bank.refreshEndTime = timestamp_end;
+    if (!bank.cycles.act.is_open())
+        bank.cycles.act.start_interval(timestamp);
+    rank.updateBankTimestamps(bank_idx);
+
+    // Execute implicit pre-charge at refresh end
+    m_implicitCommandHandler.addImplicitCommand(timestamp_end, [rank_idx, bank_idx, timestamp_end](BasicCore& self) {
+        auto& rank = self.m_ranks[rank_idx];
+        auto& bank = rank.banks[bank_idx];
+        rank.setBankPrecharged(bank_idx);
+        bank.cycles.act.close_interval(timestamp_end);
+
+        if (!rank.isActive(timestamp_end)) {
+            rank.cycles.act.close_interval(timestamp_end);
+        }
+    });
+}
+
+template <typename Policy, typename Geometry>
+void BasicCore<Policy, Geometry>::handleSelfRefreshEntry(std::size_t rank_idx, timestamp_t timestamp) {
+    // Issue implicit refresh
+    handleRefAll(rank_idx, timestamp);
+
+    // Handle self-refresh entry after tRFC
+    auto timestampSelfRefreshStart = timestamp + Policy::tRFC(m_memSpec);
+    m_implicitCommandHandler.addImplicitCommand(timestampSelfRefreshStart, [rank_idx, timestampSelfRefreshStart](BasicCore& self) {
+        auto& rank = self.m_ranks[rank_idx];
+        rank.counter.selfRefresh++;
+        rank.cycles.sref.start_interval(timestampSelfRefreshStart);
+        rank.memState = MemState::SREF;
+    });
+}
+
+template <typename Policy, typename Geometry>
+void BasicCore<Policy, Geometry>::handleSelfRefreshExit(Rank &rank, timestamp_t timestamp) {
+    assert(rank.memState == MemState::SREF);
+    rank.cycles.sref.close_interval(timestamp);  // Duration between entry and exit
+    rank.memState = MemState::NOT_IN_PD;
+}
+
+template <typename Policy, typename Geometry>
+void BasicCore<Policy, Geometry>::handlePowerDownActEntry(std::size_t rank_idx, timestamp_t timestamp) {
+    auto& rank = m_ranks[rank_idx];
+    auto earliestPossibleEntry = this->earliestPossiblePowerDownEntryTime(rank);
+    auto entryTime = std::max(timestamp, earliestPossibleEntry);
+    m_implicitCommandHandler.addImplicitCommand(entryTime, [rank_idx, entryTime](BasicCore& self) {
+        auto& rank = self.m_ranks[rank_idx];
+        rank.cycles.powerDownAct.start_interval(entryTime);
+        rank.memState = MemState::PDN_ACT;
+        // Closing a closed interval has no effect
+        rank.cycles.act.close_interval(entryTime);
+        for (auto& bank : rank.banks) {
+            bank.cycles.act.close_interval(entryTime);
+        }
+    });
+}
+
+template <typename Policy, typename Geometry>
+void BasicCore<Policy, Geometry>::handlePowerDownActExit(std::size_t rank_idx, timestamp_t timestamp) {
+    auto& rank = m_ranks[rank_idx];
+    if constexpr (Policy::powerDownModel == PowerDownModel::ActiveBanks) {
+        assert(rank.memState == MemState::PDN_ACT);
+    }
+    auto earliestPossibleExit = this->earliestPossiblePowerDownEntryTime(rank);
+    auto exitTime = std::max(timestamp, earliestPossibleExit);
+
+    m_implicitCommandHandler.addImplicitCommand(exitTime, [rank_idx, exitTime](BasicCore& self) {
+        auto& rank = self.m_ranks[rank_idx];
+        rank.memState = MemState::NOT_IN_PD;
+        rank.cycles.powerDownAct.close_interval(exitTime);
+
+        if constexpr (Policy::powerDownModel == PowerDownModel::ActiveBanks) {
+            // Resume the banks that were active prior to the power-down
+            rank.forEachActiveBank([&rank, exitTime](std::size_t bank_idx) {
+                rank.banks[bank_idx].cycles.act.start_interval(exitTime);
+                rank.updateBankTimestamps(bank_idx);
+            });
+            if (rank.isActive(exitTime)) {
+                rank.cycles.act.start_interval(exitTime);
+            }
+        } else {
+            // Resume the banks whose active interval was closed at entry
+            bool rank_active = Policy::powerDownModel == PowerDownModel::InterruptedBanksAndRank;
+            for (std::size_t bank_idx = 0; bank_idx < self.bankCount(); ++bank_idx) {
+                auto& bank = rank.banks[bank_idx];
+                if (bank.counter.act != 0 && bank.cycles.act.get_end() == rank.cycles.powerDownAct.get_start()) {
+                    rank_active = true;
+                    bank.cycles.act.start_interval(exitTime);
+                    rank.updateBankTimestamps(bank_idx);
+                }
+            }
+            if (rank_active) {
+                rank.cycles.act.start_interval(exitTime);
+            }
+        }
+    });
+}
+
+template <typename Policy, typename Geometry>
+void BasicCore<Policy, Geometry>::handlePowerDownPreEntry(std::size_t rank_idx, timestamp_t timestamp) {
+    auto& rank = m_ranks[rank_idx];
+    auto earliestPossibleEntry = this->earliestPossiblePowerDownEntryTime(rank);
+    auto entryTime = std::max(timestamp, earliestPossibleEntry);
+
+    m_implicitCommandHandler.addImplicitCommand(entryTime, [rank_idx, entryTime](BasicCore& self) {
+        auto& rank = self.m_ranks[rank_idx];
+        if constexpr (Policy::powerDownModel == PowerDownModel::ActiveBanks) {
+            for (auto& bank : rank.banks)
+                bank.cycles.act.close_interval(entryTime);
+            rank.cycles.act.close_interval(entryTime);
+        }
+        rank.cycles.powerDownPre.start_interval(entryTime);
+        rank.memState = MemState::PDN_PRE;
+    });
+}
+
+template <typename Policy, typename Geometry>
+void BasicCore<Policy, Geometry>::handlePowerDownPreExit(std::size_t rank_idx, timestamp_t timestamp) {
+    auto& rank = m_ranks[rank_idx];
+    // The computation is necessary to exit at the earliest timestamp (upon entry)
+    auto earliestPossibleExit = this->earliestPossiblePowerDownEntryTime(rank);
+    auto exitTime = std::max(timestamp, earliestPossibleExit);
+
+    m_implicitCommandHandler.addImplicitCommand(exitTime, [rank_idx, exitTime](BasicCore& self) {
+        auto& rank = self.m_ranks[rank_idx];
+        rank.memState = MemState::NOT_IN_PD;
+        rank.cycles.powerDownPre.close_interval(exitTime);
+        if constexpr (Policy::powerDownModel == PowerDownModel::ActiveBanks) {
+            rank.forEachActiveBank([&rank, exitTime](std::size_t bank_idx) {
+                rank.banks[bank_idx].cycles.act.start_interval(exitTime);
+                rank.updateBankTimestamps(bank_idx);
+            });
+        }
+    });
+}
+
+template <typename Policy, typename Geometry>
+void BasicCore<Policy, Geometry>::handleDSMEntry(Rank &rank, timestamp_t timestamp) {
+    assert(rank.memState == MemState::SREF);
+    rank.cycles.deepSleepMode.start_interval(timestamp);
+    rank.counter.deepSleepMode++;
+    rank.memState = MemState::DSM;
+}
+
+template <typename Policy, typename Geometry>
+void BasicCore<Policy, Geometry>::handleDSMExit(Rank &rank, timestamp_t timestamp) {
+    assert(rank.memState == MemState::DSM);
+    rank.cycles.deepSleepMode.close_interval(timestamp);
+    rank.memState = MemState::SREF;
+}
+
+template <typename Policy, typename Geometry>
+timestamp_t BasicCore<Policy, Geometry>::earliestPossiblePowerDownEntryTime(Rank &rank) const {
+    return rank.earliestPowerDownEntryTime(Policy::tRCD(m_memSpec), m_memSpec.tRP);
+}
+
+template <typename Policy, typename Geometry>
+void BasicCore<Policy, Geometry>::getWindowStats(timestamp_t timestamp, SimulationStats &stats) {
+    m_implicitCommandHandler.processImplicitCommandQueue(*this, timestamp, m_last_command_time);
+    stats.bank.resize(bankCount() * rankCount());
+    stats.rank_total.resize(rankCount());
+
+    // Deep sleep is part of the self-refresh interval and zero without DSM support
+    auto simulation_duration = timestamp;
+    for (size_t i = 0; i < rankCount(); ++i) {
+        const Rank &rank = m_ranks[i];
+        size_t bank_offset = i * bankCount();
+
+        const uint64_t selfRefresh = rank.cycles.sref.get_count_at(timestamp);
+        const uint64_t deepSleepMode = rank.cycles.deepSleepMode.get_count_at(timestamp);
+        const uint64_t powerDownAct = rank.cycles.powerDownAct.get_count_at(timestamp);
+        const uint64_t powerDownPre = rank.cycles.powerDownPre.get_count_at(timestamp);
+
+        for (std::size_t j = 0; j < bankCount(); ++j) {
+            auto& bankStats = stats.bank[bank_offset + j];
+            bankStats.counter = rank.banks[j].counter;
+            bankStats.cycles.act = rank.banks[j].cycles.act.get_count_at(timestamp);
+            bankStats.cycles.selfRefresh = selfRefresh - deepSleepMode;
+            bankStats.cycles.deepSleepMode = deepSleepMode;
+            bankStats.cycles.powerDownAct = powerDownAct;
+            bankStats.cycles.powerDownPre = powerDownPre;
+            bankStats.cycles.pre =
+                simulation_duration - (bankStats.cycles.act + powerDownAct + powerDownPre + selfRefresh);
+        }
+
+        auto& rankStats = stats.rank_total[i];
+        rankStats.cycles.act = rank.cycles.act.get_count_at(timestamp);
+        rankStats.cycles.powerDownAct = powerDownAct;
+        rankStats.cycles.powerDownPre = powerDownPre;
+        rankStats.cycles.selfRefresh = selfRefresh - deepSleepMode;
+        rankStats.cycles.deepSleepMode = deepSleepMode;
+        rankStats.cycles.pre =
+            simulation_duration - (rankStats.cycles.act + powerDownAct + powerDownPre + selfRefresh);
+    }
+}
+
+template <typename Policy, typename Geometry>
+void BasicCore<Policy, Geometry>::serialize(std::ostream& stream) const {
+    stream.write(reinterpret_cast<const char*>(&m_last_command_time), sizeof(m_last_command_time));
+    for (const auto& rank : m_ranks) {
+        rank.serialize(stream);
+    }
+}
+
+template <typename Policy, typename Geometry>
+void BasicCore<Policy, Geometry>::deserialize(std::istream& stream) {
+    stream.read(reinterpret_cast<char*>(&m_last_command_time), sizeof(m_last_command_time));
+    for (auto& rank : m_ranks) {
+        rank.deserialize(stream);
+    }
+}
+
+template <typename Policy, typename Geometry>
+void BasicCore<Policy, Geometry>::serializeDelta(std::ostream& stream) {
+    stream.write(reinterpret_cast<const char*>(&m_last_command_time), sizeof(m_last_command_time));
+    m_deltaTracker.serializeDelta(stream, m_ranks);
+}
+
+template <typename Policy, typename Geometry>
+void BasicCore<Policy, Geometry>::deserializeDelta(std::istream& stream) {
+    stream.read(reinterpret_cast<char*>(&m_last_command_time), sizeof(m_last_command_time));
+    m_deltaTracker.deserializeDelta(stream, m_ranks);
+}
+
+template <typename Policy, typename Geometry>
+void BasicCore<Policy, Geometry>::clearDelta() {
+    m_deltaTracker.clear();
+}
+
+} // namespace DRAMPower
+
+#endif /* DRAMPOWER_DRAM_CORE_H */
@@ -0,0 +1,87 @@
+#ifndef DRAMPOWER_DRAM_GEOMETRY_H
+#define DRAMPOWER_DRAM_GEOMETRY_H
+
+#include <DRAMPower/Exceptions.h>
+#include <DRAMPower/dram/Rank.h>
+
+#include <array>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace DRAMPower {
+
+// Geometry of a core sized at runtime from the memspec
+struct DynamicGeometry {
+    static constexpr bool isFixed = false;
+    using ranks_t = std::vector<Rank>;
+
+    static constexpr std::size_t ranks(std::size_t numberOfRanks) { return numberOfRanks; }
+    static constexpr std::size_t banks(std::size_t numberOfBanks) { return numberOfBanks; }
+    static constexpr std::size_t bankGroups(std::size_t numberOfBankGroups) { return numberOfBankGroups; }
+
+    static constexpr bool matches(std::size_t, std::size_t, std::size_t) { return true; }
+
+    static ranks_t makeRanks(std::size_t numberOfRanks, std::size_t numberOfBanks, std::size_t) {
+        return ranks_t(numberOfRanks, Rank(numberOfBanks));
+    }
+};
+
+// Geometry fixed at compile time. The ranks are stored in place and the loops of the core over
+// ranks, banks and bank groups have constant bounds. Each Rank still keeps its banks and bank state
+// in vectors sized at construction, Rank isn't templated on the geometry. The loops inside Rank
+// (e.g. forEachActiveBank) have runtime bounds.
+template <std::size_t Ranks, std::size_t Banks, std::size_t BankGroups>
+struct FixedGeometry {
+    static_assert(Ranks > 0 && Banks > 0, "A fixed geometry needs at least one rank and bank");
+
+    static constexpr bool isFixed = true;
+    using ranks_t = std::array<Rank, Ranks>;
+
+    static constexpr std::size_t ranks(std::size_t) { return Ranks; }
+    static constexpr std::size_t banks(std::size_t) { return Banks; }
+    static constexpr std::size_t bankGroups(std::size_t) { return BankGroups; }
+
+    static constexpr bool matches(std::size_t numberOfRanks, std::size_t numberOfBanks, std::size_t numberOfBankGroups) {
+        return Ranks == numberOfRanks && Banks == numberOfBanks && BankGroups == numberOfBankGroups;
+    }
+
+    static ranks_t makeRanks(std::size_t numberOfRanks, std::size_t numberOfBanks, std::size_t numberOfBankGroups) {
+        if (!matches(numberOfRanks, numberOfBanks, numberOfBankGroups)) {
+            throw Exception("The memspec doesn't match the fixed geometry of the core");
+        }
+        return makeRanks(std::make_index_sequence<Ranks>{});
+    }
+
+private:
+    template <std::size_t... I>
+    static ranks_t makeRanks(std::index_sequence<I...>) {
+        return {{((void)I, Rank(Banks))...}};
+    }
+};
+
+template <typename... Geometries>
+struct GeometryList {};
+
+// Calls func with a default constructed geometry of list which matches the memspec geometry
+// and with DynamicGeometry{} if none does. All calls must return the same type.
+template <typename Func>
+decltype(auto) dispatchGeometry(GeometryList<>, std::size_t, std::size_t, std::size_t, Func&& func) {
+    return std::forward<Func>(func)(DynamicGeometry{});
+}
+
+template <typename Geometry, typename... Geometries, typename Func>
+decltype(auto) dispatchGeometry(GeometryList<Geometry, Geometries...>, std::size_t numberOfRanks,
+    std::size_t numberOfBanks, std::size_t numberOfBankGroups, Func&& func)
+{
+    if (Geometry::matches(numberOfRanks, numberOfBanks, numberOfBankGroups)) {
+        return std::forward<Func>(func)(Geometry{});
+    }
+    return dispatchGeometry(GeometryList<Geometries...>{}, numberOfRanks, numberOfBanks, numberOfBankGroups,
+        std::forward<Func>(func));
+}
+
+} // namespace DRAMPower
+
+#endif /* DRAMPOWER_DRAM_GEOMETRY_H */
@@ -148,15 +148,9 @@ void TogglingHandle::incCountBitLength(timestamp_t timestamp, uint64_t bitlength
     assert(bitlength % this->width == 0);
     this->incCountBurstLength(timestamp, bitlength / this->width);
 }
-util::bus_stats_t TogglingHandle::get_stats(timestamp_t timestamp) const
+void TogglingHandle::get_count(timestamp_t virtual_timestamp, uint64_t &count, uint64_t &idle) const
 {
-    // Convert to bus timings
-    timestamp_t virtual_timestamp = timestamp * this->datarate;
-    assert(virtual_timestamp / this->datarate == timestamp); // No overflow
-
-    util::bus_stats_t stats;
-
-    uint64_t count = this->count;
+    count = this->count;
     timestamp_t disable_time = this->disable_time;
     if(this->enableflag) {
         // Check if last burst is finished
@@ -172,6 +166,20 @@ util::bus_stats_t TogglingHandle::get_stats(timestamp_t timestamp) const
     } else {
         disable_time += virtual_timestamp - this->disable_timestamp;
     }
+    idle = virtual_timestamp - disable_time - count;
+}
+
+util::bus_stats_t TogglingHandle::get_stats(timestamp_t timestamp) const
+{
+    // Convert to bus timings
+    timestamp_t virtual_timestamp = timestamp * this->datarate;
+    assert(virtual_timestamp / this->datarate == timestamp); // No overflow
+
+    util::bus_stats_t stats;
+
+    uint64_t count = 0;
+    uint64_t idle = 0;
+    get_count(virtual_timestamp, count, idle);
     // Compute toggles
     stats.ones = count * this->duty_cycle;
     stats.zeroes = count * (1 - this->duty_cycle);
@@ -179,10 +187,10 @@ util::bus_stats_t TogglingHandle::get_stats(timestamp_t timestamp) const
     // Compute idle
     switch (this->idlepattern) {
         case TogglingRateIdlePattern::L:
-            stats.zeroes += virtual_timestamp - disable_time - count;
+            stats.zeroes += idle;
             break;
         case TogglingRateIdlePattern::H:
-            stats.ones += virtual_timestamp - disable_time - count;
+            stats.ones += idle;
             break;
         case TogglingRateIdlePattern::Invalid:
             throw Exception("Invalid TogglingRateIdlePattern");
@@ -197,6 +205,20 @@ util::bus_stats_t TogglingHandle::get_stats(timestamp_t timestamp) const
     return stats;
 }
 
+toggling_activity_t TogglingHandle::get_activity(timestamp_t timestamp) const
+{
+    timestamp_t virtual_timestamp = timestamp * this->datarate;
+    assert(virtual_timestamp / this->datarate == timestamp); // No overflow
+
+    uint64_t count = 0;
+    uint64_t idle = 0;
+    get_count(virtual_timestamp, count, idle);
+    toggling_activity_t activity;
+    activity.bits = count * this->width;
+    activity.idle = idle * this->width;
+    return activity;
+}
+
 void TogglingHandle::serialize(std::ostream &stream) const {
     stream.write(reinterpret_cast<const char*>(&width), sizeof(width));
     stream.write(reinterpret_cast<const char*>(&datarate), sizeof(datarate));
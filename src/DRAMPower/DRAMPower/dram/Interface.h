@@ -7,12 +7,52 @@
 #include <DRAMPower/util/Deserialize.h>
 
 #include <DRAMUtils/config/toggling_rate.h>
+#include <DRAMUtils/util/json_utils.h>
 
 #include <stdint.h>
 
 
 namespace DRAMPower {
 
+// Transferred and idle bit times of a toggling handle, scaled by the bus width.
+// The toggling stats are a function of the activity and the toggling rate definition.
+struct toggling_activity_t : public util::Serialize, public util::Deserialize {
+    uint64_t bits = 0;
+    uint64_t idle = 0;
+
+    toggling_activity_t& operator+=(const toggling_activity_t& rhs) {
+        bits += rhs.bits;
+        idle += rhs.idle;
+        return *this;
+    }
+
+    toggling_activity_t& operator-=(const toggling_activity_t& rhs) {
+        bits -= rhs.bits;
+        idle -= rhs.idle;
+        return *this;
+    }
+
+    toggling_activity_t& operator*=(uint64_t rhs) {
+        bits *= rhs;
+        idle *= rhs;
+        return *this;
+    }
+
+    bool operator==(const toggling_activity_t& rhs) const {
+        return bits == rhs.bits && idle == rhs.idle;
+    }
+
+    void serialize(std::ostream& stream) const override {
+        stream.write(reinterpret_cast<const char*>(&bits), sizeof(bits));
+        stream.write(reinterpret_cast<const char*>(&idle), sizeof(idle));
+    }
+    void deserialize(std::istream& stream) override {
+        stream.read(reinterpret_cast<char*>(&bits), sizeof(bits));
+        stream.read(reinterpret_cast<char*>(&idle), sizeof(idle));
+    }
+};
+NLOHMANN_JSONIFY_ALL_THINGS(toggling_activity_t, bits, idle);
+
 class TogglingHandle : public util::Serialize, public util::Deserialize
 {
 
@@ -63,11 +103,15 @@ public:
     void incCountBurstLength(timestamp_t timestamp, uint64_t burstlength);
     void incCountBitLength(timestamp_t timestamp, uint64_t bitlength);
     util::bus_stats_t get_stats(timestamp_t timestamp) const;
+    toggling_activity_t get_activity(timestamp_t timestamp) const;
 
 // Overrides
     void serialize(std::ostream &stream) const override;
     void deserialize(std::istream &stream) override;
 
+private:
+    // Transferred and idle bit times of a single line
+    void get_count(timestamp_t virtual_timestamp, uint64_t &count, uint64_t &idle) const;
 };
 
 struct interface_stats_t 
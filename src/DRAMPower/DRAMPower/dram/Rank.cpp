@@ -6,23 +6,98 @@ namespace DRAMPower {
 
 Rank::Rank(std::size_t numBanks)
     : banks(numBanks)
+    , m_activeBanks((numBanks + 63) / 64, 0)
+    , m_activatedBanks((numBanks + 63) / 64, 0)
+    , m_prechargedBanks((numBanks + 63) / 64, 0)
+    , m_actStartTime(numBanks, 0)
+    , m_latestPreTime(numBanks, 0)
+    , m_refreshEndTime(numBanks, 0)
 {};
 
 bool Rank::isActive(timestamp_t timestamp) {
     if ( timestamp < this->endRefreshTime ) {
         std::cout << "[WARN] Rank::isActive() -> timestamp (" << timestamp <<") < "  << "endRefreshTime (" << this->endRefreshTime << ")"  << std::endl;
     }
-    return countActiveBanks() > 0 || timestamp < this->endRefreshTime;
+    return anyBitSet(m_activeBanks) || timestamp < this->endRefreshTime;
 }
 
 std::size_t Rank::countActiveBanks() const {
-    return (unsigned)std::count_if(banks.begin(), banks.end(),
-        [](const auto& bank) {
-            return (bank.bankState == Bank::BankState::BANK_ACTIVE);
+    std::size_t count = 0;
+    for (const auto word : m_activeBanks) {
+        count += util::BinaryOps::popcount(word);
+    }
+    return count;
+}
+
+bool Rank::isIdle(timestamp_t timestamp) const {
+    if (memState != MemState::NOT_IN_PD || timestamp < endRefreshTime || cycles.act.is_open() || anyBitSet(m_activeBanks)) {
+        return false;
+    }
+    return std::none_of(banks.begin(), banks.end(),
+        [timestamp](const auto& bank) {
+            return bank.cycles.act.is_open() || timestamp < bank.refreshEndTime;
     });
 }
 
-void Rank::serialize(std::ostream& stream) const {
+void Rank::updateBankTimestamps(std::size_t bank_idx) {
+    const auto& bank = banks[bank_idx];
+    auto word_idx = bank_idx / 64;
+    auto bit = uint64_t{1} << (bank_idx % 64);
+
+    if (bank.counter.act != 0) {
+        m_activatedBanks[word_idx] |= bit;
+        m_actStartTime[bank_idx] = bank.cycles.act.get_start();
+    } else {
+        m_activatedBanks[word_idx] &= ~bit;
+        m_actStartTime[bank_idx] = 0;
+    }
+    if (bank.counter.pre != 0) {
+        m_prechargedBanks[word_idx] |= bit;
+        m_latestPreTime[bank_idx] = bank.latestPre;
+    } else {
+        m_prechargedBanks[word_idx] &= ~bit;
+        m_latestPreTime[bank_idx] = 0;
+    }
+    m_refreshEndTime[bank_idx] = bank.refreshEndTime;
+}
+
+timestamp_t Rank::earliestPowerDownEntryTime(uint64_t tRCD, uint64_t tRP) const {
+    // Banks which were never activated / precharged hold 0 and don't contribute to the maximum
+    timestamp_t actStart = 0;
+    timestamp_t latestPre = 0;
+    timestamp_t refreshEnd = 0;
+    for (std::size_t i = 0; i < m_actStartTime.size(); ++i) {
+        actStart = std::max(actStart, m_actStartTime[i]);
+        latestPre = std::max(latestPre, m_latestPreTime[i]);
+        refreshEnd = std::max(refreshEnd, m_refreshEndTime[i]);
+    }
+    return std::max({
+        anyBitSet(m_activatedBanks) ? actStart + tRCD : 0,
+        anyBitSet(m_prechargedBanks) ? latestPre + tRP : 0,
+        refreshEnd
+    });
+}
+
+bool Rank::anyBitSet(const std::vector<uint64_t>& mask) {
+    return std::any_of(mask.begin(), mask.end(), [](uint64_t word) { return word != 0; });
+}
+
+void Rank::rebuildBankState() {
+    for (std::size_t bank_idx = 0; bank_idx < banks.size(); ++bank_idx) {
+        rebuildBankState(bank_idx);
+    }
+}
+
+void Rank::rebuildBankState(std::size_t bank_idx) {
+    if (banks[bank_idx].bankState == Bank::BankState::BANK_ACTIVE) {
+        m_activeBanks[bank_idx / 64] |= (uint64_t{1} << (bank_idx % 64));
+    } else {
+        m_activeBanks[bank_idx / 64] &= ~(uint64_t{1} << (bank_idx % 64));
+    }
+    updateBankTimestamps(bank_idx);
+}
+
+void Rank::serializeState(std::ostream& stream) const {
     stream.write(reinterpret_cast<const char*>(&memState), sizeof(memState));
     stream.write(reinterpret_cast<const char *>(&endRefreshTime), sizeof(endRefreshTime));
 
@@ -36,13 +111,16 @@ void Rank::serialize(std::ostream& stream) const {
     cycles.powerDownAct.serialize(stream);
     cycles.powerDownPre.serialize(stream);
     cycles.deepSleepMode.serialize(stream);
+}
 
+void Rank::serialize(std::ostream& stream) const {
+    serializeState(stream);
     for (const auto& bank : banks) {
         bank.serialize(stream);
     }
 };
 
-void Rank::deserialize(std::istream& stream) {
+void Rank::deserializeState(std::istream& stream) {
     stream.read(reinterpret_cast<char *>(&memState), sizeof(memState));
     stream.read(reinterpret_cast<char *>(&endRefreshTime), sizeof(endRefreshTime));
 
@@ -56,10 +134,19 @@ void Rank::deserialize(std::istream& stream) {
     cycles.powerDownAct.deserialize(stream);
     cycles.powerDownPre.deserialize(stream);
     cycles.deepSleepMode.deserialize(stream);
+}
 
+void Rank::deserializeBank(std::size_t bank_idx, std::istream& stream) {
+    banks[bank_idx].deserialize(stream);
+    rebuildBankState(bank_idx);
+}
+
+void Rank::deserialize(std::istream& stream) {
+    deserializeState(stream);
     for (auto & bank : banks) {
         bank.deserialize(stream);
     }
+    rebuildBankState();
 };
 
 
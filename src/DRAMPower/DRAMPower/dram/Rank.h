@@ -7,7 +7,9 @@
 
 #include <DRAMPower/util/Serialize.h>
 #include <DRAMPower/util/Deserialize.h>
+#include <DRAMPower/util/binary_ops.h>
 
+#include <cstdint>
 #include <vector>
 
 namespace DRAMPower {
@@ -50,11 +52,77 @@ public:
 public:
 	bool isActive(timestamp_t timestamp);
 	std::size_t countActiveBanks() const;
+	// True if no bank is active, no refresh is pending and the rank is not in a
+	// power-down or self-refresh state at the given timestamp
+	bool isIdle(timestamp_t timestamp) const;
+
+	// Bank state changes must go through these functions to keep the active bank mask in sync
+	void setBankActive(std::size_t bank_idx);
+	void setBankPrecharged(std::size_t bank_idx);
+	bool isBankActive(std::size_t bank_idx) const;
+	std::size_t bankIndex(const Bank& bank) const;
+	// Calls func(bank_idx) for every bank that is active when the call starts
+	template <typename Func>
+	void forEachActiveBank(Func&& func) const;
+
+	// Must be called after the activate / precharge counters, the start of the active interval,
+	// latestPre or refreshEndTime of a bank changed
+	void updateBankTimestamps(std::size_t bank_idx);
+	// Maximum over all banks of the earliest power-down entry time of the bank
+	timestamp_t earliestPowerDownEntryTime(uint64_t tRCD, uint64_t tRP) const;
+	// State of the rank without the banks
+	void serializeState(std::ostream& stream) const;
+	void deserializeState(std::istream& stream);
+	void deserializeBank(std::size_t bank_idx, std::istream& stream);
 // Overrides
 	void serialize(std::ostream& stream) const override;
 	void deserialize(std::istream& stream) override;
+
+private:
+	static bool anyBitSet(const std::vector<uint64_t>& mask);
+	void rebuildBankState();
+	void rebuildBankState(std::size_t bank_idx);
+
+private:
+// Bank state bitmasks (one bit per bank)
+	std::vector<uint64_t> m_activeBanks;
+	std::vector<uint64_t> m_activatedBanks;
+	std::vector<uint64_t> m_prechargedBanks;
+// Bank timestamps as structure of arrays (0 if the bank was never activated / precharged)
+	std::vector<timestamp_t> m_actStartTime;
+	std::vector<timestamp_t> m_latestPreTime;
+	std::vector<timestamp_t> m_refreshEndTime;
 };
 
+inline void Rank::setBankActive(std::size_t bank_idx) {
+	banks[bank_idx].bankState = Bank::BankState::BANK_ACTIVE;
+	m_activeBanks[bank_idx / 64] |= (uint64_t{1} << (bank_idx % 64));
+}
+
+inline void Rank::setBankPrecharged(std::size_t bank_idx) {
+	banks[bank_idx].bankState = Bank::BankState::BANK_PRECHARGED;
+	m_activeBanks[bank_idx / 64] &= ~(uint64_t{1} << (bank_idx % 64));
+}
+
+inline bool Rank::isBankActive(std::size_t bank_idx) const {
+	return (m_activeBanks[bank_idx / 64] >> (bank_idx % 64)) & 1;
+}
+
+inline std::size_t Rank::bankIndex(const Bank& bank) const {
+	return static_cast<std::size_t>(&bank - banks.data());
+}
+
+template <typename Func>
+void Rank::forEachActiveBank(Func&& func) const {
+	for (std::size_t word_idx = 0; word_idx < m_activeBanks.size(); ++word_idx) {
+		uint64_t word = m_activeBanks[word_idx];
+		while (word != 0) {
+			func(word_idx * 64 + util::BinaryOps::countr_zero(word));
+			word &= word - 1;
+		}
+	}
+}
+
 struct RankInterface : public util::Serialize, public util::Deserialize {
 	uint64_t 	seamlessPrePostambleCounter_read	= 0;
 	uint64_t 	seamlessPrePostambleCounter_write	= 0;
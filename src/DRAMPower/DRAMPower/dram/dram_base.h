@@ -1,10 +1,12 @@
 #ifndef DRAMPOWER_DRAM_DRAM_BASE_H
 #define DRAMPOWER_DRAM_DRAM_BASE_H
 
+#include <DRAMPower/Exceptions.h>
 #include <DRAMPower/command/Command.h>
 
 #include <DRAMPower/data/energy.h>
 #include <DRAMPower/data/stats.h>
+#include <DRAMPower/data/stats_publisher.h>
 #include <DRAMPower/util/extension_manager.h>
 #include <DRAMPower/util/extensions.h>
 
@@ -12,21 +14,30 @@
 #include <DRAMPower/util/PatternHandler.h>
 #include <DRAMPower/util/ImplicitCommandHandler.h>
 #include <DRAMPower/util/cli_architecture_config.h>
+#include <DRAMPower/util/profiler.h>
 #include <DRAMPower/util/Serialize.h>
 #include <DRAMPower/util/Deserialize.h>
 
 #include <DRAMUtils/config/toggling_rate.h>
 
 #include <cassert>
+#include <memory>
 #include <vector>
 
 namespace DRAMPower {
 
 using namespace DRAMUtils::Config;
 
+template <typename Standard>
+struct StaticDispatch;
+
 template <typename CommandEnum>
 class dram_base : public util::Serialize, public util::Deserialize
 {
+// Friend classes
+template <typename Standard>
+friend struct StaticDispatch;
+
 // Public type definitions
 public:
     using commandEnum_t = CommandEnum;
@@ -61,10 +72,23 @@ public:
         doInterfaceCommandImpl(command);
     }
 
+    // Throws the Exception of StatsPublisher::publish if a publication is due and the stats don't fit
+    // into the publisher, after the command was simulated
     void doCommand(const Command& command) {
+        DRAMPOWER_PROFILE_COMMAND_SCOPE(util::profiling::Section::DoCommand, command.type);
         doCoreCommandImpl(command);
         doInterfaceCommandImpl(command);
+        publishStats(command);
+    }
+
+    // Publishes snapshots of the stats from doCommand. nullptr disables the publication.
+    // The size of the stats is fixed by the ranks and banks of this memory, a publisher shared with a
+    // memory with fewer ranks or banks which published first makes doCommand throw.
+    void setStatsPublisher(std::shared_ptr<StatsPublisher> publisher) {
+        m_statsPublisher = std::move(publisher);
+        m_publishedCommandCount = 0;
     }
+    const std::shared_ptr<StatsPublisher>& getStatsPublisher() const { return m_statsPublisher; }
 
     // deprecated
     void doCoreInterfaceCommand(const Command& command) {
@@ -93,6 +117,33 @@ public:
         // Deserialize the extension manager
         m_extensionManager.deserialize(stream);
         deserialize_impl(stream);
+        // The restored state is the start of a new delta chain
+        clearDelta_impl();
+    }
+
+    // Delta checkpoints
+    // serializeBase writes a full checkpoint, which is restored by deserialize.
+    // serializeDelta only writes the ranks, banks and buses changed since the previous base
+    // or delta. A chain is restored by deserialize and deserializeDelta in the written order.
+    void serializeBase(std::ostream& stream) {
+        if (!isSerializable()) {
+            throw Exception("Checkpoint with pending implicit commands");
+        }
+        serialize(stream);
+        clearDelta_impl();
+    }
+
+    void serializeDelta(std::ostream& stream) {
+        if (!isSerializable()) {
+            throw Exception("Checkpoint with pending implicit commands");
+        }
+        m_extensionManager.serialize(stream);
+        serializeDelta_impl(stream);
+    }
+
+    void deserializeDelta(std::istream& stream) {
+        m_extensionManager.deserialize(stream);
+        deserializeDelta_impl(stream);
     }
 
 // Public virtual methods
@@ -105,10 +156,31 @@ public:
     interface_energy_info_t calcInterfaceEnergy(timestamp_t timestamp) {
         return calcInterfaceEnergyStats(getWindowStats(timestamp));
     }
+    // Data bus (DQ and DBI) energy of every device. Requires SimConfig::deviceBusStats and the bus mode
+    std::vector<interface_energy_info_t> calcDeviceInterfaceEnergy(timestamp_t timestamp) {
+        const SimulationStats stats = getWindowStats(timestamp);
+        std::vector<interface_energy_info_t> energy;
+        energy.reserve(stats.devices.size());
+        for (std::size_t device = 0; device < stats.devices.size(); ++device) {
+            energy.push_back(calcInterfaceEnergyStats(stats.getDeviceStats(device)));
+        }
+        return energy;
+    }
     virtual SimulationStats getWindowStats(timestamp_t timestamp) = 0;
     virtual util::CLIArchitectureConfig getCLIArchitectureConfig() = 0;
     virtual bool isSerializable() const = 0;
 
+// Private member functions
+private:
+    void publishStats(const Command& command) {
+        if (m_statsPublisher) {
+            ++m_publishedCommandCount;
+            if (m_statsPublisher->due(m_publishedCommandCount, command.timestamp)) {
+                m_statsPublisher->publish(getWindowStats(command.timestamp), command.timestamp, m_publishedCommandCount);
+            }
+        }
+    }
+
 // Private virtual methods
 private:
     virtual void doCoreCommandImpl(const Command& command) = 0;
@@ -116,10 +188,16 @@ private:
     virtual timestamp_t getLastCommandTime_impl() const = 0;
     virtual void serialize_impl(std::ostream& stream) const = 0;
     virtual void deserialize_impl(std::istream& stream) = 0;
+    // Without dirty tracking a delta is a full checkpoint
+    virtual void serializeDelta_impl(std::ostream& stream) { serialize_impl(stream); }
+    virtual void deserializeDelta_impl(std::istream& stream) { deserialize_impl(stream); }
+    virtual void clearDelta_impl() {}
 
 // Private member variables
 private:
     extension_manager_t m_extensionManager;
+    std::shared_ptr<StatsPublisher> m_statsPublisher;
+    uint64_t m_publishedCommandCount = 0;
 };
 
 template <typename CommandEnum>
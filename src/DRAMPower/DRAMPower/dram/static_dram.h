@@ -0,0 +1,107 @@
+#ifndef DRAMPOWER_DRAM_STATIC_DRAM_H
+#define DRAMPOWER_DRAM_STATIC_DRAM_H
+
+#include <DRAMPower/command/CmdType.h>
+#include <DRAMPower/command/Command.h>
+#include <DRAMPower/dram/dram_base.h>
+#include <DRAMPower/util/profiler.h>
+
+#include <iterator>
+#include <utility>
+
+namespace DRAMPower {
+
+// Command path of a standard without virtual calls. Standard is the complete type of the dram,
+// e.g. DDR4, BasicDDR5<FixedGeometry<1, 32, 8>> or util::ObservedDRAM<LPDDR4, ...>.
+// The core and interface commands are called with a qualified name and can be inlined.
+// Behaves exactly like dram_base::doCommand, including the stats publication.
+template <typename Standard>
+struct StaticDispatch {
+    static void doCommand(Standard& dram, const Command& command) {
+        DRAMPOWER_PROFILE_COMMAND_SCOPE(util::profiling::Section::DoCommand, command.type);
+        dram.Standard::doCoreCommandImpl(command);
+        dram.Standard::doInterfaceCommandImpl(command);
+        static_cast<dram_base<CmdType>&>(dram).publishStats(command);
+    }
+
+    static void doCoreCommand(Standard& dram, const Command& command) {
+        dram.Standard::doCoreCommandImpl(command);
+    }
+
+    static void doInterfaceCommand(Standard& dram, const Command& command) {
+        dram.Standard::doInterfaceCommandImpl(command);
+    }
+};
+
+// Fallback for a dram of unknown type, uses the virtual command path
+template <>
+struct StaticDispatch<dram_base<CmdType>> {
+    static void doCommand(dram_base<CmdType>& dram, const Command& command) {
+        dram.doCommand(command);
+    }
+
+    static void doCoreCommand(dram_base<CmdType>& dram, const Command& command) {
+        dram.doCoreCommand(command);
+    }
+
+    static void doInterfaceCommand(dram_base<CmdType>& dram, const Command& command) {
+        dram.doInterfaceCommand(command);
+    }
+};
+
+/** Standard with a non-virtual simulation facade
+ * Owns a Standard (see StaticDispatch) and simulates commands without indirect calls.
+ * All other member functions (energy, stats, serialization) are reached through get().
+ */
+template <typename Standard>
+class StaticDRAM {
+// Public type definitions
+public:
+    using standard_t = Standard;
+
+// Public constructors
+public:
+    template <typename... Args>
+    explicit StaticDRAM(Args&&... args)
+        : m_dram(std::forward<Args>(args)...)
+    {}
+
+// Public member functions
+public:
+    void doCommand(const Command& command) {
+        StaticDispatch<Standard>::doCommand(m_dram, command);
+    }
+
+    void doCoreCommand(const Command& command) {
+        StaticDispatch<Standard>::doCoreCommand(m_dram, command);
+    }
+
+    void doInterfaceCommand(const Command& command) {
+        StaticDispatch<Standard>::doInterfaceCommand(m_dram, command);
+    }
+
+    template <typename Iterator>
+    void doCommands(Iterator first, Iterator last) {
+        for (; first != last; ++first) {
+            StaticDispatch<Standard>::doCommand(m_dram, *first);
+        }
+    }
+
+    template <typename Commands>
+    void doCommands(const Commands& commands) {
+        doCommands(std::begin(commands), std::end(commands));
+    }
+
+    Standard& get() { return m_dram; }
+    const Standard& get() const { return m_dram; }
+    Standard* operator->() { return &m_dram; }
+    const Standard* operator->() const { return &m_dram; }
+
+// Private member variables
+private:
+    Standard m_dram;
+};
+
+} // namespace DRAMPower
+
+#endif /* DRAMPOWER_DRAM_STATIC_DRAM_H */
@@ -48,10 +48,64 @@
 
 #include <vector>
 #include <algorithm>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <type_traits>
 
 
 namespace DRAMPower {
 
+// Binary (de)serialization helpers for the derived memspecs
+namespace memspec_io {
+
+template <typename T>
+void write(std::ostream &stream, const T &value) {
+    static_assert(std::is_trivially_copyable_v<T>, "memspec_io::write requires a trivially copyable type");
+    stream.write(reinterpret_cast<const char *>(&value), sizeof(value));
+}
+
+template <typename T>
+void read(std::istream &stream, T &value) {
+    static_assert(std::is_trivially_copyable_v<T>, "memspec_io::read requires a trivially copyable type");
+    stream.read(reinterpret_cast<char *>(&value), sizeof(value));
+}
+
+inline void write(std::ostream &stream, const std::string &value) {
+    write(stream, static_cast<uint64_t>(value.size()));
+    stream.write(value.data(), static_cast<std::streamsize>(value.size()));
+}
+
+inline void read(std::istream &stream, std::string &value) {
+    uint64_t size = 0;
+    read(stream, size);
+    if (!stream) {
+        return;
+    }
+    value.resize(size);
+    stream.read(value.data(), static_cast<std::streamsize>(size));
+}
+
+template <typename T>
+void write(std::ostream &stream, const std::vector<T> &values) {
+    write(stream, static_cast<uint64_t>(values.size()));
+    for (const T &value : values) {
+        write(stream, value);
+    }
+}
+
+template <typename T>
+void read(std::istream &stream, std::vector<T> &values) {
+    uint64_t size = 0;
+    read(stream, size);
+    values.clear();
+    for (uint64_t i = 0; i < size && stream; ++i) {
+        read(stream, values.emplace_back());
+    }
+}
+
+} // namespace memspec_io
+
 template <typename T>
 class MemSpec
 {
@@ -81,7 +135,6 @@ public:
 
     uint64_t prechargeOffsetRD;
     uint64_t prechargeOffsetWR;
-    MemSpec() = delete;
     virtual ~MemSpec() = default;
 
 	// MemSpec() = default;
@@ -102,6 +155,38 @@ public:
         memoryType = memspec.id;
     }
 
+protected:
+    // Only used for deserialization. The members are read with deserializeBase
+    MemSpec() = default;
+
+    void serializeBase(std::ostream &stream) const {
+        memspec_io::write(stream, numberOfBanks);
+        memspec_io::write(stream, numberOfRows);
+        memspec_io::write(stream, numberOfColumns);
+        memspec_io::write(stream, numberOfDevices);
+        memspec_io::write(stream, burstLength);
+        memspec_io::write(stream, dataRate);
+        memspec_io::write(stream, bitWidth);
+        memspec_io::write(stream, memoryId);
+        memspec_io::write(stream, memoryType);
+        memspec_io::write(stream, prechargeOffsetRD);
+        memspec_io::write(stream, prechargeOffsetWR);
+    }
+
+    void deserializeBase(std::istream &stream) {
+        memspec_io::read(stream, numberOfBanks);
+        memspec_io::read(stream, numberOfRows);
+        memspec_io::read(stream, numberOfColumns);
+        memspec_io::read(stream, numberOfDevices);
+        memspec_io::read(stream, burstLength);
+        memspec_io::read(stream, dataRate);
+        memspec_io::read(stream, bitWidth);
+        memspec_io::read(stream, memoryId);
+        memspec_io::read(stream, memoryType);
+        memspec_io::read(stream, prechargeOffsetRD);
+        memspec_io::read(stream, prechargeOffsetWR);
+    }
+
 };
 
 } // namespace DRAMPower
@@ -0,0 +1,279 @@
+#include "MemSpecCache.h"
+
+#include <DRAMUtils/memspec/MemSpec.h>
+
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <exception>
+#include <fstream>
+#include <istream>
+#include <sstream>
+#include <streambuf>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define DRAMPOWER_MEMSPECCACHE_MMAP
+#endif
+
+using namespace DRAMPower;
+
+namespace {
+
+constexpr std::array<char, 8> MAGIC = {'D', 'P', 'M', 'S', 'P', 'E', 'C', '\0'};
+// Increment if the serialization of a memspec changes
+constexpr uint32_t VERSION = 1;
+
+struct Header {
+    std::array<char, 8> magic;
+    uint32_t version;
+    uint32_t standard;
+    uint64_t layout;
+    uint64_t contentHash;
+    uint64_t payloadSize;
+};
+
+// Fingerprint of the structures which are copied as a whole. Invalidates compiled
+// memspecs of builds with a different layout.
+constexpr uint64_t layoutFingerprint() {
+    constexpr std::array<std::size_t, 18> sizes = {
+        sizeof(MemSpecDDR4::MemTimingSpec), sizeof(MemSpecDDR4::MemPowerSpec),
+        sizeof(MemSpecDDR4::MemImpedanceSpec), sizeof(MemSpecDDR4::PrePostamble),
+        sizeof(MemSpecDDR5::MemTimingSpec), sizeof(MemSpecDDR5::MemPowerSpec),
+        sizeof(MemSpecDDR5::MemImpedanceSpec), sizeof(MemSpecDDR5::DataRateSpec),
+        sizeof(MemSpecLPDDR4::MemTimingSpec), sizeof(MemSpecLPDDR4::MemPowerSpec),
+        sizeof(MemSpecLPDDR4::MemImpedanceSpec),
+        sizeof(MemSpecLPDDR5::MemTimingSpec), sizeof(MemSpecLPDDR5::MemPowerSpec),
+        sizeof(MemSpecLPDDR5::MemImpedanceSpec),
+        sizeof(MemSpecLPDDR6::MemTimingSpec), sizeof(MemSpecLPDDR6::MemPowerSpec),
+        sizeof(MemSpecLPDDR6::MemImpedanceSpec),
+        sizeof(std::size_t),
+    };
+    uint64_t hash = 14695981039346656037ull;
+    for (std::size_t size : sizes) {
+        hash = (hash ^ size) * 1099511628211ull;
+    }
+    return hash;
+}
+
+// Read only view of a whole file
+class MappedFile {
+public:
+    explicit MappedFile(const std::filesystem::path &path) {
+#ifdef DRAMPOWER_MEMSPECCACHE_MMAP
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            return;
+        }
+        struct stat st;
+        if (0 == ::fstat(fd, &st) && st.st_size > 0) {
+            void *data = ::mmap(nullptr, static_cast<std::size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+            if (MAP_FAILED != data) {
+                m_data = static_cast<const char *>(data);
+                m_size = static_cast<std::size_t>(st.st_size);
+            }
+        }
+        ::close(fd);
+#else
+        std::ifstream file(path, std::ios::binary);
+        if (file) {
+            m_buffer.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+            m_data = m_buffer.data();
+            m_size = m_buffer.size();
+        }
+#endif
+    }
+
+    ~MappedFile() {
+#ifdef DRAMPOWER_MEMSPECCACHE_MMAP
+        if (m_data) {
+            ::munmap(const_cast<char *>(m_data), m_size);
+        }
+#endif
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool valid() const { return nullptr != m_data; }
+    const char *data() const { return m_data; }
+    std::size_t size() const { return m_size; }
+
+private:
+    const char *m_data = nullptr;
+    std::size_t m_size = 0;
+#ifndef DRAMPOWER_MEMSPECCACHE_MMAP
+    std::string m_buffer;
+#endif
+};
+
+// std::istream over a memory region without copying it
+class MemoryBuffer : public std::streambuf {
+public:
+    MemoryBuffer(const char *data, std::size_t size) {
+        char *begin = const_cast<char *>(data);
+        setg(begin, begin, begin + size);
+    }
+};
+
+template <std::size_t... I>
+std::optional<MemSpecCache::memspec_t> readStandard(std::size_t standard, std::istream &stream, std::index_sequence<I...>) {
+    std::optional<MemSpecCache::memspec_t> result;
+    ((standard == I
+        ? (void)result.emplace(std::in_place_index<I>, std::variant_alternative_t<I, MemSpecCache::memspec_t>::from_stream(stream))
+        : (void)0), ...);
+    return result;
+}
+
+std::optional<MemSpecCache::memspec_t> fromDRAMUtils(const DRAMUtils::MemSpec::MemSpecVariant &memspec) {
+    return std::visit([](auto &&arg) -> std::optional<MemSpecCache::memspec_t> {
+        using T = std::decay_t<decltype(arg)>;
+        if constexpr (std::is_same_v<T, DRAMUtils::MemSpec::MemSpecDDR4>) {
+            return MemSpecDDR4{arg};
+        } else if constexpr (std::is_same_v<T, DRAMUtils::MemSpec::MemSpecDDR5>) {
+            return MemSpecDDR5{arg};
+        } else if constexpr (std::is_same_v<T, DRAMUtils::MemSpec::MemSpecLPDDR4>) {
+            return MemSpecLPDDR4{arg};
+        } else if constexpr (std::is_same_v<T, DRAMUtils::MemSpec::MemSpecLPDDR5>) {
+            return MemSpecLPDDR5{arg};
+        } else if constexpr (std::is_same_v<T, DRAMUtils::MemSpec::MemSpecLPDDR6>) {
+            return MemSpecLPDDR6{arg};
+        } else {
+            return std::nullopt;
+        }
+    }, memspec.getVariant());
+}
+
+} // namespace
+
+MemSpecCache::MemSpecCache(std::filesystem::path cacheDir)
+    : m_cacheDir(std::move(cacheDir))
+{}
+
+uint64_t MemSpecCache::contentHash(const char *data, std::size_t size) {
+    uint64_t hash = 14695981039346656037ull;
+    for (std::size_t i = 0; i < size; ++i) {
+        hash = (hash ^ static_cast<uint8_t>(data[i])) * 1099511628211ull;
+    }
+    return hash;
+}
+
+std::filesystem::path MemSpecCache::cacheFile(const std::filesystem::path &jsonFile) const {
+    if (m_cacheDir.empty()) {
+        std::filesystem::path result = jsonFile;
+        result += FILE_EXTENSION;
+        return result;
+    }
+    // Distinguish json files with the same name in different directories
+    std::error_code ec;
+    std::string absolute = std::filesystem::absolute(jsonFile, ec).string();
+    uint64_t pathHash = contentHash(absolute.data(), absolute.size());
+    char suffix[17];
+    std::snprintf(suffix, sizeof(suffix), "%016llx", static_cast<unsigned long long>(pathHash));
+    return m_cacheDir / (jsonFile.filename().string() + "-" + suffix + FILE_EXTENSION);
+}
+
+void MemSpecCache::write(std::ostream &stream, const memspec_t &memspec, uint64_t contentHash) {
+    std::ostringstream payload;
+    std::visit([&payload](const auto &arg) { arg.serialize(payload); }, memspec);
+    const std::string data = payload.str();
+
+    Header header{MAGIC, VERSION, static_cast<uint32_t>(memspec.index()), layoutFingerprint(), contentHash, data.size()};
+    stream.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    stream.write(data.data(), static_cast<std::streamsize>(data.size()));
+}
+
+std::optional<MemSpecCache::memspec_t> MemSpecCache::read(const char *data, std::size_t size, uint64_t contentHash) {
+    Header header;
+    if (size < sizeof(header)) {
+        return std::nullopt;
+    }
+    std::memcpy(&header, data, sizeof(header));
+    if (header.magic != MAGIC
+        || header.version != VERSION
+        || header.layout != layoutFingerprint()
+        || header.contentHash != contentHash
+        || header.standard >= std::variant_size_v<memspec_t>
+        || header.payloadSize != size - sizeof(header)
+    ) {
+        return std::nullopt;
+    }
+    MemoryBuffer buffer(data + sizeof(header), header.payloadSize);
+    std::istream stream(&buffer);
+    auto result = readStandard(header.standard, stream, std::make_index_sequence<std::variant_size_v<memspec_t>>{});
+    // Truncated or trailing data
+    if (!stream || stream.peek() != std::char_traits<char>::eof()) {
+        return std::nullopt;
+    }
+    return result;
+}
+
+std::optional<MemSpecCache::memspec_t> MemSpecCache::load(const std::filesystem::path &jsonFile) {
+    m_lastStatus = Status::Failed;
+    MappedFile json(jsonFile);
+    if (!json.valid()) {
+        return std::nullopt;
+    }
+    const uint64_t hash = contentHash(json.data(), json.size());
+    const std::filesystem::path compiled = cacheFile(jsonFile);
+
+    // Cache hit
+    {
+        MappedFile cache(compiled);
+        if (cache.valid()) {
+            if (auto result = read(cache.data(), cache.size(), hash)) {
+                m_lastStatus = Status::Hit;
+                return result;
+            }
+        }
+    }
+
+    // Cache miss
+    std::optional<memspec_t> result;
+    try {
+        auto memspec = DRAMUtils::parse_memspec_from_file(jsonFile);
+        if (memspec) {
+            result = fromDRAMUtils(*memspec);
+        }
+    } catch (const std::exception &) {
+        return std::nullopt;
+    }
+    if (!result) {
+        return std::nullopt;
+    }
+    m_lastStatus = Status::Miss;
+
+    // Write to a temporary file first so concurrent runs never see a partial file.
+    // The cache is optional, errors are ignored.
+    std::error_code ec;
+    if (!m_cacheDir.empty()) {
+        std::filesystem::create_directories(m_cacheDir, ec);
+    }
+    std::filesystem::path tmp = compiled;
+    tmp += ".tmp" + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count());
+    {
+        std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            return result;
+        }
+        write(out, *result, hash);
+        if (!out) {
+            out.close();
+            std::filesystem::remove(tmp, ec);
+            return result;
+        }
+    }
+    std::filesystem::rename(tmp, compiled, ec);
+    if (ec) {
+        std::filesystem::remove(tmp, ec);
+    }
+    return result;
+}
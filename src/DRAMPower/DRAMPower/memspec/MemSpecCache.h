@@ -0,0 +1,63 @@
+#ifndef DRAMPOWER_MEMSPEC_MEMSPECCACHE_H
+#define DRAMPOWER_MEMSPEC_MEMSPECCACHE_H
+
+#include <DRAMPower/memspec/MemSpecDDR4.h>
+#include <DRAMPower/memspec/MemSpecDDR5.h>
+#include <DRAMPower/memspec/MemSpecLPDDR4.h>
+#include <DRAMPower/memspec/MemSpecLPDDR5.h>
+#include <DRAMPower/memspec/MemSpecLPDDR6.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <ostream>
+#include <variant>
+
+namespace DRAMPower {
+
+// Cache for compiled memspecs. A compiled memspec is the binary representation of the
+// derived MemSpecXXX object together with a hash of the json file it was created from.
+// On a cache hit the compiled memspec is memory-mapped and deserialized, so neither the
+// json parsing nor the derivation of the memspec is repeated. The cache entry is rewritten
+// automatically if the content of the json file changes.
+class MemSpecCache {
+// Public type definitions
+public:
+    using memspec_t = std::variant<MemSpecDDR4, MemSpecDDR5, MemSpecLPDDR4, MemSpecLPDDR5, MemSpecLPDDR6>;
+
+    enum class Status {
+        None,   // No load yet
+        Hit,    // Loaded from the compiled memspec
+        Miss,   // Parsed from json, the compiled memspec was (re)written
+        Failed, // Invalid json file
+    };
+
+    static constexpr const char *FILE_EXTENSION = ".dpmspec";
+
+// Public constructors
+public:
+    // The compiled memspecs are stored next to the json files if no cache directory is given
+    explicit MemSpecCache(std::filesystem::path cacheDir = {});
+
+// Public member functions
+public:
+    std::optional<memspec_t> load(const std::filesystem::path &jsonFile);
+    std::filesystem::path cacheFile(const std::filesystem::path &jsonFile) const;
+    Status lastStatus() const { return m_lastStatus; }
+
+    // FNV-1a hash of the json file content
+    static uint64_t contentHash(const char *data, std::size_t size);
+    static void write(std::ostream &stream, const memspec_t &memspec, uint64_t contentHash);
+    // Returns std::nullopt if the data is not a compiled memspec of the given content hash
+    static std::optional<memspec_t> read(const char *data, std::size_t size, uint64_t contentHash);
+
+// Private member variables
+private:
+    std::filesystem::path m_cacheDir;
+    Status m_lastStatus = Status::None;
+};
+
+} // namespace DRAMPower
+
+#endif /* DRAMPOWER_MEMSPEC_MEMSPECCACHE_H */
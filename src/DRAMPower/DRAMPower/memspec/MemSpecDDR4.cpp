@@ -142,3 +142,37 @@ MemSpecDDR4 MemSpecDDR4::from_memspec(const DRAMUtils::MemSpec::MemSpecVariant&
     return std::get<DRAMUtils::MemSpec::MemSpecDDR4>(memSpec.getVariant());
 }
 
+MemSpecDDR4 MemSpecDDR4::from_stream(std::istream& stream)
+{
+    MemSpecDDR4 memspec;
+    memspec.deserialize(stream);
+    return memspec;
+}
+
+void MemSpecDDR4::serialize(std::ostream& stream) const
+{
+    serializeBase(stream);
+    memspec_io::write(stream, numberOfBankGroups);
+    memspec_io::write(stream, numberOfRanks);
+    memspec_io::write(stream, vddq);
+    memspec_io::write(stream, refreshMode);
+    memspec_io::write(stream, memTimingSpec);
+    memspec_io::write(stream, memPowerSpec);
+    memspec_io::write(stream, memImpedanceSpec);
+    memspec_io::write(stream, prePostamble);
+    memspec_io::write(stream, bwParams);
+}
+
+void MemSpecDDR4::deserialize(std::istream& stream)
+{
+    deserializeBase(stream);
+    memspec_io::read(stream, numberOfBankGroups);
+    memspec_io::read(stream, numberOfRanks);
+    memspec_io::read(stream, vddq);
+    memspec_io::read(stream, refreshMode);
+    memspec_io::read(stream, memTimingSpec);
+    memspec_io::read(stream, memPowerSpec);
+    memspec_io::read(stream, memImpedanceSpec);
+    memspec_io::read(stream, prePostamble);
+    memspec_io::read(stream, bwParams);
+}
@@ -40,6 +40,9 @@
 
 #include "MemSpec.h"
 
+#include <DRAMPower/util/Serialize.h>
+#include <DRAMPower/util/Deserialize.h>
+
 #include <DRAMUtils/memspec/standards/MemSpecDDR4.h>
 
 #include <DRAMUtils/util/json.h>
@@ -47,7 +50,7 @@
 
 namespace DRAMPower {
 
-class MemSpecDDR4 final : public MemSpec<DRAMUtils::MemSpec::MemSpecDDR4>
+class MemSpecDDR4 final : public MemSpec<DRAMUtils::MemSpec::MemSpecDDR4>, public util::Serialize, public util::Deserialize
 {
 public:
 	using MemImpedanceSpec = DRAMUtils::MemSpec::MemImpedanceSpecTypeDDR4;
@@ -58,8 +61,6 @@ public:
     };
 
 public:
-    MemSpecDDR4() = delete;
-    
 	MemSpecDDR4(const DRAMUtils::MemSpec::MemSpecDDR4 &memspec);
 
 	MemSpecDDR4(json_t &data) = delete;
@@ -147,10 +148,16 @@ public:
 	PrePostamble prePostamble;
 	BankWiseParams bwParams;
 private:
+	// Only used by from_stream
+	MemSpecDDR4() = default;
 	void parseImpedanceSpec(const DRAMUtils::MemSpec::MemSpecDDR4 &memspec);
 	void parsePrePostamble(const DRAMUtils::MemSpec::MemSpecDDR4 &memspec);
 public:
     static MemSpecDDR4 from_memspec(const DRAMUtils::MemSpec::MemSpecVariant&);
+    // Binary representation of the derived memspec (see MemSpecCache)
+    static MemSpecDDR4 from_stream(std::istream& stream);
+    void serialize(std::ostream& stream) const override;
+    void deserialize(std::istream& stream) override;
     
 };
 
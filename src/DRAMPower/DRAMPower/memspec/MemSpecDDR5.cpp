@@ -100,3 +100,38 @@ MemSpecDDR5 MemSpecDDR5::from_memspec(const DRAMUtils::MemSpec::MemSpecVariant&
 {
     return std::get<DRAMUtils::MemSpec::MemSpecDDR5>(memSpec.getVariant());
 }
+
+MemSpecDDR5 MemSpecDDR5::from_stream(std::istream& stream)
+{
+    MemSpecDDR5 memspec;
+    memspec.deserialize(stream);
+    return memspec;
+}
+
+void MemSpecDDR5::serialize(std::ostream& stream) const
+{
+    serializeBase(stream);
+    memspec_io::write(stream, numberOfBankGroups);
+    memspec_io::write(stream, banksPerGroup);
+    memspec_io::write(stream, numberOfRanks);
+    memspec_io::write(stream, vddq);
+    memspec_io::write(stream, memTimingSpec);
+    memspec_io::write(stream, memImpedanceSpec);
+    memspec_io::write(stream, dataRateSpec);
+    memspec_io::write(stream, memPowerSpec);
+    memspec_io::write(stream, bwParams);
+}
+
+void MemSpecDDR5::deserialize(std::istream& stream)
+{
+    deserializeBase(stream);
+    memspec_io::read(stream, numberOfBankGroups);
+    memspec_io::read(stream, banksPerGroup);
+    memspec_io::read(stream, numberOfRanks);
+    memspec_io::read(stream, vddq);
+    memspec_io::read(stream, memTimingSpec);
+    memspec_io::read(stream, memImpedanceSpec);
+    memspec_io::read(stream, dataRateSpec);
+    memspec_io::read(stream, memPowerSpec);
+    memspec_io::read(stream, bwParams);
+}
@@ -3,12 +3,15 @@
 
 #include "MemSpec.h"
 
+#include <DRAMPower/util/Serialize.h>
+#include <DRAMPower/util/Deserialize.h>
+
 #include <DRAMUtils/memspec/standards/MemSpecDDR5.h>
 
 
 namespace DRAMPower {
 
-class MemSpecDDR5 final : public MemSpec<DRAMUtils::MemSpec::MemSpecDDR5> {
+class MemSpecDDR5 final : public MemSpec<DRAMUtils::MemSpec::MemSpecDDR5>, public util::Serialize, public util::Deserialize {
     public:
 	    using MemImpedanceSpec = DRAMUtils::MemSpec::MemImpedanceSpecTypeDDR5;
 
@@ -18,8 +21,6 @@ class MemSpecDDR5 final : public MemSpec<DRAMUtils::MemSpec::MemSpecDDR5> {
         };
 
     public:
-        MemSpecDDR5() = delete;
-
         MemSpecDDR5(const DRAMUtils::MemSpec::MemSpecDDR5 &memspec);
 
         MemSpecDDR5(json_t &data) = delete;
@@ -92,10 +93,16 @@ class MemSpecDDR5 final : public MemSpec<DRAMUtils::MemSpec::MemSpecDDR5> {
         BankWiseParams bwParams;
 
     private:
+        // Only used by from_stream
+        MemSpecDDR5() = default;
         void parseImpedanceSpec(const DRAMUtils::MemSpec::MemSpecDDR5 &memspec);
         void parseDataRateSpec(const DRAMUtils::MemSpec::MemSpecDDR5 &memspec);
     public:
         static MemSpecDDR5 from_memspec(const DRAMUtils::MemSpec::MemSpecVariant&);
+        // Binary representation of the derived memspec (see MemSpecCache)
+        static MemSpecDDR5 from_stream(std::istream& stream);
+        void serialize(std::ostream& stream) const override;
+        void deserialize(std::istream& stream) override;
     };
 
 }
@@ -205,3 +205,44 @@ MemSpecLPDDR4 MemSpecLPDDR4::from_memspec(const DRAMUtils::MemSpec::MemSpecVaria
 {
     return std::get<DRAMUtils::MemSpec::MemSpecLPDDR4>(memSpec.getVariant());
 }
+
+MemSpecLPDDR4 MemSpecLPDDR4::from_stream(std::istream& stream)
+{
+    MemSpecLPDDR4 memspec;
+    memspec.deserialize(stream);
+    return memspec;
+}
+
+void MemSpecLPDDR4::serialize(std::ostream& stream) const
+{
+    serializeBase(stream);
+    memspec_io::write(stream, numberOfBankGroups);
+    memspec_io::write(stream, banksPerGroup);
+    memspec_io::write(stream, numberOfRanks);
+    memspec_io::write(stream, vddq);
+    memspec_io::write(stream, memTimingSpec);
+    memspec_io::write(stream, memImpedanceSpec);
+    memspec_io::write(stream, memPowerSpec);
+    memspec_io::write(stream, bwParams.activeBanks);
+    memspec_io::write(stream, bwParams.bwPowerFactRho);
+    memspec_io::write(stream, bwParams.bwPowerFactSigma);
+    memspec_io::write(stream, bwParams.flgPASR);
+    memspec_io::write(stream, bwParams.pasrMode);
+}
+
+void MemSpecLPDDR4::deserialize(std::istream& stream)
+{
+    deserializeBase(stream);
+    memspec_io::read(stream, numberOfBankGroups);
+    memspec_io::read(stream, banksPerGroup);
+    memspec_io::read(stream, numberOfRanks);
+    memspec_io::read(stream, vddq);
+    memspec_io::read(stream, memTimingSpec);
+    memspec_io::read(stream, memImpedanceSpec);
+    memspec_io::read(stream, memPowerSpec);
+    memspec_io::read(stream, bwParams.activeBanks);
+    memspec_io::read(stream, bwParams.bwPowerFactRho);
+    memspec_io::read(stream, bwParams.bwPowerFactSigma);
+    memspec_io::read(stream, bwParams.flgPASR);
+    memspec_io::read(stream, bwParams.pasrMode);
+}
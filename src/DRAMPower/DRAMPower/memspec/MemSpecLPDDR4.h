@@ -3,12 +3,15 @@
 
 #include "MemSpec.h"
 
+#include <DRAMPower/util/Serialize.h>
+#include <DRAMPower/util/Deserialize.h>
+
 #include <DRAMUtils/memspec/standards/MemSpecLPDDR4.h>
 
 
 namespace DRAMPower {
 
-class MemSpecLPDDR4 final : public MemSpec<DRAMUtils::MemSpec::MemSpecLPDDR4>
+class MemSpecLPDDR4 final : public MemSpec<DRAMUtils::MemSpec::MemSpecLPDDR4>, public util::Serialize, public util::Deserialize
 {
 public:
 	using MemImpedanceSpec = DRAMUtils::MemSpec::MemImpedanceSpecTypeLPDDR4;
@@ -19,8 +22,6 @@ public:
     };
 
 public:
-	MemSpecLPDDR4() = delete;
-	
 	MemSpecLPDDR4(const DRAMUtils::MemSpec::MemSpecLPDDR4 &memspec);
 	
 	MemSpecLPDDR4(json_t &data) = delete;
@@ -111,10 +112,16 @@ public:
 	BankWiseParams bwParams;
 
 private:
+    // Only used by from_stream
+    MemSpecLPDDR4() = default;
     void parseImpedanceSpec(const DRAMUtils::MemSpec::MemSpecLPDDR4 &memspec);
 
 public:
     static MemSpecLPDDR4 from_memspec(const DRAMUtils::MemSpec::MemSpecVariant&);
+    // Binary representation of the derived memspec (see MemSpecCache)
+    static MemSpecLPDDR4 from_stream(std::istream& stream);
+    void serialize(std::ostream& stream) const override;
+    void deserialize(std::istream& stream) override;
 };
 
 }
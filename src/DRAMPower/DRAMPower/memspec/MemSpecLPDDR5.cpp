@@ -137,3 +137,42 @@ MemSpecLPDDR5 MemSpecLPDDR5::from_memspec(const DRAMUtils::MemSpec::MemSpecVaria
 {
     return std::get<DRAMUtils::MemSpec::MemSpecLPDDR5>(memSpec.getVariant());
 }
+
+MemSpecLPDDR5 MemSpecLPDDR5::from_stream(std::istream& stream)
+{
+    MemSpecLPDDR5 memspec;
+    memspec.deserialize(stream);
+    return memspec;
+}
+
+void MemSpecLPDDR5::serialize(std::ostream& stream) const
+{
+    serializeBase(stream);
+    memspec_io::write(stream, numberOfBankGroups);
+    memspec_io::write(stream, banksPerGroup);
+    memspec_io::write(stream, numberOfRanks);
+    memspec_io::write(stream, perTwoBankOffset);
+    memspec_io::write(stream, bank_arch);
+    memspec_io::write(stream, wckAlwaysOnMode);
+    memspec_io::write(stream, vddq);
+    memspec_io::write(stream, memTimingSpec);
+    memspec_io::write(stream, memImpedanceSpec);
+    memspec_io::write(stream, memPowerSpec);
+    memspec_io::write(stream, bwParams);
+}
+
+void MemSpecLPDDR5::deserialize(std::istream& stream)
+{
+    deserializeBase(stream);
+    memspec_io::read(stream, numberOfBankGroups);
+    memspec_io::read(stream, banksPerGroup);
+    memspec_io::read(stream, numberOfRanks);
+    memspec_io::read(stream, perTwoBankOffset);
+    memspec_io::read(stream, bank_arch);
+    memspec_io::read(stream, wckAlwaysOnMode);
+    memspec_io::read(stream, vddq);
+    memspec_io::read(stream, memTimingSpec);
+    memspec_io::read(stream, memImpedanceSpec);
+    memspec_io::read(stream, memPowerSpec);
+    memspec_io::read(stream, bwParams);
+}
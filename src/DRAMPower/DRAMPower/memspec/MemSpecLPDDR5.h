@@ -2,11 +2,14 @@
 #define DRAMPOWER_MEMSPEC_MEMSPECLPDDR5_H
 
 #include "MemSpec.h"
+
+#include <DRAMPower/util/Serialize.h>
+#include <DRAMPower/util/Deserialize.h>
 #include <DRAMUtils/memspec/standards/MemSpecLPDDR5.h>
 
 namespace DRAMPower {
 
-    class MemSpecLPDDR5 final : public MemSpec<DRAMUtils::MemSpec::MemSpecLPDDR5> {
+    class MemSpecLPDDR5 final : public MemSpec<DRAMUtils::MemSpec::MemSpecLPDDR5>, public util::Serialize, public util::Deserialize {
     public:
         using MemImpedanceSpec = DRAMUtils::MemSpec::MemImpedanceSpecTypeLPDDR5;
         enum VoltageDomain {
@@ -22,8 +25,6 @@ namespace DRAMPower {
         };
 
     public:
-        MemSpecLPDDR5() = delete;
-
         MemSpecLPDDR5(const DRAMUtils::MemSpec::MemSpecLPDDR5 &memspec);
 	
         MemSpecLPDDR5(json_t &data) = delete;
@@ -97,10 +98,16 @@ namespace DRAMPower {
         BankWiseParams bwParams;
 
        private:
+        // Only used by from_stream
+        MemSpecLPDDR5() = default;
         void parseImpedanceSpec(const DRAMUtils::MemSpec::MemSpecLPDDR5 &memspec);
 
        public:
         static MemSpecLPDDR5 from_memspec(const DRAMUtils::MemSpec::MemSpecVariant&);
+        // Binary representation of the derived memspec (see MemSpecCache)
+        static MemSpecLPDDR5 from_stream(std::istream& stream);
+        void serialize(std::ostream& stream) const override;
+        void deserialize(std::istream& stream) override;
     };
 
 }  // namespace DRAMPower
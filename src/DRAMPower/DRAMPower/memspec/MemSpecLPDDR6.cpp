@@ -107,3 +107,38 @@ MemSpecLPDDR6 MemSpecLPDDR6::from_memspec(const DRAMUtils::MemSpec::MemSpecVaria
 {
     return std::get<DRAMUtils::MemSpec::MemSpecLPDDR6>(memSpec.getVariant());
 }
+
+MemSpecLPDDR6 MemSpecLPDDR6::from_stream(std::istream& stream)
+{
+    MemSpecLPDDR6 memspec;
+    memspec.deserialize(stream);
+    return memspec;
+}
+
+void MemSpecLPDDR6::serialize(std::ostream& stream) const
+{
+    serializeBase(stream);
+    memspec_io::write(stream, numberOfBankGroups);
+    memspec_io::write(stream, banksPerGroup);
+    memspec_io::write(stream, numberOfRanks);
+    memspec_io::write(stream, wckAlwaysOnMode);
+    memspec_io::write(stream, vddq);
+    memspec_io::write(stream, memTimingSpec);
+    memspec_io::write(stream, memImpedanceSpec);
+    memspec_io::write(stream, memPowerSpec);
+    memspec_io::write(stream, bwParams);
+}
+
+void MemSpecLPDDR6::deserialize(std::istream& stream)
+{
+    deserializeBase(stream);
+    memspec_io::read(stream, numberOfBankGroups);
+    memspec_io::read(stream, banksPerGroup);
+    memspec_io::read(stream, numberOfRanks);
+    memspec_io::read(stream, wckAlwaysOnMode);
+    memspec_io::read(stream, vddq);
+    memspec_io::read(stream, memTimingSpec);
+    memspec_io::read(stream, memImpedanceSpec);
+    memspec_io::read(stream, memPowerSpec);
+    memspec_io::read(stream, bwParams);
+}
@@ -2,11 +2,14 @@
 #define DRAMPOWER_MEMSPEC_MEMSPECLPDDR6_H
 
 #include "MemSpec.h"
+
+#include <DRAMPower/util/Serialize.h>
+#include <DRAMPower/util/Deserialize.h>
 #include <DRAMUtils/memspec/standards/MemSpecLPDDR6.h>
 
 namespace DRAMPower {
 
-    class MemSpecLPDDR6 final : public MemSpec<DRAMUtils::MemSpec::MemSpecLPDDR6> {
+    class MemSpecLPDDR6 final : public MemSpec<DRAMUtils::MemSpec::MemSpecLPDDR6>, public util::Serialize, public util::Deserialize {
     public:
         using MemImpedanceSpec = DRAMUtils::MemSpec::MemImpedanceSpecTypeLPDDR6;
         enum VoltageDomain {
@@ -16,8 +19,6 @@ namespace DRAMPower {
         };
 
     public:
-        MemSpecLPDDR6() = delete;
-
         MemSpecLPDDR6(const DRAMUtils::MemSpec::MemSpecLPDDR6 &memspec);
 	
         MemSpecLPDDR6(json_t &data) = delete;
@@ -90,10 +91,16 @@ namespace DRAMPower {
         BankWiseParams bwParams;
 
        private:
+        // Only used by from_stream
+        MemSpecLPDDR6() = default;
         void parseImpedanceSpec(const DRAMUtils::MemSpec::MemSpecLPDDR6 &memspec);
 
        public:
         static MemSpecLPDDR6 from_memspec(const DRAMUtils::MemSpec::MemSpecVariant&);
+        // Binary representation of the derived memspec (see MemSpecCache)
+        static MemSpecLPDDR6 from_stream(std::istream& stream);
+        void serialize(std::ostream& stream) const override;
+        void deserialize(std::istream& stream) override;
     };
 
 }  // namespace DRAMPower
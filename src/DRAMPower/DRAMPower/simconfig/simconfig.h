@@ -10,8 +10,10 @@ struct SimConfig {
     using ToggleRateDefinition_t = DRAMUtils::Config::ToggleRateDefinition;
 
     std::optional<ToggleRateDefinition_t> toggleRateDefinition;
+    // Collect the data bus stats of every device (SimulationStats::devices)
+    std::optional<bool> deviceBusStats;
 };
-NLOHMANN_JSONIFY_ALL_THINGS(SimConfig, toggleRateDefinition);
+NLOHMANN_JSONIFY_ALL_THINGS(SimConfig, toggleRateDefinition, deviceBusStats);
 
 } // DRAMPower::config
 
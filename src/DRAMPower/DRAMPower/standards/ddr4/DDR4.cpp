@@ -14,7 +14,8 @@ namespace DRAMPower {
 
     using namespace DRAMUtils::Config;
 
-    DDR4::DDR4(const MemSpecDDR4 &memSpec, const config::SimConfig &simConfig)
+    template <typename Geometry>
+    BasicDDR4<Geometry>::BasicDDR4(const MemSpecDDR4 &memSpec, const config::SimConfig &simConfig)
         : m_memSpec(memSpec)
         , m_interface(m_memSpec, simConfig)
         , m_core(m_memSpec)
@@ -23,7 +24,8 @@ namespace DRAMPower {
     }
 
 // Extensions
-    void DDR4::registerExtensions() {
+    template <typename Geometry>
+    void BasicDDR4<Geometry>::registerExtensions() {
         getExtensionManager().registerExtension<extensions::DBI>([this](const timestamp_t, const bool enable) {
             // Assumption: the enabling of the DBI does not interleave with previous data on the bus
             // x4,x8,x16 devices: only x8 and x16 support dbi
@@ -37,27 +39,32 @@ namespace DRAMPower {
     }
 
 // Getters for CLI
-    util::CLIArchitectureConfig DDR4::getCLIArchitectureConfig() {
+    template <typename Geometry>
+    util::CLIArchitectureConfig BasicDDR4<Geometry>::getCLIArchitectureConfig() {
         return util::CLIArchitectureConfig{
             m_memSpec.numberOfDevices,
             m_memSpec.numberOfRanks,
-            m_memSpec.numberOfBanks
+            m_memSpec.numberOfBanks,
+            0 != m_memSpec.numberOfBankGroups ? m_memSpec.numberOfBanks / m_memSpec.numberOfBankGroups : 0
         };
     }
 
 // Calculation
-    energy_t DDR4::calcCoreEnergyStats(const SimulationStats& stats) const {
+    template <typename Geometry>
+    energy_t BasicDDR4<Geometry>::calcCoreEnergyStats(const SimulationStats& stats) const {
         Calculation_DDR4 calculation(m_memSpec);
         return calculation.calcEnergy(stats);
     }
 
-    interface_energy_info_t DDR4::calcInterfaceEnergyStats(const SimulationStats& stats) const {
+    template <typename Geometry>
+    interface_energy_info_t BasicDDR4<Geometry>::calcInterfaceEnergyStats(const SimulationStats& stats) const {
         InterfaceCalculation_DDR4 calculation(m_memSpec);
         return calculation.calculateEnergy(stats);
     }
 
 // Stats
-    SimulationStats DDR4::getWindowStats(timestamp_t timestamp) {
+    template <typename Geometry>
+    SimulationStats BasicDDR4<Geometry>::getWindowStats(timestamp_t timestamp) {
         SimulationStats stats;
         m_core.getWindowStats(timestamp, stats);
         m_interface.getWindowStats(timestamp, stats);
@@ -65,14 +72,48 @@ namespace DRAMPower {
     }
 
 // Serialization
-    void DDR4::serialize_impl(std::ostream& stream) const {
+    template <typename Geometry>
+    void BasicDDR4<Geometry>::serialize_impl(std::ostream& stream) const {
         m_core.serialize(stream);
         m_interface.serialize(stream);
     }
 
-    void DDR4::deserialize_impl(std::istream& stream) {
+    template <typename Geometry>
+    void BasicDDR4<Geometry>::deserialize_impl(std::istream& stream) {
         m_core.deserialize(stream);
         m_interface.deserialize(stream);
     }
 
+    template <typename Geometry>
+    void BasicDDR4<Geometry>::serializeDelta_impl(std::ostream& stream) {
+        m_core.serializeDelta(stream);
+        m_interface.serializeDelta(stream);
+    }
+
+    template <typename Geometry>
+    void BasicDDR4<Geometry>::deserializeDelta_impl(std::istream& stream) {
+        m_core.deserializeDelta(stream);
+        m_interface.deserializeDelta(stream);
+    }
+
+    template <typename Geometry>
+    void BasicDDR4<Geometry>::clearDelta_impl() {
+        m_core.clearDelta();
+        m_interface.clearDelta();
+    }
+
+    template class BasicDDR4<DynamicGeometry>;
+    template class BasicDDR4<FixedGeometry<1, 16, 4>>;
+    template class BasicDDR4<FixedGeometry<2, 16, 4>>;
+    template class BasicDDR4<FixedGeometry<1, 8, 2>>;
+    template class BasicDDR4<FixedGeometry<2, 8, 2>>;
+
+// Factory
+    std::unique_ptr<dram_base<CmdType>> makeDRAM(const MemSpecDDR4 &memSpec, const config::SimConfig &simConfig) {
+        return dispatchGeometry(DDR4Geometries{}, memSpec.numberOfRanks, memSpec.numberOfBanks, memSpec.numberOfBankGroups,
+            [&memSpec, &simConfig](auto geometry) -> std::unique_ptr<dram_base<CmdType>> {
+                return std::make_unique<BasicDDR4<decltype(geometry)>>(memSpec, simConfig);
+            });
+    }
+
 } // namespace DRAMPower
@@ -18,28 +18,33 @@
 #include "DRAMPower/simconfig/simconfig.h"
 
 #include <algorithm>
+#include <memory>
 
 namespace DRAMPower {
 
-class DDR4 : public dram_base<CmdType> {
+template <typename Geometry = DynamicGeometry>
+class BasicDDR4 : public dram_base<CmdType> {
+// Friend classes
+friend struct StaticDispatch<BasicDDR4>;
+
 // Public constructors and assignment operators
 public:
-    DDR4() = delete; // No default constructor
-    DDR4(const DDR4& other) = default; // copy constructor
-    DDR4(DDR4&& other) noexcept = default; // move constructor
-    DDR4& operator=(const DDR4&) = default; // copy assignment operator
-    DDR4& operator=(DDR4&&) = default; // move assignment operator
-    ~DDR4() override = default;
+    BasicDDR4() = delete; // No default constructor
+    BasicDDR4(const BasicDDR4& other) = default; // copy constructor
+    BasicDDR4(BasicDDR4&& other) noexcept = default; // move constructor
+    BasicDDR4& operator=(const BasicDDR4&) = default; // copy assignment operator
+    BasicDDR4& operator=(BasicDDR4&&) = default; // move assignment operator
+    ~BasicDDR4() override = default;
     
-    DDR4(const MemSpecDDR4 &memSpec, const config::SimConfig &simConfig = {});
+    BasicDDR4(const MemSpecDDR4 &memSpec, const config::SimConfig &simConfig = {});
 
 // Public member functions
 public:
 // Member functions
-    DDR4Core& getCore() {
+    BasicDDR4Core<Geometry>& getCore() {
         return m_core;
     }
-    const DDR4Core& getCore() const {
+    const BasicDDR4Core<Geometry>& getCore() const {
         return m_core;
     }
     DDR4Interface& getInterface() {
@@ -73,14 +78,23 @@ private:
     }
     void serialize_impl(std::ostream& stream) const override;
     void deserialize_impl(std::istream& stream) override;
+    void serializeDelta_impl(std::ostream& stream) override;
+    void deserializeDelta_impl(std::istream& stream) override;
+    void clearDelta_impl() override;
 
 // Private member variables
 private:
     MemSpecDDR4 m_memSpec;
     DDR4Interface m_interface;
-    DDR4Core m_core;
+    BasicDDR4Core<Geometry> m_core;
 };
 
+using DDR4 = BasicDDR4<DynamicGeometry>;
+
+// Creates a DDR4 with the fixed geometry core matching memSpec (see DDR4Geometries)
+// and a DDR4 sized at runtime otherwise
+std::unique_ptr<dram_base<CmdType>> makeDRAM(const MemSpecDDR4 &memSpec, const config::SimConfig &simConfig = {});
+
 } // namespace DRAMPower
 
 #endif /* DRAMPOWER_STANDARDS_DDR4_DDR4_H */
@@ -4,23 +4,22 @@
 #include "DRAMPower/util/Deserialize.h"
 #include "DRAMPower/util/Serialize.h"
 #include <DRAMPower/Types.h>
+#include <DRAMPower/dram/Core.h>
+#include <DRAMPower/dram/Geometry.h>
 #include <DRAMPower/dram/Rank.h>
 #include <DRAMPower/command/Command.h>
 #include <DRAMPower/data/stats.h>
 #include <DRAMPower/util/ImplicitCommandHandler.h>
+#include <DRAMPower/util/delta_checkpoint.h>
 #include <DRAMPower/simconfig/simconfig.h>
 
 #include <DRAMPower/memspec/MemSpecDDR4.h>
 
+#include <utility>
 #include <vector>
 
 namespace DRAMPower {
 
-namespace internal {
-    template<typename Core>
-    class TestAccessor;
-}
-
 struct DDR4CoreMemSpec {
     DDR4CoreMemSpec(const MemSpecDDR4& memSpec)
         : numberOfBanks(memSpec.numberOfBanks)
@@ -44,56 +43,45 @@ struct DDR4CoreMemSpec {
     uint64_t prechargeOffsetWR;
 };
 
-class DDR4Core : public util::Serialize, public util::Deserialize {
-// Friend classes
-friend class internal::TestAccessor<DDR4Core>;
-
-// Public constructors and assignment operators
-public:
-    DDR4Core(const MemSpecDDR4& memSpec)
-        : m_memSpec(memSpec)
-        , m_ranks(memSpec.numberOfRanks, {static_cast<std::size_t>(memSpec.numberOfBanks)})
-    {}
-
-// Public member functions
-public:
-// Member functions
-    void doCommand(const Command& cmd);
-    timestamp_t getLastCommandTime() const;
-    bool isSerializable() const;
-    void getWindowStats(timestamp_t timestamp, SimulationStats &stats);
-// Overrides
-    void serialize(std::ostream& stream) const override;
-    void deserialize(std::istream& stream) override;
-
-// Private member functions
-private:
-    void handleAct(Rank & rank, Bank & bank, timestamp_t timestamp);
-    void handlePre(Rank & rank, Bank & bank, timestamp_t timestamp);
-    void handlePreAll(Rank & rank, timestamp_t timestamp); 
-    void handleRefAll(std::size_t rank_idx, timestamp_t timestamp);
-    void handleSelfRefreshEntry(std::size_t rank_idx, timestamp_t timestamp);
-    void handleSelfRefreshExit(Rank & rank, timestamp_t timestamp);
-    void handleRead(Rank & rank, Bank & bank, timestamp_t timestamp);
-    void handleWrite(Rank & rank, Bank & bank, timestamp_t timestamp);
-    void handleReadAuto(std::size_t rank_idx, std::size_t bank_idx, timestamp_t timestamp);
-    void handleWriteAuto(std::size_t rank_idx, std::size_t bank_idx, timestamp_t timestamp);
-    void handlePowerDownActEntry(std::size_t rank_idx, timestamp_t timestamp);
-    void handlePowerDownActExit(std::size_t rank_idx, timestamp_t timestamp);
-    void handlePowerDownPreEntry(std::size_t rank_idx, timestamp_t timestamp);
-    void handlePowerDownPreExit(std::size_t rank_idx, timestamp_t timestamp);
-
-    timestamp_t earliestPossiblePowerDownEntryTime(Rank & rank) const;
-
-
-// Private members variables
-private:
-    DDR4CoreMemSpec m_memSpec;
-    std::vector<Rank> m_ranks;
-    ImplicitCommandHandler<DDR4Core> m_implicitCommandHandler;
-    timestamp_t m_last_command_time = 0;
+// Commands and timings of the DDR4 core, see BasicCore
+struct DDR4CorePolicy {
+    using memspec_t = MemSpecDDR4;
+    using timings_t = DDR4CoreMemSpec;
+    using command_t = Command;
+
+    static constexpr bool perBankRefresh = false;    // REFB
+    static constexpr bool sameBankRefresh = false;   // REFSB, PRESB
+    static constexpr bool perTwoBankRefresh = false; // REFP2B
+    static constexpr bool dualBankRefresh = false;   // REFDB
+    static constexpr bool deepSleepMode = false;     // DSMEN, DSMEX
+    static constexpr PowerDownModel powerDownModel = PowerDownModel::ActiveBanks;
+
+    static uint64_t tRFC(const timings_t& t) { return t.tRFC; }
+    static uint64_t tRCD(const timings_t& t) { return t.tRCD; }
 };
 
+// Ranks, banks and bank groups are sized by Geometry. DynamicGeometry sizes them from the memspec,
+// a FixedGeometry at compile time (see DDR4Geometries).
+template <typename Geometry = DynamicGeometry>
+using BasicDDR4Core = BasicCore<DDR4CorePolicy, Geometry>;
+
+using DDR4Core = BasicDDR4Core<DynamicGeometry>;
+
+// Fixed geometries (ranks, banks, bank groups) with a compiled core, see makeDRAM
+using DDR4Geometries = GeometryList<
+    FixedGeometry<1, 16, 4>,
+    FixedGeometry<2, 16, 4>,
+    FixedGeometry<1, 8, 2>,
+    FixedGeometry<2, 8, 2>
+>;
+
+// Compiled in DDR4Core.cpp
+extern template class BasicCore<DDR4CorePolicy, DynamicGeometry>;
+extern template class BasicCore<DDR4CorePolicy, FixedGeometry<1, 16, 4>>;
+extern template class BasicCore<DDR4CorePolicy, FixedGeometry<2, 16, 4>>;
+extern template class BasicCore<DDR4CorePolicy, FixedGeometry<1, 8, 2>>;
+extern template class BasicCore<DDR4CorePolicy, FixedGeometry<2, 8, 2>>;
+
 } // namespace DRAMPower
 
 #endif /* DRAMPOWER_STANDARDS_DDR4_DDR4CORE_H */
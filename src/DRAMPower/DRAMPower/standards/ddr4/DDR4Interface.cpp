@@ -21,7 +21,8 @@ namespace DRAMPower {
                 util::DataBusConfig{
                     memSpec.bitWidth * memSpec.numberOfDevices,
                     memSpec.dataRate,
-                    simConfig.toggleRateDefinition.value_or(busConfig)
+                    simConfig.toggleRateDefinition.value_or(busConfig),
+                    simConfig.deviceBusStats.value_or(false) ? memSpec.bitWidth : 0
                 },
                 simConfig.toggleRateDefinition.has_value()
                     ? util::DataBusMode::TogglingRate
@@ -35,8 +36,8 @@ namespace DRAMPower {
             [this](timestamp_t load_timestamp, timestamp_t, std::size_t pin, bool inversion_state, bool read) {
             this->handleDBIPinChange(load_timestamp, pin, inversion_state, read);
         }, false)
-        , m_dbiread(m_dbi.getChunksPerWidth().value(), pin_dbi_t{m_dbi.getIdlePattern(), m_dbi.getIdlePattern()})
-        , m_dbiwrite(m_dbi.getChunksPerWidth().value(), pin_dbi_t{m_dbi.getIdlePattern(), m_dbi.getIdlePattern()})
+        , m_dbiread(m_dbi.getChunksPerWidth().value(), m_dbi.getIdlePattern(), m_dbi.getIdlePattern())
+        , m_dbiwrite(m_dbi.getChunksPerWidth().value(), m_dbi.getIdlePattern(), m_dbi.getIdlePattern())
         , prepostambleReadMinTccd(memSpec.prePostamble.readMinTccd)
         , prepostambleWriteMinTccd(memSpec.prePostamble.writeMinTccd)
         , m_ranks(memSpec.numberOfRanks)
@@ -45,6 +46,9 @@ namespace DRAMPower {
             {pattern_descriptor::X, PatternEncoderBitSpec::H},
         }, cmdBusInitPattern)
     {
+        m_dbi.setBurstCallback([this](timestamp_t load_timestamp, const std::vector<uint64_t>& beat_masks, bool read) {
+            this->handleDBIBurst(load_timestamp, beat_masks, read);
+        });
         registerPatterns();
     }
 
@@ -145,6 +149,7 @@ namespace DRAMPower {
     }
 
     void DDR4Interface::doCommand(const Command& cmd) {
+        m_deltaTracker.markCommand(cmd);
         switch(cmd.type) {
             case CmdType::ACT:
             case CmdType::PRE:
@@ -179,9 +184,17 @@ namespace DRAMPower {
     void DDR4Interface::handleDBIPinChange(const timestamp_t load_timestamp, std::size_t pin, bool state, bool read) {
         assert(pin < m_dbiread.size() || pin < m_dbiwrite.size());
         if (read) {
-            this->m_dbiread[pin].set(load_timestamp, state ? util::PinState::L : util::PinState::H, 1);
+            this->m_dbiread.set_pin(pin, load_timestamp, state ? util::PinState::L : util::PinState::H, 1);
         } else {
-            this->m_dbiwrite[pin].set(load_timestamp, state ? util::PinState::L : util::PinState::H, 1);
+            this->m_dbiwrite.set_pin(pin, load_timestamp, state ? util::PinState::L : util::PinState::H, 1);
+        }
+    }
+
+    void DDR4Interface::handleDBIBurst(const timestamp_t load_timestamp, const std::vector<uint64_t>& beat_masks, bool read) {
+        auto &pins = read ? m_dbiread : m_dbiwrite;
+        // One bit-plane per beat
+        for (const uint64_t mask : beat_masks) {
+            pins.set(load_timestamp, ~mask, 1);
         }
     }
 
@@ -356,6 +369,10 @@ namespace DRAMPower {
             stats.togglingStats.read,
             stats.togglingStats.write
         );
+        m_dataBus.get_toggling_activity(timestamp,
+            stats.togglingStats.readActivity,
+            stats.togglingStats.writeActivity
+        );
 
         // single line stored in stats
         // differential power calculated in interface calculation
@@ -363,12 +380,11 @@ namespace DRAMPower {
         stats.readDQSStats = NumDQsPairs * 2u * m_readDQS.get_stats_at(timestamp);
         stats.writeDQSStats = NumDQsPairs * 2u * m_writeDQS.get_stats_at(timestamp);
 
-        for (const auto &dbi_pin : m_dbiread) {
-            stats.readDBI += dbi_pin.get_stats_at(timestamp, 2);
-        }
-        for (const auto &dbi_pin : m_dbiwrite) {
-            stats.writeDBI += dbi_pin.get_stats_at(timestamp, 2);
-        }
+        stats.readDBI += m_dbiread.get_stats_at(timestamp, 2);
+        stats.writeDBI += m_dbiwrite.get_stats_at(timestamp, 2);
+
+        util::addDeviceBusStats(m_dataBus, timestamp, stats.devices);
+        util::addDeviceDBIStats(m_dbiread, m_dbiwrite, timestamp, 2, stats.devices);
     }
 
     void DDR4Interface::serialize(std::ostream& stream) const {
@@ -383,12 +399,8 @@ namespace DRAMPower {
         for (const auto& rank : m_ranks) {
             rank.serialize(stream);
         }
-        for (const auto& pin : m_dbiread) {
-            pin.serialize(stream);
-        }
-        for (const auto& pin : m_dbiwrite) {
-            pin.serialize(stream);
-        }
+        m_dbiread.serialize(stream);
+        m_dbiwrite.serialize(stream);
     }
 
     void DDR4Interface::deserialize(std::istream& stream) {
@@ -403,12 +415,61 @@ namespace DRAMPower {
         for (auto &rank : m_ranks) {
             rank.deserialize(stream);
         }
-        for (auto &pin : m_dbiread) {
-            pin.deserialize(stream);
+        m_dbiread.deserialize(stream);
+        m_dbiwrite.deserialize(stream);
+    }
+
+    void DDR4Interface::serializeDelta(std::ostream& stream) {
+        m_deltaTracker.serialize(stream);
+        stream.write(reinterpret_cast<const char*>(&m_last_command_time), sizeof(m_last_command_time));
+        m_patternHandler.serialize(stream);
+        if (m_deltaTracker.commandBus) {
+            m_commandBus.serialize(stream);
         }
-        for (auto &pin : m_dbiwrite) {
-            pin.deserialize(stream);
+        if (m_deltaTracker.dataBus) {
+            m_dataBus.serialize(stream);
+        }
+        m_readDQS.serialize(stream);
+        m_writeDQS.serialize(stream);
+        m_clock.serialize(stream);
+        if (m_deltaTracker.dbi) {
+            m_dbi.serialize(stream);
+            m_dbiread.serialize(stream);
+            m_dbiwrite.serialize(stream);
         }
+        for (const auto& rank : m_ranks) {
+            rank.serialize(stream);
+        }
+        m_deltaTracker.clear();
+    }
+
+    void DDR4Interface::deserializeDelta(std::istream& stream) {
+        util::InterfaceDeltaTracker delta;
+        delta.deserialize(stream);
+        stream.read(reinterpret_cast<char*>(&m_last_command_time), sizeof(m_last_command_time));
+        m_patternHandler.deserialize(stream);
+        if (delta.commandBus) {
+            m_commandBus.deserialize(stream);
+        }
+        if (delta.dataBus) {
+            m_dataBus.deserialize(stream);
+        }
+        m_readDQS.deserialize(stream);
+        m_writeDQS.deserialize(stream);
+        m_clock.deserialize(stream);
+        if (delta.dbi) {
+            m_dbi.deserialize(stream);
+            m_dbiread.deserialize(stream);
+            m_dbiwrite.deserialize(stream);
+        }
+        for (auto& rank : m_ranks) {
+            rank.deserialize(stream);
+        }
+        m_deltaTracker.clear();
+    }
+
+    void DDR4Interface::clearDelta() {
+        m_deltaTracker.clear();
     }
 
 } // namespace DRAMPower
@@ -13,8 +13,6 @@
 namespace DRAMPower 
 {
 
-class DDR4;
-
 class Calculation_DDR4
 {
 public:
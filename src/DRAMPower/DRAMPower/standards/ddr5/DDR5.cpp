@@ -13,34 +13,40 @@ namespace DRAMPower {
 
     using namespace DRAMUtils::Config;
 
-    DDR5::DDR5(const MemSpecDDR5 &memSpec, const config::SimConfig &simConfig)
+    template <typename Geometry>
+    BasicDDR5<Geometry>::BasicDDR5(const MemSpecDDR5 &memSpec, const config::SimConfig &simConfig)
         : m_memSpec(memSpec)
         , m_interface(m_memSpec, simConfig)
         , m_core(m_memSpec)
     {}
 
 // Getters for CLI
-    util::CLIArchitectureConfig DDR5::getCLIArchitectureConfig() {
+    template <typename Geometry>
+    util::CLIArchitectureConfig BasicDDR5<Geometry>::getCLIArchitectureConfig() {
         return util::CLIArchitectureConfig{
             m_memSpec.numberOfDevices,
             m_memSpec.numberOfRanks,
-            m_memSpec.numberOfBanks
+            m_memSpec.numberOfBanks,
+            m_memSpec.banksPerGroup
         };
     }
 
 // Calculation
-    energy_t DDR5::calcCoreEnergyStats(const SimulationStats& stats) const {
+    template <typename Geometry>
+    energy_t BasicDDR5<Geometry>::calcCoreEnergyStats(const SimulationStats& stats) const {
         Calculation_DDR5 calculation(m_memSpec);
         return calculation.calcEnergy(stats);
     }
 
-    interface_energy_info_t DDR5::calcInterfaceEnergyStats(const SimulationStats& stats) const {
+    template <typename Geometry>
+    interface_energy_info_t BasicDDR5<Geometry>::calcInterfaceEnergyStats(const SimulationStats& stats) const {
         InterfaceCalculation_DDR5 calculation(m_memSpec);
         return calculation.calculateEnergy(stats);
     }
 
 // Stats
-    SimulationStats DDR5::getWindowStats(timestamp_t timestamp) {
+    template <typename Geometry>
+    SimulationStats BasicDDR5<Geometry>::getWindowStats(timestamp_t timestamp) {
         SimulationStats stats;
         m_core.getWindowStats(timestamp, stats);
         m_interface.getWindowStats(timestamp, stats);
@@ -48,14 +54,48 @@ namespace DRAMPower {
     }
 
 // Serialization
-    void DDR5::serialize_impl(std::ostream &stream) const {
+    template <typename Geometry>
+    void BasicDDR5<Geometry>::serialize_impl(std::ostream &stream) const {
         m_core.serialize(stream);
         m_interface.serialize(stream);
     }
 
-    void DDR5::deserialize_impl(std::istream &stream) {
+    template <typename Geometry>
+    void BasicDDR5<Geometry>::deserialize_impl(std::istream &stream) {
         m_core.deserialize(stream);
         m_interface.deserialize(stream);
     }
 
+    template <typename Geometry>
+    void BasicDDR5<Geometry>::serializeDelta_impl(std::ostream& stream) {
+        m_core.serializeDelta(stream);
+        m_interface.serializeDelta(stream);
+    }
+
+    template <typename Geometry>
+    void BasicDDR5<Geometry>::deserializeDelta_impl(std::istream& stream) {
+        m_core.deserializeDelta(stream);
+        m_interface.deserializeDelta(stream);
+    }
+
+    template <typename Geometry>
+    void BasicDDR5<Geometry>::clearDelta_impl() {
+        m_core.clearDelta();
+        m_interface.clearDelta();
+    }
+
+    template class BasicDDR5<DynamicGeometry>;
+    template class BasicDDR5<FixedGeometry<1, 32, 8>>;
+    template class BasicDDR5<FixedGeometry<2, 32, 8>>;
+    template class BasicDDR5<FixedGeometry<1, 16, 4>>;
+    template class BasicDDR5<FixedGeometry<2, 16, 4>>;
+
+// Factory
+    std::unique_ptr<dram_base<CmdType>> makeDRAM(const MemSpecDDR5 &memSpec, const config::SimConfig &simConfig) {
+        return dispatchGeometry(DDR5Geometries{}, memSpec.numberOfRanks, memSpec.numberOfBanks, memSpec.numberOfBankGroups,
+            [&memSpec, &simConfig](auto geometry) -> std::unique_ptr<dram_base<CmdType>> {
+                return std::make_unique<BasicDDR5<decltype(geometry)>>(memSpec, simConfig);
+            });
+    }
+
 } // namespace DRAMPower
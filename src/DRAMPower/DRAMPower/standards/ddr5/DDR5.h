@@ -17,20 +17,25 @@
 #include "DRAMPower/simconfig/simconfig.h"
 
 #include <algorithm>
+#include <memory>
 
 namespace DRAMPower {
 
-class DDR5 : public dram_base<CmdType> {
+template <typename Geometry = DynamicGeometry>
+class BasicDDR5 : public dram_base<CmdType> {
+// Friend classes
+friend struct StaticDispatch<BasicDDR5>;
+
 // public constructors and assignment operators
 public:
-    DDR5() = delete; // No default constructor
-    DDR5(const DDR5&) = default; // copy constructor
-    DDR5& operator=(const DDR5&) = default; // copy assignment operator
-    DDR5(DDR5&&) = default; // move constructor
-    DDR5& operator=(DDR5&&) = default; // move assignment operator
-    ~DDR5() override = default;
+    BasicDDR5() = delete; // No default constructor
+    BasicDDR5(const BasicDDR5&) = default; // copy constructor
+    BasicDDR5& operator=(const BasicDDR5&) = default; // copy assignment operator
+    BasicDDR5(BasicDDR5&&) = default; // move constructor
+    BasicDDR5& operator=(BasicDDR5&&) = default; // move assignment operator
+    ~BasicDDR5() override = default;
 
-    DDR5(const MemSpecDDR5& memSpec, const config::SimConfig &simConfig = {});
+    BasicDDR5(const MemSpecDDR5& memSpec, const config::SimConfig &simConfig = {});
 
 // Public member functions
 public:
@@ -42,10 +47,10 @@ public:
         return m_core.isSerializable();
     }
 // member functions
-    DDR5Core& getCore() {
+    BasicDDR5Core<Geometry>& getCore() {
         return m_core;
     }
-    const DDR5Core& getCore() const {
+    const BasicDDR5Core<Geometry>& getCore() const {
         return m_core;
     }
     DDR5Interface& getInterface() {
@@ -69,14 +74,23 @@ private:
     }
     void serialize_impl(std::ostream& stream) const override;
     void deserialize_impl(std::istream& stream) override;
+    void serializeDelta_impl(std::ostream& stream) override;
+    void deserializeDelta_impl(std::istream& stream) override;
+    void clearDelta_impl() override;
 
 // Private member variables
 private:
     MemSpecDDR5 m_memSpec;
     DDR5Interface m_interface;
-    DDR5Core m_core;
+    BasicDDR5Core<Geometry> m_core;
 };
 
+using DDR5 = BasicDDR5<DynamicGeometry>;
+
+// Creates a DDR5 with the fixed geometry core matching memSpec (see DDR5Geometries)
+// and a DDR5 sized at runtime otherwise
+std::unique_ptr<dram_base<CmdType>> makeDRAM(const MemSpecDDR5 &memSpec, const config::SimConfig &simConfig = {});
+
 }  // namespace DRAMPower
 
 #endif /* DRAMPOWER_STANDARDS_DDR5_DDR5_H */
@@ -2,23 +2,22 @@
 #define DRAMPOWER_STANDARDS_DDR5_DDR5CORE_H
 
 #include "DRAMPower/command/Command.h"
+#include "DRAMPower/dram/Core.h"
+#include "DRAMPower/dram/Geometry.h"
 #include "DRAMPower/dram/Rank.h"
 #include "DRAMPower/util/ImplicitCommandHandler.h"
+#include "DRAMPower/util/delta_checkpoint.h"
 #include "DRAMPower/util/Deserialize.h"
 #include "DRAMPower/util/Serialize.h"
 
 #include "DRAMPower/memspec/MemSpecDDR5.h"
 
 #include <cstddef>
+#include <utility>
 #include <vector>
 
 namespace DRAMPower {
 
-namespace internal {
-    template<typename Core>
-    class TestAccessor;
-}
-
 struct DDR5CoreMemSpec {
     DDR5CoreMemSpec(const MemSpecDDR5& memSpec)
         : numberOfBanks(memSpec.numberOfBanks)
@@ -48,58 +47,46 @@ struct DDR5CoreMemSpec {
     uint64_t prechargeOffsetWR;
 };
 
-class DDR5Core : public util::Serialize, public util::Deserialize {
-// Friend classes
-friend class internal::TestAccessor<DDR5Core>;
-
-// Public constructors and assignment operators
-public:
-    DDR5Core(const MemSpecDDR5& memSpec)
-        : m_memSpec(memSpec)
-        , m_ranks(memSpec.numberOfRanks, {static_cast<std::size_t>(memSpec.numberOfBanks)})
-    {}
-
-// Public member functions
-public:
-// Member functions
-    void doCommand(const Command& cmd);
-    timestamp_t getLastCommandTime() const;
-    bool isSerializable() const;
-    void getWindowStats(timestamp_t timestamp, SimulationStats &stats);
-// Overrides
-    void serialize(std::ostream& stream) const override;
-    void deserialize(std::istream& stream) override;
-
-// Private member functions
-private:
-    void handleAct(Rank& rank, Bank& bank, timestamp_t timestamp);
-    void handlePre(Rank& rank, Bank& bank, timestamp_t timestamp);
-    void handlePreSameBank(Rank& rank, std::size_t bank_id, timestamp_t timestamp);
-    void handlePreAll(Rank& rank, timestamp_t timestamp);
-    void handleRefSameBank(std::size_t rank_idx, std::size_t bank_id, timestamp_t timestamp);
-    void handleRefAll(std::size_t rank_idx, timestamp_t timestamp);
-    void handleRefreshOnBank(std::size_t rank_idx, std::size_t bank_idx, timestamp_t timestamp, uint64_t timing, uint64_t& counter);
-    void handleSelfRefreshEntry(std::size_t rank_idx, timestamp_t timestamp);
-    void handleSelfRefreshExit(Rank& rank, timestamp_t timestamp);
-    void handleRead(Rank& rank, Bank& bank, timestamp_t timestamp);
-    void handleWrite(Rank& rank, Bank& bank, timestamp_t timestamp);
-    void handleReadAuto(std::size_t rank_idx, std::size_t bank_idx, timestamp_t timestamp);
-    void handleWriteAuto(std::size_t rank_idx, std::size_t bank_idx, timestamp_t timestamp);
-    void handlePowerDownActEntry(std::size_t rank_idx, timestamp_t timestamp);
-    void handlePowerDownActExit(std::size_t rank_idx, timestamp_t timestamp);
-    void handlePowerDownPreEntry(std::size_t rank_idx, timestamp_t timestamp);
-    void handlePowerDownPreExit(std::size_t rank_idx, timestamp_t timestamp);
-
-    timestamp_t earliestPossiblePowerDownEntryTime(Rank& rank);
-
-// Private member variables
-private:
-    DDR5CoreMemSpec m_memSpec;
-    std::vector<Rank> m_ranks;
-    ImplicitCommandHandler<DDR5Core> m_implicitCommandHandler;
-    timestamp_t m_last_command_time = 0;
+// Commands and timings of the DDR5 core, see BasicCore
+struct DDR5CorePolicy {
+    using memspec_t = MemSpecDDR5;
+    using timings_t = DDR5CoreMemSpec;
+    using command_t = Command;
+
+    static constexpr bool perBankRefresh = false;    // REFB
+    static constexpr bool sameBankRefresh = true;    // REFSB, PRESB
+    static constexpr bool perTwoBankRefresh = false; // REFP2B
+    static constexpr bool dualBankRefresh = false;   // REFDB
+    static constexpr bool deepSleepMode = false;     // DSMEN, DSMEX
+    static constexpr PowerDownModel powerDownModel = PowerDownModel::InterruptedBanks;
+
+    static uint64_t tRFC(const timings_t& t) { return t.tRFC; }
+    static uint64_t tRFCbank(const timings_t& t) { return t.tRFCsb; }
+    static uint64_t tRCD(const timings_t& t) { return t.tRCD; }
 };
 
+// Ranks, banks and bank groups are sized by Geometry. DynamicGeometry sizes them from the memspec,
+// a FixedGeometry at compile time (see DDR5Geometries).
+template <typename Geometry = DynamicGeometry>
+using BasicDDR5Core = BasicCore<DDR5CorePolicy, Geometry>;
+
+using DDR5Core = BasicDDR5Core<DynamicGeometry>;
+
+// Fixed geometries (ranks, banks, bank groups) with a compiled core, see makeDRAM
+using DDR5Geometries = GeometryList<
+    FixedGeometry<1, 32, 8>,
+    FixedGeometry<2, 32, 8>,
+    FixedGeometry<1, 16, 4>,
+    FixedGeometry<2, 16, 4>
+>;
+
+// Compiled in DDR5Core.cpp
+extern template class BasicCore<DDR5CorePolicy, DynamicGeometry>;
+extern template class BasicCore<DDR5CorePolicy, FixedGeometry<1, 32, 8>>;
+extern template class BasicCore<DDR5CorePolicy, FixedGeometry<2, 32, 8>>;
+extern template class BasicCore<DDR5CorePolicy, FixedGeometry<1, 16, 4>>;
+extern template class BasicCore<DDR5CorePolicy, FixedGeometry<2, 16, 4>>;
+
 } // namespace DRAMPower
 
 #endif /* DRAMPOWER_STANDARDS_DDR5_DDR5CORE_H */
@@ -21,7 +21,8 @@ DDR5Interface::DDR5Interface(const MemSpecDDR5& memSpec, const config::SimConfig
             util::DataBusConfig {
                 memSpec.bitWidth * memSpec.numberOfDevices,
                 memSpec.dataRate,
-                simConfig.toggleRateDefinition.value_or(busConfig)
+                simConfig.toggleRateDefinition.value_or(busConfig),
+                simConfig.deviceBusStats.value_or(false) ? memSpec.bitWidth : 0
             },
             simConfig.toggleRateDefinition.has_value()
                 ? util::DataBusMode::TogglingRate
@@ -124,6 +125,7 @@ timestamp_t DDR5Interface::getLastCommandTime() const {
 }
 
 void DDR5Interface::doCommand(const Command& cmd) {
+    m_deltaTracker.markCommand(cmd);
     switch(cmd.type) {
         case CmdType::NOP:
         case CmdType::ACT:
@@ -268,6 +270,11 @@ void DDR5Interface::getWindowStats(timestamp_t timestamp, SimulationStats &stats
         stats.togglingStats.read,
         stats.togglingStats.write
     );
+    m_dataBus.get_toggling_activity(timestamp,
+        stats.togglingStats.readActivity,
+        stats.togglingStats.writeActivity
+    );
+    util::addDeviceBusStats(m_dataBus, timestamp, stats.devices);
 
     stats.clockStats = 2 * m_clock.get_stats_at(timestamp);
     stats.readDQSStats = 2 * m_readDQS.get_stats_at(timestamp);
@@ -301,4 +308,41 @@ void DDR5Interface::deserialize(std::istream& stream) {
     m_clock.deserialize(stream);
 }
 
+void DDR5Interface::serializeDelta(std::ostream& stream) {
+    m_deltaTracker.serialize(stream);
+    stream.write(reinterpret_cast<const char*>(&m_last_command_time), sizeof(m_last_command_time));
+    m_patternHandler.serialize(stream);
+    if (m_deltaTracker.commandBus) {
+        m_commandBus.serialize(stream);
+    }
+    if (m_deltaTracker.dataBus) {
+        m_dataBus.serialize(stream);
+    }
+    m_readDQS.serialize(stream);
+    m_writeDQS.serialize(stream);
+    m_clock.serialize(stream);
+    m_deltaTracker.clear();
+}
+
+void DDR5Interface::deserializeDelta(std::istream& stream) {
+    util::InterfaceDeltaTracker delta;
+    delta.deserialize(stream);
+    stream.read(reinterpret_cast<char*>(&m_last_command_time), sizeof(m_last_command_time));
+    m_patternHandler.deserialize(stream);
+    if (delta.commandBus) {
+        m_commandBus.deserialize(stream);
+    }
+    if (delta.dataBus) {
+        m_dataBus.deserialize(stream);
+    }
+    m_readDQS.deserialize(stream);
+    m_writeDQS.deserialize(stream);
+    m_clock.deserialize(stream);
+    m_deltaTracker.clear();
+}
+
+void DDR5Interface::clearDelta() {
+    m_deltaTracker.clear();
+}
+
 } // namespace DRAMPower
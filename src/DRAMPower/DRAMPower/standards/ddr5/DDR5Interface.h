@@ -3,6 +3,7 @@
 
 #include "DRAMPower/util/bus.h"
 #include "DRAMPower/util/databus_presets.h"
+#include "DRAMPower/util/device_stats.h"
 #include "DRAMPower/util/clock.h"
 #include "DRAMPower/util/Serialize.h"
 #include "DRAMPower/util/Deserialize.h"
@@ -12,6 +13,7 @@
 #include "DRAMPower/data/stats.h"
 
 #include "DRAMPower/util/PatternHandler.h"
+#include "DRAMPower/util/delta_checkpoint.h"
 
 #include "DRAMPower/memspec/MemSpecDDR5.h"
 
@@ -42,7 +44,7 @@ public:
 
 // Public type definitions
 public:
-    using commandbus_t = util::Bus<cmdBusWidth>;
+    using commandbus_t = util::Bus;
     using databus_t = util::databus_presets::databus_preset_t;
     using patternHandler_t = PatternHandler<CmdType>;
 
@@ -59,6 +61,10 @@ public:
 // Overrides
     void serialize(std::ostream& stream) const override;
     void deserialize(std::istream& stream) override;
+    // Delta checkpoints
+    void serializeDelta(std::ostream& stream);
+    void deserializeDelta(std::istream& stream);
+    void clearDelta();
 
 // Private member functions
 private:
@@ -78,6 +84,7 @@ private:
     util::Clock m_clock;
     patternHandler_t m_patternHandler;
     timestamp_t m_last_command_time = 0;
+    util::InterfaceDeltaTracker m_deltaTracker;
 };
 
 } // namespace DRAMPower
@@ -13,8 +13,6 @@
 namespace DRAMPower
 {
 
-class DDR5;
-
 class Calculation_DDR5
 {
 public:
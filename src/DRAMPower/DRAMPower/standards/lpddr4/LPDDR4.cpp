@@ -11,7 +11,8 @@ namespace DRAMPower {
 
     using namespace DRAMUtils::Config;
 
-    LPDDR4::LPDDR4(const MemSpecLPDDR4 &memSpec, const config::SimConfig &simConfig)
+    template <typename Geometry>
+    BasicLPDDR4<Geometry>::BasicLPDDR4(const MemSpecLPDDR4 &memSpec, const config::SimConfig &simConfig)
         : m_memSpec(memSpec)
         , m_interface(m_memSpec, simConfig)
         , m_core(m_memSpec)
@@ -20,7 +21,8 @@ namespace DRAMPower {
     }
 
 // Extensions
-    void LPDDR4::registerExtensions() {
+    template <typename Geometry>
+    void BasicLPDDR4<Geometry>::registerExtensions() {
         getExtensionManager().registerExtension<extensions::DBI>([this](const timestamp_t, const bool enable){
             // Assumption: the enabling of the DBI does not interleave with previous data on the bus
             // x8,x16 devices: support dbi
@@ -30,27 +32,32 @@ namespace DRAMPower {
     }
 
 // Getters for CLI
-    util::CLIArchitectureConfig LPDDR4::getCLIArchitectureConfig() {
+    template <typename Geometry>
+    util::CLIArchitectureConfig BasicLPDDR4<Geometry>::getCLIArchitectureConfig() {
         return util::CLIArchitectureConfig{
             m_memSpec.numberOfDevices,
             m_memSpec.numberOfRanks,
-            m_memSpec.numberOfBanks
+            m_memSpec.numberOfBanks,
+            m_memSpec.banksPerGroup
         };
     }
 
 // Calculation
-    energy_t LPDDR4::calcCoreEnergyStats(const SimulationStats& stats) const {
+    template <typename Geometry>
+    energy_t BasicLPDDR4<Geometry>::calcCoreEnergyStats(const SimulationStats& stats) const {
         Calculation_LPDDR4 calculation(m_memSpec);
         return calculation.calcEnergy(stats);
     }
 
-    interface_energy_info_t LPDDR4::calcInterfaceEnergyStats(const SimulationStats& stats) const {
+    template <typename Geometry>
+    interface_energy_info_t BasicLPDDR4<Geometry>::calcInterfaceEnergyStats(const SimulationStats& stats) const {
         InterfaceCalculation_LPDDR4 interface_calc(m_memSpec);
         return interface_calc.calculateEnergy(stats);
     }
 
 // Stats
-    SimulationStats LPDDR4::getWindowStats(timestamp_t timestamp) {
+    template <typename Geometry>
+    SimulationStats BasicLPDDR4<Geometry>::getWindowStats(timestamp_t timestamp) {
         SimulationStats stats;
         m_core.getWindowStats(timestamp, stats);
         m_interface.getWindowStats(timestamp, stats);
@@ -58,14 +65,46 @@ namespace DRAMPower {
     }
 
 // Serialization
-    void LPDDR4::serialize_impl(std::ostream& stream) const {
+    template <typename Geometry>
+    void BasicLPDDR4<Geometry>::serialize_impl(std::ostream& stream) const {
         m_core.serialize(stream);
         m_interface.serialize(stream);
     }
 
-    void LPDDR4::deserialize_impl(std::istream& stream) {
+    template <typename Geometry>
+    void BasicLPDDR4<Geometry>::deserialize_impl(std::istream& stream) {
         m_core.deserialize(stream);
         m_interface.deserialize(stream);
     }
 
+    template <typename Geometry>
+    void BasicLPDDR4<Geometry>::serializeDelta_impl(std::ostream& stream) {
+        m_core.serializeDelta(stream);
+        m_interface.serializeDelta(stream);
+    }
+
+    template <typename Geometry>
+    void BasicLPDDR4<Geometry>::deserializeDelta_impl(std::istream& stream) {
+        m_core.deserializeDelta(stream);
+        m_interface.deserializeDelta(stream);
+    }
+
+    template <typename Geometry>
+    void BasicLPDDR4<Geometry>::clearDelta_impl() {
+        m_core.clearDelta();
+        m_interface.clearDelta();
+    }
+
+    template class BasicLPDDR4<DynamicGeometry>;
+    template class BasicLPDDR4<FixedGeometry<1, 8, 1>>;
+    template class BasicLPDDR4<FixedGeometry<2, 8, 1>>;
+
+// Factory
+    std::unique_ptr<dram_base<CmdType>> makeDRAM(const MemSpecLPDDR4 &memSpec, const config::SimConfig &simConfig) {
+        return dispatchGeometry(LPDDR4Geometries{}, memSpec.numberOfRanks, memSpec.numberOfBanks, memSpec.numberOfBankGroups,
+            [&memSpec, &simConfig](auto geometry) -> std::unique_ptr<dram_base<CmdType>> {
+                return std::make_unique<BasicLPDDR4<decltype(geometry)>>(memSpec, simConfig);
+            });
+    }
+
 } // namespace DRAMPower
@@ -16,28 +16,33 @@
 #include "DRAMPower/simconfig/simconfig.h"
 
 #include <algorithm>
+#include <memory>
 
 namespace DRAMPower {
 
-class LPDDR4 : public dram_base<CmdType>{
+template <typename Geometry = DynamicGeometry>
+class BasicLPDDR4 : public dram_base<CmdType> {
+// Friend classes
+friend struct StaticDispatch<BasicLPDDR4>;
+
 // public constructors and assignment operators
 public:
-    LPDDR4() = delete; // No default constructor
-    LPDDR4(const LPDDR4&) = default; // copy constructor
-    LPDDR4& operator=(const LPDDR4&) = default; // copy assignment operator
-    LPDDR4(LPDDR4&&) = default; // move constructor
-    LPDDR4& operator=(LPDDR4&&) = default; // move assignment operator
-    ~LPDDR4() override = default;
+    BasicLPDDR4() = delete; // No default constructor
+    BasicLPDDR4(const BasicLPDDR4&) = default; // copy constructor
+    BasicLPDDR4& operator=(const BasicLPDDR4&) = default; // copy assignment operator
+    BasicLPDDR4(BasicLPDDR4&&) = default; // move constructor
+    BasicLPDDR4& operator=(BasicLPDDR4&&) = default; // move assignment operator
+    ~BasicLPDDR4() override = default;
     
-    LPDDR4(const MemSpecLPDDR4& memSpec, const config::SimConfig &simConfig = {});
+    BasicLPDDR4(const MemSpecLPDDR4& memSpec, const config::SimConfig &simConfig = {});
 
 // Public member functions
 public:
 // Member functions
-    LPDDR4Core& getCore() {
+    BasicLPDDR4Core<Geometry>& getCore() {
         return m_core;
     }
-    const LPDDR4Core& getCore() const {
+    const BasicLPDDR4Core<Geometry>& getCore() const {
         return m_core;
     }
     LPDDR4Interface& getInterface() {
@@ -72,14 +77,23 @@ private:
     }
     void serialize_impl(std::ostream& stream) const override;
     void deserialize_impl(std::istream& stream) override;
+    void serializeDelta_impl(std::ostream& stream) override;
+    void deserializeDelta_impl(std::istream& stream) override;
+    void clearDelta_impl() override;
 
 // Private member variables
 private:
     MemSpecLPDDR4 m_memSpec;
     LPDDR4Interface m_interface;
-    LPDDR4Core m_core;
+    BasicLPDDR4Core<Geometry> m_core;
 };
 
+using LPDDR4 = BasicLPDDR4<DynamicGeometry>;
+
+// Creates a LPDDR4 with the fixed geometry core matching memSpec (see LPDDR4Geometries)
+// and a LPDDR4 sized at runtime otherwise
+std::unique_ptr<dram_base<CmdType>> makeDRAM(const MemSpecLPDDR4 &memSpec, const config::SimConfig &simConfig = {});
+
 } // namespace DRAMPower
 
 #endif /* DRAMPOWER_STANDARDS_LPDDR4_LPDDR4_H */
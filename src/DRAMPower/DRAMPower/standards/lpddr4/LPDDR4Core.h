@@ -4,22 +4,21 @@
 #include "DRAMPower/util/Deserialize.h"
 #include "DRAMPower/util/Serialize.h"
 #include <DRAMPower/Types.h>
+#include "DRAMPower/dram/Core.h"
+#include "DRAMPower/dram/Geometry.h"
 #include "DRAMPower/dram/Rank.h"
 #include "DRAMPower/command/Command.h"
 #include <DRAMPower/data/stats.h>
 #include <DRAMPower/util/ImplicitCommandHandler.h>
+#include <DRAMPower/util/delta_checkpoint.h>
 
 #include "DRAMPower/memspec/MemSpecLPDDR4.h"
 
+#include <utility>
 #include <vector>
 
 namespace DRAMPower {
 
-namespace internal {
-    template<typename Core>
-    class TestAccessor;
-}
-
 struct LPDDR4CoreMemSpec {
     LPDDR4CoreMemSpec(const MemSpecLPDDR4& memSpec)
         : numberOfBanks(memSpec.numberOfBanks)
@@ -45,56 +44,41 @@ struct LPDDR4CoreMemSpec {
     uint64_t prechargeOffsetWR;
 };
 
-class LPDDR4Core : public util::Serialize, public util::Deserialize {
-// Friend classes
-friend class internal::TestAccessor<LPDDR4Core>;
+// Commands and timings of the LPDDR4 core, see BasicCore
+struct LPDDR4CorePolicy {
+    using memspec_t = MemSpecLPDDR4;
+    using timings_t = LPDDR4CoreMemSpec;
+    using command_t = Command;
+
+    static constexpr bool perBankRefresh = true;     // REFB
+    static constexpr bool sameBankRefresh = false;   // REFSB, PRESB
+    static constexpr bool perTwoBankRefresh = false; // REFP2B
+    static constexpr bool dualBankRefresh = false;   // REFDB
+    static constexpr bool deepSleepMode = false;     // DSMEN, DSMEX
+    static constexpr PowerDownModel powerDownModel = PowerDownModel::InterruptedBanks;
+
+    static uint64_t tRFC(const timings_t& t) { return t.tRFC; }
+    static uint64_t tRFCbank(const timings_t& t) { return t.tRFCPB; }
+    static uint64_t tRCD(const timings_t& t) { return t.tRCD; }
+};
 
-// Public constructors amd assignment operators
-public:
-    LPDDR4Core(const MemSpecLPDDR4& memSpec)
-        : m_memSpec(memSpec)
-        , m_ranks(memSpec.numberOfRanks, {static_cast<std::size_t>(memSpec.numberOfBanks)})
-    {}
+// Ranks, banks and bank groups are sized by Geometry. DynamicGeometry sizes them from the memspec,
+// a FixedGeometry at compile time (see LPDDR4Geometries).
+template <typename Geometry = DynamicGeometry>
+using BasicLPDDR4Core = BasicCore<LPDDR4CorePolicy, Geometry>;
 
-// Public member functions
-public:
-// Member functions
-    void doCommand(const Command& cmd);
-    timestamp_t getLastCommandTime() const;
-    bool isSerializable() const;
-    void getWindowStats(timestamp_t timestamp, SimulationStats &stats);
-// Overrides
-    void serialize(std::ostream& stream) const override;
-    void deserialize(std::istream& stream) override;
-
-// Private member functions
-private:
-    void handleAct(Rank & rank, Bank & bank, timestamp_t timestamp);
-    void handlePre(Rank & rank, Bank & bank, timestamp_t timestamp);
-    void handlePreAll(Rank & rank, timestamp_t timestamp);
-    void handleRead(Rank & rank, Bank & bank, timestamp_t timestamp);
-    void handleWrite(Rank & rank, Bank & bank, timestamp_t timestamp);
-    void handleReadAuto(std::size_t rank_idx, std::size_t bank_idx, timestamp_t timestamp);
-    void handleWriteAuto(std::size_t rank_idx, std::size_t bank_idx, timestamp_t timestamp);
-    void handleRefAll(std::size_t rank_idx, timestamp_t timestamp);
-    void handleRefPerBank(std::size_t rank_idx, std::size_t bank_idx, timestamp_t timestamp);
-    void handleRefreshOnBank(std::size_t rank_idx, std::size_t bank_idx, timestamp_t timestamp, uint64_t timing, uint64_t & counter);
-    void handleSelfRefreshEntry(std::size_t rank_idx, timestamp_t timestamp);
-    void handleSelfRefreshExit(Rank & rank, timestamp_t timestamp);
-    void handlePowerDownActEntry(std::size_t rank_idx, timestamp_t timestamp);
-    void handlePowerDownActExit(std::size_t rank_idx, timestamp_t timestamp);
-    void handlePowerDownPreEntry(std::size_t rank_idx, timestamp_t timestamp);
-    void handlePowerDownPreExit(std::size_t rank_idx, timestamp_t timestamp);
-
-    timestamp_t earliestPossiblePowerDownEntryTime(Rank & rank) const;
-
-// Private member variables
-private:
-    LPDDR4CoreMemSpec m_memSpec;
-    std::vector<Rank> m_ranks;
-    ImplicitCommandHandler<LPDDR4Core> m_implicitCommandHandler;
-    timestamp_t m_last_command_time = 0;
-};
+using LPDDR4Core = BasicLPDDR4Core<DynamicGeometry>;
+
+// Fixed geometries (ranks, banks, bank groups) with a compiled core, see makeDRAM
+using LPDDR4Geometries = GeometryList<
+    FixedGeometry<1, 8, 1>,
+    FixedGeometry<2, 8, 1>
+>;
+
+// Compiled in LPDDR4Core.cpp
+extern template class BasicCore<LPDDR4CorePolicy, DynamicGeometry>;
+extern template class BasicCore<LPDDR4CorePolicy, FixedGeometry<1, 8, 1>>;
+extern template class BasicCore<LPDDR4CorePolicy, FixedGeometry<2, 8, 1>>;
 
 } // namespace DRAMPower
 
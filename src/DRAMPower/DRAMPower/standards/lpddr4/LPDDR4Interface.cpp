@@ -22,7 +22,8 @@ LPDDR4Interface::LPDDR4Interface(const MemSpecLPDDR4& memSpec, const config::Sim
             util::DataBusConfig {
                 memSpec.bitWidth * memSpec.numberOfDevices,
                 memSpec.dataRate,
-                simConfig.toggleRateDefinition.value_or(busConfig)
+                simConfig.toggleRateDefinition.value_or(busConfig),
+                simConfig.deviceBusStats.value_or(false) ? memSpec.bitWidth : 0
             },
             simConfig.toggleRateDefinition.has_value()
                 ? util::DataBusMode::TogglingRate
@@ -35,13 +36,16 @@ LPDDR4Interface::LPDDR4Interface(const MemSpecLPDDR4& memSpec, const config::Sim
         [this](timestamp_t load_timestamp, timestamp_t, std::size_t pin, bool inversion_state, bool read) {
         this->handleDBIPinChange(load_timestamp, pin, inversion_state, read);
     }, false)
-    , m_dbiread(m_dbi.getChunksPerWidth().value(), pin_dbi_t{m_dbi.getIdlePattern(), m_dbi.getIdlePattern()})
-    , m_dbiwrite(m_dbi.getChunksPerWidth().value(), pin_dbi_t{m_dbi.getIdlePattern(), m_dbi.getIdlePattern()})
+    , m_dbiread(m_dbi.getChunksPerWidth().value(), m_dbi.getIdlePattern(), m_dbi.getIdlePattern())
+    , m_dbiwrite(m_dbi.getChunksPerWidth().value(), m_dbi.getIdlePattern(), m_dbi.getIdlePattern())
     , m_patternHandler(PatternEncoderOverrides{
         {pattern_descriptor::C0, PatternEncoderBitSpec::L},
         {pattern_descriptor::C1, PatternEncoderBitSpec::L},
     })
 {
+    m_dbi.setBurstCallback([this](timestamp_t load_timestamp, const std::vector<uint64_t>& beat_masks, bool read) {
+        this->handleDBIBurst(load_timestamp, beat_masks, read);
+    });
     registerPatterns();
 }
 
@@ -119,6 +123,7 @@ void LPDDR4Interface::registerPatterns() {
     }
 
     void LPDDR4Interface::doCommand(const Command& cmd) {
+        m_deltaTracker.markCommand(cmd);
         switch(cmd.type) {
             case CmdType::ACT:
             case CmdType::PRE:
@@ -155,9 +160,17 @@ void LPDDR4Interface::registerPatterns() {
 void LPDDR4Interface::handleDBIPinChange(const timestamp_t load_timestamp, std::size_t pin, bool state, bool read) {
     assert(pin < m_dbiread.size() || pin < m_dbiwrite.size());
     if (read) {
-        this->m_dbiread[pin].set(load_timestamp, state ? util::PinState::H : util::PinState::L, 1);
+        this->m_dbiread.set_pin(pin, load_timestamp, state ? util::PinState::H : util::PinState::L, 1);
     } else {
-        this->m_dbiwrite[pin].set(load_timestamp, state ? util::PinState::H : util::PinState::L, 1);
+        this->m_dbiwrite.set_pin(pin, load_timestamp, state ? util::PinState::H : util::PinState::L, 1);
+    }
+}
+
+void LPDDR4Interface::handleDBIBurst(const timestamp_t load_timestamp, const std::vector<uint64_t>& beat_masks, bool read) {
+    auto &pins = read ? m_dbiread : m_dbiwrite;
+    // One bit-plane per beat
+    for (const uint64_t mask : beat_masks) {
+        pins.set(load_timestamp, mask, 1);
     }
 }
 
@@ -248,17 +261,20 @@ void LPDDR4Interface::getWindowStats(timestamp_t timestamp, SimulationStats &sta
         stats.togglingStats.read,
         stats.togglingStats.write
     );
+    m_dataBus.get_toggling_activity(timestamp,
+        stats.togglingStats.readActivity,
+        stats.togglingStats.writeActivity
+    );
 
     stats.clockStats = 2 * m_clock.get_stats_at(timestamp);
     stats.readDQSStats = 2 * m_readDQS.get_stats_at(timestamp);
     stats.writeDQSStats = 2 * m_writeDQS.get_stats_at(timestamp);
 
-    for (const auto &dbi_pin : m_dbiread) {
-        stats.readDBI += dbi_pin.get_stats_at(timestamp, 2);
-    }
-    for (const auto &dbi_pin : m_dbiwrite) {
-        stats.writeDBI += dbi_pin.get_stats_at(timestamp, 2);
-    }
+    stats.readDBI += m_dbiread.get_stats_at(timestamp, 2);
+    stats.writeDBI += m_dbiwrite.get_stats_at(timestamp, 2);
+
+    util::addDeviceBusStats(m_dataBus, timestamp, stats.devices);
+    util::addDeviceDBIStats(m_dbiread, m_dbiwrite, timestamp, 2, stats.devices);
 
     if (m_memSpec.bitWidth == 16) {
         stats.readDQSStats *= 2;
@@ -285,5 +301,42 @@ void LPDDR4Interface::deserialize(std::istream& stream) {
     m_clock.deserialize(stream);
 }
 
+void LPDDR4Interface::serializeDelta(std::ostream& stream) {
+    m_deltaTracker.serialize(stream);
+    stream.write(reinterpret_cast<const char*>(&m_last_command_time), sizeof(m_last_command_time));
+    m_patternHandler.serialize(stream);
+    if (m_deltaTracker.commandBus) {
+        m_commandBus.serialize(stream);
+    }
+    if (m_deltaTracker.dataBus) {
+        m_dataBus.serialize(stream);
+    }
+    m_readDQS.serialize(stream);
+    m_writeDQS.serialize(stream);
+    m_clock.serialize(stream);
+    m_deltaTracker.clear();
+}
+
+void LPDDR4Interface::deserializeDelta(std::istream& stream) {
+    util::InterfaceDeltaTracker delta;
+    delta.deserialize(stream);
+    stream.read(reinterpret_cast<char*>(&m_last_command_time), sizeof(m_last_command_time));
+    m_patternHandler.deserialize(stream);
+    if (delta.commandBus) {
+        m_commandBus.deserialize(stream);
+    }
+    if (delta.dataBus) {
+        m_dataBus.deserialize(stream);
+    }
+    m_readDQS.deserialize(stream);
+    m_writeDQS.deserialize(stream);
+    m_clock.deserialize(stream);
+    m_deltaTracker.clear();
+}
+
+void LPDDR4Interface::clearDelta() {
+    m_deltaTracker.clear();
+}
+
 
 } // namespace DRAMPower
\ No newline at end of file
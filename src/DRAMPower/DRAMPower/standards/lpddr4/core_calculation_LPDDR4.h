@@ -13,8 +13,6 @@
 namespace DRAMPower 
 {
 
-class LPDDR4;
-
 class Calculation_LPDDR4
 {
 public:
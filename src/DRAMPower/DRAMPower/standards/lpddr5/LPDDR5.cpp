@@ -13,7 +13,8 @@
 
 namespace DRAMPower {
 
-    LPDDR5::LPDDR5(const MemSpecLPDDR5 &memSpec, const config::SimConfig& simConfig)
+    template <typename Geometry>
+    BasicLPDDR5<Geometry>::BasicLPDDR5(const MemSpecLPDDR5 &memSpec, const config::SimConfig& simConfig)
         : m_memSpec(memSpec)
         , m_interface(m_memSpec, simConfig)
         , m_core(m_memSpec)
@@ -22,7 +23,8 @@ namespace DRAMPower {
     }
 
 // Extensions
-    void LPDDR5::registerExtensions() {
+    template <typename Geometry>
+    void BasicLPDDR5<Geometry>::registerExtensions() {
         getExtensionManager().registerExtension<extensions::DBI>([this](const timestamp_t, const bool enable){
             // Assumption: the enabling of the DBI does not interleave with previous data on the bus
             m_interface.enableDBI(enable);
@@ -31,27 +33,32 @@ namespace DRAMPower {
     }
 
 // Getters for CLI
-    util::CLIArchitectureConfig LPDDR5::getCLIArchitectureConfig() {
+    template <typename Geometry>
+    util::CLIArchitectureConfig BasicLPDDR5<Geometry>::getCLIArchitectureConfig() {
         return util::CLIArchitectureConfig{
             m_memSpec.numberOfDevices,
             m_memSpec.numberOfRanks,
-            m_memSpec.numberOfBanks
+            m_memSpec.numberOfBanks,
+            m_memSpec.banksPerGroup
         };
     }
 
 // Calculation
-    energy_t LPDDR5::calcCoreEnergyStats(const SimulationStats& stats) const {
+    template <typename Geometry>
+    energy_t BasicLPDDR5<Geometry>::calcCoreEnergyStats(const SimulationStats& stats) const {
         Calculation_LPDDR5 calculation(m_memSpec);
         return calculation.calcEnergy(stats);
     }
 
-    interface_energy_info_t LPDDR5::calcInterfaceEnergyStats(const SimulationStats& stats) const {
+    template <typename Geometry>
+    interface_energy_info_t BasicLPDDR5<Geometry>::calcInterfaceEnergyStats(const SimulationStats& stats) const {
         InterfaceCalculation_LPDDR5 calculation(m_memSpec);
         return calculation.calculateEnergy(stats);
     }
 
 // Stats
-    SimulationStats LPDDR5::getWindowStats(timestamp_t timestamp) {
+    template <typename Geometry>
+    SimulationStats BasicLPDDR5<Geometry>::getWindowStats(timestamp_t timestamp) {
         SimulationStats stats;
         m_core.getWindowStats(timestamp, stats);
         m_interface.getWindowStats(timestamp, stats);
@@ -59,15 +66,49 @@ namespace DRAMPower {
     }
 
 // Serialization
-    void LPDDR5::serialize_impl(std::ostream& stream) const {
+    template <typename Geometry>
+    void BasicLPDDR5<Geometry>::serialize_impl(std::ostream& stream) const {
         m_core.serialize(stream);
         m_interface.serialize(stream);
     }
 
-    void LPDDR5::deserialize_impl(std::istream& stream) {
+    template <typename Geometry>
+    void BasicLPDDR5<Geometry>::deserialize_impl(std::istream& stream) {
         m_core.deserialize(stream);
         m_interface.deserialize(stream);
     }
 
+    template <typename Geometry>
+    void BasicLPDDR5<Geometry>::serializeDelta_impl(std::ostream& stream) {
+        m_core.serializeDelta(stream);
+        m_interface.serializeDelta(stream);
+    }
+
+    template <typename Geometry>
+    void BasicLPDDR5<Geometry>::deserializeDelta_impl(std::istream& stream) {
+        m_core.deserializeDelta(stream);
+        m_interface.deserializeDelta(stream);
+    }
+
+    template <typename Geometry>
+    void BasicLPDDR5<Geometry>::clearDelta_impl() {
+        m_core.clearDelta();
+        m_interface.clearDelta();
+    }
+
+
+    template class BasicLPDDR5<DynamicGeometry>;
+    template class BasicLPDDR5<FixedGeometry<1, 16, 4>>;
+    template class BasicLPDDR5<FixedGeometry<2, 16, 4>>;
+    template class BasicLPDDR5<FixedGeometry<1, 16, 1>>;
+    template class BasicLPDDR5<FixedGeometry<1, 8, 1>>;
+
+// Factory
+    std::unique_ptr<dram_base<CmdType>> makeDRAM(const MemSpecLPDDR5 &memSpec, const config::SimConfig &simConfig) {
+        return dispatchGeometry(LPDDR5Geometries{}, memSpec.numberOfRanks, memSpec.numberOfBanks, memSpec.numberOfBankGroups,
+            [&memSpec, &simConfig](auto geometry) -> std::unique_ptr<dram_base<CmdType>> {
+                return std::make_unique<BasicLPDDR5<decltype(geometry)>>(memSpec, simConfig);
+            });
+    }
 
 } // namespace DRAMPower
@@ -16,27 +16,32 @@
 #include "DRAMPower/simconfig/simconfig.h"
 
 #include <algorithm>
+#include <memory>
 
 namespace DRAMPower {
 
-class LPDDR5 : public dram_base<CmdType> {
+template <typename Geometry = DynamicGeometry>
+class BasicLPDDR5 : public dram_base<CmdType> {
+// Friend classes
+friend struct StaticDispatch<BasicLPDDR5>;
+
 // Public constructors and assignment operators
 public:
-    LPDDR5() = delete; // No default constructor
-    LPDDR5(const LPDDR5&) = default; // copy constructor
-    LPDDR5& operator=(const LPDDR5&) = default; // copy assignment operator
-    LPDDR5(LPDDR5&&) = default; // move constructor
-    LPDDR5& operator=(LPDDR5&&) = default; // move assignment operator
-    ~LPDDR5() override = default;
-    LPDDR5(const MemSpecLPDDR5& memSpec, const config::SimConfig& simConfig = {});
+    BasicLPDDR5() = delete; // No default constructor
+    BasicLPDDR5(const BasicLPDDR5&) = default; // copy constructor
+    BasicLPDDR5& operator=(const BasicLPDDR5&) = default; // copy assignment operator
+    BasicLPDDR5(BasicLPDDR5&&) = default; // move constructor
+    BasicLPDDR5& operator=(BasicLPDDR5&&) = default; // move assignment operator
+    ~BasicLPDDR5() override = default;
+    BasicLPDDR5(const MemSpecLPDDR5& memSpec, const config::SimConfig& simConfig = {});
 
 // Public member functions
 public:
 // Member functions
-    LPDDR5Core& getCore() {
+    BasicLPDDR5Core<Geometry>& getCore() {
         return m_core;
     }
-    const LPDDR5Core& getCore() const {
+    const BasicLPDDR5Core<Geometry>& getCore() const {
         return m_core;
     }
     LPDDR5Interface& getInterface() {
@@ -70,14 +75,23 @@ private:
     }
     void serialize_impl(std::ostream& stream) const override;
     void deserialize_impl(std::istream& stream) override;
+    void serializeDelta_impl(std::ostream& stream) override;
+    void deserializeDelta_impl(std::istream& stream) override;
+    void clearDelta_impl() override;
 
 // Private member variables
 private:
     MemSpecLPDDR5 m_memSpec;
     LPDDR5Interface m_interface;
-    LPDDR5Core m_core;
+    BasicLPDDR5Core<Geometry> m_core;
 };
 
+using LPDDR5 = BasicLPDDR5<DynamicGeometry>;
+
+// Creates a LPDDR5 with the fixed geometry core matching memSpec (see LPDDR5Geometries)
+// and a LPDDR5 sized at runtime otherwise
+std::unique_ptr<dram_base<CmdType>> makeDRAM(const MemSpecLPDDR5 &memSpec, const config::SimConfig &simConfig = {});
+
 }  // namespace DRAMPower
 
 #endif /* DRAMPOWER_STANDARDS_LPDDR5_LPDDR5_H */
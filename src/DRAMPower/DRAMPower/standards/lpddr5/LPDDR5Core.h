@@ -4,22 +4,21 @@
 #include "DRAMPower/util/Deserialize.h"
 #include "DRAMPower/util/Serialize.h"
 #include <DRAMPower/Types.h>
+#include "DRAMPower/dram/Core.h"
+#include "DRAMPower/dram/Geometry.h"
 #include "DRAMPower/dram/Rank.h"
 #include "DRAMPower/command/Command.h"
 #include <DRAMPower/data/stats.h>
 #include "DRAMPower/util/ImplicitCommandHandler.h"
+#include "DRAMPower/util/delta_checkpoint.h"
 
 #include "DRAMPower/memspec/MemSpecLPDDR5.h"
 
+#include <utility>
 #include <vector>
 
 namespace DRAMPower {
 
-namespace internal {
-    template<typename Core>
-    class TestAccessor;
-}
-
 struct LPDDR5CoreMemSpec {
     LPDDR5CoreMemSpec(const MemSpecLPDDR5& memSpec)
         : numberOfBanks(memSpec.numberOfBanks)
@@ -49,61 +48,49 @@ struct LPDDR5CoreMemSpec {
     uint64_t prechargeOffsetWR;
 };
 
-class LPDDR5Core : public util::Serialize, public util::Deserialize {
-// Friend classes
-friend class internal::TestAccessor<LPDDR5Core>;
-
-// Public constructors
-public:
-    LPDDR5Core(const MemSpecLPDDR5& memSpec)
-        : m_memSpec(memSpec)
-        , m_ranks(memSpec.numberOfRanks, {static_cast<std::size_t>(memSpec.numberOfBanks)})
-    {}
-
-// Public member functions
-public:
-// Member functions
-    void doCommand(const Command& cmd);
-    timestamp_t getLastCommandTime() const;
-    bool isSerializable() const;
-    void getWindowStats(timestamp_t timestamp, SimulationStats &stats);
-// Overrides
-    void serialize(std::ostream& stream) const override;
-    void deserialize(std::istream& stream) override;
-
-// Private member functions
-private:
-    void handleAct(Rank& rank, Bank& bank, timestamp_t timestamp);
-    void handlePre(Rank& rank, Bank& bank, timestamp_t timestamp);
-    void handlePreAll(Rank& rank, timestamp_t timestamp);
-    void handleRead(Rank& rank, Bank& bank, timestamp_t timestamp);
-    void handleWrite(Rank& rank, Bank& bank, timestamp_t timestamp);
-    void handleReadAuto(std::size_t rank_idx, std::size_t bank_idx, timestamp_t timestamp);
-    void handleWriteAuto(std::size_t rank_idx, std::size_t bank_idx, timestamp_t timestamp);
-    void handleRefAll(std::size_t rank_idx, timestamp_t timestamp);
-    void handleRefPerBank(std::size_t rank_idx, std::size_t bank_idx, timestamp_t timestamp);
-    void handleRefPerTwoBanks(std::size_t rank_idx, std::size_t bank_id, timestamp_t timestamp);
-    void handleRefreshOnBank(std::size_t rank_idx, std::size_t bank_idx, timestamp_t timestamp, uint64_t timing,
-                             uint64_t& counter);
-    void handleSelfRefreshEntry(std::size_t rank_idx, timestamp_t timestamp);
-    void handleSelfRefreshExit(Rank& rank, timestamp_t timestamp);
-    void handlePowerDownActEntry(std::size_t rank_idx, timestamp_t timestamp);
-    void handlePowerDownActExit(std::size_t rank_idx, timestamp_t timestamp);
-    void handlePowerDownPreEntry(std::size_t rank_idx, timestamp_t timestamp);
-    void handlePowerDownPreExit(std::size_t rank_idx, timestamp_t timestamp);
-    void handleDSMEntry(Rank& rank, timestamp_t timestamp);
-    void handleDSMExit(Rank& rank, timestamp_t timestamp);
-
-    timestamp_t earliestPossiblePowerDownEntryTime(Rank & rank) const;
-
-// Private member variables
-private:
-    LPDDR5CoreMemSpec m_memSpec;
-    std::vector<Rank> m_ranks;
-    ImplicitCommandHandler<LPDDR5Core> m_implicitCommandHandler;
-    timestamp_t m_last_command_time = 0;
+// Commands and timings of the LPDDR5 core, see BasicCore
+struct LPDDR5CorePolicy {
+    using memspec_t = MemSpecLPDDR5;
+    using timings_t = LPDDR5CoreMemSpec;
+    using command_t = Command;
+
+    static constexpr bool perBankRefresh = true;     // REFB
+    static constexpr bool sameBankRefresh = false;   // REFSB, PRESB
+    static constexpr bool perTwoBankRefresh = true;  // REFP2B
+    static constexpr bool dualBankRefresh = false;   // REFDB
+    static constexpr bool deepSleepMode = true;      // DSMEN, DSMEX
+    static constexpr PowerDownModel powerDownModel = PowerDownModel::InterruptedBanks;
+
+    static uint64_t tRFC(const timings_t& t) { return t.tRFC; }
+    static uint64_t tRFCbank(const timings_t& t) { return t.tRFCPB; }
+    static uint64_t tRCD(const timings_t& t) { return t.tRCD; }
+    static bool supportsPerTwoBankRefresh(const timings_t& t) {
+        return t.bank_arch == MemSpecLPDDR5::MBG || t.bank_arch == MemSpecLPDDR5::M16B;
+    }
 };
 
+// Ranks, banks and bank groups are sized by Geometry. DynamicGeometry sizes them from the memspec,
+// a FixedGeometry at compile time (see LPDDR5Geometries).
+template <typename Geometry = DynamicGeometry>
+using BasicLPDDR5Core = BasicCore<LPDDR5CorePolicy, Geometry>;
+
+using LPDDR5Core = BasicLPDDR5Core<DynamicGeometry>;
+
+// Fixed geometries (ranks, banks, bank groups) with a compiled core, see makeDRAM
+using LPDDR5Geometries = GeometryList<
+    FixedGeometry<1, 16, 4>,
+    FixedGeometry<2, 16, 4>,
+    FixedGeometry<1, 16, 1>,
+    FixedGeometry<1, 8, 1>
+>;
+
+// Compiled in LPDDR5Core.cpp
+extern template class BasicCore<LPDDR5CorePolicy, DynamicGeometry>;
+extern template class BasicCore<LPDDR5CorePolicy, FixedGeometry<1, 16, 4>>;
+extern template class BasicCore<LPDDR5CorePolicy, FixedGeometry<2, 16, 4>>;
+extern template class BasicCore<LPDDR5CorePolicy, FixedGeometry<1, 16, 1>>;
+extern template class BasicCore<LPDDR5CorePolicy, FixedGeometry<1, 8, 1>>;
+
 } // namespace DRAMPower
 
 #endif /* DRAMPOWER_STANDARDS_LPDDR5_LPDDR5CORE_H */
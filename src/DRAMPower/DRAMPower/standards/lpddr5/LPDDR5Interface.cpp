@@ -21,7 +21,8 @@ LPDDR5Interface::LPDDR5Interface(const MemSpecLPDDR5& memSpec, const config::Sim
             util::DataBusConfig {
                 memSpec.bitWidth * memSpec.numberOfDevices,
                 memSpec.dataRate,
-                simConfig.toggleRateDefinition.value_or(busConfig)
+                simConfig.toggleRateDefinition.value_or(busConfig),
+                simConfig.deviceBusStats.value_or(false) ? memSpec.bitWidth : 0
             },
             simConfig.toggleRateDefinition.has_value()
                 ? util::DataBusMode::TogglingRate
@@ -34,10 +35,13 @@ LPDDR5Interface::LPDDR5Interface(const MemSpecLPDDR5& memSpec, const config::Sim
         [this](timestamp_t load_timestamp, timestamp_t, std::size_t pin, bool inversion_state, bool read) {
         this->handleDBIPinChange(load_timestamp, pin, inversion_state, read);
     }, false)
-    , m_dbiread(m_dbi.getChunksPerWidth().value(), pin_dbi_t{m_dbi.getIdlePattern(), m_dbi.getIdlePattern()})
-    , m_dbiwrite(m_dbi.getChunksPerWidth().value(), pin_dbi_t{m_dbi.getIdlePattern(), m_dbi.getIdlePattern()})
+    , m_dbiread(m_dbi.getChunksPerWidth().value(), m_dbi.getIdlePattern(), m_dbi.getIdlePattern())
+    , m_dbiwrite(m_dbi.getChunksPerWidth().value(), m_dbi.getIdlePattern(), m_dbi.getIdlePattern())
     , m_patternHandler(PatternEncoderOverrides{}) // No overrides
 {
+    m_dbi.setBurstCallback([this](timestamp_t load_timestamp, const std::vector<uint64_t>& beat_masks, bool read) {
+        this->handleDBIBurst(load_timestamp, beat_masks, read);
+    });
     registerPatterns();
 }
 
@@ -244,6 +248,7 @@ timestamp_t LPDDR5Interface::getLastCommandTime() const {
 }
 
 void LPDDR5Interface::doCommand(const Command& cmd) {
+    m_deltaTracker.markCommand(cmd);
     switch(cmd.type) {
         case CmdType::ACT:
         case CmdType::PRE:
@@ -287,9 +292,17 @@ void LPDDR5Interface::doCommand(const Command& cmd) {
 void LPDDR5Interface::handleDBIPinChange(const timestamp_t load_timestamp, std::size_t pin, bool state, bool read) {
     assert(pin < m_dbiread.size() || pin < m_dbiwrite.size());
     if (read) {
-        this->m_dbiread[pin].set(load_timestamp, state ? util::PinState::H : util::PinState::L, 1);
+        this->m_dbiread.set_pin(pin, load_timestamp, state ? util::PinState::H : util::PinState::L, 1);
     } else {
-        this->m_dbiwrite[pin].set(load_timestamp, state ? util::PinState::H : util::PinState::L, 1);
+        this->m_dbiwrite.set_pin(pin, load_timestamp, state ? util::PinState::H : util::PinState::L, 1);
+    }
+}
+
+void LPDDR5Interface::handleDBIBurst(const timestamp_t load_timestamp, const std::vector<uint64_t>& beat_masks, bool read) {
+    auto &pins = read ? m_dbiread : m_dbiwrite;
+    // One bit-plane per beat
+    for (const uint64_t mask : beat_masks) {
+        pins.set(load_timestamp, mask, 1);
     }
 }
 
@@ -379,17 +392,20 @@ void LPDDR5Interface::getWindowStats(timestamp_t timestamp, SimulationStats &sta
         stats.togglingStats.read,
         stats.togglingStats.write
     );
+    m_dataBus.get_toggling_activity(timestamp,
+        stats.togglingStats.readActivity,
+        stats.togglingStats.writeActivity
+    );
 
     stats.clockStats = 2.0 * m_clock.get_stats_at(timestamp);
     stats.wClockStats = 2.0 * m_wck.get_stats_at(timestamp);
     stats.readDQSStats = 2.0 * m_readDQS.get_stats_at(timestamp);
 
-    for (const auto &dbi_pin : m_dbiread) {
-        stats.readDBI += dbi_pin.get_stats_at(timestamp, 2);
-    }
-    for (const auto &dbi_pin : m_dbiwrite) {
-        stats.writeDBI += dbi_pin.get_stats_at(timestamp, 2);
-    }
+    stats.readDBI += m_dbiread.get_stats_at(timestamp, 2);
+    stats.writeDBI += m_dbiwrite.get_stats_at(timestamp, 2);
+
+    util::addDeviceBusStats(m_dataBus, timestamp, stats.devices);
+    util::addDeviceDBIStats(m_dbiread, m_dbiwrite, timestamp, 2, stats.devices);
 }
 
 void LPDDR5Interface::serialize(std::ostream& stream) const {
@@ -411,4 +427,41 @@ void LPDDR5Interface::deserialize(std::istream& stream) {
     m_clock.deserialize(stream);
 }
 
+void LPDDR5Interface::serializeDelta(std::ostream& stream) {
+    m_deltaTracker.serialize(stream);
+    stream.write(reinterpret_cast<const char*>(&m_last_command_time), sizeof(m_last_command_time));
+    m_patternHandler.serialize(stream);
+    if (m_deltaTracker.commandBus) {
+        m_commandBus.serialize(stream);
+    }
+    if (m_deltaTracker.dataBus) {
+        m_dataBus.serialize(stream);
+    }
+    m_readDQS.serialize(stream);
+    m_wck.serialize(stream);
+    m_clock.serialize(stream);
+    m_deltaTracker.clear();
+}
+
+void LPDDR5Interface::deserializeDelta(std::istream& stream) {
+    util::InterfaceDeltaTracker delta;
+    delta.deserialize(stream);
+    stream.read(reinterpret_cast<char*>(&m_last_command_time), sizeof(m_last_command_time));
+    m_patternHandler.deserialize(stream);
+    if (delta.commandBus) {
+        m_commandBus.deserialize(stream);
+    }
+    if (delta.dataBus) {
+        m_dataBus.deserialize(stream);
+    }
+    m_readDQS.deserialize(stream);
+    m_wck.deserialize(stream);
+    m_clock.deserialize(stream);
+    m_deltaTracker.clear();
+}
+
+void LPDDR5Interface::clearDelta() {
+    m_deltaTracker.clear();
+}
+
 } // namespace DRAMPower
\ No newline at end of file
@@ -1,9 +1,10 @@
 #ifndef DRAMPOWER_STANDARDS_LPDDR5_LPDDR5INTERFACE_H
 #define DRAMPOWER_STANDARDS_LPDDR5_LPDDR5INTERFACE_H
 
-#include "DRAMPower/util/pin.h"
+#include "DRAMPower/util/pin_group.h"
 #include "DRAMPower/util/bus.h"
 #include "DRAMPower/util/databus_presets.h"
+#include "DRAMPower/util/device_stats.h"
 #include "DRAMPower/util/clock.h"
 #include "DRAMPower/util/Serialize.h"
 #include "DRAMPower/util/Deserialize.h"
@@ -14,6 +15,7 @@
 
 #include "DRAMPower/util/PatternHandler.h"
 #include "DRAMPower/util/dbi.h"
+#include "DRAMPower/util/delta_checkpoint.h"
 
 #include "DRAMPower/memspec/MemSpecLPDDR5.h"
 
@@ -49,8 +51,8 @@ public:
 
 // Public type definitions
 public:
-    using commandbus_t = util::Bus<cmdBusWidth>;
-    using pin_dbi_t = util::Pin<32>; // max_burst_length = 32
+    using commandbus_t = util::Bus;
+    using pin_dbi_t = util::PinGroup<32>; // max_burst_length = 32
     using databus_t = util::databus_presets::databus_preset_t;
     using patternHandler_t = PatternHandler<CmdType>;
 
@@ -67,6 +69,10 @@ public:
 // Override
     void serialize(std::ostream& stream) const override;
     void deserialize(std::istream& stream) override;
+    // Delta checkpoints
+    void serializeDelta(std::ostream& stream);
+    void deserializeDelta(std::istream& stream);
+    void clearDelta();
 // Extensions
     void enableDBI(bool enable) {
         m_dbi.enable(enable);
@@ -77,6 +83,7 @@ private:
     void registerPatterns();
     std::optional<const uint8_t *> handleDBIInterface(timestamp_t timestamp, std::size_t n_bits, const uint8_t* data, bool read);
     void handleDBIPinChange(const timestamp_t load_timestamp, std::size_t pin, bool state, bool read);
+    void handleDBIBurst(const timestamp_t load_timestamp, const std::vector<uint64_t>& beat_masks, bool read);
     void handleOverrides(size_t length, bool read);
     void handleDQs(const Command& cmd, util::Clock &dqs, size_t length, uint64_t datarate);
     void handleCommandBus(const Command& cmd);
@@ -92,10 +99,11 @@ private:
     util::Clock m_wck;
     util::Clock m_clock;
     util::DBI<uint8_t, 1, util::PinState::L, util::StaticDBI> m_dbi;
-    std::vector<pin_dbi_t> m_dbiread;
-    std::vector<pin_dbi_t> m_dbiwrite;
+    pin_dbi_t m_dbiread;
+    pin_dbi_t m_dbiwrite;
     patternHandler_t m_patternHandler;
     timestamp_t m_last_command_time = 0;
+    util::InterfaceDeltaTracker m_deltaTracker;
 };
 
 } // namespace DRAMPower
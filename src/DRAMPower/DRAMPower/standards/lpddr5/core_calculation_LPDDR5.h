@@ -14,8 +14,6 @@
 namespace DRAMPower
 {
 
-    class LPDDR5;
-
     class Calculation_LPDDR5
     {
     public:
@@ -13,7 +13,8 @@ namespace DRAMPower {
 
     using namespace DRAMUtils::Config;
 
-    LPDDR6::LPDDR6(const MemSpecLPDDR6 &memSpec, const config::SimConfig &simConfig)
+    template <typename Geometry>
+    BasicLPDDR6<Geometry>::BasicLPDDR6(const MemSpecLPDDR6 &memSpec, const config::SimConfig &simConfig)
         : m_memSpec(memSpec)
         , m_interface(m_memSpec, simConfig)
         , m_core(m_memSpec)
@@ -22,7 +23,8 @@ namespace DRAMPower {
     }
 
 // Extensions
-    void LPDDR6::registerExtensions() {
+    template <typename Geometry>
+    void BasicLPDDR6<Geometry>::registerExtensions() {
         getExtensionManager().registerExtension<extensions::DBI>([this](const timestamp_t, const bool enable) -> bool {
             // Assumption: the enabling of the DBI does not interleave with previous data on the bus
             m_interface.enableDBI(enable);
@@ -37,27 +39,32 @@ namespace DRAMPower {
     }
 
 // Getters for CLI
-    util::CLIArchitectureConfig LPDDR6::getCLIArchitectureConfig() {
+    template <typename Geometry>
+    util::CLIArchitectureConfig BasicLPDDR6<Geometry>::getCLIArchitectureConfig() {
         return util::CLIArchitectureConfig{
             m_memSpec.numberOfDevices,
             m_memSpec.numberOfRanks,
-            m_memSpec.numberOfBanks
+            m_memSpec.numberOfBanks,
+            m_memSpec.banksPerGroup
         };
     }
 
 // Calculation
-    energy_t LPDDR6::calcCoreEnergyStats(const SimulationStats& stats) const {
+    template <typename Geometry>
+    energy_t BasicLPDDR6<Geometry>::calcCoreEnergyStats(const SimulationStats& stats) const {
         Calculation_LPDDR6 calculation(m_memSpec);
         return calculation.calcEnergy(stats);
     }
 
-    interface_energy_info_t LPDDR6::calcInterfaceEnergyStats(const SimulationStats& stats) const {
+    template <typename Geometry>
+    interface_energy_info_t BasicLPDDR6<Geometry>::calcInterfaceEnergyStats(const SimulationStats& stats) const {
         InterfaceCalculation_LPDDR6 calculation(m_memSpec);
         return calculation.calculateEnergy(stats);
     }
 
 // Stats
-    SimulationStats LPDDR6::getWindowStats(timestamp_t timestamp) {
+    template <typename Geometry>
+    SimulationStats BasicLPDDR6<Geometry>::getWindowStats(timestamp_t timestamp) {
         SimulationStats stats;
         m_core.getWindowStats(timestamp, stats);
         m_interface.getWindowStats(timestamp, stats);
@@ -65,14 +72,46 @@ namespace DRAMPower {
     }
 
 // Serialization
-    void LPDDR6::serialize_impl(std::ostream& stream) const {
+    template <typename Geometry>
+    void BasicLPDDR6<Geometry>::serialize_impl(std::ostream& stream) const {
         m_core.serialize(stream);
         m_interface.serialize(stream);
     }
 
-    void LPDDR6::deserialize_impl(std::istream& stream) {
+    template <typename Geometry>
+    void BasicLPDDR6<Geometry>::deserialize_impl(std::istream& stream) {
         m_core.deserialize(stream);
         m_interface.deserialize(stream);
     }
 
+    template <typename Geometry>
+    void BasicLPDDR6<Geometry>::serializeDelta_impl(std::ostream& stream) {
+        m_core.serializeDelta(stream);
+        m_interface.serializeDelta(stream);
+    }
+
+    template <typename Geometry>
+    void BasicLPDDR6<Geometry>::deserializeDelta_impl(std::istream& stream) {
+        m_core.deserializeDelta(stream);
+        m_interface.deserializeDelta(stream);
+    }
+
+    template <typename Geometry>
+    void BasicLPDDR6<Geometry>::clearDelta_impl() {
+        m_core.clearDelta();
+        m_interface.clearDelta();
+    }
+
+    template class BasicLPDDR6<DynamicGeometry>;
+    template class BasicLPDDR6<FixedGeometry<1, 16, 4>>;
+    template class BasicLPDDR6<FixedGeometry<2, 16, 4>>;
+
+// Factory
+    std::unique_ptr<dram_base<CmdType>> makeDRAM(const MemSpecLPDDR6 &memSpec, const config::SimConfig &simConfig) {
+        return dispatchGeometry(LPDDR6Geometries{}, memSpec.numberOfRanks, memSpec.numberOfBanks, memSpec.numberOfBankGroups,
+            [&memSpec, &simConfig](auto geometry) -> std::unique_ptr<dram_base<CmdType>> {
+                return std::make_unique<BasicLPDDR6<decltype(geometry)>>(memSpec, simConfig);
+            });
+    }
+
 } // namespace DRAMPower
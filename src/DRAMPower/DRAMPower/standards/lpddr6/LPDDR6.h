@@ -14,27 +14,32 @@
 #include "DRAMPower/util/cli_architecture_config.h"
 
 #include <algorithm>
+#include <memory>
 
 namespace DRAMPower {
 
-class LPDDR6 : public dram_base<CmdType> {
+template <typename Geometry = DynamicGeometry>
+class BasicLPDDR6 : public dram_base<CmdType> {
+// Friend classes
+friend struct StaticDispatch<BasicLPDDR6>;
+
 // Public constructors and assignment operators
 public:
-    LPDDR6() = delete; // No default constructor
-    LPDDR6(const LPDDR6&) = default; // copy constructor
-    LPDDR6& operator=(const LPDDR6&) = default; // copy assignment operator
-    LPDDR6(LPDDR6&&) = default; // move constructor
-    LPDDR6& operator=(LPDDR6&&) = default; // move assignment operator
-    ~LPDDR6() override = default;
-    LPDDR6(const MemSpecLPDDR6& memSpec, const config::SimConfig &simConfig = {});
+    BasicLPDDR6() = delete; // No default constructor
+    BasicLPDDR6(const BasicLPDDR6&) = default; // copy constructor
+    BasicLPDDR6& operator=(const BasicLPDDR6&) = default; // copy assignment operator
+    BasicLPDDR6(BasicLPDDR6&&) = default; // move constructor
+    BasicLPDDR6& operator=(BasicLPDDR6&&) = default; // move assignment operator
+    ~BasicLPDDR6() override = default;
+    BasicLPDDR6(const MemSpecLPDDR6& memSpec, const config::SimConfig &simConfig = {});
 
 // Public member functions
 public:
 // Member functions
-    LPDDR6Core& getCore() {
+    BasicLPDDR6Core<Geometry>& getCore() {
         return m_core;
     }
-    const LPDDR6Core& getCore() const {
+    const BasicLPDDR6Core<Geometry>& getCore() const {
         return m_core;
     }
     LPDDR6Interface& getInterface() {
@@ -68,14 +73,23 @@ private:
     }
     void serialize_impl(std::ostream& stream) const override;
     void deserialize_impl(std::istream& stream) override;
+    void serializeDelta_impl(std::ostream& stream) override;
+    void deserializeDelta_impl(std::istream& stream) override;
+    void clearDelta_impl() override;
 
 // Private member variables
 private:
     MemSpecLPDDR6 m_memSpec;
     LPDDR6Interface m_interface;
-    LPDDR6Core m_core;
+    BasicLPDDR6Core<Geometry> m_core;
 };
 
+using LPDDR6 = BasicLPDDR6<DynamicGeometry>;
+
+// Creates a LPDDR6 with the fixed geometry core matching memSpec (see LPDDR6Geometries)
+// and a LPDDR6 sized at runtime otherwise
+std::unique_ptr<dram_base<CmdType>> makeDRAM(const MemSpecLPDDR6 &memSpec, const config::SimConfig &simConfig = {});
+
 }  // namespace DRAMPower
 
 #endif /* DRAMPOWER_STANDARDS_LPDDR6_LPDDR6_H */
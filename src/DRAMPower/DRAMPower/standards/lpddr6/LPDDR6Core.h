@@ -1,23 +1,22 @@
 #ifndef DRAMPOWER_STANDARDS_LPDDR6_LPDDR6CORE_H
 #define DRAMPOWER_STANDARDS_LPDDR6_LPDDR6CORE_H
 
+#include "DRAMPower/dram/Core.h"
+#include "DRAMPower/dram/Geometry.h"
 #include "DRAMPower/dram/Rank.h"
 #include "DRAMPower/standards/lpddr6/LPDDR6Command.h"
 #include "DRAMPower/util/ImplicitCommandHandler.h"
+#include "DRAMPower/util/delta_checkpoint.h"
 #include "DRAMPower/util/Serialize.h"
 #include "DRAMPower/util/Deserialize.h"
 
 #include "DRAMPower/memspec/MemSpecLPDDR6.h"
 
+#include <utility>
 #include <vector>
 
 namespace DRAMPower {
 
-namespace internal {
-    template<typename Core>
-    class TestAccessor;
-}
-
 struct LPDDR6CoreMemSpec {
     LPDDR6CoreMemSpec(const MemSpecLPDDR6& memSpec)
         : numberOfBanks(memSpec.numberOfBanks)
@@ -45,57 +44,41 @@ struct LPDDR6CoreMemSpec {
     uint64_t prechargeOffsetWR;
 };
 
-class LPDDR6Core : public util::Serialize, public util::Deserialize {
-// Friend classes
-friend class internal::TestAccessor<LPDDR6Core>;
+// Commands and timings of the LPDDR6 core, see BasicCore
+struct LPDDR6CorePolicy {
+    using memspec_t = MemSpecLPDDR6;
+    using timings_t = LPDDR6CoreMemSpec;
+    using command_t = LPDDR6Command;
+
+    static constexpr bool perBankRefresh = false;    // REFB
+    static constexpr bool sameBankRefresh = false;   // REFSB, PRESB
+    static constexpr bool perTwoBankRefresh = false; // REFP2B
+    static constexpr bool dualBankRefresh = true;    // REFDB
+    static constexpr bool deepSleepMode = false;     // DSMEN, DSMEX
+    static constexpr PowerDownModel powerDownModel = PowerDownModel::InterruptedBanksAndRank;
+
+    static uint64_t tRFC(const timings_t& t) { return t.tRFCAB; }
+    static uint64_t tRFCbank(const timings_t& t) { return t.tRFCDB; }
+    static uint64_t tRCD(const timings_t& t) { return std::max(t.tRCDR, t.tRCDW); }
+};
 
-// Public constructors and assignment operators
-public:
-    LPDDR6Core(const MemSpecLPDDR6& memSpec)
-        : m_memSpec(memSpec)
-        , m_ranks(memSpec.numberOfRanks, {static_cast<std::size_t>(memSpec.numberOfBanks)})
-    {}
+// Ranks, banks and bank groups are sized by Geometry. DynamicGeometry sizes them from the memspec,
+// a FixedGeometry at compile time (see LPDDR6Geometries).
+template <typename Geometry = DynamicGeometry>
+using BasicLPDDR6Core = BasicCore<LPDDR6CorePolicy, Geometry>;
 
-// Public member functions
-public:
-// Member functions
-    void doCommand(const LPDDR6Command& cmd);
-    timestamp_t getLastCommandTime() const;
-    bool isSerializable() const;
-    void getWindowStats(timestamp_t timestamp, SimulationStats &stats);
-// Overrides
-    void serialize(std::ostream& stream) const override;
-    void deserialize(std::istream& stream) override;
-
-// Private member functions
-private:
-    void handleAct(Rank& rank, Bank& bank, timestamp_t timestamp);
-    void handlePre(Rank& rank, Bank& bank, timestamp_t timestamp);
-    void handlePreAll(Rank& rank, timestamp_t timestamp);
-    void handleRead(Rank& rank, Bank& bank, timestamp_t timestamp);
-    void handleWrite(Rank& rank, Bank& bank, timestamp_t timestamp);
-    void handleReadAuto(std::size_t rank_idx, std::size_t bank_idx, timestamp_t timestamp);
-    void handleWriteAuto(std::size_t rank_idx, std::size_t bank_idx, timestamp_t timestamp);
-    void handleRefAll(std::size_t rank_idx, timestamp_t timestamp);
-    void handleRefDualBanks(std::size_t rank_idx, std::size_t bank_idx1, std::size_t bank_idx2, timestamp_t timestamp);
-    void handleRefreshOnBank(std::size_t rank_idx, std::size_t bank_idx, timestamp_t timestamp, uint64_t timing,
-                             uint64_t& counter);
-    void handleSelfRefreshEntry(std::size_t rank_idx, timestamp_t timestamp);
-    void handleSelfRefreshExit(Rank& rank, timestamp_t timestamp);
-    void handlePowerDownActEntry(std::size_t rank_idx, timestamp_t timestamp);
-    void handlePowerDownActExit(std::size_t rank_idx, timestamp_t timestamp);
-    void handlePowerDownPreEntry(std::size_t rank_idx, timestamp_t timestamp);
-    void handlePowerDownPreExit(std::size_t rank_idx, timestamp_t timestamp);
-
-    timestamp_t earliestPossiblePowerDownEntryTime(Rank & rank) const;
-
-// Private member variables
-private:
-    LPDDR6CoreMemSpec m_memSpec;
-    std::vector<Rank> m_ranks;
-    ImplicitCommandHandler<LPDDR6Core> m_implicitCommandHandler;
-    timestamp_t m_last_command_time = 0;
-};
+using LPDDR6Core = BasicLPDDR6Core<DynamicGeometry>;
+
+// Fixed geometries (ranks, banks, bank groups) with a compiled core, see makeDRAM
+using LPDDR6Geometries = GeometryList<
+    FixedGeometry<1, 16, 4>,
+    FixedGeometry<2, 16, 4>
+>;
+
+// Compiled in LPDDR6Core.cpp
+extern template class BasicCore<LPDDR6CorePolicy, DynamicGeometry>;
+extern template class BasicCore<LPDDR6CorePolicy, FixedGeometry<1, 16, 4>>;
+extern template class BasicCore<LPDDR6CorePolicy, FixedGeometry<2, 16, 4>>;
 
 } // namespace DRAMPower
 
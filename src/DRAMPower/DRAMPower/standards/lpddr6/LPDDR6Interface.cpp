@@ -27,7 +27,8 @@ LPDDR6Interface::LPDDR6Interface(const MemSpecLPDDR6& memSpec, const config::Sim
             util::DataBusConfig {
                 memSpec.bitWidth * memSpec.numberOfDevices,
                 memSpec.dataRate,
-                simConfig.toggleRateDefinition.value_or(busConfig)
+                simConfig.toggleRateDefinition.value_or(busConfig),
+                simConfig.deviceBusStats.value_or(false) ? memSpec.bitWidth : 0
             },
             simConfig.toggleRateDefinition.has_value()
                 ? util::DataBusMode::TogglingRate
@@ -216,6 +217,7 @@ timestamp_t LPDDR6Interface::getLastCommandTime() const {
 }
 
 void LPDDR6Interface::doCommand(const LPDDR6Command& cmd) {
+    m_deltaTracker.markCommand(cmd);
     switch(cmd.type) {
         case CmdType::NOP:
         case CmdType::PDEA:
@@ -363,6 +365,11 @@ void LPDDR6Interface::getWindowStats(timestamp_t timestamp, SimulationStats &sta
         stats.togglingStats.read,
         stats.togglingStats.write
     );
+    m_dataBus.get_toggling_activity(timestamp,
+        stats.togglingStats.readActivity,
+        stats.togglingStats.writeActivity
+    );
+    util::addDeviceBusStats(m_dataBus, timestamp, stats.devices);
 
     stats.clockStats = 2.0 * m_clock.get_stats_at(timestamp);
     stats.wClockStats = 2.0 * m_wck.get_stats_at(timestamp);
@@ -390,6 +397,43 @@ void LPDDR6Interface::deserialize(std::istream& stream) {
     m_clock.deserialize(stream);
 }
 
+void LPDDR6Interface::serializeDelta(std::ostream& stream) {
+    m_deltaTracker.serialize(stream);
+    stream.write(reinterpret_cast<const char*>(&m_last_command_time), sizeof(m_last_command_time));
+    m_patternHandler.serialize(stream);
+    if (m_deltaTracker.commandBus) {
+        m_commandBus.serialize(stream);
+    }
+    if (m_deltaTracker.dataBus) {
+        m_dataBus.serialize(stream);
+    }
+    m_readDQS.serialize(stream);
+    m_wck.serialize(stream);
+    m_clock.serialize(stream);
+    m_deltaTracker.clear();
+}
+
+void LPDDR6Interface::deserializeDelta(std::istream& stream) {
+    util::InterfaceDeltaTracker delta;
+    delta.deserialize(stream);
+    stream.read(reinterpret_cast<char*>(&m_last_command_time), sizeof(m_last_command_time));
+    m_patternHandler.deserialize(stream);
+    if (delta.commandBus) {
+        m_commandBus.deserialize(stream);
+    }
+    if (delta.dataBus) {
+        m_dataBus.deserialize(stream);
+    }
+    m_readDQS.deserialize(stream);
+    m_wck.deserialize(stream);
+    m_clock.deserialize(stream);
+    m_deltaTracker.clear();
+}
+
+void LPDDR6Interface::clearDelta() {
+    m_deltaTracker.clear();
+}
+
 std::tuple<const uint8_t*, std::size_t> LPDDR6Interface::DataFormatter::formatData(
     const uint8_t* inputData, std::size_t n_bits,
     std::optional<std::reference_wrapper<const std::vector<bool>>> InversionState
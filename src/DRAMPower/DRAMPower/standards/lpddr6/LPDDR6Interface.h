@@ -4,6 +4,7 @@
 #include "DRAMPower/standards/lpddr6/LPDDR6Pattern.h"
 #include "DRAMPower/util/bus.h"
 #include "DRAMPower/util/databus_presets.h"
+#include "DRAMPower/util/device_stats.h"
 #include "DRAMPower/util/clock.h"
 #include "DRAMPower/util/Serialize.h"
 #include "DRAMPower/util/Deserialize.h"
@@ -14,6 +15,7 @@
 
 #include "DRAMPower/util/PatternHandler.h"
 #include "DRAMPower/util/dbi.h"
+#include "DRAMPower/util/delta_checkpoint.h"
 
 #include "DRAMPower/memspec/MemSpecLPDDR6.h"
 
@@ -104,7 +106,7 @@ public:
     };
 
 public:
-    using commandbus_t = util::Bus<cmdBusWidth>;
+    using commandbus_t = util::Bus;
     using databus_t = util::databus_presets::databus_preset_t;
     using patternHandler_t = PatternHandler<CmdType, pattern_descriptor_LPDDR6::t, LPDDR6TargetCoordinate, LPDDR6Encoder, LPDDR6PatternExtraData>;
 
@@ -121,6 +123,10 @@ public:
 // Overrides
     void serialize(std::ostream& stream) const override;
     void deserialize(std::istream& stream) override;
+    // Delta checkpoints
+    void serializeDelta(std::ostream& stream);
+    void deserializeDelta(std::istream& stream);
+    void clearDelta();
 // Extensions
     void enable(timestamp_t timestamp);
     void disable(timestamp_t timestamp);
@@ -153,6 +159,7 @@ private:
     DataFormatter m_formatter;
     patternHandler_t m_patternHandler;
     timestamp_t m_last_command_time = 0;
+    util::InterfaceDeltaTracker m_deltaTracker;
     bool m_enabled;
 };
 
@@ -14,8 +14,6 @@
 namespace DRAMPower
 {
 
-    class LPDDR6;
-
     class Calculation_LPDDR6
     {
     public:
@@ -14,7 +14,7 @@ namespace DRAMPower::internal {
 template<typename Core>
 class TestAccessor {
 public:
-    static std::vector<Rank>& getRanks(Core& core) {
+    static auto& getRanks(Core& core) {
         return core.m_ranks;
     }
 };
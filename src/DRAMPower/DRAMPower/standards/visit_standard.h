@@ -0,0 +1,79 @@
+#ifndef DRAMPOWER_STANDARDS_VISIT_STANDARD_H
+#define DRAMPOWER_STANDARDS_VISIT_STANDARD_H
+
+#include <DRAMPower/command/CmdType.h>
+#include <DRAMPower/dram/Geometry.h>
+#include <DRAMPower/dram/dram_base.h>
+
+#include <DRAMPower/standards/ddr4/DDR4.h>
+#include <DRAMPower/standards/ddr5/DDR5.h>
+#include <DRAMPower/standards/lpddr4/LPDDR4.h>
+#include <DRAMPower/standards/lpddr5/LPDDR5.h>
+#include <DRAMPower/standards/lpddr6/LPDDR6.h>
+
+#include <typeinfo>
+#include <utility>
+
+namespace DRAMPower {
+
+template <typename... Standards>
+struct StandardList {};
+
+namespace detail {
+
+template <template <typename> class Standard, typename Geometries>
+struct compiled_standards;
+
+template <template <typename> class Standard, typename... Geometries>
+struct compiled_standards<Standard, GeometryList<Geometries...>> {
+    using type = StandardList<Standard<DynamicGeometry>, Standard<Geometries>...>;
+};
+
+template <typename... Lists>
+struct concat_standards;
+
+template <typename... Standards>
+struct concat_standards<StandardList<Standards...>> {
+    using type = StandardList<Standards...>;
+};
+
+template <typename... Lhs, typename... Rhs, typename... Lists>
+struct concat_standards<StandardList<Lhs...>, StandardList<Rhs...>, Lists...> {
+    using type = typename concat_standards<StandardList<Lhs..., Rhs...>, Lists...>::type;
+};
+
+} // namespace detail
+
+// Every standard with a compiled core, i.e. the dynamic and all fixed geometries (see makeDRAM)
+using CompiledStandards = typename detail::concat_standards<
+    typename detail::compiled_standards<BasicDDR4, DDR4Geometries>::type,
+    typename detail::compiled_standards<BasicDDR5, DDR5Geometries>::type,
+    typename detail::compiled_standards<BasicLPDDR4, LPDDR4Geometries>::type,
+    typename detail::compiled_standards<BasicLPDDR5, LPDDR5Geometries>::type,
+    typename detail::compiled_standards<BasicLPDDR6, LPDDR6Geometries>::type
+>::type;
+
+// Calls func with dram cast to the standard of list with the same dynamic type and with
+// dram itself if none matches (e.g. an ObservedDRAM). All calls must return the same type.
+// The type is resolved once per call, func can then use StaticDispatch for every command.
+template <typename Func>
+decltype(auto) visitStandard(StandardList<>, dram_base<CmdType>& dram, Func&& func) {
+    return std::forward<Func>(func)(dram);
+}
+
+template <typename Standard, typename... Standards, typename Func>
+decltype(auto) visitStandard(StandardList<Standard, Standards...>, dram_base<CmdType>& dram, Func&& func) {
+    if (typeid(dram) == typeid(Standard)) {
+        return std::forward<Func>(func)(static_cast<Standard&>(dram));
+    }
+    return visitStandard(StandardList<Standards...>{}, dram, std::forward<Func>(func));
+}
+
+template <typename Func>
+decltype(auto) visitStandard(dram_base<CmdType>& dram, Func&& func) {
+    return visitStandard(CompiledStandards{}, dram, std::forward<Func>(func));
+}
+
+} // namespace DRAMPower
+
+#endif /* DRAMPOWER_STANDARDS_VISIT_STANDARD_H */
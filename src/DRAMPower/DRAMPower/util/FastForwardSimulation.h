@@ -0,0 +1,331 @@
+#ifndef DRAMPOWER_UTIL_FASTFORWARDSIMULATION_H
+#define DRAMPOWER_UTIL_FASTFORWARDSIMULATION_H
+
+#include <DRAMPower/Types.h>
+#include <DRAMPower/command/CmdType.h>
+#include <DRAMPower/command/Command.h>
+#include <DRAMPower/data/energy.h>
+#include <DRAMPower/data/stats.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+namespace DRAMPower {
+
+// Feeds commands to a dram and fast forwards periodic stretches of refresh and
+// power state commands, e.g. REFA every tREFI or a rank cycling through power down
+// and refresh while the system is idle.
+//
+// A periodic stretch is detected from the last commands: the smallest pattern of
+// up to MAX_PERIOD_LENGTH refresh or power state commands which repeated twice with
+// the same types, targets and a constant period. The pattern is confirmed by
+// simulating two more periods and comparing the window stats increments of both
+// periods. From then on every further repetition of the pattern is not simulated,
+// the dram time is shifted by one period and the confirmed increment is added to
+// the stats instead. Any other command or a deviation from the pattern ends the
+// stretch, the commands of the incomplete period are simulated and the simulation
+// continues with shifted timestamps. The stats are identical to a full simulation.
+template <typename DRAM>
+class FastForwardSimulation {
+// Public type definitions
+public:
+    static constexpr std::size_t MAX_PERIOD_LENGTH = 32;
+
+// Private type definitions
+private:
+    enum class State {
+        Detect,
+        Confirm,
+        Skip,
+    };
+
+    struct Entry {
+        CmdType type;
+        TargetCoordinate target;
+        timestamp_t timestamp;
+    };
+
+// Public constructors and assignment operators
+public:
+    // dram must outlive the simulation. All commands must be issued through the simulation.
+    explicit FastForwardSimulation(DRAM& dram)
+        : m_dram(dram)
+    {}
+
+// Public member functions
+public:
+    static bool isEligible(const Command& command) {
+        if (nullptr != command.data) {
+            return false;
+        }
+        switch (command.type) {
+            case CmdType::PREA:
+            case CmdType::REFA:
+            case CmdType::REFB:
+            case CmdType::REFSB:
+            case CmdType::REFP2B:
+            case CmdType::REFDB:
+            case CmdType::PDEA:
+            case CmdType::PDEP:
+            case CmdType::PDXA:
+            case CmdType::PDXP:
+            case CmdType::SREFEN:
+            case CmdType::SREFEX:
+            case CmdType::DSMEN:
+            case CmdType::DSMEX:
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    void doCommand(const Command& command) {
+        m_lastCommandTime = command.timestamp;
+        switch (m_state) {
+            case State::Skip:
+                if (skip(command)) {
+                    return;
+                }
+                endSkip();
+                break;
+            case State::Confirm:
+                if (confirm(command)) {
+                    return;
+                }
+                m_state = State::Detect;
+                m_history.clear();
+                break;
+            case State::Detect:
+                break;
+        }
+        execute(command);
+        detect(command);
+    }
+
+    // Skips all complete periods of a confirmed pattern which end before timestamp without
+    // issuing their commands. The caller guarantees that the pattern continues until timestamp.
+    // Returns the number of skipped periods.
+    uint64_t skipUntil(timestamp_t timestamp) {
+        if (State::Skip != m_state) {
+            return 0;
+        }
+        uint64_t periods = 0;
+        if (m_matched == m_pattern.size() && timestamp >= m_periodStart + m_period) {
+            commitPeriods(1);
+            periods = 1;
+        }
+        if (0 == m_matched && timestamp >= m_periodStart + m_period) {
+            uint64_t count = (timestamp - m_periodStart) / m_period;
+            commitPeriods(count);
+            periods += count;
+        }
+        return periods;
+    }
+
+    // Simulates the commands of an incomplete period
+    void flush() {
+        if (State::Skip == m_state) {
+            endSkip();
+        }
+    }
+
+    SimulationStats getWindowStats(timestamp_t timestamp) {
+        flush();
+        SimulationStats stats = m_dram.getWindowStats(timestamp - m_shift);
+        stats += m_offset;
+        return stats;
+    }
+
+    energy_t calcCoreEnergy(timestamp_t timestamp) {
+        return m_dram.calcCoreEnergyStats(getWindowStats(timestamp));
+    }
+
+    interface_energy_info_t calcInterfaceEnergy(timestamp_t timestamp) {
+        return m_dram.calcInterfaceEnergyStats(getWindowStats(timestamp));
+    }
+
+    double getTotalEnergy(timestamp_t timestamp) {
+        SimulationStats stats = getWindowStats(timestamp);
+        return m_dram.calcCoreEnergyStats(stats).total() + m_dram.calcInterfaceEnergyStats(stats).total();
+    }
+
+    // Timestamp of the last command of the trace (not shifted)
+    timestamp_t getLastCommandTime() const { return m_lastCommandTime; }
+    uint64_t getSkippedPeriods() const { return m_skippedPeriods; }
+    // Simulation time which was not simulated by the dram
+    timestamp_t getSkippedTime() const { return m_shift; }
+
+// Private member functions
+private:
+    void execute(const Command& command) {
+        if (0 == m_shift) {
+            m_dram.doCommand(command);
+            return;
+        }
+        Command shifted = command;
+        shifted.timestamp -= m_shift;
+        m_dram.doCommand(shifted);
+    }
+
+    bool matches(const Command& command, const Entry& entry, timestamp_t timestamp) const {
+        return isEligible(command)
+            && command.type == entry.type
+            && command.timestamp == timestamp
+            && command.targetCoordinate.bank == entry.target.bank
+            && command.targetCoordinate.bankGroup == entry.target.bankGroup
+            && command.targetCoordinate.rank == entry.target.rank
+            && command.targetCoordinate.row == entry.target.row
+            && command.targetCoordinate.column == entry.target.column;
+    }
+
+    bool matchesPattern(const Command& command) const {
+        const Entry& entry = m_pattern[m_matched];
+        return matches(command, entry, m_periodStart + entry.timestamp);
+    }
+
+    void detect(const Command& command) {
+        if (!isEligible(command)) {
+            m_history.clear();
+            return;
+        }
+        if (m_history.size() == 2 * MAX_PERIOD_LENGTH) {
+            m_history.pop_front();
+        }
+        m_history.push_back({command.type, command.targetCoordinate, command.timestamp});
+
+        const std::size_t n = m_history.size();
+        for (std::size_t length = 1; 2 * length <= n; ++length) {
+            const timestamp_t period = m_history[n - 1].timestamp - m_history[n - 1 - length].timestamp;
+            const timestamp_t start = m_history[n - length].timestamp;
+            // The pattern must lie strictly inside one period
+            if (0 == period || m_history[n - 1].timestamp >= start + period) {
+                continue;
+            }
+            bool periodic = true;
+            for (std::size_t i = n - length; i < n && periodic; ++i) {
+                const Entry& previous = m_history[i - length];
+                const Entry& current = m_history[i];
+                periodic = current.type == previous.type
+                    && current.timestamp - previous.timestamp == period
+                    && current.target.bank == previous.target.bank
+                    && current.target.bankGroup == previous.target.bankGroup
+                    && current.target.rank == previous.target.rank
+                    && current.target.row == previous.target.row
+                    && current.target.column == previous.target.column;
+            }
+            if (!periodic) {
+                continue;
+            }
+            // The pattern offsets are relative to the period start
+            m_pattern.assign(m_history.begin() + (n - length), m_history.end());
+            for (Entry& entry : m_pattern) {
+                entry.timestamp -= start;
+            }
+            m_period = period;
+            m_periodStart = start + period;
+            m_matched = 0;
+            m_boundaryCount = 0;
+            m_state = State::Confirm;
+            return;
+        }
+    }
+
+    // Simulates the next period of the pattern and measures the increment of the window stats per period
+    bool confirm(const Command& command) {
+        if (!matchesPattern(command)) {
+            return false;
+        }
+        if (0 == m_matched) {
+            SimulationStats stats = m_dram.getWindowStats(m_periodStart - m_shift);
+            if (m_boundaryCount > 0) {
+                SimulationStats delta = stats;
+                delta -= m_boundaryStats;
+                if (m_boundaryCount > 1 && delta == m_delta) {
+                    // The first command of the first skipped period
+                    m_state = State::Skip;
+                    m_periodCount = 0;
+                    m_matched = 1;
+                    return true;
+                }
+                m_delta = std::move(delta);
+            }
+            m_boundaryStats = std::move(stats);
+            ++m_boundaryCount;
+        }
+        execute(command);
+        if (++m_matched == m_pattern.size()) {
+            m_matched = 0;
+            m_periodStart += m_period;
+        }
+        return true;
+    }
+
+    bool skip(const Command& command) {
+        if (m_matched == m_pattern.size()) {
+            // The period is complete if no other command falls into it
+            if (command.timestamp < m_periodStart + m_period) {
+                return false;
+            }
+            commitPeriods(1);
+        }
+        if (!matchesPattern(command)) {
+            return false;
+        }
+        ++m_matched;
+        return true;
+    }
+
+    void commitPeriods(uint64_t count) {
+        m_periodCount += count;
+        m_skippedPeriods += count;
+        m_shift += count * m_period;
+        m_periodStart += count * m_period;
+        m_matched = 0;
+    }
+
+    void endSkip() {
+        for (std::size_t i = 0; i < m_matched; ++i) {
+            const Entry& entry = m_pattern[i];
+            execute({m_periodStart + entry.timestamp, entry.type, entry.target});
+        }
+        if (m_periodCount > 0) {
+            SimulationStats skipped = m_delta;
+            skipped *= m_periodCount;
+            m_offset += skipped;
+        }
+        m_periodCount = 0;
+        m_matched = 0;
+        m_state = State::Detect;
+        m_history.clear();
+    }
+
+// Private member variables
+private:
+    DRAM& m_dram;
+    State m_state = State::Detect;
+    timestamp_t m_lastCommandTime = 0;
+
+    // Detection
+    std::deque<Entry> m_history;
+
+    // Current pattern
+    std::vector<Entry> m_pattern;
+    timestamp_t m_period = 0;
+    timestamp_t m_periodStart = 0;
+    std::size_t m_matched = 0;
+    std::size_t m_boundaryCount = 0;
+    SimulationStats m_boundaryStats;
+    SimulationStats m_delta;
+    uint64_t m_periodCount = 0;
+
+    // Accumulated fast forward
+    timestamp_t m_shift = 0;
+    uint64_t m_skippedPeriods = 0;
+    SimulationStats m_offset;
+};
+
+} // namespace DRAMPower
+
+#endif /* DRAMPOWER_UTIL_FASTFORWARDSIMULATION_H */
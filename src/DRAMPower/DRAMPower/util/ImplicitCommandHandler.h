@@ -2,6 +2,7 @@
 #define DRAMPOWER_UTIL_IMPLICITCOMMANDHANDLER_H
 
 #include <DRAMPower/Types.h>
+#include <DRAMPower/util/profiler.h>
 
 #include <deque>
 #include <functional>
@@ -9,6 +10,7 @@
 #include <utility>
 #include <algorithm>
 #include <cstddef>
+#include <cstdint>
 
 namespace DRAMPower {
 
@@ -49,12 +51,21 @@ public:
     }
 
     void processImplicitCommandQueue(CommandContext_t context, timestamp_t timestamp, timestamp_t &last_command_time) {
+        processImplicitCommandQueue(context, timestamp, last_command_time, [](timestamp_t) {});
+    }
+
+    // Calls onExecuted with the timestamp of every executed implicit command
+    template <typename Func>
+    void processImplicitCommandQueue(CommandContext_t context, timestamp_t timestamp, timestamp_t &last_command_time, Func&& onExecuted) {
+        DRAMPOWER_PROFILE_SCOPE(util::profiling::Section::ImplicitCommandQueue);
         while (!m_implicitCommandList.empty() && m_implicitCommandList.front().first <= timestamp) {
             // Execute implicit command functor
             auto& [i_timestamp, i_implicitCommand] = m_implicitCommandList.front();
             i_implicitCommand(context);
             last_command_time = i_timestamp;
             m_implicitCommandList.pop_front();
+            ++m_executedCount;
+            onExecuted(last_command_time);
         }
     }
 
@@ -62,9 +73,15 @@ public:
         return m_implicitCommandList.size();
     }
 
+    // Number of implicit commands executed so far, changes whenever the queue executed a command
+    uint64_t executedCount() const {
+        return m_executedCount;
+    }
+
 // Private member variables
 private:
     implicitCommandList_t m_implicitCommandList;
+    uint64_t m_executedCount = 0;
 };
 
 template<>
@@ -84,6 +101,7 @@ public:
     }
 
     void processImplicitCommandQueue(timestamp_t timestamp, timestamp_t &last_command_time) {
+        DRAMPOWER_PROFILE_SCOPE(util::profiling::Section::ImplicitCommandQueue);
         while (!m_implicitCommandList.empty() && m_implicitCommandList.front().first <= timestamp) {
             // Execute implicit command functor
             auto& [i_timestamp, i_implicitCommand] = m_implicitCommandList.front();
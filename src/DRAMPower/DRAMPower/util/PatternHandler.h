@@ -5,6 +5,7 @@
 #include <DRAMPower/command/Command.h>
 #include <DRAMPower/util/Serialize.h>
 #include <DRAMPower/util/Deserialize.h>
+#include <DRAMPower/util/profiler.h>
 
 #include <utility>
 #include <variant>
@@ -79,6 +80,7 @@ public:
     }
     uint64_t getCommandPattern(commandEnum_t type, const TargetCoordinate_t& coordinate)
     {
+        DRAMPOWER_PROFILE_SCOPE(util::profiling::Section::CommandPattern);
         if (m_commandPatternMap[static_cast<std::size_t>(type)].empty()) {
             // No pattern registered for this command
             throw std::runtime_error("No pattern registered for this command");
@@ -9,8 +9,9 @@
 namespace DRAMPower::util {
 
 namespace coreHelpers {
-    template<typename Func, typename Owner, typename Command_t = Command>
-    decltype(auto) bankHandler(const Command_t& cmd, std::vector<Rank>& ranks, Owner owner, Func &&member_func) {
+    // Ranks is the rank container of the core (std::vector or std::array of Rank)
+    template<typename Func, typename Owner, typename Ranks, typename Command_t = Command>
+    decltype(auto) bankHandler(const Command_t& cmd, Ranks& ranks, Owner owner, Func &&member_func) {
         assert(ranks.size()>cmd.targetCoordinate.rank);
         auto & rank = ranks.at(cmd.targetCoordinate.rank);
 
@@ -20,30 +21,30 @@ namespace coreHelpers {
         return (owner->*member_func)(rank, bank, cmd.timestamp);
     }
 
-    template<typename Func, typename Owner, typename Command_t = Command>
-    decltype(auto) bankHandlerIdx(const Command_t& cmd, std::vector<Rank>& ranks, Owner owner, Func &&member_func) {
+    template<typename Func, typename Owner, typename Ranks, typename Command_t = Command>
+    decltype(auto) bankHandlerIdx(const Command_t& cmd, Ranks& ranks, Owner owner, Func &&member_func) {
         assert(ranks.size()>cmd.targetCoordinate.rank);
         assert(ranks.at(cmd.targetCoordinate.rank).banks.size()>cmd.targetCoordinate.bank);
 
         return (owner->*member_func)(cmd.targetCoordinate.rank, cmd.targetCoordinate.bank, cmd.timestamp);
     }
 
-    template<typename Func, typename Owner, typename Command_t = Command>
-    decltype(auto) rankHandler(const Command_t& cmd, std::vector<Rank>& ranks, Owner owner, Func &&member_func) {
+    template<typename Func, typename Owner, typename Ranks, typename Command_t = Command>
+    decltype(auto) rankHandler(const Command_t& cmd, Ranks& ranks, Owner owner, Func &&member_func) {
         assert(ranks.size()>cmd.targetCoordinate.rank);
         auto & rank = ranks.at(cmd.targetCoordinate.rank);
 
         return (owner->*member_func)(rank, cmd.timestamp);
     }
 
-    template<typename Func, typename Owner, typename Command_t = Command>
-    decltype(auto) rankHandlerIdx(const Command_t& cmd, std::vector<Rank>& ranks, Owner owner, Func &&member_func) {
+    template<typename Func, typename Owner, typename Ranks, typename Command_t = Command>
+    decltype(auto) rankHandlerIdx(const Command_t& cmd, Ranks& ranks, Owner owner, Func &&member_func) {
         assert(ranks.size()>cmd.targetCoordinate.rank);
         return (owner->*member_func)(cmd.targetCoordinate.rank, cmd.timestamp);
     }
 
-    template<typename Func, typename Owner, typename Command_t = Command>
-    decltype(auto) bankGroupHandler(const Command_t& cmd, std::vector<Rank>& ranks, Owner owner, Func &&member_func) {
+    template<typename Func, typename Owner, typename Ranks, typename Command_t = Command>
+    decltype(auto) bankGroupHandler(const Command_t& cmd, Ranks& ranks, Owner owner, Func &&member_func) {
         assert(ranks.size()>cmd.targetCoordinate.rank);
         auto& rank = ranks.at(cmd.targetCoordinate.rank);
 
@@ -56,8 +57,8 @@ namespace coreHelpers {
         return (owner->*member_func)(rank, bank_id, cmd.timestamp);
     }
 
-    template<typename Func, typename Owner, typename Command_t = Command>
-    decltype(auto) bankGroupHandlerIdx(const Command_t& cmd, std::vector<Rank>& ranks, Owner owner, Func &&member_func) {
+    template<typename Func, typename Owner, typename Ranks, typename Command_t = Command>
+    decltype(auto) bankGroupHandlerIdx(const Command_t& cmd, Ranks& ranks, Owner owner, Func &&member_func) {
         assert(ranks.size()>cmd.targetCoordinate.rank);
         auto& rank = ranks.at(cmd.targetCoordinate.rank);
 
@@ -0,0 +1,206 @@
+#ifndef DRAMPOWER_UTIL_SEGMENTEDCORESIMULATION_H
+#define DRAMPOWER_UTIL_SEGMENTEDCORESIMULATION_H
+
+#include <DRAMPower/Types.h>
+#include <DRAMPower/command/CmdType.h>
+#include <DRAMPower/command/Command.h>
+#include <DRAMPower/data/stats.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <optional>
+#include <set>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace DRAMPower {
+
+// Splits a command trace into segments at idle points, simulates the segments
+// on independent copies of a fresh core in parallel and stitches the window
+// stats together. A boundary is only accepted if the core that simulated the
+// preceding segment is idle at the boundary (see Core::isIdle). Otherwise the
+// following segment is replayed sequentially on that core. The result is
+// identical to a sequential simulation of the whole trace.
+template <typename Core, typename CommandType = Command>
+class SegmentedCoreSimulation {
+// Private type definitions
+private:
+    struct Segment {
+        std::size_t begin;
+        std::size_t end;
+        timestamp_t start;
+        std::optional<Core> core;
+        SimulationStats baseline;
+    };
+
+// Public constructors and assignment operators
+public:
+    // prototype must be a freshly constructed core without any issued commands
+    SegmentedCoreSimulation(const Core& prototype, std::size_t segmentCount,
+        std::size_t threadCount = std::thread::hardware_concurrency(), timestamp_t guardInterval = 0)
+        : m_prototype(prototype)
+        , m_segmentCount(std::max<std::size_t>(segmentCount, 1))
+        , m_threadCount(std::max<std::size_t>(threadCount, 1))
+        , m_guardInterval(guardInterval)
+    {}
+
+// Public member functions
+public:
+    // Simulates all commands and returns the core window stats at timestamp
+    SimulationStats run(const std::vector<CommandType>& commands, timestamp_t timestamp) {
+        std::vector<Segment> segments = splitSegments(commands);
+        m_reconciledSegmentCount = 0;
+
+        // Parallel phase
+        // An exception must not leave a std::thread, it is rethrown after all workers joined
+        std::size_t threadCount = std::min(m_threadCount, segments.size());
+        std::vector<std::exception_ptr> errors(threadCount);
+        std::atomic<std::size_t> nextSegment{0};
+        auto worker = [this, &segments, &commands, &nextSegment, &errors](std::size_t id) {
+            try {
+                for (std::size_t i = nextSegment++; i < segments.size(); i = nextSegment++) {
+                    auto& segment = segments[i];
+                    segment.core.emplace(m_prototype);
+                    segment.core->getWindowStats(segment.start, segment.baseline);
+                    for (std::size_t j = segment.begin; j < segment.end; ++j) {
+                        segment.core->doCommand(commands[j]);
+                    }
+                }
+            } catch (...) {
+                errors[id] = std::current_exception();
+                // The other workers don't start further segments
+                nextSegment = segments.size();
+            }
+        };
+        std::vector<std::thread> threads;
+        threads.reserve(threadCount - 1);
+        for (std::size_t i = 1; i < threadCount; ++i) {
+            threads.emplace_back(worker, i);
+        }
+        worker(0);
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        for (const auto& error : errors) {
+            if (error) {
+                std::rethrow_exception(error);
+            }
+        }
+
+        // Reconciliation phase
+        SimulationStats result;
+        Segment* current = &segments.front();
+        for (std::size_t i = 1; i < segments.size(); ++i) {
+            auto& next = segments[i];
+            if (current->core->isIdle(next.start)) {
+                accumulateWindow(result, *current, next.start);
+                current->core.reset();
+                current = &next;
+                continue;
+            }
+            // The boundary state differs from a fresh core -> continue sequentially
+            for (std::size_t j = next.begin; j < next.end; ++j) {
+                current->core->doCommand(commands[j]);
+            }
+            next.core.reset();
+            ++m_reconciledSegmentCount;
+        }
+        accumulateWindow(result, *current, timestamp);
+        return result;
+    }
+
+    // Number of segment boundaries of the last run which had to be replayed sequentially
+    std::size_t getReconciledSegmentCount() const {
+        return m_reconciledSegmentCount;
+    }
+
+// Private member functions
+private:
+    std::vector<Segment> splitSegments(const std::vector<CommandType>& commands) const {
+        std::vector<Segment> segments;
+        segments.push_back({0, commands.size(), 0, std::nullopt, {}});
+        if (commands.empty() || m_segmentCount == 1) {
+            return segments;
+        }
+
+        // Pre-pass: track the trace-level bank and power state to find candidate idle points
+        std::set<std::pair<std::size_t, std::size_t>> openBanks;
+        std::set<std::size_t> poweredDownRanks;
+        std::size_t targetSize = (commands.size() + m_segmentCount - 1) / m_segmentCount;
+        std::size_t nextTarget = targetSize;
+        for (std::size_t i = 0; i < commands.size(); ++i) {
+            const auto& cmd = commands[i];
+            if (i >= nextTarget && openBanks.empty() && poweredDownRanks.empty()
+                && cmd.timestamp >= commands[i - 1].timestamp + m_guardInterval
+                && cmd.timestamp > commands[i - 1].timestamp
+            ) {
+                segments.back().end = i;
+                segments.push_back({i, commands.size(), cmd.timestamp, std::nullopt, {}});
+                nextTarget = i + targetSize;
+            }
+            auto rank = cmd.targetCoordinate.rank;
+            auto bank = std::make_pair(rank, cmd.targetCoordinate.bank);
+            switch (cmd.type) {
+                case CmdType::ACT:
+                    openBanks.insert(bank);
+                    break;
+                case CmdType::PRE:
+                case CmdType::PRESB:
+                case CmdType::RDA:
+                case CmdType::WRA:
+                    openBanks.erase(bank);
+                    break;
+                case CmdType::PREA:
+                    for (auto it = openBanks.begin(); it != openBanks.end();) {
+                        it = it->first == rank ? openBanks.erase(it) : std::next(it);
+                    }
+                    break;
+                case CmdType::PDEA:
+                case CmdType::PDEP:
+                case CmdType::SREFEN:
+                case CmdType::DSMEN:
+                    poweredDownRanks.insert(rank);
+                    break;
+                case CmdType::PDXA:
+                case CmdType::PDXP:
+                case CmdType::SREFEX:
+                case CmdType::DSMEX:
+                    poweredDownRanks.erase(rank);
+                    break;
+                default:
+                    break;
+            }
+        }
+        return segments;
+    }
+
+    void accumulateWindow(SimulationStats& result, Segment& segment, timestamp_t timestamp) const {
+        SimulationStats stats;
+        segment.core->getWindowStats(timestamp, stats);
+        result.bank.resize(stats.bank.size());
+        result.rank_total.resize(stats.rank_total.size());
+        for (std::size_t i = 0; i < stats.bank.size(); ++i) {
+            result.bank[i] += stats.bank[i];
+            result.bank[i] -= segment.baseline.bank[i];
+        }
+        for (std::size_t i = 0; i < stats.rank_total.size(); ++i) {
+            result.rank_total[i] += stats.rank_total[i];
+            result.rank_total[i] -= segment.baseline.rank_total[i];
+        }
+    }
+
+// Private member variables
+private:
+    Core m_prototype;
+    std::size_t m_segmentCount;
+    std::size_t m_threadCount;
+    timestamp_t m_guardInterval;
+    std::size_t m_reconciledSegmentCount = 0;
+};
+
+} // namespace DRAMPower
+
+#endif /* DRAMPOWER_UTIL_SEGMENTEDCORESIMULATION_H */
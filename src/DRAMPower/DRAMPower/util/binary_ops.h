@@ -3,6 +3,7 @@
 
 #include <sstream>
 #include <bitset>
+#include <cstdint>
 
 #if defined(__GNUC__)
 	#define POPCOUNT __builtin_popcountll
@@ -22,6 +23,17 @@
 	#define POPCOUNT popcount_
 #endif
 
+#if defined(__GNUC__)
+	#define COUNTR_ZERO __builtin_ctzll
+#elif defined(_MSC_VER) && defined(_M_X64)
+	#include <intrin.h>
+	inline std::size_t countr_zero_(uint64_t n) { unsigned long index; _BitScanForward64(&index, n); return index; };
+	#define COUNTR_ZERO countr_zero_
+#else
+	inline std::size_t countr_zero_(uint64_t n) { std::size_t index = 0; while (!(n & 1)) { n >>= 1; ++index; } return index; };
+	#define COUNTR_ZERO countr_zero_
+#endif
+
 namespace DRAMPower::util {
 
 template <typename T>
@@ -49,6 +61,40 @@ struct BinaryOps {
         return bitset.count();
     }
 
+    // Popcount of every field_width bit field of n, stored in the field (SWAR).
+    // field_width must be a power of two between 2 and 64
+    static uint64_t popcount_fields(uint64_t n, std::size_t field_width)
+    {
+        n = n - ((n >> 1) & 0x5555555555555555ull);
+        if (2 == field_width) return n;
+        n = (n & 0x3333333333333333ull) + ((n >> 2) & 0x3333333333333333ull);
+        if (4 == field_width) return n;
+        n = (n + (n >> 4)) & 0x0F0F0F0F0F0F0F0Full;
+        if (8 == field_width) return n;
+        n = (n + (n >> 8)) & 0x00FF00FF00FF00FFull;
+        if (16 == field_width) return n;
+        n = (n + (n >> 16)) & 0x0000FFFF0000FFFFull;
+        if (32 == field_width) return n;
+        return (n + (n >> 32)) & 0x00000000FFFFFFFFull;
+    }
+
+    // Bits [64 * index, 64 * index + 64) of bitset
+    template <std::size_t N>
+    static uint64_t word(const std::bitset<N>& bitset, std::size_t index)
+    {
+        if constexpr (N <= 64) {
+            return 0 == index ? bitset.to_ullong() : 0;
+        } else {
+            return ((bitset >> (64 * index)) & std::bitset<N>{~0ull}).to_ullong();
+        }
+    }
+
+    // Index of the least significant set bit (n must not be zero)
+    static std::size_t countr_zero(uint64_t n)
+    {
+        return COUNTR_ZERO(n);
+    }
+
     template <typename T>
     static std::size_t zero_to_ones(const T& p, const T& q)
     {
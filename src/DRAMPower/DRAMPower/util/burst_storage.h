@@ -6,9 +6,11 @@
 #include "DRAMPower/Types.h"
 #include "DRAMPower/util/binary_ops.h"
 #include "DRAMPower/util/bus_types.h"
+#include "DRAMPower/util/packed_burst.h"
 #include "DRAMPower/util/Serialize.h"
 #include "DRAMPower/util/Deserialize.h"
 
+#include <algorithm>
 #include <bitset>
 #include <cstddef>
 #include <iostream>
@@ -30,11 +32,11 @@ struct BitsetContainer {
     timestamp_t load_time = 0;
 };
 
-template <std::size_t bitset_size>
+// Bursts of width bits, each packed into stride words
 struct BusContainer {
-    using bitset_t = std::bitset<bitset_size>;
-    std::vector<bitset_t> bursts{};
+    std::vector<uint64_t> words{};
     std::size_t width = 0;
+    std::size_t stride = 0;
     std::size_t count = 0;
     timestamp_t load_time = 0;
 };
@@ -187,79 +189,46 @@ struct burst_storage_impl <BitsetContainer<bitset_size>>{
     }
 };
 
-template <std::size_t bitset_size>
-struct burst_storage_impl <BusContainer<bitset_size>> {
-    using data_t = BusContainer<bitset_size>;
-    // using data_t = BusContainer<32>;
-    using bitset_t = typename data_t::bitset_t;
-    using burst_t = bitset_t;
-    // using bitset_t = std::bitset<32>;
-    using stats_t = util::bus_stats_t;
+template <>
+struct burst_storage_impl <BusContainer> {
+    using data_t = BusContainer;
+    using burst_t = burst_view;
 
     static inline void init(data_t& data, std::size_t width) {
         data.width = width;
-    }
-
-    static inline stats_t count(const data_t& data, timestamp_t start, timestamp_t end, std::optional<burst_t> prev = std::nullopt) {
-        assert(start >= data.load_time && "start timestamp must be greater or equal to load timestamp");
-        std::size_t length = end - start;
-        // Clamp length to count
-        if (length > data.count) {
-            length = data.count;
-        }
-
-        const std::size_t offset = start - data.load_time;
-        assert(length + offset <= data.bursts.size() && "Invalid access");
-
-        // Stats
-        bus_stats_t stats{};
-
-        for (std::size_t i = offset; i < length; i++) {
-            const auto& entry = data.bursts[i];
-            if (0 == offset) {
-                // Last Burst to this burst
-                stats += diff(data, prev, entry);
-            } else {
-                auto ones = util::BinaryOps::popcount(entry);
-                stats.ones += ones;
-                stats.zeroes += data.width - ones;
-                const auto& entry_prev = data.bursts[i - 1];
-                stats.bit_changes += util::BinaryOps::bit_changes(entry_prev, entry);
-                stats.ones_to_zeroes += util::BinaryOps::one_to_zeroes(entry_prev, entry);
-                stats.zeroes_to_ones += stats.bit_changes - stats.ones_to_zeroes;
-            }
-        }
-        return stats;
+        data.stride = burst_words(width);
     }
 
     static inline void resize(data_t& data, std::size_t size) {
-        if (data.bursts.size() < size) {
-            data.bursts.resize(size);
+        if (data.words.size() < size * data.stride) {
+            data.words.resize(size * data.stride);
         }
     }
 
     static inline void push_back(data_t& data, timestamp_t load_time, burst_t burst) {
+        assert(burst.size() == data.width && "Invalid burst width");
         if (load_time != data.load_time) {
             data.count = 0;
             data.load_time = load_time;
         }
         resize(data, data.count + 1);
-        data.bursts[data.count] = burst;
+        std::copy(burst.begin(), burst.end(), get(data, data.count));
         data.count++;
     }
 
-    static inline burst_t& get(data_t& data, std::size_t index) {
-        assert((data.bursts.size() > index) && "Invalid access");
-        return data.bursts[index];
+    // Words of the burst at index
+    static inline uint64_t* get(data_t& data, std::size_t index) {
+        assert((size(data) > index) && "Invalid access");
+        return data.words.data() + index * data.stride;
     }
 
-    static inline const burst_t& get_const(const data_t& data, std::size_t n) {
+    static inline burst_t get_const(const data_t& data, std::size_t n) {
         assert((data.count > n) && "Invalid access");
-        return data.bursts[data.count - 1 - n];
+        return {data.words.data() + (data.count - 1 - n) * data.stride, data.width};
     }
 
     static inline std::size_t size(const data_t& data) {
-        return data.bursts.size();
+        return 0 == data.stride ? 0 : data.words.size() / data.stride;
     }
 
     static inline void clear(data_t& data) {
@@ -283,36 +252,12 @@ struct burst_storage_impl <BusContainer<bitset_size>> {
         data.load_time = timestamp;
     }
 
-	static inline void serializeBurst(std::ostream& stream, const burst_t& burst) {
-		std::array<uint8_t, (bitset_size + 7) / 8> burst_data;
-		for (std::size_t i = 0; i < burst_data.size(); ++i) {
-			burst_data[i] = 0;
-			for (std::size_t j = 0; j < 8 && (i * 8 + j) < bitset_size; ++j) {
-				if (burst.test(i * 8 + j)) {
-					burst_data[i] |= (1 << j);
-				}
-			}
-		}
-		stream.write(reinterpret_cast<const char*>(burst_data.data()), burst_data.size());
-	}
-	static inline void deserializeBurst(std::istream& stream, burst_t& burst) {
-		std::array<uint8_t, (bitset_size +7) / 8> burst_data{};
-		stream.read(reinterpret_cast<char*>(burst_data.data()), burst_data.size());
-		for (std::size_t i = 0; i < burst_data.size(); ++i) {
-			for (std::size_t j = 0; j < 8 && (i * 8 + j) < bitset_size; ++j) {
-				burst.set(i * 8 + j, (burst_data[i] >> j) & 1);
-			}
-		}
-	}
-
     static inline void serialize(const data_t& data, std::ostream& stream) {
-        std::size_t totalBursts = data.bursts.size();
+        std::size_t totalBursts = size(data);
 		stream.write(reinterpret_cast<const char*>(&data.count), sizeof(data.count));
 		stream.write(reinterpret_cast<const char*>(&data.load_time), sizeof(data.load_time));
         stream.write(reinterpret_cast<const char*>(&totalBursts), sizeof(totalBursts));
-        for (const auto& burst : data.bursts) {
-            serializeBurst(stream, burst);
-        }
+        stream.write(reinterpret_cast<const char*>(data.words.data()), totalBursts * data.stride * sizeof(uint64_t));
     }
 
     static inline void deserialize(data_t& data, std::istream& stream) {
@@ -320,11 +265,8 @@ struct burst_storage_impl <BusContainer<bitset_size>> {
 		stream.read(reinterpret_cast<char*>(&data.count), sizeof(data.count));
 		stream.read(reinterpret_cast<char*>(&data.load_time), sizeof(data.load_time));
 		stream.read(reinterpret_cast<char*>(&totalBursts), sizeof(totalBursts));
-		data.bursts.clear();
-		data.bursts.resize(totalBursts);
-		for (std::size_t i = 0; i < totalBursts; ++i) {
-			deserializeBurst(stream, data.bursts[i]);
-		}
+		data.words.assign(totalBursts * data.stride, 0);
+		stream.read(reinterpret_cast<char*>(data.words.data()), totalBursts * data.stride * sizeof(uint64_t));
     }
 };
 
@@ -355,7 +297,7 @@ public:
         return impl_t::count(m_bursts, start, end, prev);
     }
 
-	inline burst_t& get_or_add(std::size_t index) {
+	inline decltype(auto) get_or_add(std::size_t index) {
         impl_t::resize(m_bursts, index + 1);
 		return impl_t::get(m_bursts, index);
 	}
@@ -395,25 +337,34 @@ public:
 
 struct BurstStorageInsertHelper {
 
-    template <std::size_t bitset_width>
-    static inline void insert_data(burst_storage<BusContainer<bitset_width>>& burst_storage, timestamp_t timestamp, std::size_t width, const uint8_t* data, std::size_t n_bits, bool invert = false) {
-        size_t n_bursts = n_bits / width;
-        size_t burst_offset = 0;
-        size_t byte_index = 0;
-        size_t bit_index = 0;
+    // Bits [offset, offset + n_bits) of the n_bytes bytes of data, n_bits must not exceed 64
+    static inline uint64_t extract_bits(const uint8_t* data, std::size_t n_bytes, std::size_t offset, std::size_t n_bits) {
+        const std::size_t first = offset / 8;
+        const std::size_t shift = offset % 8;
+        const std::size_t last = std::min(n_bytes, (offset + n_bits + 7) / 8);
+        uint64_t value = 0;
+        for (std::size_t byte = first; byte < last && byte < first + 8; ++byte) {
+            value |= uint64_t{data[byte]} << (8 * (byte - first));
+        }
+        value >>= shift;
+        if (last > first + 8) {
+            // The window spans 9 bytes
+            value |= uint64_t{data[first + 8]} << (64 - shift);
+        }
+        return n_bits < 64 ? value & ((uint64_t{1} << n_bits) - 1) : value;
+    }
+
+    static inline void insert_data(burst_storage<BusContainer>& burst_storage, timestamp_t timestamp, std::size_t width, const uint8_t* data, std::size_t n_bits, bool invert = false) {
+        const std::size_t n_bursts = n_bits / width;
+        const std::size_t n_bytes = (n_bits + 7) / 8;
+        const std::size_t n_words = burst_words(width);
         for (std::size_t i = 0; i < n_bursts; ++i) {
-            // Extract bursts
-            std::bitset<bitset_width> &bits = burst_storage.get_or_add(i);
-            burst_offset = i * width;
-            for (std::size_t j = 0; j < width && (burst_offset + j) < n_bits; ++j) {
-                // Extract bit
-                std::size_t bit_position = bit_index % 8;
-                bool bit_value = (data[byte_index] >> bit_position) & 1;
-                bits.set(j, invert ? !bit_value : bit_value);
-                bit_index++;
-                if (bit_index % 8 == 0) {
-                    ++byte_index;
-                }
+            // Extract bursts word by word
+            uint64_t* words = burst_storage.get_or_add(i);
+            for (std::size_t word = 0; word < n_words; ++word) {
+                const std::size_t bits = std::min<std::size_t>(64, width - word * 64);
+                const uint64_t value = extract_bits(data, n_bytes, i * width + word * 64, bits);
+                words[word] = invert ? ~value & (~uint64_t{0} >> (64 - bits)) : value;
             }
         }
         burst_storage.setLoadTime(timestamp);
@@ -4,10 +4,13 @@
 #include <DRAMPower/util/binary_ops.h>
 #include <DRAMPower/util/burst_storage.h>
 #include <DRAMPower/util/bus_types.h>
+#include <DRAMPower/util/packed_burst.h>
 #include <DRAMPower/util/pending_stats.h>
+#include <DRAMPower/util/profiler.h>
 #include <DRAMPower/util/Serialize.h>
 #include <DRAMPower/util/Deserialize.h>
 #include <DRAMPower/Types.h>
+#include <DRAMPower/Exceptions.h>
 
 #include <DRAMUtils/util/types.h>
 
@@ -18,19 +21,24 @@
 #include <limits>
 #include <cassert>
 #include <limits.h>
+#include <vector>
 
 #include <iostream>
 
 namespace DRAMPower::util
 {
 
-template <std::size_t max_bitset_size = 0>
+// The bursts are packed into 64 bit words sized to the width of the bus, the bus width is not bounded.
+// at() returns a view of the stored burst without copying it.
+// Optionally the bus is split into lanes of lane_width bits (e.g. the DQ lanes of the devices of a rank).
+// The stats of every lane are counted in the same pass as the aggregate stats. Lane widths which are
+// a power of two are counted word-parallel (SWAR), other lane widths with one mask per lane.
 class Bus : public Serialize, public Deserialize {
 
 public:
 	
-	using burst_storage_t = util::burst_storage<BusContainer<max_bitset_size>>;
-	using burst_t = typename burst_storage_t::burst_t;
+	using burst_storage_t = util::burst_storage<BusContainer>;
+	using burst_t = packed_burst;
 	using stats_t = bus_stats_t;
 
 	stats_t stats;
@@ -52,31 +60,60 @@ private:
 	burst_t idle_pattern_burst;
 	
 	BusIdlePatternSpec idle_pattern;
+
+	// Lanes, lane_width 0 disables the lane stats
+	std::size_t lane_width = 0;
+	std::vector<stats_t> lane_stats;
+	std::vector<stats_t> lane_pending_stats;
+	stats_t lane_idle_stats;
+	std::vector<burst_t> lane_masks;
+
+	// Stats sink of the aggregate stats
+	struct TotalSink {
+		const Bus& bus;
+		stats_t& stats;
+		void diff(burst_view high, burst_view low) { stats += bus.diff(high, low); }
+		void idle(timestamp_t n) { stats += n * bus.idle_stats; }
+	};
+
+	// Stats sink of the aggregate and the lane stats
+	struct LaneSink {
+		const Bus& bus;
+		stats_t& stats;
+		std::vector<stats_t>& lanes;
+		void diff(burst_view high, burst_view low) { stats += bus.diff_lanes(high, low, lanes); }
+		void idle(timestamp_t n) {
+			stats += n * bus.idle_stats;
+			for (stats_t& lane : lanes) {
+				lane += n * bus.lane_idle_stats;
+			}
+		}
+	};
 public:
 	Bus(std::size_t width, uint64_t datarate, BusIdlePatternSpec idle_pattern,
-		bool enableflag = true
+		bool enableflag = true, std::size_t lane_width = 0
 	) 
 		: burst_storage(width)
 		, enableflag(enableflag)
 		, width(width)
 		, datarate(datarate)
+		, last_pattern(width)
+		, idle_pattern_burst(width)
 		, idle_pattern(idle_pattern)
+		, lane_width(lane_width)
 	{
+		if (0 != lane_width) {
+			init_lanes();
+		}
 		
 		// Initialize idle pattern
 		switch(idle_pattern)
 		{
 			case BusIdlePatternSpec::L:
-				this->idle_pattern_burst = burst_t();
 				this->idle_pattern_burst.reset();
 				break;
 			case BusIdlePatternSpec::H:
-				this->idle_pattern_burst = burst_t();
-				this->idle_pattern_burst.reset();
-				for (std::size_t i = 0; i < width; i++)
-				{
-					this->idle_pattern_burst.set(i, true);
-				}
+				this->idle_pattern_burst.set();
 				break;
 		}
 		this->idle_stats = diff(idle_pattern_burst, idle_pattern_burst);
@@ -89,22 +126,59 @@ public:
 
 private:
 
-	void advance_stats(timestamp_t virtual_timestamp, stats_t& stats) const {
+	void init_lanes() {
+		if (width % lane_width != 0) {
+			throw Exception("Bus width " + std::to_string(width) + " is no multiple of the lane width " + std::to_string(lane_width));
+		}
+		const std::size_t lanes = width / lane_width;
+		if (!is_swar_lane_width()) {
+			lane_masks.assign(lanes, burst_t(width));
+			for (std::size_t i = 0; i < width; ++i) {
+				lane_masks[i / lane_width].set(i);
+			}
+		}
+		lane_idle_stats = stats_t{};
+		if (BusIdlePatternSpec::H == idle_pattern) {
+			lane_idle_stats.ones = lane_width;
+		} else {
+			lane_idle_stats.zeroes = lane_width;
+		}
+		lane_stats.assign(lanes, stats_t{});
+		lane_pending_stats.assign(lanes, lane_idle_stats);
+	}
+
+	bool is_swar_lane_width() const {
+		return lane_width >= 2 && lane_width <= 64 && 0 == (lane_width & (lane_width - 1));
+	}
+
+	template <typename Sink>
+	void advance_stats(timestamp_t virtual_timestamp, Sink& sink) const {
 		// Advance counters to new timestamp
 		timestamp_t burstStorageEndTime = this->burst_storage.endTime();
 		// Burst storage
 		timestamp_t lastburstEnd = std::min(burstStorageEndTime, virtual_timestamp);
 		for (timestamp_t t = this->last_load; 0 != lastburstEnd && t < lastburstEnd - 1; ++t) {
-			stats += diff(this->at(t), this->at(t + 1)); // Last: (virtual_timestamp - 2, virtual_timestamp - 1)
+			sink.diff(this->at(t), this->at(t + 1)); // Last: (virtual_timestamp - 2, virtual_timestamp - 1)
 		}
 		// Burst to idle
 		if (virtual_timestamp > burstStorageEndTime && burstStorageEndTime > 0) {
 			// Burst to idle
-			stats += diff(this->at(burstStorageEndTime - 1), this->at(burstStorageEndTime));
+			sink.diff(this->at(burstStorageEndTime - 1), this->at(burstStorageEndTime));
 		}
-		// Idle
-		if (virtual_timestamp > burstStorageEndTime) {
-			stats += (virtual_timestamp - burstStorageEndTime - 1) * idle_stats;
+		// Idle, after an enable without a load the idle cycles start at the enable timestamp
+		const timestamp_t idleStart = std::max(burstStorageEndTime, this->last_load);
+		if (virtual_timestamp > idleStart) {
+			sink.idle(virtual_timestamp - idleStart - 1);
+		}
+	}
+
+	void advance_stats(timestamp_t virtual_timestamp, stats_t& stats, std::vector<stats_t>& lanes) const {
+		if (0 == lane_width) {
+			TotalSink sink{*this, stats};
+			advance_stats(virtual_timestamp, sink);
+		} else {
+			LaneSink sink{*this, stats, lanes};
+			advance_stats(virtual_timestamp, sink);
 		}
 	}
 
@@ -115,9 +189,12 @@ private:
 		if(this->pending_stats.isPending() && this->pending_stats.getTimestamp() < virtual_timestamp)
 		{
 			this->stats += this->pending_stats.getStats();
+			for (std::size_t i = 0; i < this->lane_stats.size(); ++i) {
+				this->lane_stats[i] += this->lane_pending_stats[i];
+			}
 			this->pending_stats.clear();
 		}
-		advance_stats(virtual_timestamp, stats);
+		advance_stats(virtual_timestamp, this->stats, this->lane_stats);
 		// Pattern for pending stats (virtual_timestamp - 1, virtual_timestamp)
 		if(virtual_timestamp > 0)
 		{
@@ -131,10 +208,19 @@ private:
 		BurstStorageInsertHelper::insert_data(this->burst_storage, virtual_timestamp, width, data, n_bits);
 
 		// Adjust statistics for new data
-		this->pending_stats.setPendingStats(virtual_timestamp, diff(
-			this->last_pattern,
-			this->at(this->last_load)
-		));
+		if (0 == this->lane_width) {
+			this->pending_stats.setPendingStats(virtual_timestamp, diff(
+				this->last_pattern,
+				this->at(this->last_load)
+			));
+		} else {
+			std::fill(this->lane_pending_stats.begin(), this->lane_pending_stats.end(), stats_t{});
+			this->pending_stats.setPendingStats(virtual_timestamp, diff_lanes(
+				this->last_pattern,
+				this->at(this->last_load),
+				this->lane_pending_stats
+			));
+		}
 
 		// last pattern for idle pattern
 		if (this->burst_storage.size() != 0) {
@@ -144,6 +230,7 @@ private:
 
 public:
 	void load(timestamp_t timestamp, const uint8_t * data, std::size_t n_bits) {
+		DRAMPOWER_PROFILE_SCOPE(util::profiling::Section::BusLoad);
 		if (!this->enableflag) {
 			return;
 		}
@@ -179,7 +266,7 @@ public:
 		this->load(timestamp, bytes.data(), n_bits);
 	};
 
-	burst_t at(timestamp_t n) const
+	burst_view at(timestamp_t n) const
 	{
 		// Assert timestamp does not lie in past
 		assert(n >= last_load);
@@ -217,14 +304,25 @@ public:
 		this->last_load = timestamp * this->datarate;
 		// Add pending stats at enable timestamp
 		this->pending_stats.setPendingStats(this->last_load, idle_stats);
+		std::fill(this->lane_pending_stats.begin(), this->lane_pending_stats.end(), lane_idle_stats);
 		this->enableflag = true;
 	}
 
 	size_t get_width() const { return width; };
 
+	// Returns timestamp of the end of the last burst
+	timestamp_t get_lastburst_timestamp(bool relative_to_clock = true) const {
+		timestamp_t lastburst = this->last_load + this->burst_storage.size();
+		if (relative_to_clock) {
+			return (lastburst + this->datarate - 1) / this->datarate;
+		}
+		return lastburst;
+	};
+
 	// Get stats not including timestamp t
 	stats_t get_stats(timestamp_t timestamp) const 
 	{
+		DRAMPOWER_PROFILE_SCOPE(util::profiling::Section::BusStats);
 
 		timestamp_t t_virtual = timestamp * this->datarate;
 		assert(t_virtual >= this->last_load);
@@ -242,29 +340,121 @@ public:
 			stats += this->pending_stats.getStats();
 		}
 		if (this->enableflag) {
-			advance_stats(t_virtual, stats);
+			TotalSink sink{*this, stats};
+			advance_stats(t_virtual, sink);
 		}
 		return stats;
 	};
 
-	stats_t diff(burst_t high, burst_t low) const {
+	std::size_t get_lane_width() const { return lane_width; };
+
+	// Get the stats of every lane not including timestamp t. Empty without lanes
+	std::vector<stats_t> get_lane_stats(timestamp_t timestamp) const
+	{
+		timestamp_t t_virtual = timestamp * this->datarate;
+		assert(t_virtual >= this->last_load);
+		std::vector<stats_t> lanes = this->lane_stats;
+		if(0 == t_virtual || 0 == this->lane_width)
+		{
+			return lanes;
+		}
+
+		// Add pending stats from last load
+		if(this->pending_stats.isPending() && this->pending_stats.getTimestamp() < t_virtual)
+		{
+			for (std::size_t i = 0; i < lanes.size(); ++i) {
+				lanes[i] += this->lane_pending_stats[i];
+			}
+		}
+		if (this->enableflag) {
+			stats_t stats;
+			LaneSink sink{*this, stats, lanes};
+			advance_stats(t_virtual, sink);
+		}
+		return lanes;
+	};
+
+	stats_t diff(burst_view high, burst_view low) const {
 		stats_t stats;
-		stats.ones += util::BinaryOps::popcount(low);
-		stats.zeroes += width - stats.ones;
-		stats.bit_changes += util::BinaryOps::bit_changes(high, low);
-		stats.ones_to_zeroes += util::BinaryOps::one_to_zeroes(high, low);
-		stats.zeroes_to_ones += util::BinaryOps::zero_to_ones(high, low);
+		for (std::size_t i = 0; i < low.num_words(); ++i) {
+			const uint64_t h = high.word(i);
+			const uint64_t l = low.word(i);
+			stats.ones += util::BinaryOps::popcount(l);
+			stats.bit_changes += util::BinaryOps::bit_changes(h, l);
+			stats.ones_to_zeroes += util::BinaryOps::one_to_zeroes(h, l);
+		}
+		stats.zeroes = width - stats.ones;
+		stats.zeroes_to_ones = stats.bit_changes - stats.ones_to_zeroes;
 		return stats;
 	};
 
+	// Adds the stats of every lane to lanes and returns the aggregate stats (equal to diff(high, low))
+	stats_t diff_lanes(burst_view high, burst_view low, std::vector<stats_t>& lanes) const {
+		stats_t total;
+		auto add = [&total](stats_t& lane, uint64_t lane_width, uint64_t ones, uint64_t changes, uint64_t ones_to_zeroes, uint64_t zeroes_to_ones) {
+			lane.ones += ones;
+			lane.zeroes += lane_width - ones;
+			lane.bit_changes += changes;
+			lane.ones_to_zeroes += ones_to_zeroes;
+			lane.zeroes_to_ones += zeroes_to_ones;
+			total.ones += ones;
+			total.zeroes += lane_width - ones;
+			total.bit_changes += changes;
+			total.ones_to_zeroes += ones_to_zeroes;
+			total.zeroes_to_ones += zeroes_to_ones;
+		};
+		if (!is_swar_lane_width()) {
+			for (std::size_t lane = 0; lane < lanes.size(); ++lane) {
+				const burst_t& mask = lane_masks[lane];
+				uint64_t ones = 0, changes = 0, ones_to_zeroes = 0;
+				// Only the words the lane overlaps
+				for (std::size_t i = lane * lane_width / 64; i <= ((lane + 1) * lane_width - 1) / 64; ++i) {
+					const uint64_t h = high.word(i) & mask.word(i);
+					const uint64_t l = low.word(i) & mask.word(i);
+					ones += util::BinaryOps::popcount(l);
+					changes += util::BinaryOps::bit_changes(h, l);
+					ones_to_zeroes += util::BinaryOps::one_to_zeroes(h, l);
+				}
+				add(lanes[lane], lane_width, ones, changes, ones_to_zeroes, changes - ones_to_zeroes);
+			}
+			return total;
+		}
+		// Popcounts of all lanes of a word at once
+		const std::size_t lanes_per_word = 64 / lane_width;
+		const uint64_t field_mask = 64 == lane_width ? ~uint64_t{0} : (uint64_t{1} << lane_width) - 1;
+		for (std::size_t word = 0; word * lanes_per_word < lanes.size(); ++word) {
+			const uint64_t h = high.word(word);
+			const uint64_t l = low.word(word);
+			const uint64_t ones = util::BinaryOps::popcount_fields(l, lane_width);
+			const uint64_t changes = util::BinaryOps::popcount_fields(h ^ l, lane_width);
+			const uint64_t ones_to_zeroes = util::BinaryOps::popcount_fields(h & ~l, lane_width);
+			const uint64_t zeroes_to_ones = util::BinaryOps::popcount_fields(~h & l, lane_width);
+			const std::size_t end = std::min(lanes.size(), (word + 1) * lanes_per_word);
+			for (std::size_t lane = word * lanes_per_word, shift = 0; lane < end; ++lane, shift += lane_width) {
+				add(lanes[lane], lane_width,
+					(ones >> shift) & field_mask,
+					(changes >> shift) & field_mask,
+					(ones_to_zeroes >> shift) & field_mask,
+					(zeroes_to_ones >> shift) & field_mask
+				);
+			}
+		}
+		return total;
+	};
+
 	void serialize(std::ostream& stream) const override {
 		this->stats.serialize(stream);
 		this->burst_storage.serialize(stream);
 		stream.write(reinterpret_cast<const char*>(&this->last_load), sizeof(this->last_load));
 		stream.write(reinterpret_cast<const char*>(&this->enableflag), sizeof(this->enableflag));
 		stream.write(reinterpret_cast<const char*>(&this->virtual_disable_timestamp), sizeof(this->virtual_disable_timestamp));
-		stream.write(reinterpret_cast<const char*>(&this->last_pattern), sizeof(this->last_pattern));
+		stream.write(reinterpret_cast<const char*>(this->last_pattern.data()), this->last_pattern.num_words() * sizeof(uint64_t));
 		this->pending_stats.serialize(stream);
+		// Only buses with lanes
+		for (std::size_t i = 0; i < this->lane_stats.size(); ++i) {
+			this->lane_stats[i].serialize(stream);
+			this->lane_pending_stats[i].serialize(stream);
+		}
 	};
 
 	void deserialize(std::istream& stream) override {
@@ -273,8 +463,12 @@ public:
 		stream.read(reinterpret_cast<char*>(&this->last_load), sizeof(this->last_load));
 		stream.read(reinterpret_cast<char*>(&this->enableflag), sizeof(this->enableflag));
 		stream.read(reinterpret_cast<char*>(&this->virtual_disable_timestamp), sizeof(this->virtual_disable_timestamp));
-		stream.read(reinterpret_cast<char*>(&this->last_pattern), sizeof(this->last_pattern));
+		stream.read(reinterpret_cast<char*>(this->last_pattern.data()), this->last_pattern.num_words() * sizeof(uint64_t));
 		this->pending_stats.deserialize(stream);
+		for (std::size_t i = 0; i < this->lane_stats.size(); ++i) {
+			this->lane_stats[i].deserialize(stream);
+			this->lane_pending_stats[i].deserialize(stream);
+		}
 	};
 };
 
@@ -32,6 +32,15 @@ struct bus_stats_t :public Serialize, public Deserialize {
 		return *this;
 	};
 
+	bus_stats_t& operator-=(const bus_stats_t& rhs) {
+		this->bit_changes -= rhs.bit_changes;
+		this->ones -= rhs.ones;
+		this->zeroes -= rhs.zeroes;
+		this->ones_to_zeroes -= rhs.ones_to_zeroes;
+		this->zeroes_to_ones -= rhs.zeroes_to_ones;
+		return *this;
+	};
+
 	bus_stats_t& operator*=(const uint64_t rhs) {
 		this->bit_changes *= rhs;
 		this->ones *= rhs;
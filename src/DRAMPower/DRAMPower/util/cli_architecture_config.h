@@ -9,6 +9,8 @@ struct CLIArchitectureConfig {
     uint64_t deviceCount;
     uint64_t rankCount;
     uint64_t bankCount;
+    // Banks per bank group, 0 if the banks are not grouped
+    uint64_t banksPerGroup = 0;
 };
 
 };
@@ -0,0 +1,168 @@
+#ifndef DRAMPOWER_UTIL_COMMAND_ENERGY_H
+#define DRAMPOWER_UTIL_COMMAND_ENERGY_H
+
+#include <DRAMPower/Types.h>
+#include <DRAMPower/command/Command.h>
+#include <DRAMPower/data/core_energy_coefficients.h>
+#include <DRAMPower/data/energy.h>
+#include <DRAMPower/data/stats.h>
+#include <DRAMPower/dram/Rank.h>
+#include <DRAMPower/util/command_observer.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+
+namespace DRAMPower::util {
+
+struct command_energy_t {
+    double core = 0.0;
+    double interface = 0.0;
+
+    double total() const { return core + interface; }
+};
+
+/** Observer for ObservedDRAM which attributes the energy to the commands
+ * The energy of a command is the energy accrued since the previous command up to its timestamp.
+ * It includes the background energy of the gap and the implicit commands executed in it.
+ * The core energy is tracked per rank with CoreEnergyCoefficients as energy at the latest state change
+ * plus the power of the current state. A command re-evaluates only the rank it targets, independent of
+ * the number of ranks and of the length of the trace. Implicit commands re-evaluate all ranks, including
+ * the ones executed outside of a command by a stats query on the core (e.g. calcCoreEnergy).
+ * The interface energy is evaluated from the interface stats alone.
+ * The energy is reported to the callback after the interface handled the command.
+ */
+class CommandEnergyAttribution {
+// Public type definitions
+public:
+    using callback_t = std::function<void(const Command&, const command_energy_t&)>;
+    using interface_calc_t = std::function<interface_energy_info_t(const SimulationStats&)>;
+
+// Public member functions
+public:
+    static constexpr CommandHook getSupportedHooks() {
+        return CommandHook::PostCore | CommandHook::PostInterface;
+    }
+
+    // Must be called before the first command is observed. dram must outlive the attribution.
+    template <typename DRAM>
+    void attach(const DRAM &dram, callback_t callback = {}) {
+        const auto &ranks = dram.getCore().getRanks();
+        SimulationStats shape;
+        shape.rank_total.resize(ranks.size());
+        shape.bank.resize(ranks.size() * (ranks.empty() ? 0 : ranks.front().banks.size()));
+        m_coefficients = CoreEnergyCoefficients(dram, shape);
+        m_calcInterfaceEnergy = [&dram](const SimulationStats &stats) {
+            return dram.calcInterfaceEnergyStats(stats);
+        };
+        m_callback = std::move(callback);
+
+        m_timestamp = dram.getLastCommandTime();
+        m_implicitCommands = dram.getCore().implicitCommandsExecuted();
+        m_rankEnergy.assign(ranks.size(), {});
+        m_base = 0.0;
+        m_power = 0.0;
+        updateRanks(ranks);
+        m_coreEnergy = coreEnergy();
+        m_interfaceEnergy = interfaceEnergy(dram.getInterface());
+        m_pending = {};
+        m_total = {};
+    }
+
+    void setCallback(callback_t callback) { m_callback = std::move(callback); }
+
+    // Sum of the energy of all attributed commands
+    const command_energy_t &getTotal() const { return m_total; }
+    const CoreEnergyCoefficients &getCoefficients() const { return m_coefficients; }
+
+// Hooks
+public:
+    template <typename Core>
+    void postCore(const Command &command, const Core &core) {
+        const auto &ranks = core.getRanks();
+        m_timestamp = std::max(m_timestamp, command.timestamp);
+        const std::size_t rank_idx = command.targetCoordinate.rank;
+        // Implicit commands may have run in this command or in a stats query since the previous one
+        const uint64_t implicitCommands = core.implicitCommandsExecuted();
+        if (implicitCommands != m_implicitCommands || CmdType::END_OF_SIMULATION == command.type || rank_idx >= ranks.size()) {
+            updateRanks(ranks);
+        } else {
+            updateRank(rank_idx, ranks[rank_idx]);
+        }
+        m_implicitCommands = implicitCommands;
+
+        const double energy = coreEnergy();
+        m_pending.core += energy - m_coreEnergy;
+        m_coreEnergy = energy;
+    }
+
+    template <typename Interface>
+    void postInterface(const Command &command, const Interface &interface) {
+        m_timestamp = std::max(m_timestamp, command.timestamp);
+        const double energy = interfaceEnergy(interface);
+        m_pending.interface += energy - m_interfaceEnergy;
+        m_interfaceEnergy = energy;
+
+        m_total.core += m_pending.core;
+        m_total.interface += m_pending.interface;
+        if (m_callback) {
+            m_callback(command, m_pending);
+        }
+        m_pending = {};
+    }
+
+// Private member functions
+private:
+    void updateRank(std::size_t rank_idx, const Rank &rank) {
+        const CoreEnergyCoefficients::rank_energy_t evaluated = m_coefficients.evaluate(rank, m_timestamp);
+        // Energy extrapolated to timestamp 0 with the power of the current state
+        const double base = evaluated.energy - evaluated.power * static_cast<double>(m_timestamp);
+        m_base += base - m_rankEnergy[rank_idx].energy;
+        m_power += evaluated.power - m_rankEnergy[rank_idx].power;
+        m_rankEnergy[rank_idx] = {base, evaluated.power};
+    }
+
+    template <typename Ranks>
+    void updateRanks(const Ranks &ranks) {
+        for (std::size_t rank_idx = 0; rank_idx < ranks.size(); ++rank_idx) {
+            updateRank(rank_idx, ranks[rank_idx]);
+        }
+    }
+
+    double coreEnergy() const {
+        return m_base + m_power * static_cast<double>(m_timestamp);
+    }
+
+    template <typename Interface>
+    double interfaceEnergy(const Interface &interface) const {
+        // The interface accumulates some fields, start from empty stats
+        SimulationStats stats;
+        interface.getWindowStats(m_timestamp, stats);
+        return m_calcInterfaceEnergy(stats).total();
+    }
+
+// Private member variables
+private:
+    CoreEnergyCoefficients m_coefficients;
+    interface_calc_t m_calcInterfaceEnergy;
+    callback_t m_callback;
+
+    timestamp_t m_timestamp = 0;
+    // Per rank energy extrapolated to timestamp 0 and power
+    std::vector<CoreEnergyCoefficients::rank_energy_t> m_rankEnergy;
+    double m_base = 0.0;
+    double m_power = 0.0;
+    double m_coreEnergy = 0.0;
+    double m_interfaceEnergy = 0.0;
+
+    command_energy_t m_pending;
+    command_energy_t m_total;
+    uint64_t m_implicitCommands = 0;
+};
+
+} // namespace DRAMPower::util
+
+#endif /* DRAMPOWER_UTIL_COMMAND_ENERGY_H */
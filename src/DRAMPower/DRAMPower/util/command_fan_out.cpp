@@ -0,0 +1,110 @@
+#include "command_fan_out.h"
+
+#include <DRAMPower/Exceptions.h>
+
+#include <algorithm>
+#include <limits>
+
+using namespace DRAMPower;
+using namespace DRAMPower::util;
+
+namespace {
+
+constexpr std::size_t NO_DATA = std::numeric_limits<std::size_t>::max();
+
+} // namespace
+
+void CommandBatch::push(const Command &command)
+{
+    m_commands.push_back(command);
+    m_commands.back().data = nullptr;
+    if (nullptr == command.data) {
+        m_offsets.push_back(NO_DATA);
+        return;
+    }
+    m_offsets.push_back(m_data.size());
+    m_data.insert(m_data.end(), command.data, command.data + (command.sz_bits + 7) / 8);
+}
+
+void CommandBatch::seal()
+{
+    for (std::size_t i = 0; i < m_commands.size(); ++i) {
+        if (NO_DATA != m_offsets[i]) {
+            m_commands[i].data = m_data.data() + m_offsets[i];
+        }
+    }
+}
+
+void CommandBatch::clear()
+{
+    m_commands.clear();
+    m_offsets.clear();
+    m_data.clear();
+}
+
+CommandBatchRing::CommandBatchRing(std::size_t consumers, std::size_t capacity)
+    : m_slots(capacity)
+    , m_positions(consumers, 0)
+    , m_detached(consumers, false)
+{
+    if (0 == capacity) {
+        throw Exception("CommandBatchRing: the capacity must not be zero");
+    }
+}
+
+uint64_t CommandBatchRing::slowestPosition() const
+{
+    uint64_t position = m_head;
+    for (std::size_t i = 0; i < m_positions.size(); ++i) {
+        if (!m_detached[i]) {
+            position = std::min(position, m_positions[i]);
+        }
+    }
+    return position;
+}
+
+void CommandBatchRing::push(batch_t batch)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if (m_closed) {
+        throw Exception("CommandBatchRing: push after close");
+    }
+    m_consumed.wait(lock, [this]() { return m_head - slowestPosition() < m_slots.size(); });
+    m_slots[m_head % m_slots.size()] = std::move(batch);
+    ++m_head;
+    lock.unlock();
+    m_produced.notify_all();
+}
+
+void CommandBatchRing::close()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_closed = true;
+    }
+    m_produced.notify_all();
+}
+
+CommandBatchRing::batch_t CommandBatchRing::pop(std::size_t consumer)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    uint64_t &position = m_positions.at(consumer);
+    m_produced.wait(lock, [this, &position]() { return position < m_head || m_closed; });
+    if (position == m_head) {
+        return nullptr;
+    }
+    batch_t batch = m_slots[position % m_slots.size()];
+    ++position;
+    lock.unlock();
+    m_consumed.notify_one();
+    return batch;
+}
+
+void CommandBatchRing::detach(std::size_t consumer)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_detached.at(consumer) = true;
+    }
+    m_consumed.notify_one();
+}
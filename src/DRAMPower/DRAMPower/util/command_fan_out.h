@@ -0,0 +1,160 @@
+#ifndef DRAMPOWER_UTIL_COMMAND_FAN_OUT_H
+#define DRAMPOWER_UTIL_COMMAND_FAN_OUT_H
+
+#include <DRAMPower/Types.h>
+#include <DRAMPower/command/Command.h>
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace DRAMPower::util {
+
+// Commands with their data in one contiguous buffer
+class CommandBatch {
+// Public member functions
+public:
+    // Copies the command and its data into the batch
+    void push(const Command &command);
+    // Resolves the data pointers of the commands. Must be called after the last push.
+    void seal();
+    void clear();
+
+    const std::vector<Command>& commands() const { return m_commands; }
+    std::size_t size() const { return m_commands.size(); }
+    bool empty() const { return m_commands.empty(); }
+
+// Private member variables
+private:
+    std::vector<Command> m_commands;
+    // Offsets of the command data in m_data
+    std::vector<std::size_t> m_offsets;
+    std::vector<uint8_t> m_data;
+};
+
+// Bounded ring which broadcasts batches from one producer to a fixed number of consumers.
+// A slot is reused after every attached consumer popped its batch, so the producer blocks
+// on the slowest consumer. A detached consumer doesn't hold back the producer.
+class CommandBatchRing {
+// Public type definitions
+public:
+    using batch_t = std::shared_ptr<const CommandBatch>;
+
+// Public constructors and assignment operators
+public:
+    CommandBatchRing(std::size_t consumers, std::size_t capacity);
+
+    CommandBatchRing(const CommandBatchRing&) = delete;
+    CommandBatchRing& operator=(const CommandBatchRing&) = delete;
+
+// Public member functions
+public:
+    std::size_t consumers() const { return m_positions.size(); }
+    std::size_t capacity() const { return m_slots.size(); }
+
+    // Producer
+    // Blocks until the slot of the batch is released by all consumers
+    void push(batch_t batch);
+    // Ends the stream
+    void close();
+
+    // Consumer
+    // Blocks until the next batch is available. Returns nullptr at the end of the stream.
+    batch_t pop(std::size_t consumer);
+    // The consumer stops consuming
+    void detach(std::size_t consumer);
+
+// Private member functions
+private:
+    uint64_t slowestPosition() const;
+
+// Private member variables
+private:
+    std::mutex m_mutex;
+    std::condition_variable m_produced;
+    std::condition_variable m_consumed;
+    std::vector<batch_t> m_slots;
+    // Number of pushed batches
+    uint64_t m_head = 0;
+    // Number of popped batches per consumer
+    std::vector<uint64_t> m_positions;
+    std::vector<bool> m_detached;
+    bool m_closed = false;
+};
+
+struct FanOutResult {
+    uint64_t commandCount = 0;
+    // Exception of every dram which failed, nullptr if the dram finished the stream
+    std::vector<std::exception_ptr> errors;
+};
+
+// Decodes a command stream once and simulates it on several drams in parallel.
+// The producer is called on the calling thread with an emit function, which it calls
+// for every command in order. The commands are copied into batches of batchSize commands
+// and broadcast through a ring of ringCapacity batches to one worker thread per dram.
+// A failing dram stops its worker without affecting the other drams, an exception of
+// the producer is rethrown after all workers finished.
+template <typename DRAM, typename Producer>
+FanOutResult fanOut(const std::vector<DRAM *> &drams, Producer &&producer,
+    std::size_t batchSize = 4096, std::size_t ringCapacity = 8)
+{
+    FanOutResult result;
+    result.errors.resize(drams.size());
+    CommandBatchRing ring(drams.size(), ringCapacity);
+
+    std::vector<std::thread> workers;
+    workers.reserve(drams.size());
+    for (std::size_t i = 0; i < drams.size(); ++i) {
+        workers.emplace_back([&ring, &result, &drams, i]() {
+            try {
+                while (auto batch = ring.pop(i)) {
+                    for (const Command &command : batch->commands()) {
+                        drams[i]->doCommand(command);
+                    }
+                }
+            } catch (...) {
+                result.errors[i] = std::current_exception();
+                ring.detach(i);
+            }
+        });
+    }
+
+    std::exception_ptr producerError;
+    try {
+        auto batch = std::make_shared<CommandBatch>();
+        auto emit = [&ring, &batch, &result, batchSize](const Command &command) {
+            batch->push(command);
+            ++result.commandCount;
+            if (batch->size() >= batchSize) {
+                batch->seal();
+                ring.push(std::move(batch));
+                batch = std::make_shared<CommandBatch>();
+            }
+        };
+        producer(emit);
+        if (!batch->empty()) {
+            batch->seal();
+            ring.push(std::move(batch));
+        }
+    } catch (...) {
+        producerError = std::current_exception();
+    }
+    ring.close();
+    for (auto &worker : workers) {
+        worker.join();
+    }
+    if (producerError) {
+        std::rethrow_exception(producerError);
+    }
+    return result;
+}
+
+} // namespace DRAMPower::util
+
+#endif /* DRAMPOWER_UTIL_COMMAND_FAN_OUT_H */
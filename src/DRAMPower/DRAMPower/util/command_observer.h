@@ -0,0 +1,141 @@
+#ifndef DRAMPOWER_UTIL_COMMAND_OBSERVER_H
+#define DRAMPOWER_UTIL_COMMAND_OBSERVER_H
+
+#include <DRAMPower/Types.h>
+#include <DRAMPower/command/Command.h>
+#include <DRAMPower/util/extension_manager_static.h>
+
+#include <DRAMUtils/util/types.h>
+
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+namespace DRAMPower {
+
+template <typename Standard>
+struct StaticDispatch;
+
+} // namespace DRAMPower
+
+namespace DRAMPower::util {
+
+// Hook points of the command path
+enum class CommandHook : uint8_t {
+    None = 0,
+    // Before the core handles a command: preCommand(const Command&)
+    PreCommand = 1 << 0,
+    // After every implicit command executed by the core: implicitEvent(timestamp_t, const Core&)
+    ImplicitEvent = 1 << 1,
+    // After the core handled a command: postCore(const Command&, const Core&)
+    PostCore = 1 << 2,
+    // After the interface handled a command: postInterface(const Command&, const Interface&)
+    PostInterface = 1 << 3,
+};
+
+constexpr CommandHook operator|(CommandHook lhs, CommandHook rhs) {
+    return static_cast<CommandHook>(static_cast<std::underlying_type_t<CommandHook>>(lhs)
+        | static_cast<std::underlying_type_t<CommandHook>>(rhs));
+}
+
+constexpr CommandHook operator&(CommandHook lhs, CommandHook rhs) {
+    return static_cast<CommandHook>(static_cast<std::underlying_type_t<CommandHook>>(lhs)
+        & static_cast<std::underlying_type_t<CommandHook>>(rhs));
+}
+
+/** Standard with compile-time command observers
+ * Template arguments:
+ * - Standard: DDR4, DDR5, LPDDR4, LPDDR5 or LPDDR6
+ * - Observers: default constructible types with
+ *   static constexpr CommandHook getSupportedHooks() and the member functions of the supported hooks
+ * The observers are called through a StaticExtensionManager. Hooks without observers are compiled out,
+ * ObservedDRAM<Standard> behaves exactly like Standard. Observers are not part of the serialized state.
+ */
+template <typename Standard, typename... Observers>
+class ObservedDRAM final : public Standard {
+// Friend classes
+friend struct StaticDispatch<ObservedDRAM>;
+
+// Public type definitions
+public:
+    using standard_t = Standard;
+    using observer_manager_t = extension_manager_static::StaticExtensionManager<
+        DRAMUtils::util::type_sequence<Observers...>,
+        CommandHook
+    >;
+
+// Public constructors and assignment operators
+public:
+    // The core and interface register callbacks on this, copies are not supported
+    ObservedDRAM(const ObservedDRAM&) = delete;
+    ObservedDRAM& operator=(const ObservedDRAM&) = delete;
+    ObservedDRAM(ObservedDRAM&&) = delete;
+    ObservedDRAM& operator=(ObservedDRAM&&) = delete;
+    ~ObservedDRAM() override = default;
+
+    template <typename... Args>
+    explicit ObservedDRAM(Args&&... args)
+        : Standard(std::forward<Args>(args)...)
+    {}
+
+// Public member functions
+public:
+    template <typename Observer>
+    constexpr static bool hasObserver() {
+        return observer_manager_t::template hasExtension<Observer>();
+    }
+
+    template <typename Observer>
+    Observer& getObserver() {
+        return m_observers.template getExtension<Observer>();
+    }
+
+    template <typename Observer>
+    const Observer& getObserver() const {
+        return m_observers.template getExtension<Observer>();
+    }
+
+// Private member functions
+private:
+    template <CommandHook hook>
+    constexpr static bool isObserved() {
+        return ((CommandHook::None != (Observers::getSupportedHooks() & hook)) || ...);
+    }
+
+// Overrides
+private:
+    void doCoreCommandImpl(const Command& command) override {
+        m_observers.template callHook<CommandHook::PreCommand>([&command](auto& observer) {
+            observer.preCommand(command);
+        });
+        auto& core = this->getCore();
+        if constexpr (isObserved<CommandHook::ImplicitEvent>()) {
+            // Execute the implicit commands before the core does to observe them one by one
+            core.processImplicitCommands(command.timestamp, [this, &core](timestamp_t timestamp) {
+                m_observers.template callHook<CommandHook::ImplicitEvent>([timestamp, &core](auto& observer) {
+                    observer.implicitEvent(timestamp, std::as_const(core));
+                });
+            });
+        }
+        core.doCommand(command);
+        m_observers.template callHook<CommandHook::PostCore>([&command, &core](auto& observer) {
+            observer.postCore(command, std::as_const(core));
+        });
+    }
+
+    void doInterfaceCommandImpl(const Command& command) override {
+        auto& interface = this->getInterface();
+        interface.doCommand(command);
+        m_observers.template callHook<CommandHook::PostInterface>([&command, &interface](auto& observer) {
+            observer.postInterface(command, std::as_const(interface));
+        });
+    }
+
+// Private member variables
+private:
+    observer_manager_t m_observers;
+};
+
+} // namespace DRAMPower::util
+
+#endif /* DRAMPOWER_UTIL_COMMAND_OBSERVER_H */
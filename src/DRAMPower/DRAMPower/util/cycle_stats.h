@@ -14,13 +14,19 @@ template<typename T>
 class interval_counter : public Serialize, public Deserialize
 {
 private:
-	T count{ 0 };
+	// Flags instead of std::optional keep the counter at three words
+	enum : uint8_t {
+		HAS_START = 1 << 0,
+		HAS_END = 1 << 1,
+	};
 
-	std::optional<T> start;
-	std::optional<T> end;
+	T count{ 0 };
+	T start{ 0 };
+	T end{ 0 };
+	uint8_t flags{ 0 };
 public:
 	interval_counter() = default;
-	interval_counter(T start) : start(start) {};
+	interval_counter(T start) : start(start), flags(HAS_START) {};
 
 	interval_counter(const interval_counter<T>&) = default;
 	interval_counter& operator=(const interval_counter<T>&) = default;
@@ -28,19 +34,19 @@ public:
 	interval_counter(interval_counter<T>&&) = default;
 	interval_counter& operator=(interval_counter<T>&&) = default;
 public:
-	T get_start() const { return start.value_or(0); };
-	T get_end() const { return end.value_or(0); };
+	T get_start() const { return hasStart() ? start : T{ 0 }; };
+	T get_end() const { return hasEnd() ? end : T{ 0 }; };
 public:
-	bool is_open() const { return start && !end; };
-	bool is_closed() const { return start && end; };
+	bool is_open() const { return hasStart() && !hasEnd(); };
+	bool is_closed() const { return hasStart() && hasEnd(); };
 
 	T get_count() const { 
 		return count;
 	};
 
 	T get_count_at(T timestamp) const { 
-		if (is_open() && timestamp > *start)
-			return count + timestamp - *start;
+		if (is_open() && timestamp > start)
+			return count + timestamp - start;
 
 		return get_count();
 	}
@@ -54,20 +60,20 @@ public:
 			return T{ 0 };
 
 		end = timestamp;
-		auto diff = timestamp - *start;
+		flags |= HAS_END;
+		auto diff = timestamp - start;
 		count += diff;
 
 		return diff;
 	}
 
 	void reset_interval() {
-		this->start.reset();
-		this->end.reset();
+		this->flags = 0;
 	}
 
 	void start_interval(T start) {
 		this->start = start;
-		this->end.reset();
+		this->flags = HAS_START;
 	}
 
 	void start_interval_if_not_running(T start) {
@@ -75,36 +81,45 @@ public:
 			start_interval(start);
 	}
 
+	// The serialized format stores start and end as std::optional
 	void serialize(std::ostream& stream) const override  {
 		stream.write(reinterpret_cast<const char *>(&count), sizeof(count));
-		bool starthasValue = start.has_value();
+		bool starthasValue = hasStart();
 		stream.write(reinterpret_cast<const char *>(&starthasValue), sizeof(starthasValue));
 		if (starthasValue) {
-			stream.write(reinterpret_cast<const char *>(&start), sizeof(start));
+			std::optional<T> value = start;
+			stream.write(reinterpret_cast<const char *>(&value), sizeof(value));
 		}
-		bool endhasValue = end.has_value();
+		bool endhasValue = hasEnd();
 		stream.write(reinterpret_cast<const char *>(&endhasValue), sizeof(endhasValue));
 		if (endhasValue) {
-			stream.write(reinterpret_cast<const char *>(&end), sizeof(end));
+			std::optional<T> value = end;
+			stream.write(reinterpret_cast<const char *>(&value), sizeof(value));
 		}
 	}
 	void deserialize(std::istream& stream) override {
 		stream.read(reinterpret_cast<char *>(&count), sizeof(count));
+		flags = 0;
 		bool starthasValue = false;
 		stream.read(reinterpret_cast<char *>(&starthasValue), sizeof(starthasValue));
 		if (starthasValue) {
-			stream.read(reinterpret_cast<char *>(&start), sizeof(start));
-		} else {
-			start.reset();
+			std::optional<T> value;
+			stream.read(reinterpret_cast<char *>(&value), sizeof(value));
+			start = value.value_or(T{ 0 });
+			flags |= HAS_START;
 		}
 		bool endhasValue = false;
 		stream.read(reinterpret_cast<char *>(&endhasValue), sizeof(endhasValue));
 		if (endhasValue) {
-			stream.read(reinterpret_cast<char *>(&end), sizeof(end));
-		} else {
-			end.reset();
+			std::optional<T> value;
+			stream.read(reinterpret_cast<char *>(&value), sizeof(value));
+			end = value.value_or(T{ 0 });
+			flags |= HAS_END;
 		}
 	}
+private:
+	bool hasStart() const { return 0 != (flags & HAS_START); }
+	bool hasEnd() const { return 0 != (flags & HAS_END); }
 };
 
 }
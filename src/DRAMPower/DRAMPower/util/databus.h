@@ -4,8 +4,11 @@
 #include "DRAMPower/Exceptions.h"
 #include "DRAMPower/util/bus_types.h"
 #include <cstddef>
+#include <memory>
+#include <sstream>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 
 #include <DRAMPower/util/bus.h>
@@ -21,11 +24,13 @@
 namespace DRAMPower::util {
 
 // DataBus class
-template<std::size_t max_bitset_size = 0>
+// Only the half of the active mode is allocated. The bus half is created with the first enableBus
+// and the toggling rate half with the first enableTogglingRate. A missing half has the stats of a
+// half which was disabled from the start, i.e. none.
 class DataBus : public Serialize, public Deserialize {
 
 public:
-    using Bus_t = util::Bus<max_bitset_size>;
+    using Bus_t = util::Bus;
     using IdlePattern_t = util::BusIdlePatternSpec;
 
 static constexpr BusIdlePatternSpec convertIdlePattern(const DRAMUtils::Config::TogglingRateIdlePattern idlePattern) {
@@ -41,94 +46,119 @@ static constexpr BusIdlePatternSpec convertIdlePattern(const DRAMUtils::Config::
     return BusIdlePatternSpec::L; // Unreachable
 }
 
+private:
+    struct BusHalf {
+        Bus_t read;
+        Bus_t write;
+    };
+
+    struct TogglingHalf {
+        TogglingHandle read;
+        TogglingHandle write;
+    };
+
 // BusInitPatternSpec
 public:
     DataBus(DataBusConfig&& config, DataBusMode mode)
-        : busRead(
-            config.width,
-            config.dataRate,
-            convertIdlePattern(config.toggleRateConf.idlePatternRead),
-            DataBusMode::Bus == mode
-        )
-        , busWrite(
-            config.width,
-            config.dataRate,
-            convertIdlePattern(config.toggleRateConf.idlePatternWrite),
-            DataBusMode::Bus == mode
-        )
-        , togglingHandleRead(
-            config.width,
-            config.dataRate,
-            config.toggleRateConf.togglingRateRead,
-            config.toggleRateConf.dutyCycleRead,
-            config.toggleRateConf.idlePatternRead,
-            DataBusMode::TogglingRate == mode
-        )
-        , togglingHandleWrite(
-            config.width,
-            config.dataRate,
-            config.toggleRateConf.togglingRateWrite,
-            config.toggleRateConf.dutyCycleWrite,
-            config.toggleRateConf.idlePatternWrite,
-            DataBusMode::TogglingRate == mode
-        )
+        : toggleRateConf(config.toggleRateConf)
+        , idlePatternRead(convertIdlePattern(config.toggleRateConf.idlePatternRead))
+        , idlePatternWrite(convertIdlePattern(config.toggleRateConf.idlePatternWrite))
         , busType(mode)
         , dataRate(config.dataRate)
         , width(config.width)
-    {}
+        , laneWidth(config.laneWidth)
+    {
+        switch(mode) {
+            case DataBusMode::Bus:
+                buses = makeBuses(true);
+                break;
+            case DataBusMode::TogglingRate:
+                togglingHandles = makeTogglingHandles(true);
+                break;
+        }
+    }
 
 private:
-    void load(Bus_t &bus, TogglingHandle &togglingHandle, timestamp_t timestamp, std::size_t n_bits, const uint8_t *data = nullptr) {
+    std::unique_ptr<BusHalf> makeBuses(bool enable) const {
+        return std::make_unique<BusHalf>(BusHalf{
+            Bus_t{width, dataRate, idlePatternRead, enable, laneWidth},
+            Bus_t{width, dataRate, idlePatternWrite, enable, laneWidth},
+        });
+    }
+
+    std::unique_ptr<TogglingHalf> makeTogglingHandles(bool enable) const {
+        return std::make_unique<TogglingHalf>(TogglingHalf{
+            TogglingHandle{width, dataRate, toggleRateConf.togglingRateRead, toggleRateConf.dutyCycleRead,
+                toggleRateConf.idlePatternRead, enable},
+            TogglingHandle{width, dataRate, toggleRateConf.togglingRateWrite, toggleRateConf.dutyCycleWrite,
+                toggleRateConf.idlePatternWrite, enable},
+        });
+    }
+
+    void load(bool read, timestamp_t timestamp, std::size_t n_bits, const uint8_t *data = nullptr) {
         switch(busType) {
             case DataBusMode::Bus: {
                 if (nullptr == data || 0 == n_bits) {
                     // No data to load, skip burst
                     return;
                 }
-                bus.load(timestamp, data, n_bits);
+                (read ? buses->read : buses->write).load(timestamp, data, n_bits);
                 break;
             }
             case DataBusMode::TogglingRate:
-                togglingHandle.incCountBitLength(timestamp, n_bits);
+                (read ? togglingHandles->read : togglingHandles->write).incCountBitLength(timestamp, n_bits);
                 break;
         }
     }
 
 public:
     void loadWrite(timestamp_t timestamp, std::size_t n_bits, const uint8_t *data = nullptr) {
-        load(busWrite, togglingHandleWrite, timestamp, n_bits, data);
+        load(false, timestamp, n_bits, data);
     }
     void loadRead(timestamp_t timestamp, std::size_t n_bits, const uint8_t *data = nullptr) {
-        load(busRead, togglingHandleRead, timestamp, n_bits, data);
+        load(true, timestamp, n_bits, data);
     }
 
     void enableBus(timestamp_t timestamp) {
-        busRead.enable(timestamp);
-        busWrite.enable(timestamp);
-        togglingHandleRead.disable(timestamp);
-        togglingHandleWrite.disable(timestamp);
+        if (!buses) {
+            buses = makeBuses(false);
+        }
+        buses->read.enable(timestamp);
+        buses->write.enable(timestamp);
+        if (togglingHandles) {
+            togglingHandles->read.disable(timestamp);
+            togglingHandles->write.disable(timestamp);
+        }
         busType = DataBusMode::Bus;
     }
 
     void enableTogglingRate(timestamp_t timestamp) {
-        busRead.disable(timestamp);
-        busWrite.disable(timestamp);
-        togglingHandleRead.enable(timestamp);
-        togglingHandleWrite.enable(timestamp);
+        if (buses) {
+            buses->read.disable(timestamp);
+            buses->write.disable(timestamp);
+        }
+        if (!togglingHandles) {
+            togglingHandles = makeTogglingHandles(false);
+        }
+        togglingHandles->read.enable(timestamp);
+        togglingHandles->write.enable(timestamp);
         busType = DataBusMode::TogglingRate;
     }
 
     void setTogglingRateDefinition(DRAMUtils::Config::ToggleRateDefinition toggleratedefinition) {
-        togglingHandleRead.setTogglingRateAndDutyCycle(toggleratedefinition.togglingRateRead, toggleratedefinition.dutyCycleRead, toggleratedefinition.idlePatternRead);
-        togglingHandleWrite.setTogglingRateAndDutyCycle(toggleratedefinition.togglingRateWrite, toggleratedefinition.dutyCycleWrite, toggleratedefinition.idlePatternWrite);
+        toggleRateConf = toggleratedefinition;
+        if (togglingHandles) {
+            togglingHandles->read.setTogglingRateAndDutyCycle(toggleratedefinition.togglingRateRead, toggleratedefinition.dutyCycleRead, toggleratedefinition.idlePatternRead);
+            togglingHandles->write.setTogglingRateAndDutyCycle(toggleratedefinition.togglingRateWrite, toggleratedefinition.dutyCycleWrite, toggleratedefinition.idlePatternWrite);
+        }
     }
 
     timestamp_t lastBurst() const {
         switch(busType) {
             case DataBusMode::Bus:
-                return std::max(busWrite.get_lastburst_timestamp(), busRead.get_lastburst_timestamp());
+                return std::max(buses->write.get_lastburst_timestamp(), buses->read.get_lastburst_timestamp());
             case DataBusMode::TogglingRate:
-                return std::max(togglingHandleRead.get_lastburst_timestamp(), togglingHandleWrite.get_lastburst_timestamp());
+                return std::max(togglingHandles->read.get_lastburst_timestamp(), togglingHandles->write.get_lastburst_timestamp());
         }
         assert(false);
         return 0;
@@ -156,36 +186,100 @@ public:
         util::bus_stats_t &togglingHandleReadStats,
         util::bus_stats_t &togglingHandleWriteStats) const
     {
-        busReadStats += busRead.get_stats(timestamp);
-        busWriteStats += busWrite.get_stats(timestamp);
-        togglingHandleReadStats += togglingHandleRead.get_stats(timestamp);
-        togglingHandleWriteStats += togglingHandleWrite.get_stats(timestamp);
+        if (buses) {
+            busReadStats += buses->read.get_stats(timestamp);
+            busWriteStats += buses->write.get_stats(timestamp);
+        }
+        if (togglingHandles) {
+            togglingHandleReadStats += togglingHandles->read.get_stats(timestamp);
+            togglingHandleWriteStats += togglingHandles->write.get_stats(timestamp);
+        }
     }
 
+    // Stats of every lane of the bus. Only the bus mode has lane stats
+    void get_lane_stats(timestamp_t timestamp,
+        std::vector<util::bus_stats_t> &busReadStats,
+        std::vector<util::bus_stats_t> &busWriteStats) const
+    {
+        if (!buses || 0 == laneWidth) {
+            return;
+        }
+        accumulate(busReadStats, buses->read.get_lane_stats(timestamp));
+        accumulate(busWriteStats, buses->write.get_lane_stats(timestamp));
+    }
+
+    void get_toggling_activity(timestamp_t timestamp,
+        toggling_activity_t &togglingHandleReadActivity,
+        toggling_activity_t &togglingHandleWriteActivity) const
+    {
+        if (togglingHandles) {
+            togglingHandleReadActivity += togglingHandles->read.get_activity(timestamp);
+            togglingHandleWriteActivity += togglingHandles->write.get_activity(timestamp);
+        }
+    }
+
+    // A missing half is serialized as a disabled half
     void serialize(std::ostream &stream) const override {
-        busRead.serialize(stream);
-        busWrite.serialize(stream);
-        togglingHandleRead.serialize(stream);
-        togglingHandleWrite.serialize(stream);
+        const std::unique_ptr<BusHalf> disabledBuses = buses ? nullptr : makeBuses(false);
+        const BusHalf &busHalf = buses ? *buses : *disabledBuses;
+        busHalf.read.serialize(stream);
+        busHalf.write.serialize(stream);
+        const std::unique_ptr<TogglingHalf> disabledTogglingHandles = togglingHandles ? nullptr : makeTogglingHandles(false);
+        const TogglingHalf &togglingHalf = togglingHandles ? *togglingHandles : *disabledTogglingHandles;
+        togglingHalf.read.serialize(stream);
+        togglingHalf.write.serialize(stream);
         stream.write(reinterpret_cast<const char*>(&busType), sizeof(busType));
     }
 
+    // Only the halves which are active or hold state are kept
     void deserialize(std::istream &stream) override {
-        busRead.deserialize(stream);
-        busWrite.deserialize(stream);
-        togglingHandleRead.deserialize(stream);
-        togglingHandleWrite.deserialize(stream);
+        std::unique_ptr<BusHalf> restoredBuses = makeBuses(false);
+        restoredBuses->read.deserialize(stream);
+        restoredBuses->write.deserialize(stream);
+        std::unique_ptr<TogglingHalf> restoredTogglingHandles = makeTogglingHandles(false);
+        restoredTogglingHandles->read.deserialize(stream);
+        restoredTogglingHandles->write.deserialize(stream);
         stream.read(reinterpret_cast<char*>(&busType), sizeof(busType));
+
+        const bool keepBuses = DataBusMode::Bus == busType || !sameState(*restoredBuses, *makeBuses(false));
+        buses = keepBuses ? std::move(restoredBuses) : nullptr;
+        const bool keepTogglingHandles = DataBusMode::TogglingRate == busType
+            || !sameState(*restoredTogglingHandles, *makeTogglingHandles(false));
+        togglingHandles = keepTogglingHandles ? std::move(restoredTogglingHandles) : nullptr;
     }
 
 private:
-    Bus_t busRead;
-    Bus_t busWrite;
-    TogglingHandle togglingHandleRead;
-    TogglingHandle togglingHandleWrite;
+    // A half in the state of a half which was disabled from the start is equal to a missing half
+    template <typename Half>
+    static bool sameState(const Half &lhs, const Half &rhs) {
+        std::ostringstream lhsStream;
+        lhs.read.serialize(lhsStream);
+        lhs.write.serialize(lhsStream);
+        std::ostringstream rhsStream;
+        rhs.read.serialize(rhsStream);
+        rhs.write.serialize(rhsStream);
+        return lhsStream.str() == rhsStream.str();
+    }
+
+    static void accumulate(std::vector<util::bus_stats_t> &stats, const std::vector<util::bus_stats_t> &lanes) {
+        if (stats.size() < lanes.size()) {
+            stats.resize(lanes.size());
+        }
+        for (std::size_t i = 0; i < lanes.size(); ++i) {
+            stats[i] += lanes[i];
+        }
+    }
+
+private:
+    std::unique_ptr<BusHalf> buses;
+    std::unique_ptr<TogglingHalf> togglingHandles;
+    DRAMUtils::Config::ToggleRateDefinition toggleRateConf;
+    IdlePattern_t idlePatternRead;
+    IdlePattern_t idlePatternWrite;
     DataBusMode busType;
     std::size_t dataRate;
     std::size_t width;
+    std::size_t laneWidth;
 };
 
 /** DataBusContainer class
@@ -330,6 +424,18 @@ public:
         }, m_dataBusContainer.getVariant());
     }
 
+    void get_lane_stats(timestamp_t timestamp, std::vector<util::bus_stats_t> &busReadStats, std::vector<util::bus_stats_t> &busWriteStats) const {
+        std::visit([timestamp, &busReadStats, &busWriteStats](auto && arg) {
+            arg.get_lane_stats(timestamp, busReadStats, busWriteStats);
+        }, m_dataBusContainer.getVariant());
+    }
+
+    void get_toggling_activity(timestamp_t timestamp, toggling_activity_t &togglingReadActivity, toggling_activity_t &togglingWriteActivity) const {
+        std::visit([timestamp, &togglingReadActivity, &togglingWriteActivity](auto && arg) {
+            arg.get_toggling_activity(timestamp, togglingReadActivity, togglingWriteActivity);
+        }, m_dataBusContainer.getVariant());
+    }
+
     void serialize(std::ostream& stream) const override {
         std::visit([&stream](const auto& arg) {
             arg.serialize(stream);
@@ -9,16 +9,9 @@
 
 namespace DRAMPower::util::databus_presets {
 
-    using databus_64_t = DataBus<64>;
-    using databus_256_t = DataBus<256>;
-    using databus_1024_t = DataBus<1024>;
-    using databus_4096_t = DataBus<4096>;
-
+    // The bursts are sized to the bus width at runtime, one bus type covers every width
     using databus_preset_sequence_t = DRAMUtils::util::type_sequence<
-        databus_64_t,
-        databus_256_t,
-        databus_1024_t,
-        databus_4096_t
+        DataBus
     >;
 
     using databus_preset_t = util::DataBusContainerProxy<databus_preset_sequence_t>;
@@ -27,17 +20,7 @@ namespace DRAMPower::util::databus_presets {
         DataBusConfig&& busConfig,
         util::DataBusMode mode
     ) {
-        if (busConfig.width <= 64) {
-            return databus_64_t(std::move(busConfig), mode);
-        } else if (busConfig.width <= 256) {
-            return databus_256_t(std::move(busConfig), mode);
-        } else if (busConfig.width <= 1024) {
-            return databus_1024_t(std::move(busConfig), mode);
-        } else if (busConfig.width > 4096) {
-            assert(false);
-            throw std::runtime_error("Data bus width exceeds maximum.");
-        }
-        return databus_4096_t(std::move(busConfig), mode);
+        return DataBus(std::move(busConfig), mode);
     }
 
 } // namespace DRAMPower::util::databus_presets
@@ -19,6 +19,8 @@ struct DataBusConfig {
     std::size_t width;
     std::size_t dataRate;
     DRAMUtils::Config::ToggleRateDefinition toggleRateConf;
+    // Width of the lanes with separate stats (e.g. the DQ of one device), 0 disables the lane stats
+    std::size_t laneWidth = 0;
 };
 
 } // namespace DRAMPower::util
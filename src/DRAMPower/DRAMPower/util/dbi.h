@@ -9,6 +9,7 @@
 #include "DRAMPower/util/dbialgos.h"
 #include "DRAMPower/util/dbitypes.h"
 #include "DRAMPower/util/dbihelpers.h"
+#include "DRAMPower/util/profiler.h"
 
 #include <algorithm>
 #include <bitset>
@@ -59,6 +60,15 @@ public:
     // Callback signature void(timestamp_t load_time, timestamp_t chunk_time, std::size_t chunk_idx, bool inversion_state, bool read)
     // chunk_time equals load_time if no bus width is provided. The chunk_idx is then absolute to the beginning of the request
     using ChangeCallback_t = std::function<void(timestamp_t, timestamp_t, std::size_t, bool, bool)>;
+
+    // Callback signature void(timestamp_t load_time, const std::vector<uint64_t>& beat_masks, bool read)
+    // Called once per burst instead of the ChangeCallback_t if set. Requires a bus width of at most 64 chunks
+    // Bit i of beat_masks[beat] holds the inversion state of chunk i in the beat
+    using BurstCallback_t = std::function<void(timestamp_t, const std::vector<uint64_t>&, bool)>;
+
+    // The whole burst engine computes all inversions of a burst at once (see StaticDBI::computeBurstDBI)
+    static constexpr bool BurstEngine = std::is_same_v<Algorithm, StaticDBI>
+        && std::is_same_v<DataType_t, uint8_t> && 8 == ChunkSize;
     
     using IdlePattern_t = PinState;
 
@@ -242,7 +252,13 @@ public:
         m_changeCallback = std::forward<Func>(func);
     }
 
+    template<typename Func>
+    void setBurstCallback(Func&& func) {
+        m_burstCallback = std::forward<Func>(func);
+    }
+
     std::optional<const DataType_t*> updateDBI(timestamp_t timestamp, std::size_t n_bits, const DataType_t* data, bool read) {
+        DRAMPOWER_PROFILE_SCOPE(util::profiling::Section::DBIUpdate);
         if (!data || 0 == n_bits || !m_enable || IdlePattern_t::Z == IDLEPATTERN) return std::nullopt;
 
         // Select read or write members
@@ -270,9 +286,16 @@ public:
         std::size_t n_chunks = n_bits / ChunkSize;
         
         // Resize lastInvert vector if needed
-        if (lastInvert.capacity() < n_chunks) {
+        if (lastInvert.size() < n_chunks) {
             lastInvert.resize(n_chunks, false);
         }
+
+        if constexpr (BurstEngine) {
+            computeBurst(timestamp, n_chunks, lastInvert, read);
+            m_lastBurst.update(timestamp, m_width, m_burstLength, n_bits);
+            lastBurstRead = read;
+            return m_invertedData.data();
+        }
         
         // SAFETY: inverting the chunk while iterating over the data is safe because the invertedData is resized to the maximum size
         auto invert_visitor = [this, &lastInvert, timestamp, read] (bool invert_chunk, const std::size_t chunk) {
@@ -350,6 +373,43 @@ public:
 
 // Private member functions
 private:
+    void computeBurst(timestamp_t timestamp, std::size_t n_chunks, std::vector<bool>& lastInvert, bool read) {
+        Algorithm_t::computeBurstDBI(reinterpret_cast<uint8_t*>(m_invertedData.data()), n_chunks, IDLEPATTERN, m_invertMask);
+
+        std::optional<std::size_t> chunks_per_width = getChunksPerWidth();
+        if (nullptr != m_burstCallback && chunks_per_width.has_value() && chunks_per_width.value() <= 64
+            && 0 == n_chunks % chunks_per_width.value()
+        ) {
+            // Pack the inversion states per beat and report the burst in one call
+            std::size_t width = chunks_per_width.value();
+            m_beatMasks.assign(n_chunks / width, 0);
+            for (std::size_t beat = 0; beat < m_beatMasks.size(); ++beat) {
+                m_beatMasks[beat] = extractBits(m_invertMask, beat * width, width);
+            }
+            for (std::size_t chunk = 0; chunk < n_chunks; ++chunk) {
+                lastInvert[chunk] = (m_invertMask[chunk / 64] >> (chunk % 64)) & 1;
+            }
+            m_burstCallback(timestamp, m_beatMasks, read);
+            return;
+        }
+        for (std::size_t chunk = 0; chunk < n_chunks; ++chunk) {
+            bool invert_chunk = (m_invertMask[chunk / 64] >> (chunk % 64)) & 1;
+            dispatchCallback(timestamp, chunk, invert_chunk, read);
+            lastInvert[chunk] = invert_chunk;
+        }
+    }
+
+    // Returns n <= 64 bits of mask starting at bit position pos
+    static uint64_t extractBits(const std::vector<uint64_t>& mask, std::size_t pos, std::size_t n) {
+        std::size_t word = pos / 64;
+        std::size_t offset = pos % 64;
+        uint64_t value = mask[word] >> offset;
+        if (offset != 0 && offset + n > 64) {
+            value |= mask[word + 1] << (64 - offset);
+        }
+        return n >= 64 ? value : value & ((uint64_t{1} << n) - 1);
+    }
+
     void saveLastBurst(timestamp_t timestamp, LastBurst_t& m_lastBurst) {
         if (m_lastBurst.m_init && m_lastBurst.end() == timestamp && m_width.has_value() // seamless burst and busWidth provided
             && m_lastBurst.beats() != 0 && m_invertedData.size() > m_width.value() / DATATYPEDIGITS) // at least one beat is required
@@ -465,6 +525,9 @@ private:
     std::optional<DataBuffer_t> m_idleData; // Buffer for idle data
 
     ChangeCallback_t m_changeCallback = nullptr; // Callback called in updateDBI
+    BurstCallback_t m_burstCallback = nullptr; // Batched callback called in updateDBI (whole burst engine)
+    std::vector<uint64_t> m_invertMask; // Inversion state per chunk of the last burst (whole burst engine)
+    std::vector<uint64_t> m_beatMasks; // Inversion state per beat of the last burst (whole burst engine)
     bool m_enable = false;
     Algorithm_t m_algorithm;
 };
@@ -7,7 +7,10 @@
 
 #include "DRAMUtils/util/types.h"
 
+#include <cstdint>
+#include <cstring>
 #include <optional>
+#include <vector>
 
 
 namespace DRAMPower::util {
@@ -55,6 +58,52 @@ struct StaticDBI {
         }
     }
 
+    // Whole burst variant for 8 bit chunks. The popcounts of 8 chunks are computed at once
+    // in a 64 bit word (SWAR) and the selected chunks are inverted in place with a masked XOR.
+    // The inversion state of chunk i is stored in bit (i % 64) of invert_mask[i / 64].
+    static void computeBurstDBI(uint8_t* data, std::size_t n_chunks, PinState idlePattern, std::vector<uint64_t>& invert_mask) {
+        constexpr uint64_t lsb = 0x0101010101010101ULL;
+        constexpr uint64_t msb = 0x8080808080808080ULL;
+        // Moves the most significant bit of every byte into one byte
+        constexpr uint64_t gather = 0x0102040810204080ULL;
+
+        invert_mask.assign((n_chunks + 63) / 64, 0);
+        if (PinState::Z == idlePattern) {
+            return;
+        }
+
+        std::size_t chunk = 0;
+        for (; chunk + 8 <= n_chunks; chunk += 8) {
+            uint64_t word;
+            std::memcpy(&word, data + chunk, sizeof(word));
+
+            // Popcount per byte
+            uint64_t ones = word - ((word >> 1) & (0x55 * lsb));
+            ones = (ones & (0x33 * lsb)) + ((ones >> 2) & (0x33 * lsb));
+            ones = (ones + (ones >> 4)) & (0x0F * lsb);
+
+            // Idle L: invert if ones > 4, idle H: invert if ones < 4 (ones <= 8 -> no carry between bytes)
+            uint64_t invert = (PinState::L == idlePattern)
+                ? (ones + (0x7B * lsb)) & msb
+                : ~(ones + (0x7C * lsb)) & msb;
+
+            word ^= (invert >> 7) * 0xFF;
+            std::memcpy(data + chunk, &word, sizeof(word));
+
+            invert_mask[chunk / 64] |= (((invert >> 7) * gather) >> 56) << (chunk % 64);
+        }
+        for (; chunk < n_chunks; ++chunk) {
+            std::size_t ones = BinaryOps::popcount(data[chunk]);
+            const bool invert =
+                (idlePattern == PinState::L && ones > 4) ||
+                (idlePattern == PinState::H && ones < 4);
+            if (invert) {
+                data[chunk] = static_cast<uint8_t>(~data[chunk]);
+                invert_mask[chunk / 64] |= uint64_t{1} << (chunk % 64);
+            }
+        }
+    }
+
 };
 
 template <std::size_t threshold>
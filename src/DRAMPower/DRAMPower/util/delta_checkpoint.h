@@ -0,0 +1,168 @@
+#ifndef DRAMPOWER_UTIL_DELTA_CHECKPOINT_H
+#define DRAMPOWER_UTIL_DELTA_CHECKPOINT_H
+
+#include <DRAMPower/command/CmdType.h>
+#include <DRAMPower/dram/Rank.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <vector>
+
+namespace DRAMPower::util {
+
+// Ranks and banks of a core which changed since the last checkpoint.
+// A bank command dirties the bank and the state of its rank, any other command the whole rank.
+// Implicit commands only target ranks and banks dirtied by the command which scheduled them,
+// which is sufficient because checkpoints require an empty implicit command queue.
+// A new tracker is completely dirty.
+class RankDeltaTracker {
+// Public constructors
+public:
+    RankDeltaTracker(std::size_t numberOfRanks, std::size_t numberOfBanks)
+        : m_numberOfBanks(numberOfBanks)
+        , m_ranks(numberOfRanks, true)
+        , m_banks(numberOfRanks * numberOfBanks, true)
+    {}
+
+    // Ranks is the rank container of the core (std::vector or std::array of Rank)
+    template <typename Ranks>
+    explicit RankDeltaTracker(const Ranks& ranks)
+        : RankDeltaTracker(ranks.size(), ranks.empty() ? 0 : ranks.front().banks.size())
+    {}
+
+// Public member functions
+public:
+    template <typename Command_t>
+    void markCommand(const Command_t& cmd) {
+        const std::size_t rank = cmd.targetCoordinate.rank;
+        if (rank >= m_ranks.size()) {
+            return;
+        }
+        switch (cmd.type) {
+            case CmdType::ACT:
+            case CmdType::PRE:
+            case CmdType::RD:
+            case CmdType::RDA:
+            case CmdType::WR:
+            case CmdType::WRA:
+                markBank(rank, cmd.targetCoordinate.bank);
+                break;
+            case CmdType::NOP:
+            case CmdType::END_OF_SIMULATION:
+                break;
+            default:
+                markRank(rank);
+                break;
+        }
+    }
+
+    void markBank(std::size_t rank, std::size_t bank) {
+        if (bank >= m_numberOfBanks) {
+            return;
+        }
+        m_ranks[rank] = true;
+        m_banks[rank * m_numberOfBanks + bank] = true;
+    }
+
+    void markRank(std::size_t rank) {
+        m_ranks[rank] = true;
+        std::fill_n(m_banks.begin() + rank * m_numberOfBanks, m_numberOfBanks, true);
+    }
+
+    void clear() {
+        std::fill(m_ranks.begin(), m_ranks.end(), false);
+        std::fill(m_banks.begin(), m_banks.end(), false);
+    }
+
+    // Writes the dirty rank states and banks and clears the tracker
+    template <typename Ranks>
+    void serializeDelta(std::ostream& stream, const Ranks& ranks) {
+        const uint64_t rankCount = std::count(m_ranks.begin(), m_ranks.end(), true);
+        stream.write(reinterpret_cast<const char*>(&rankCount), sizeof(rankCount));
+        for (uint64_t rank = 0; rank < m_ranks.size(); ++rank) {
+            if (m_ranks[rank]) {
+                stream.write(reinterpret_cast<const char*>(&rank), sizeof(rank));
+                ranks[rank].serializeState(stream);
+            }
+        }
+        const uint64_t bankCount = std::count(m_banks.begin(), m_banks.end(), true);
+        stream.write(reinterpret_cast<const char*>(&bankCount), sizeof(bankCount));
+        for (uint64_t index = 0; index < m_banks.size(); ++index) {
+            if (m_banks[index]) {
+                stream.write(reinterpret_cast<const char*>(&index), sizeof(index));
+                ranks[index / m_numberOfBanks].banks[index % m_numberOfBanks].serialize(stream);
+            }
+        }
+        clear();
+    }
+
+    // Applies a delta written by serializeDelta and clears the tracker
+    template <typename Ranks>
+    void deserializeDelta(std::istream& stream, Ranks& ranks) {
+        uint64_t rankCount = 0;
+        stream.read(reinterpret_cast<char*>(&rankCount), sizeof(rankCount));
+        for (uint64_t i = 0; i < rankCount; ++i) {
+            uint64_t rank = 0;
+            stream.read(reinterpret_cast<char*>(&rank), sizeof(rank));
+            ranks.at(rank).deserializeState(stream);
+        }
+        uint64_t bankCount = 0;
+        stream.read(reinterpret_cast<char*>(&bankCount), sizeof(bankCount));
+        for (uint64_t i = 0; i < bankCount; ++i) {
+            uint64_t index = 0;
+            stream.read(reinterpret_cast<char*>(&index), sizeof(index));
+            ranks.at(index / m_numberOfBanks).deserializeBank(index % m_numberOfBanks, stream);
+        }
+        clear();
+    }
+
+// Private member variables
+private:
+    std::size_t m_numberOfBanks;
+    std::vector<bool> m_ranks;
+    std::vector<bool> m_banks;
+};
+
+// Buses of an interface which changed since the last checkpoint.
+// The remaining interface state (clocks, pattern encoder, pre/postamble counters) is small
+// and always part of a delta. A new tracker is completely dirty.
+struct InterfaceDeltaTracker {
+    bool commandBus = true;
+    bool dataBus = true;
+    bool dbi = true;
+
+    template <typename Command_t>
+    void markCommand(const Command_t& cmd) {
+        commandBus = true;
+        if (CmdTypeUtil::needs_data(cmd.type) || CmdType::END_OF_SIMULATION == cmd.type) {
+            dataBus = true;
+            dbi = true;
+        }
+    }
+
+    void clear() {
+        commandBus = false;
+        dataBus = false;
+        dbi = false;
+    }
+
+    void serialize(std::ostream& stream) const {
+        const uint8_t flags = (commandBus ? 1 : 0) | (dataBus ? 2 : 0) | (dbi ? 4 : 0);
+        stream.write(reinterpret_cast<const char*>(&flags), sizeof(flags));
+    }
+
+    void deserialize(std::istream& stream) {
+        uint8_t flags = 0;
+        stream.read(reinterpret_cast<char*>(&flags), sizeof(flags));
+        commandBus = 0 != (flags & 1);
+        dataBus = 0 != (flags & 2);
+        dbi = 0 != (flags & 4);
+    }
+};
+
+} // namespace DRAMPower::util
+
+#endif /* DRAMPOWER_UTIL_DELTA_CHECKPOINT_H */
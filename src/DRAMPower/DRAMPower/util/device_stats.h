@@ -0,0 +1,57 @@
+#ifndef DRAMPOWER_UTIL_DEVICE_STATS_H
+#define DRAMPOWER_UTIL_DEVICE_STATS_H
+
+#include <DRAMPower/Types.h>
+#include <DRAMPower/data/stats.h>
+#include <DRAMPower/util/bus_types.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace DRAMPower::util {
+
+// Adds the data bus stats of every device to devices. The data bus must be created with
+// the device width as lane width (DataBusConfig::laneWidth), otherwise devices is not changed.
+template <typename DataBus>
+void addDeviceBusStats(const DataBus &dataBus, timestamp_t timestamp, std::vector<DeviceStats> &devices)
+{
+    std::vector<bus_stats_t> read;
+    std::vector<bus_stats_t> write;
+    dataBus.get_lane_stats(timestamp, read, write);
+    devices.resize(std::max(devices.size(), read.size()));
+    for (std::size_t device = 0; device < read.size(); ++device) {
+        devices[device].readBus += read[device];
+        devices[device].writeBus += write[device];
+    }
+}
+
+// Adds the stats of the DBI pins of every device to devices. The pins are evenly distributed
+// over the devices. Devices with less than one DBI pin (e.g. DDR4 x4) have no DBI stats.
+template <typename PinGroup>
+void addDeviceDBIStats(const PinGroup &dbiRead, const PinGroup &dbiWrite, timestamp_t timestamp,
+    std::size_t dataRate, std::vector<DeviceStats> &devices)
+{
+    if (devices.empty()) {
+        return;
+    }
+    const std::size_t pinsPerDevice = dbiRead.size() / devices.size();
+    if (0 == pinsPerDevice || dbiRead.size() != pinsPerDevice * devices.size()) {
+        return;
+    }
+    // The pins are selected with a 64 bit mask
+    assert(1 <= pinsPerDevice && pinsPerDevice <= 64);
+    assert(dbiRead.size() <= 64);
+    const uint64_t deviceMask = 64 == pinsPerDevice ? ~uint64_t{0} : (uint64_t{1} << pinsPerDevice) - 1;
+    for (std::size_t device = 0; device < devices.size(); ++device) {
+        const uint64_t mask = deviceMask << (device * pinsPerDevice);
+        devices[device].readDBI += dbiRead.get_stats_at(mask, timestamp, dataRate);
+        devices[device].writeDBI += dbiWrite.get_stats_at(mask, timestamp, dataRate);
+    }
+}
+
+} // namespace DRAMPower::util
+
+#endif /* DRAMPOWER_UTIL_DEVICE_STATS_H */
@@ -0,0 +1,192 @@
+#ifndef DRAMPOWER_UTIL_PACKED_BURST_H
+#define DRAMPOWER_UTIL_PACKED_BURST_H
+
+#include <DRAMPower/util/binary_ops.h>
+
+#include <algorithm>
+#include <array>
+#include <bitset>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+namespace DRAMPower::util
+{
+
+// Number of 64 bit words of a burst of width bits
+constexpr std::size_t burst_words(std::size_t width)
+{
+    return (width + 63) / 64;
+}
+
+// Non owning view of a burst packed into 64 bit words.
+// Bit n is bit n % 64 of word n / 64. The bits above the width are zero.
+class burst_view
+{
+private:
+    const uint64_t *m_words = nullptr;
+    std::size_t m_width = 0;
+public:
+    constexpr burst_view() = default;
+    constexpr burst_view(const uint64_t *words, std::size_t width)
+        : m_words(words)
+        , m_width(width)
+    {}
+public:
+    inline std::size_t size() const { return m_width; }
+    inline std::size_t num_words() const { return burst_words(m_width); }
+    inline const uint64_t *data() const { return m_words; }
+    inline const uint64_t *begin() const { return m_words; }
+    inline const uint64_t *end() const { return m_words + num_words(); }
+
+    inline uint64_t word(std::size_t index) const {
+        assert(index < num_words());
+        return m_words[index];
+    }
+    inline bool test(std::size_t n) const {
+        assert(n < m_width);
+        return (m_words[n / 64] >> (n % 64)) & 1;
+    }
+    inline bool operator[](std::size_t n) const { return test(n); }
+
+    std::size_t count() const {
+        std::size_t n = 0;
+        for (uint64_t word : *this) {
+            n += BinaryOps::popcount(word);
+        }
+        return n;
+    }
+};
+
+// Burst packed into 64 bit words with the width known at runtime.
+// Bursts of up to inline_bits bits are stored in place, wider bursts on the heap.
+class packed_burst
+{
+public:
+    static constexpr std::size_t inline_words = 2;
+    static constexpr std::size_t inline_bits = 64 * inline_words;
+private:
+    std::size_t m_width = 0;
+    std::array<uint64_t, inline_words> m_inline{};
+    std::vector<uint64_t> m_heap;
+public:
+    packed_burst() = default;
+    explicit packed_burst(std::size_t width)
+    {
+        resize(width);
+    }
+    explicit packed_burst(burst_view burst)
+    {
+        assign(burst);
+    }
+public:
+    inline std::size_t size() const { return m_width; }
+    inline std::size_t num_words() const { return burst_words(m_width); }
+    inline uint64_t *data() { return m_width > inline_bits ? m_heap.data() : m_inline.data(); }
+    inline const uint64_t *data() const { return m_width > inline_bits ? m_heap.data() : m_inline.data(); }
+
+    inline burst_view view() const { return {data(), m_width}; }
+    inline operator burst_view() const { return view(); }
+
+    inline uint64_t word(std::size_t index) const { return view().word(index); }
+    inline bool test(std::size_t n) const { return view().test(n); }
+    inline bool operator[](std::size_t n) const { return test(n); }
+    inline std::size_t count() const { return view().count(); }
+
+    // Clears all bits. The storage of the old width is reused if possible
+    void resize(std::size_t width) {
+        m_width = width;
+        if (width > inline_bits) {
+            m_heap.assign(burst_words(width), 0);
+        } else {
+            m_inline.fill(0);
+        }
+    }
+
+    // Copies the burst without allocating if the width is unchanged
+    packed_burst& assign(burst_view burst) {
+        if (burst.size() != m_width) {
+            resize(burst.size());
+        }
+        std::copy(burst.begin(), burst.end(), data());
+        return *this;
+    }
+    packed_burst& operator=(burst_view burst) { return assign(burst); }
+public:
+    inline void set(std::size_t n, bool value = true) {
+        assert(n < m_width);
+        const uint64_t bit = uint64_t{1} << (n % 64);
+        uint64_t &word = data()[n / 64];
+        word = value ? (word | bit) : (word & ~bit);
+    }
+    void set() {
+        uint64_t *words = data();
+        std::fill(words, words + num_words(), ~uint64_t{0});
+        if (0 != m_width % 64) {
+            words[num_words() - 1] = (uint64_t{1} << (m_width % 64)) - 1;
+        }
+    }
+    void reset() {
+        uint64_t *words = data();
+        std::fill(words, words + num_words(), 0);
+    }
+};
+
+inline bool operator==(burst_view lhs, burst_view rhs)
+{
+    return lhs.size() == rhs.size() && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+inline bool operator!=(burst_view lhs, burst_view rhs)
+{
+    return !(lhs == rhs);
+}
+
+inline bool operator==(const packed_burst &lhs, const packed_burst &rhs)
+{
+    return lhs.view() == rhs.view();
+}
+
+inline bool operator!=(const packed_burst &lhs, const packed_burst &rhs)
+{
+    return !(lhs == rhs);
+}
+
+// Bitwise comparison, missing bits are zero
+template <std::size_t N>
+bool operator==(burst_view lhs, const std::bitset<N> &rhs)
+{
+    for (std::size_t i = 0; i < std::max(lhs.num_words(), burst_words(N)); ++i) {
+        const uint64_t word = i < lhs.num_words() ? lhs.word(i) : 0;
+        if (word != BinaryOps::word(rhs, i)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <std::size_t N>
+bool operator!=(burst_view lhs, const std::bitset<N> &rhs)
+{
+    return !(lhs == rhs);
+}
+
+inline std::ostream &operator<<(std::ostream &stream, burst_view burst)
+{
+    stream << '[';
+    for (std::size_t i = burst.size(); i > 0;) {
+        stream << (burst.test(--i) ? '1' : '0');
+    }
+    return stream << ']';
+}
+
+inline std::ostream &operator<<(std::ostream &stream, const packed_burst &burst)
+{
+    return stream << burst.view();
+}
+
+} // namespace DRAMPower::util
+
+#endif /* DRAMPOWER_UTIL_PACKED_BURST_H */
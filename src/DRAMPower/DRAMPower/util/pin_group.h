@@ -0,0 +1,467 @@
+#ifndef DRAMPOWER_UTIL_PIN_GROUP_H
+#define DRAMPOWER_UTIL_PIN_GROUP_H
+
+#include <DRAMPower/Types.h>
+#include <DRAMPower/util/binary_ops.h>
+#include <DRAMPower/util/bus_types.h>
+#include <DRAMPower/util/pin_types.h>
+#include <DRAMPower/util/Serialize.h>
+#include <DRAMPower/util/Deserialize.h>
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace DRAMPower::util {
+
+// Group of up to 64 pins with the same idle state, e.g. the DBI pins of an interface.
+// Every pin behaves exactly like a util::Pin. The burst storage is kept as bit-planes
+// (one 64 bit word per beat, bit p belongs to pin p) and the pin statistics as bit-sliced
+// counters (word k holds bit k of the counter of every pin). Pins which share the same
+// timing state are updated and counted together with word-parallel logic.
+// Per-pin statistics are extracted on demand. The counters are allocated with the first set,
+// groups which are never set (e.g. the DBI pins with DBI disabled) only hold the timing state.
+template<std::size_t max_burst_length>
+class PinGroup : public Serialize, public Deserialize {
+// Public type definitions
+public:
+    using pin_stats_t = bus_stats_t;
+    using mask_t = uint64_t;
+
+// Private type definitions
+private:
+    static constexpr std::size_t MAX_PINS = 64;
+    static constexpr std::size_t COUNTER_BITS = 64;
+
+    // PinState as two bit-planes
+    struct StateMask {
+        mask_t high = 0;
+        mask_t z = 0;
+
+        mask_t low() const { return ~high & ~z; }
+        PinState get(std::size_t pin) const {
+            if ((z >> pin) & 1) return PinState::Z;
+            return ((high >> pin) & 1) ? PinState::H : PinState::L;
+        }
+        void set(mask_t mask, const StateMask& state) {
+            high = (high & ~mask) | (state.high & mask);
+            z = (z & ~mask) | (state.z & mask);
+        }
+        static StateMask uniform(PinState state) {
+            return {PinState::H == state ? ~mask_t{0} : 0, PinState::Z == state ? ~mask_t{0} : 0};
+        }
+    };
+
+    // Timing state of a pin. Pins with equal timing state are processed together
+    struct PinTiming {
+        timestamp_t last_set = 0;
+        timestamp_t load_time = 0;
+        std::size_t count = 0;
+        timestamp_t pending_time = 0;
+        bool pending = false;
+        bool init_load = true;
+
+        bool operator==(const PinTiming& rhs) const {
+            return last_set == rhs.last_set && load_time == rhs.load_time && count == rhs.count
+                && pending_time == rhs.pending_time && pending == rhs.pending && init_load == rhs.init_load;
+        }
+    };
+
+    // Bit-sliced counters of one statistic field
+    using counter_t = std::array<mask_t, COUNTER_BITS>;
+
+    struct SlicedStats {
+        counter_t ones{};
+        counter_t zeroes{};
+        counter_t bit_changes{};
+        counter_t ones_to_zeroes{};
+        counter_t zeroes_to_ones{};
+    };
+
+    // Adds value to the counters of all pins in mask
+    static void add(counter_t& counter, mask_t mask, uint64_t value) {
+        mask_t carry = 0;
+        for (std::size_t bit = 0; bit < COUNTER_BITS && (0 != value || 0 != carry); ++bit, value >>= 1) {
+            mask_t addend = (value & 1) ? mask : 0;
+            mask_t sum = counter[bit] ^ addend ^ carry;
+            carry = (counter[bit] & addend) | (carry & (counter[bit] ^ addend));
+            counter[bit] = sum;
+        }
+    }
+
+    static uint64_t extract(const counter_t& counter, std::size_t pin) {
+        uint64_t value = 0;
+        for (std::size_t bit = 0; bit < COUNTER_BITS; ++bit) {
+            value |= ((counter[bit] >> pin) & 1) << bit;
+        }
+        return value;
+    }
+
+    static uint64_t total(const counter_t& counter, mask_t mask) {
+        uint64_t value = 0;
+        for (std::size_t bit = 0; bit < COUNTER_BITS; ++bit) {
+            value += static_cast<uint64_t>(BinaryOps::popcount(counter[bit] & mask)) << bit;
+        }
+        return value;
+    }
+
+    // Stats sink committing to the bit-sliced counters
+    struct SlicedSink {
+        SlicedStats& stats;
+        void ones(mask_t mask, uint64_t value) { add(stats.ones, mask, value); }
+        void zeroes(mask_t mask, uint64_t value) { add(stats.zeroes, mask, value); }
+        void changes(mask_t z2o, mask_t o2z) {
+            add(stats.bit_changes, z2o | o2z, 1);
+            add(stats.zeroes_to_ones, z2o, 1);
+            add(stats.ones_to_zeroes, o2z, 1);
+        }
+    };
+
+    // Stats sink summing up the stats of all pins
+    struct TotalSink {
+        pin_stats_t& stats;
+        void ones(mask_t mask, uint64_t value) { stats.ones += BinaryOps::popcount(mask) * value; }
+        void zeroes(mask_t mask, uint64_t value) { stats.zeroes += BinaryOps::popcount(mask) * value; }
+        void changes(mask_t z2o, mask_t o2z) {
+            stats.bit_changes += BinaryOps::popcount(z2o | o2z);
+            stats.zeroes_to_ones += BinaryOps::popcount(z2o);
+            stats.ones_to_zeroes += BinaryOps::popcount(o2z);
+        }
+    };
+
+// Constructor
+public:
+    PinGroup(std::size_t pins, PinState initstate, PinState idlestate)
+        : m_pins(pins)
+        , m_all(pins >= MAX_PINS ? ~mask_t{0} : ((mask_t{1} << pins) - 1))
+        , m_idle_state(idlestate)
+        , m_last_state(StateMask::uniform(initstate))
+        , m_timing(pins)
+    {
+        assert(pins <= MAX_PINS && "PinGroup supports at most 64 pins");
+    }
+
+// Private member functions
+private:
+    // L to H or H to L result in bit changes. X to Z or Z to X are not counted
+    template<typename Sink>
+    static void addChangeStats(mask_t mask, const StateMask& from, const StateMask& to, Sink& sink) {
+        sink.changes(mask & from.low() & to.high, mask & from.high & to.low());
+    }
+
+    template<typename Sink>
+    void addPendingStats(timestamp_t t, const PinTiming& timing, mask_t mask, Sink& sink) const {
+        // add stats from last load stored in the pending stats
+        if (timing.pending && timing.pending_time < t) {
+            addChangeStats(mask, m_pending_from, m_pending_to, sink);
+        }
+    }
+
+    // Counts the burst bit-planes in [start, start + length)
+    template<typename Sink>
+    void countBurst(const PinTiming& timing, mask_t mask, timestamp_t start, timestamp_t end, Sink& sink) const {
+        assert(start >= timing.load_time && "start timestamp must be greater or equal to load timestamp");
+        std::size_t length = end - start;
+        // Clamp length to count
+        if (length > timing.count) {
+            length = timing.count;
+        }
+        const std::size_t offset = start - timing.load_time;
+        assert(length + offset <= timing.count && "Invalid bitset access");
+        for (std::size_t beat = offset; beat < offset + length; ++beat) {
+            sink.ones(mask & m_beats[beat], 1);
+            sink.zeroes(mask & ~m_beats[beat], 1);
+            if (beat + 1 < offset + length) {
+                mask_t toggles = mask & (m_beats[beat] ^ m_beats[beat + 1]);
+                sink.changes(toggles & m_beats[beat + 1], toggles & m_beats[beat]);
+            }
+        }
+    }
+
+    template<typename Sink>
+    void count(const PinTiming& timing, mask_t mask, timestamp_t end, timestamp_t start, Sink& sink) const {
+        if (end <= start) {
+            return;
+        }
+
+        // Burst Storage
+        if (timing.load_time + timing.count > start) {
+            countBurst(timing, mask, start, end, sink);
+            // Adjust start for idle counting
+            start = timing.load_time + timing.count;
+            // Transitions last burst to idle_pattern
+            if (end > start) {
+                StateMask last{m_beats[timing.count - 1], 0};
+                addChangeStats(mask, last, StateMask::uniform(m_idle_state), sink);
+            }
+        }
+
+        // Add duration of state
+        if (end > start) {
+            switch (m_idle_state) {
+                case PinState::L:
+                    sink.zeroes(mask, end - start);
+                    break;
+                case PinState::H:
+                    sink.ones(mask, end - start);
+                    break;
+                case PinState::Z:
+                    // Nothing to do
+                    break;
+            }
+        }
+    }
+
+    // Stats from the last set of the pins in mask to t (see Pin::get_stats_at)
+    template<typename Sink>
+    void countTo(timestamp_t virtual_time, const PinTiming& timing, mask_t mask, Sink& sink) const {
+        // Count init transition
+        if (timing.init_load && (0 < virtual_time)) {
+            addChangeStats(mask, m_last_state, StateMask::uniform(m_idle_state), sink);
+        }
+        addPendingStats(virtual_time, timing, mask, sink);
+        count(timing, mask, virtual_time, timing.last_set, sink);
+    }
+
+    // Calls func(timing, mask) for every set of pins in mask with the same timing state
+    template<typename Func>
+    void forEachClass(mask_t mask, Func&& func) const {
+        mask &= m_all;
+        while (0 != mask) {
+            const std::size_t first = BinaryOps::countr_zero(mask);
+            const PinTiming& timing = m_timing[first];
+            mask_t cls = 0;
+            for (mask_t remaining = mask; 0 != remaining; remaining &= remaining - 1) {
+                std::size_t pin = BinaryOps::countr_zero(remaining);
+                if (m_timing[pin] == timing) {
+                    cls |= mask_t{1} << pin;
+                }
+            }
+            func(timing, cls);
+            mask &= ~cls;
+        }
+    }
+
+    // Sets the pins in mask which share the same timing state (see Pin::set)
+    void setClass(PinTiming timing, mask_t mask, timestamp_t load_time, const StateMask& state, std::size_t dataRate) {
+        timestamp_t virtual_load_time = load_time * dataRate;
+
+        // Count stats to virtual_load_time
+        timestamp_t virtual_time = virtual_load_time * dataRate;
+        assert(virtual_time >= timing.last_set);
+        SlicedSink sink{committedStats()};
+        countTo(virtual_time, timing, mask, sink);
+        if (timing.pending && timing.pending_time < virtual_load_time) {
+            timing.pending = false;
+        }
+
+        if ((timing.last_set != virtual_load_time) || timing.init_load) {
+            // New Burst
+            if ((virtual_load_time == timing.last_set + timing.count)
+                || (timing.init_load && (0 == virtual_load_time))) {
+                // seamless or first load
+                m_pending_from.set(mask, m_last_state);
+            } else {
+                m_pending_from.set(mask, StateMask::uniform(m_idle_state));
+            }
+            m_pending_to.set(mask, state);
+            timing.pending_time = virtual_load_time;
+            timing.pending = true;
+        }
+
+        // Push back beat
+        if (virtual_load_time != timing.load_time) {
+            timing.count = 0;
+            timing.load_time = virtual_load_time;
+        }
+        assert(timing.count < max_burst_length && "max_burst_length not enough");
+        m_beats[timing.count] = (m_beats[timing.count] & ~mask) | (state.high & mask);
+        timing.count++;
+
+        timing.last_set = virtual_load_time;
+        timing.init_load = false;
+        m_last_state.set(mask, state);
+        for (mask_t remaining = mask; 0 != remaining; remaining &= remaining - 1) {
+            m_timing[BinaryOps::countr_zero(remaining)] = timing;
+        }
+    }
+
+    void set(mask_t mask, timestamp_t load_time, const StateMask& state, std::size_t dataRate) {
+        forEachClass(mask, [this, load_time, &state, dataRate](PinTiming timing, mask_t cls) {
+            setClass(timing, cls, load_time, state, dataRate);
+        });
+    }
+
+// Public member functions
+public:
+    std::size_t size() const {
+        return m_pins;
+    }
+
+    // Sets a single pin. The timestamp t is relative to the clock frequency
+    void set_pin(std::size_t pin, timestamp_t load_time, PinState state, std::size_t dataRate = 1) {
+        assert(pin < m_pins);
+        set(mask_t{1} << pin, load_time, StateMask::uniform(state), dataRate);
+    }
+
+    // Sets one beat of all pins. Bit p of high is the state (H or L) of pin p
+    void set(timestamp_t load_time, mask_t high, std::size_t dataRate = 1) {
+        set(m_all, load_time, StateMask{high, 0}, dataRate);
+    }
+
+    // Stats of a single pin. The timestamp t is relative to the clock frequency
+    [[nodiscard]] pin_stats_t get_pin_stats_at(std::size_t pin, timestamp_t t, std::size_t dataRate = 1) const {
+        assert(pin < m_pins);
+        timestamp_t virtual_time = t * dataRate;
+        const PinTiming& timing = m_timing[pin];
+        assert(virtual_time >= timing.last_set);
+        pin_stats_t stats = get_committed_stats(pin);
+        if (virtual_time == timing.last_set) {
+            return stats;
+        }
+        TotalSink sink{stats};
+        countTo(virtual_time, timing, mask_t{1} << pin, sink);
+        return stats;
+    }
+
+    // Sum of the stats of all pins. The timestamp t is relative to the clock frequency
+    [[nodiscard]] pin_stats_t get_stats_at(timestamp_t t, std::size_t dataRate = 1) const {
+        return get_stats_at(m_all, t, dataRate);
+    }
+
+    // Sum of the stats of the pins in mask (bit p selects pin p)
+    [[nodiscard]] pin_stats_t get_stats_at(mask_t mask, timestamp_t t, std::size_t dataRate) const {
+        timestamp_t virtual_time = t * dataRate;
+        mask &= m_all;
+        pin_stats_t stats;
+        if (m_stats) {
+            stats.ones = total(m_stats->ones, mask);
+            stats.zeroes = total(m_stats->zeroes, mask);
+            stats.bit_changes = total(m_stats->bit_changes, mask);
+            stats.ones_to_zeroes = total(m_stats->ones_to_zeroes, mask);
+            stats.zeroes_to_ones = total(m_stats->zeroes_to_ones, mask);
+        }
+        TotalSink sink{stats};
+        forEachClass(mask, [this, virtual_time, &sink](const PinTiming& timing, mask_t cls) {
+            assert(virtual_time >= timing.last_set);
+            if (virtual_time != timing.last_set) {
+                countTo(virtual_time, timing, cls, sink);
+            }
+        });
+        return stats;
+    }
+
+// Overrides
+public:
+    // The serialized format equals the format of size() consecutive util::Pin objects
+    void serialize(std::ostream &stream) const override {
+        for (std::size_t pin = 0; pin < m_pins; ++pin) {
+            const PinTiming& timing = m_timing[pin];
+            PinState last_state = m_last_state.get(pin);
+            stream.write(reinterpret_cast<const char *>(&last_state), sizeof(last_state));
+            stream.write(reinterpret_cast<const char *>(&timing.last_set), sizeof(timing.last_set));
+            stream.write(reinterpret_cast<const char *>(&timing.init_load), sizeof(timing.init_load));
+            // Burst storage
+            stream.write(reinterpret_cast<const char *>(&timing.count), sizeof(timing.count));
+            stream.write(reinterpret_cast<const char *>(&timing.load_time), sizeof(timing.load_time));
+            std::array<uint8_t, (max_burst_length + 7) / 8> burst_data{};
+            for (std::size_t beat = 0; beat < max_burst_length; ++beat) {
+                burst_data[beat / 8] |= static_cast<uint8_t>(((m_beats[beat] >> pin) & 1) << (beat % 8));
+            }
+            stream.write(reinterpret_cast<const char *>(burst_data.data()), burst_data.size());
+            // Pending stats
+            PinState from = m_pending_from.get(pin);
+            PinState to = m_pending_to.get(pin);
+            stream.write(reinterpret_cast<const char *>(&timing.pending_time), sizeof(timing.pending_time));
+            stream.write(reinterpret_cast<const char *>(&from), sizeof(from));
+            stream.write(reinterpret_cast<const char *>(&to), sizeof(to));
+            stream.write(reinterpret_cast<const char *>(&timing.pending), sizeof(timing.pending));
+            // Stats
+            get_committed_stats(pin).serialize(stream);
+        }
+    }
+    void deserialize(std::istream &stream) override {
+        m_stats.reset();
+        for (std::size_t pin = 0; pin < m_pins; ++pin) {
+            const mask_t mask = mask_t{1} << pin;
+            PinTiming& timing = m_timing[pin];
+            PinState last_state;
+            stream.read(reinterpret_cast<char *>(&last_state), sizeof(last_state));
+            m_last_state.set(mask, StateMask::uniform(last_state));
+            stream.read(reinterpret_cast<char *>(&timing.last_set), sizeof(timing.last_set));
+            stream.read(reinterpret_cast<char *>(&timing.init_load), sizeof(timing.init_load));
+            // Burst storage
+            stream.read(reinterpret_cast<char *>(&timing.count), sizeof(timing.count));
+            stream.read(reinterpret_cast<char *>(&timing.load_time), sizeof(timing.load_time));
+            std::array<uint8_t, (max_burst_length + 7) / 8> burst_data{};
+            stream.read(reinterpret_cast<char *>(burst_data.data()), burst_data.size());
+            for (std::size_t beat = 0; beat < max_burst_length; ++beat) {
+                mask_t bit = (burst_data[beat / 8] >> (beat % 8)) & 1;
+                m_beats[beat] = (m_beats[beat] & ~mask) | (bit << pin);
+            }
+            // Pending stats
+            PinState from;
+            PinState to;
+            stream.read(reinterpret_cast<char *>(&timing.pending_time), sizeof(timing.pending_time));
+            stream.read(reinterpret_cast<char *>(&from), sizeof(from));
+            stream.read(reinterpret_cast<char *>(&to), sizeof(to));
+            stream.read(reinterpret_cast<char *>(&timing.pending), sizeof(timing.pending));
+            m_pending_from.set(mask, StateMask::uniform(from));
+            m_pending_to.set(mask, StateMask::uniform(to));
+            // Stats
+            pin_stats_t stats;
+            stats.deserialize(stream);
+            if (!(stats == pin_stats_t{})) {
+                SlicedStats& committed = committedStats();
+                add(committed.ones, mask, stats.ones);
+                add(committed.zeroes, mask, stats.zeroes);
+                add(committed.bit_changes, mask, stats.bit_changes);
+                add(committed.ones_to_zeroes, mask, stats.ones_to_zeroes);
+                add(committed.zeroes_to_ones, mask, stats.zeroes_to_ones);
+            }
+        }
+    }
+
+// Private member functions
+private:
+    pin_stats_t get_committed_stats(std::size_t pin) const {
+        pin_stats_t stats;
+        if (!m_stats) {
+            return stats;
+        }
+        stats.ones = extract(m_stats->ones, pin);
+        stats.zeroes = extract(m_stats->zeroes, pin);
+        stats.bit_changes = extract(m_stats->bit_changes, pin);
+        stats.ones_to_zeroes = extract(m_stats->ones_to_zeroes, pin);
+        stats.zeroes_to_ones = extract(m_stats->zeroes_to_ones, pin);
+        return stats;
+    }
+
+    SlicedStats& committedStats() {
+        if (!m_stats) {
+            m_stats = std::make_unique<SlicedStats>();
+        }
+        return *m_stats;
+    }
+
+// Private member variables
+private:
+    std::size_t m_pins;
+    mask_t m_all;
+    PinState m_idle_state;
+
+    StateMask m_last_state;
+    StateMask m_pending_from;
+    StateMask m_pending_to;
+    std::vector<PinTiming> m_timing;
+
+    std::array<mask_t, max_burst_length> m_beats{};
+    std::unique_ptr<SlicedStats> m_stats;
+};
+
+} // namespace DRAMPower::util
+
+#endif /* DRAMPOWER_UTIL_PIN_GROUP_H */
@@ -0,0 +1,197 @@
+#include "power_down_policy.h"
+
+#include <algorithm>
+
+using namespace DRAMPower;
+using namespace DRAMPower::util;
+
+namespace {
+
+bool isPowerDownCommand(CmdType type)
+{
+    switch (type) {
+    case CmdType::PDEA:
+    case CmdType::PDEP:
+    case CmdType::PDXA:
+    case CmdType::PDXP:
+    case CmdType::SREFEN:
+    case CmdType::SREFEX:
+    case CmdType::DSMEN:
+    case CmdType::DSMEX:
+        return true;
+    default:
+        return false;
+    }
+}
+
+bool isRefreshCommand(CmdType type)
+{
+    switch (type) {
+    case CmdType::REFA:
+    case CmdType::REFB:
+    case CmdType::REFP2B:
+    case CmdType::REFDB:
+    case CmdType::REFSB:
+        return true;
+    default:
+        return false;
+    }
+}
+
+timestamp_t saturatingSub(timestamp_t a, timestamp_t b)
+{
+    return a > b ? a - b : 0;
+}
+
+} // namespace
+
+PowerDownPolicyFilter::PowerDownPolicyFilter(const PowerDownPolicy &policy, const CLIArchitectureConfig &architecture)
+    : m_policy(policy)
+    , m_banksPerGroup(std::max<std::size_t>(1, 0 != architecture.banksPerGroup ? architecture.banksPerGroup : architecture.bankCount))
+    , m_ranks(architecture.rankCount)
+{
+    for (RankPolicyState &rank : m_ranks) {
+        rank.openBanks.assign(architecture.bankCount, false);
+    }
+}
+
+void PowerDownPolicyFilter::enqueue(const Command &command)
+{
+    if (isPowerDownCommand(command.type)) {
+        throw Exception("PowerDownPolicyFilter: the trace must not contain power down commands");
+    }
+    m_now = std::max(m_now, command.timestamp);
+
+    // Decide the entries of the ranks whose idle window passed
+    const timestamp_t guard = m_policy.idleCycles + m_policy.minCycles + m_policy.exitCycles;
+    for (std::size_t rank_idx = 0; rank_idx < m_ranks.size(); ++rank_idx) {
+        const RankPolicyState &rank = m_ranks[rank_idx];
+        if (RankState::Active == rank.state && m_now >= rank.lastCommand + guard) {
+            enterPowerDown(rank_idx);
+        }
+    }
+
+    const std::size_t rank_idx = command.targetCoordinate.rank;
+    if (CmdType::END_OF_SIMULATION != command.type && rank_idx < m_ranks.size()) {
+        RankPolicyState &rank = m_ranks[rank_idx];
+        if (RankState::SelfRefresh == rank.state && isRefreshCommand(command.type)) {
+            // The rank refreshes itself
+            return;
+        }
+        if (RankState::Active != rank.state) {
+            exitPowerDown(rank_idx, saturatingSub(command.timestamp, m_policy.exitCycles));
+        }
+        rank.lastCommand = command.timestamp;
+        updateBanks(rank, command);
+    }
+
+    m_pending.push_back(PendingCommand{command, {}});
+    if (nullptr != command.data) {
+        PendingCommand &pending = m_pending.back();
+        pending.data.assign(command.data, command.data + (command.sz_bits + 7) / 8);
+        pending.command.data = nullptr;
+    }
+}
+
+timestamp_t PowerDownPolicyFilter::forwardBound() const
+{
+    timestamp_t bound = m_now;
+    for (const RankPolicyState &rank : m_ranks) {
+        if (RankState::Active == rank.state) {
+            // A later entry is inserted at lastCommand + idleCycles
+            bound = std::min(bound, rank.lastCommand + m_policy.idleCycles);
+        } else {
+            // A later exit is inserted at least exitCycles before the next command
+            bound = std::min(bound, saturatingSub(m_now, m_policy.exitCycles));
+        }
+    }
+    // Inserted commands are placed after the pending commands with the same timestamp
+    return bound;
+}
+
+void PowerDownPolicyFilter::enterPowerDown(std::size_t rank_idx)
+{
+    RankPolicyState &rank = m_ranks[rank_idx];
+    CmdType type;
+    if (PowerDownMode::SelfRefresh == m_policy.mode && 0 == rank.openBankCount) {
+        type = CmdType::SREFEN;
+        rank.state = RankState::SelfRefresh;
+    } else if (0 != rank.openBankCount) {
+        type = CmdType::PDEA;
+        rank.state = RankState::PowerDownAct;
+    } else {
+        type = CmdType::PDEP;
+        rank.state = RankState::PowerDownPre;
+    }
+    insert(Command{rank.lastCommand + m_policy.idleCycles, type, {0, 0, rank_idx}});
+    ++m_entries;
+}
+
+void PowerDownPolicyFilter::exitPowerDown(std::size_t rank_idx, timestamp_t timestamp)
+{
+    RankPolicyState &rank = m_ranks[rank_idx];
+    CmdType type;
+    switch (rank.state) {
+    case RankState::PowerDownAct:
+        type = CmdType::PDXA;
+        break;
+    case RankState::PowerDownPre:
+        type = CmdType::PDXP;
+        break;
+    case RankState::SelfRefresh:
+        type = CmdType::SREFEX;
+        break;
+    default:
+        return;
+    }
+    insert(Command{timestamp, type, {0, 0, rank_idx}});
+    rank.state = RankState::Active;
+}
+
+void PowerDownPolicyFilter::insert(const Command &command)
+{
+    auto it = std::upper_bound(m_pending.begin(), m_pending.end(), command.timestamp,
+        [](timestamp_t timestamp, const PendingCommand &pending) {
+            return timestamp < pending.command.timestamp;
+        });
+    m_pending.insert(it, PendingCommand{command, {}});
+}
+
+void PowerDownPolicyFilter::updateBanks(RankPolicyState &rank, const Command &command)
+{
+    const auto setBank = [&rank](std::size_t bank_idx, bool open) {
+        if (bank_idx >= rank.openBanks.size() || rank.openBanks[bank_idx] == open) {
+            return;
+        }
+        rank.openBanks[bank_idx] = open;
+        if (open) {
+            ++rank.openBankCount;
+        } else {
+            --rank.openBankCount;
+        }
+    };
+
+    switch (command.type) {
+    case CmdType::ACT:
+        setBank(command.targetCoordinate.bank, true);
+        break;
+    case CmdType::PRE:
+    case CmdType::RDA:
+    case CmdType::WRA:
+        setBank(command.targetCoordinate.bank, false);
+        break;
+    case CmdType::PREA:
+        for (std::size_t bank_idx = 0; bank_idx < rank.openBanks.size(); ++bank_idx) {
+            setBank(bank_idx, false);
+        }
+        break;
+    case CmdType::PRESB:
+        for (std::size_t bank_idx = command.targetCoordinate.bank % m_banksPerGroup;
+             bank_idx < rank.openBanks.size(); bank_idx += m_banksPerGroup) {
+            setBank(bank_idx, false);
+        }
+        break;
+    default:
+        break;
+    }
+}
@@ -0,0 +1,177 @@
+#ifndef DRAMPOWER_UTIL_POWER_DOWN_POLICY_H
+#define DRAMPOWER_UTIL_POWER_DOWN_POLICY_H
+
+#include <DRAMPower/Exceptions.h>
+#include <DRAMPower/Types.h>
+#include <DRAMPower/command/Command.h>
+#include <DRAMPower/util/cli_architecture_config.h>
+#include <DRAMPower/util/command_fan_out.h>
+
+#include <DRAMUtils/util/json_utils.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace DRAMPower::util {
+
+enum class PowerDownMode {
+    // PDEA / PDEP depending on the open banks
+    PowerDown,
+    // SREFEN if all banks are precharged, PDEA otherwise
+    SelfRefresh,
+};
+NLOHMANN_JSON_SERIALIZE_ENUM(PowerDownMode, {
+    {PowerDownMode::PowerDown, "PowerDown"},
+    {PowerDownMode::SelfRefresh, "SelfRefresh"},
+})
+
+// Controller policy which powers a rank down after idleCycles without commands.
+// The rank is woken up by its next command, the exit is issued exitCycles before that command (e.g. tXP, tXS).
+// A rank is only powered down if it stays down for at least minCycles (e.g. tCKE). In the self refresh mode
+// minCycles must also cover the refresh issued at the entry (tRFC).
+struct PowerDownPolicy {
+    timestamp_t idleCycles = 0;
+    PowerDownMode mode = PowerDownMode::PowerDown;
+    timestamp_t exitCycles = 0;
+    timestamp_t minCycles = 0;
+};
+NLOHMANN_JSONIFY_ALL_THINGS(PowerDownPolicy, idleCycles, mode, exitCycles, minCycles)
+
+/** Inserts the power down commands of a PowerDownPolicy into a trace without power down commands
+ * The policy decides per rank. A rank is powered down idleCycles after its last command if its next
+ * command arrives at least idleCycles + minCycles + exitCycles after that command. The entry is decided
+ * as soon as the trace passed this point, so only the commands of this window are buffered.
+ * The entry (PDEA, PDEP or SREFEN) and exit (PDXA, PDXP or SREFEX) are handled by the core as if
+ * the controller issued them. Refresh commands to a rank in self refresh are dropped.
+ * Traces with power down, self refresh or deep sleep commands are rejected.
+ */
+class PowerDownPolicyFilter {
+// Public constructors
+public:
+    PowerDownPolicyFilter(const PowerDownPolicy &policy, const CLIArchitectureConfig &architecture);
+
+// Public member functions
+public:
+    // Passes command through the filter. emit(const Command&) is called for every command which is ready,
+    // in timestamp order. The data of an emitted command is valid during the call.
+    template <typename Emit>
+    void push(const Command &command, Emit &&emit) {
+        enqueue(command);
+        drain(CmdType::END_OF_SIMULATION == command.type ? std::numeric_limits<timestamp_t>::max() : forwardBound(), emit);
+    }
+
+    // Emits the remaining commands (e.g. for a trace without END_OF_SIMULATION)
+    template <typename Emit>
+    void finish(Emit &&emit) {
+        drain(std::numeric_limits<timestamp_t>::max(), emit);
+    }
+
+    const PowerDownPolicy &getPolicy() const { return m_policy; }
+    // Number of inserted power down entries
+    uint64_t getEntryCount() const { return m_entries; }
+
+// Private type definitions
+private:
+    enum class RankState {
+        Active,
+        PowerDownAct,
+        PowerDownPre,
+        SelfRefresh,
+    };
+
+    struct RankPolicyState {
+        timestamp_t lastCommand = 0;
+        RankState state = RankState::Active;
+        std::vector<bool> openBanks;
+        std::size_t openBankCount = 0;
+    };
+
+    struct PendingCommand {
+        Command command;
+        std::vector<uint8_t> data;
+    };
+
+// Private member functions
+private:
+    void enqueue(const Command &command);
+    // Commands up to the returned timestamp can't be preceded by later inserted commands
+    timestamp_t forwardBound() const;
+    void enterPowerDown(std::size_t rank_idx);
+    void exitPowerDown(std::size_t rank_idx, timestamp_t timestamp);
+    // Inserts command after the pending commands with a timestamp up to its timestamp
+    void insert(const Command &command);
+    void updateBanks(RankPolicyState &rank, const Command &command);
+
+    template <typename Emit>
+    void drain(timestamp_t bound, Emit &emit) {
+        while (!m_pending.empty() && m_pending.front().command.timestamp <= bound) {
+            PendingCommand &pending = m_pending.front();
+            if (!pending.data.empty()) {
+                pending.command.data = pending.data.data();
+            }
+            emit(std::as_const(pending.command));
+            m_pending.pop_front();
+        }
+    }
+
+// Private member variables
+private:
+    PowerDownPolicy m_policy;
+    std::size_t m_banksPerGroup;
+    std::vector<RankPolicyState> m_ranks;
+    std::deque<PendingCommand> m_pending;
+    timestamp_t m_now = 0;
+    uint64_t m_entries = 0;
+};
+
+/** Simulates one trace for several power down policies in parallel (see fanOut)
+ * drams[i] simulates the trace with the power down commands of policies[i]. The commands are filtered
+ * on the worker thread of the dram. DRAM must provide getCLIArchitectureConfig and doCommand.
+ */
+template <typename DRAM, typename Producer>
+FanOutResult sweepPowerDownPolicies(const std::vector<DRAM *> &drams, const std::vector<PowerDownPolicy> &policies,
+    Producer &&producer, std::size_t batchSize = 4096, std::size_t ringCapacity = 8)
+{
+    if (drams.size() != policies.size()) {
+        throw Exception("sweepPowerDownPolicies: one dram per policy required");
+    }
+    struct PolicyDRAM {
+        DRAM *dram;
+        PowerDownPolicyFilter filter;
+
+        void doCommand(const Command &command) {
+            filter.push(command, [this](const Command &filtered) { dram->doCommand(filtered); });
+        }
+    };
+    std::vector<PolicyDRAM> policyDrams;
+    policyDrams.reserve(drams.size());
+    for (std::size_t i = 0; i < drams.size(); ++i) {
+        policyDrams.push_back(PolicyDRAM{drams[i], PowerDownPolicyFilter(policies[i], drams[i]->getCLIArchitectureConfig())});
+    }
+    std::vector<PolicyDRAM *> targets;
+    for (PolicyDRAM &policyDram : policyDrams) {
+        targets.push_back(&policyDram);
+    }
+
+    FanOutResult result = fanOut(targets, std::forward<Producer>(producer), batchSize, ringCapacity);
+    for (std::size_t i = 0; i < policyDrams.size(); ++i) {
+        if (result.errors[i]) {
+            continue;
+        }
+        try {
+            PolicyDRAM &policyDram = policyDrams[i];
+            policyDram.filter.finish([&policyDram](const Command &filtered) { policyDram.dram->doCommand(filtered); });
+        } catch (...) {
+            result.errors[i] = std::current_exception();
+        }
+    }
+    return result;
+}
+
+} // namespace DRAMPower::util
+
+#endif /* DRAMPOWER_UTIL_POWER_DOWN_POLICY_H */
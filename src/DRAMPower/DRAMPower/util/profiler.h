@@ -0,0 +1,198 @@
+#ifndef DRAMPOWER_UTIL_PROFILER_H
+#define DRAMPOWER_UTIL_PROFILER_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#if defined(DRAMPOWER_PROFILING) && (defined(__x86_64__) || defined(_M_X64))
+    #if defined(_MSC_VER)
+        #include <intrin.h>
+    #else
+        #include <x86intrin.h>
+    #endif
+    #define DRAMPOWER_PROFILING_RDTSC
+#endif
+
+namespace DRAMPower::util::profiling {
+
+// Instrumented hot paths
+enum class Section : std::size_t {
+    DoCommand = 0,
+    ImplicitCommandQueue,
+    CommandPattern,
+    BusLoad,
+    BusStats,
+    DBIUpdate,
+    COUNT,
+};
+
+constexpr std::string_view to_string(Section section) {
+    switch (section) {
+        case Section::DoCommand: return "dram_base::doCommand";
+        case Section::ImplicitCommandQueue: return "ImplicitCommandHandler::processImplicitCommandQueue";
+        case Section::CommandPattern: return "PatternHandler::getCommandPattern";
+        case Section::BusLoad: return "Bus::load";
+        case Section::BusStats: return "Bus::get_stats";
+        case Section::DBIUpdate: return "DBI::updateDBI";
+        default: return "unknown";
+    }
+}
+
+// Upper bound for the per command type breakdown
+constexpr std::size_t MAX_COMMAND_TYPES = 32;
+
+struct Counter {
+    uint64_t calls = 0;
+    uint64_t ticks = 0;
+};
+
+struct Snapshot {
+    std::array<Counter, static_cast<std::size_t>(Section::COUNT)> sections{};
+    std::array<Counter, MAX_COMMAND_TYPES> commands{};
+};
+
+// Process wide profiling counters. The counters are only updated if the library
+// is built with DRAMPOWER_PROFILING (CMake option DRAMPOWER_ENABLE_PROFILING).
+// Otherwise the instrumentation macros expand to nothing.
+class Profiler {
+// Private type definitions
+private:
+    struct AtomicCounter {
+        std::atomic<uint64_t> calls{0};
+        std::atomic<uint64_t> ticks{0};
+
+        void add(uint64_t t) {
+            calls.fetch_add(1, std::memory_order_relaxed);
+            ticks.fetch_add(t, std::memory_order_relaxed);
+        }
+        Counter load() const {
+            return {calls.load(std::memory_order_relaxed), ticks.load(std::memory_order_relaxed)};
+        }
+        void reset() {
+            calls.store(0, std::memory_order_relaxed);
+            ticks.store(0, std::memory_order_relaxed);
+        }
+    };
+
+// Private constructors
+private:
+    Profiler() = default;
+
+// Public member functions
+public:
+    static Profiler& instance() {
+        static Profiler profiler;
+        return profiler;
+    }
+
+    static constexpr bool enabled() {
+#ifdef DRAMPOWER_PROFILING
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    // Unit of the recorded ticks
+    static constexpr std::string_view tickUnit() {
+#ifdef DRAMPOWER_PROFILING_RDTSC
+        return "cycles";
+#else
+        return "ns";
+#endif
+    }
+
+    static uint64_t now() {
+#ifdef DRAMPOWER_PROFILING_RDTSC
+        return __rdtsc();
+#else
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+    }
+
+    void add(Section section, uint64_t ticks) {
+        m_sections[static_cast<std::size_t>(section)].add(ticks);
+    }
+
+    void addCommand(std::size_t commandType, uint64_t ticks) {
+        if (commandType < MAX_COMMAND_TYPES) {
+            m_commands[commandType].add(ticks);
+        }
+    }
+
+    Snapshot snapshot() const {
+        Snapshot result;
+        for (std::size_t i = 0; i < m_sections.size(); ++i) {
+            result.sections[i] = m_sections[i].load();
+        }
+        for (std::size_t i = 0; i < m_commands.size(); ++i) {
+            result.commands[i] = m_commands[i].load();
+        }
+        return result;
+    }
+
+    void reset() {
+        for (auto& counter : m_sections) {
+            counter.reset();
+        }
+        for (auto& counter : m_commands) {
+            counter.reset();
+        }
+    }
+
+// Private member variables
+private:
+    std::array<AtomicCounter, static_cast<std::size_t>(Section::COUNT)> m_sections;
+    std::array<AtomicCounter, MAX_COMMAND_TYPES> m_commands;
+};
+
+// Records the ticks between construction and destruction
+class ScopedTimer {
+public:
+    explicit ScopedTimer(Section section)
+        : m_section(section)
+        , m_start(Profiler::now())
+    {}
+    ScopedTimer(Section section, std::size_t commandType)
+        : m_section(section)
+        , m_commandType(commandType)
+        , m_start(Profiler::now())
+    {}
+    ~ScopedTimer() {
+        uint64_t ticks = Profiler::now() - m_start;
+        Profiler::instance().add(m_section, ticks);
+        if (m_commandType < MAX_COMMAND_TYPES) {
+            Profiler::instance().addCommand(m_commandType, ticks);
+        }
+    }
+
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+private:
+    Section m_section;
+    std::size_t m_commandType = MAX_COMMAND_TYPES;
+    uint64_t m_start;
+};
+
+} // namespace DRAMPower::util::profiling
+
+#define DRAMPOWER_PROFILE_CONCAT_IMPL(a, b) a##b
+#define DRAMPOWER_PROFILE_CONCAT(a, b) DRAMPOWER_PROFILE_CONCAT_IMPL(a, b)
+
+#ifdef DRAMPOWER_PROFILING
+    #define DRAMPOWER_PROFILE_SCOPE(section) \
+        ::DRAMPower::util::profiling::ScopedTimer DRAMPOWER_PROFILE_CONCAT(drampower_profile_, __LINE__){section}
+    #define DRAMPOWER_PROFILE_COMMAND_SCOPE(section, commandType) \
+        ::DRAMPower::util::profiling::ScopedTimer DRAMPOWER_PROFILE_CONCAT(drampower_profile_, __LINE__){section, static_cast<std::size_t>(commandType)}
+#else
+    #define DRAMPOWER_PROFILE_SCOPE(section) ((void)0)
+    #define DRAMPOWER_PROFILE_COMMAND_SCOPE(section, commandType) ((void)0)
+#endif
+
+#endif /* DRAMPOWER_UTIL_PROFILER_H */
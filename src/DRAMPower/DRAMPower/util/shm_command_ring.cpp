@@ -0,0 +1,398 @@
+#include "shm_command_ring.h"
+
+#include <DRAMPower/Exceptions.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <new>
+#include <thread>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <cerrno>
+#include <csignal>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define DRAMPOWER_SHM_COMMAND_RING
+#endif
+
+using namespace DRAMPower;
+using namespace DRAMPower::util;
+
+namespace {
+
+constexpr uint64_t MAGIC = 0x474e495244504d44ull; // "DMPDRING"
+// Increment if the layout of the segment or of the records changes
+constexpr uint32_t VERSION = 1;
+constexpr std::size_t MIN_CAPACITY = 4096;
+constexpr std::size_t CACHE_LINE = 64;
+
+enum RecordKind : uint32_t {
+    RECORD_COMMAND = 1,
+    RECORD_PADDING = 2,
+    RECORD_END_OF_STREAM = 3,
+};
+
+constexpr std::size_t alignUp(std::size_t value, std::size_t alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+std::size_t roundCapacity(std::size_t capacity) {
+    std::size_t result = MIN_CAPACITY;
+    while (result < capacity) {
+        result <<= 1;
+    }
+    return result;
+}
+
+} // namespace
+
+struct ShmCommandRing::SharedHeader {
+    std::atomic<uint64_t> magic;
+    uint32_t version;
+    uint32_t recordHeaderSize;
+    uint64_t capacity;
+    // Attached processes and detach flags indexed by Role
+    std::atomic<int64_t> pid[2];
+    std::atomic<uint32_t> detached[2];
+    // Written by the producer
+    alignas(CACHE_LINE) std::atomic<uint64_t> head;
+    // Written by the consumer
+    alignas(CACHE_LINE) std::atomic<uint64_t> tail;
+};
+
+struct ShmCommandRing::RecordHeader {
+    uint32_t kind;
+    uint32_t type;
+    // Size of the record including the header and the padded data
+    uint64_t size;
+    uint64_t timestamp;
+    uint64_t bank;
+    uint64_t bankGroup;
+    uint64_t rank;
+    uint64_t row;
+    uint64_t column;
+    uint64_t sz_bits;
+};
+
+#ifdef DRAMPOWER_SHM_COMMAND_RING
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free && std::atomic<int64_t>::is_always_lock_free
+    && std::atomic<uint32_t>::is_always_lock_free, "Shared memory ring requires lock free atomics");
+
+namespace {
+
+std::string shmName(const std::string &name) {
+    return (!name.empty() && '/' == name.front()) ? name : "/" + name;
+}
+
+} // namespace
+
+ShmCommandRing::ShmCommandRing(const std::string &name, Role role, std::size_t capacity)
+    : m_name(shmName(name))
+    , m_role(role)
+{
+    const std::size_t headerSize = alignUp(sizeof(SharedHeader), CACHE_LINE);
+    bool created = true;
+    int fd = ::shm_open(m_name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (fd < 0 && EEXIST == errno) {
+        created = false;
+        fd = ::shm_open(m_name.c_str(), O_RDWR, 0600);
+    }
+    if (fd < 0) {
+        throw Exception("ShmCommandRing: cannot open shared memory segment " + m_name + ": " + std::strerror(errno));
+    }
+
+    if (created) {
+        capacity = roundCapacity(capacity);
+        m_mappedSize = headerSize + capacity;
+        if (0 != ::ftruncate(fd, static_cast<off_t>(m_mappedSize))) {
+            const int error = errno;
+            ::close(fd);
+            ::shm_unlink(m_name.c_str());
+            throw Exception("ShmCommandRing: cannot resize shared memory segment " + m_name + ": " + std::strerror(error));
+        }
+    } else {
+        // Wait until the creator resized the segment
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+        struct stat st;
+        while (0 != ::fstat(fd, &st) || static_cast<std::size_t>(st.st_size) <= headerSize) {
+            if (std::chrono::steady_clock::now() > deadline) {
+                ::close(fd);
+                throw Exception("ShmCommandRing: shared memory segment " + m_name + " was not initialized");
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        m_mappedSize = static_cast<std::size_t>(st.st_size);
+    }
+
+    void *memory = ::mmap(nullptr, m_mappedSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (MAP_FAILED == memory) {
+        if (created) {
+            ::shm_unlink(m_name.c_str());
+        }
+        throw Exception("ShmCommandRing: cannot map shared memory segment " + m_name + ": " + std::strerror(errno));
+    }
+    m_data = static_cast<uint8_t *>(memory) + headerSize;
+
+    if (created) {
+        // The segment is zero-initialized
+        m_header = new (memory) SharedHeader;
+        m_header->version = VERSION;
+        m_header->recordHeaderSize = sizeof(RecordHeader);
+        m_header->capacity = capacity;
+        m_header->magic.store(MAGIC, std::memory_order_release);
+    } else {
+        m_header = static_cast<SharedHeader *>(memory);
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+        while (MAGIC != m_header->magic.load(std::memory_order_acquire)) {
+            if (std::chrono::steady_clock::now() > deadline) {
+                ::munmap(memory, m_mappedSize);
+                throw Exception("ShmCommandRing: shared memory segment " + m_name + " was not initialized");
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        if (VERSION != m_header->version
+            || sizeof(RecordHeader) != m_header->recordHeaderSize
+            || headerSize + m_header->capacity != m_mappedSize
+        ) {
+            ::munmap(memory, m_mappedSize);
+            throw Exception("ShmCommandRing: incompatible shared memory segment " + m_name);
+        }
+    }
+
+    // Register as the only producer or consumer
+    int64_t expected = 0;
+    if (!m_header->pid[static_cast<std::size_t>(m_role)].compare_exchange_strong(expected, static_cast<int64_t>(::getpid()))) {
+        ::munmap(memory, m_mappedSize);
+        throw Exception("ShmCommandRing: shared memory segment " + m_name + " already has a "
+            + (Role::Producer == m_role ? "producer" : "consumer"));
+    }
+    m_position = Role::Producer == m_role
+        ? m_header->head.load(std::memory_order_relaxed)
+        : m_header->tail.load(std::memory_order_relaxed);
+    m_cachedOther = Role::Producer == m_role
+        ? m_header->tail.load(std::memory_order_acquire)
+        : m_header->head.load(std::memory_order_acquire);
+}
+
+ShmCommandRing::~ShmCommandRing() {
+    if (!m_header) {
+        return;
+    }
+    m_header->detached[static_cast<std::size_t>(m_role)].store(1, std::memory_order_release);
+    ::munmap(m_header, m_mappedSize);
+    // The consumer is the last user of the stream
+    if (Role::Consumer == m_role) {
+        ::shm_unlink(m_name.c_str());
+    }
+}
+
+void ShmCommandRing::unlink(const std::string &name) {
+    ::shm_unlink(shmName(name).c_str());
+}
+
+void ShmCommandRing::backoff(std::size_t &iteration) const {
+    ++iteration;
+    if (iteration < 64) {
+        return;
+    }
+    if (iteration < 1024) {
+        std::this_thread::yield();
+        return;
+    }
+    // Idle: check the other side before sleeping
+    const std::size_t other = Role::Producer == m_role ? 1 : 0;
+    const int64_t pid = m_header->pid[other].load(std::memory_order_acquire);
+    const bool detached = 0 != m_header->detached[other].load(std::memory_order_acquire);
+    if (0 != pid && (detached || (0 != ::kill(static_cast<pid_t>(pid), 0) && ESRCH == errno))) {
+        // Last check if the stream was completed before the other side detached
+        if (Role::Consumer == m_role && m_header->head.load(std::memory_order_acquire) != m_position) {
+            return;
+        }
+        throw Exception(Role::Producer == m_role
+            ? "ShmCommandRing: consumer detached from " + m_name
+            : "ShmCommandRing: producer detached from " + m_name + " without closing the stream");
+    }
+    std::this_thread::sleep_for(std::chrono::microseconds(50));
+}
+
+#else
+
+ShmCommandRing::ShmCommandRing(const std::string &name, Role role, std::size_t)
+    : m_name(name)
+    , m_role(role)
+{
+    throw Exception("ShmCommandRing: shared memory is not supported on this platform");
+}
+
+ShmCommandRing::~ShmCommandRing() = default;
+
+void ShmCommandRing::unlink(const std::string &) {}
+
+void ShmCommandRing::backoff(std::size_t &) const {}
+
+#endif
+
+std::size_t ShmCommandRing::capacity() const {
+    return m_header->capacity;
+}
+
+std::size_t ShmCommandRing::maxDataBytes() const {
+    // Every record fits into the ring if it is at most half of the capacity
+    return m_header->capacity / 2 - sizeof(RecordHeader);
+}
+
+bool ShmCommandRing::tryWrite(const RecordHeader &record, const uint8_t *data, std::size_t dataBytes) {
+    const uint64_t capacity = m_header->capacity;
+    uint64_t head = m_position;
+    const uint64_t offset = head & (capacity - 1);
+    const uint64_t contiguous = capacity - offset;
+    // Records don't wrap around, the rest of the ring is skipped
+    const uint64_t needed = record.size <= contiguous ? record.size : contiguous + record.size;
+    if (capacity - (head - m_cachedOther) < needed) {
+        m_cachedOther = m_header->tail.load(std::memory_order_acquire);
+        if (capacity - (head - m_cachedOther) < needed) {
+            return false;
+        }
+    }
+    if (record.size > contiguous) {
+        // The consumer skips a rest smaller than a record header without padding record
+        if (contiguous >= sizeof(RecordHeader)) {
+            RecordHeader padding{};
+            padding.kind = RECORD_PADDING;
+            padding.size = contiguous;
+            std::memcpy(m_data + offset, &padding, sizeof(padding));
+        }
+        head += contiguous;
+    }
+    uint8_t *destination = m_data + (head & (capacity - 1));
+    std::memcpy(destination, &record, sizeof(record));
+    if (0 != dataBytes) {
+        std::memcpy(destination + sizeof(record), data, dataBytes);
+    }
+    m_position = head + record.size;
+    m_header->head.store(m_position, std::memory_order_release);
+    return true;
+}
+
+void ShmCommandRing::waitForSpace(const RecordHeader &record, const uint8_t *data, std::size_t dataBytes) {
+    if (Role::Producer != m_role) {
+        throw Exception("ShmCommandRing: only the producer can write to " + m_name);
+    }
+    if (record.size > m_header->capacity / 2) {
+        throw Exception("ShmCommandRing: command data exceeds the capacity of " + m_name);
+    }
+    std::size_t iteration = 0;
+    while (!tryWrite(record, data, dataBytes)) {
+        backoff(iteration);
+    }
+}
+
+std::size_t ShmCommandRing::recordSize(const Command &command) const {
+    const std::size_t dataBytes = nullptr != command.data ? (command.sz_bits + 7) / 8 : 0;
+    return alignUp(sizeof(RecordHeader) + dataBytes, alignof(RecordHeader));
+}
+
+ShmCommandRing::RecordHeader ShmCommandRing::makeRecord(const Command &command) const {
+    RecordHeader record{};
+    record.kind = RECORD_COMMAND;
+    record.type = static_cast<uint32_t>(command.type);
+    record.size = recordSize(command);
+    record.timestamp = command.timestamp;
+    record.bank = command.targetCoordinate.bank;
+    record.bankGroup = command.targetCoordinate.bankGroup;
+    record.rank = command.targetCoordinate.rank;
+    record.row = command.targetCoordinate.row;
+    record.column = command.targetCoordinate.column;
+    record.sz_bits = nullptr != command.data ? command.sz_bits : 0;
+    return record;
+}
+
+void ShmCommandRing::push(const Command &command) {
+    const RecordHeader record = makeRecord(command);
+    waitForSpace(record, command.data, (record.sz_bits + 7) / 8);
+}
+
+bool ShmCommandRing::tryPush(const Command &command) {
+    if (Role::Producer != m_role) {
+        throw Exception("ShmCommandRing: only the producer can write to " + m_name);
+    }
+    const RecordHeader record = makeRecord(command);
+    if (record.size > m_header->capacity / 2) {
+        throw Exception("ShmCommandRing: command data exceeds the capacity of " + m_name);
+    }
+    return tryWrite(record, command.data, (record.sz_bits + 7) / 8);
+}
+
+void ShmCommandRing::close() {
+    RecordHeader record{};
+    record.kind = RECORD_END_OF_STREAM;
+    record.size = sizeof(RecordHeader);
+    waitForSpace(record, nullptr, 0);
+}
+
+std::optional<Command> ShmCommandRing::acquire() {
+    if (Role::Consumer != m_role) {
+        throw Exception("ShmCommandRing: only the consumer can read from " + m_name);
+    }
+    if (m_finished) {
+        return std::nullopt;
+    }
+    std::size_t iteration = 0;
+    while (m_position == m_cachedOther) {
+        m_cachedOther = m_header->head.load(std::memory_order_acquire);
+        if (m_position == m_cachedOther) {
+            backoff(iteration);
+        }
+    }
+
+    const uint64_t capacity = m_header->capacity;
+    uint64_t offset = m_position & (capacity - 1);
+    uint64_t skipped = 0;
+    RecordHeader record;
+    if (capacity - offset < sizeof(RecordHeader)) {
+        skipped = capacity - offset;
+        offset = 0;
+    }
+    std::memcpy(&record, m_data + offset, sizeof(record));
+    if (RECORD_PADDING == record.kind) {
+        skipped = capacity - offset;
+        offset = 0;
+        std::memcpy(&record, m_data, sizeof(record));
+    }
+
+    if (RECORD_END_OF_STREAM == record.kind) {
+        m_finished = true;
+        m_position += skipped + record.size;
+        m_header->tail.store(m_position, std::memory_order_release);
+        return std::nullopt;
+    }
+    const std::size_t dataBytes = (record.sz_bits + 7) / 8;
+    if (RECORD_COMMAND != record.kind
+        || record.type >= static_cast<uint32_t>(CmdType::COUNT)
+        || record.size < sizeof(RecordHeader) + dataBytes
+        || record.size > capacity - offset
+    ) {
+        throw Exception("ShmCommandRing: corrupted record in " + m_name);
+    }
+
+    m_acquired = skipped + record.size;
+    const uint8_t *data = 0 != dataBytes ? m_data + offset + sizeof(RecordHeader) : nullptr;
+    return Command{
+        record.timestamp,
+        static_cast<CmdType>(record.type),
+        {record.bank, record.bankGroup, record.rank, record.row, record.column},
+        data,
+        static_cast<std::size_t>(record.sz_bits)
+    };
+}
+
+void ShmCommandRing::release() {
+    m_position += m_acquired;
+    m_acquired = 0;
+    m_header->tail.store(m_position, std::memory_order_release);
+}
@@ -0,0 +1,109 @@
+#ifndef DRAMPOWER_UTIL_SHM_COMMAND_RING_H
+#define DRAMPOWER_UTIL_SHM_COMMAND_RING_H
+
+#include <DRAMPower/Types.h>
+#include <DRAMPower/command/Command.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+
+namespace DRAMPower::util {
+
+// Single producer single consumer ring buffer in POSIX shared memory for streaming
+// commands with their data from another process.
+// Both sides attach to the segment by name, the first one creates and initializes it.
+// Every command is stored as a fixed record header followed by its data, a record never
+// wraps around the end of the ring. The producer blocks while the ring is full
+// (backpressure), the consumer blocks while the ring is empty. The producer terminates
+// the stream with close(). A waiting side throws if the other process exited without
+// closing the stream.
+class ShmCommandRing {
+// Public type definitions
+public:
+    enum class Role {
+        Producer,
+        Consumer,
+    };
+
+    static constexpr std::size_t DEFAULT_CAPACITY = 64 * 1024 * 1024;
+
+// Public constructors and assignment operators
+public:
+    // capacity is only used if the segment is created. The capacity is rounded up to a power of two.
+    ShmCommandRing(const std::string &name, Role role, std::size_t capacity = DEFAULT_CAPACITY);
+    ~ShmCommandRing();
+
+    ShmCommandRing(const ShmCommandRing&) = delete;
+    ShmCommandRing& operator=(const ShmCommandRing&) = delete;
+
+// Public member functions
+public:
+    const std::string& name() const { return m_name; }
+    Role role() const { return m_role; }
+    std::size_t capacity() const;
+    // Largest number of data bytes of a single command
+    std::size_t maxDataBytes() const;
+
+    // Producer
+    // Blocks until the ring has space for the command
+    void push(const Command &command);
+    // Returns false if the ring is full
+    bool tryPush(const Command &command);
+    // Writes the end of stream marker
+    void close();
+
+    // Consumer
+    // Blocks until the next command is available. Returns std::nullopt at the end of the stream.
+    // The data of the command points into the ring and stays valid until release().
+    std::optional<Command> acquire();
+    void release();
+    bool finished() const { return m_finished; }
+
+    // Removes the shared memory segment. The segments of attached rings stay mapped.
+    static void unlink(const std::string &name);
+
+// Private member functions
+private:
+    struct SharedHeader;
+    struct RecordHeader;
+
+    std::size_t recordSize(const Command &command) const;
+    RecordHeader makeRecord(const Command &command) const;
+    bool tryWrite(const RecordHeader &record, const uint8_t *data, std::size_t dataBytes);
+    void waitForSpace(const RecordHeader &record, const uint8_t *data, std::size_t dataBytes);
+    void backoff(std::size_t &iteration) const;
+
+// Private member variables
+private:
+    std::string m_name;
+    Role m_role;
+    SharedHeader *m_header = nullptr;
+    uint8_t *m_data = nullptr;
+    std::size_t m_mappedSize = 0;
+
+    // Positions cached by the own side
+    uint64_t m_position = 0;
+    uint64_t m_cachedOther = 0;
+    // Size of the acquired record including skipped padding
+    uint64_t m_acquired = 0;
+    bool m_finished = false;
+};
+
+// Feeds all commands of the ring to the dram until the end of the stream.
+// Returns the number of simulated commands.
+template <typename DRAM>
+uint64_t simulateCommandRing(ShmCommandRing &ring, DRAM &dram) {
+    uint64_t count = 0;
+    while (auto command = ring.acquire()) {
+        dram.doCommand(*command);
+        ring.release();
+        ++count;
+    }
+    return count;
+}
+
+} // namespace DRAMPower::util
+
+#endif /* DRAMPOWER_UTIL_SHM_COMMAND_RING_H */
@@ -0,0 +1,367 @@
+#include "result_writer.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iterator>
+#include <utility>
+
+#include <DRAMUtils/util/json.h>
+#include <spdlog/fmt/fmt.h>
+
+namespace DRAMPower::DRAMPowerCLI {
+
+const std::array<BankEnergyField, 15> BANK_ENERGY_FIELDS = {{
+	{"ACT", &energy_info_t::E_act},
+	{"BG_ACT", &energy_info_t::E_bg_act},
+	{"BG_PRE", &energy_info_t::E_bg_pre},
+	{"PRE", &energy_info_t::E_pre},
+	{"PRE_RDA", &energy_info_t::E_pre_RDA},
+	{"PRE_WRA", &energy_info_t::E_pre_WRA},
+	{"RD", &energy_info_t::E_RD},
+	{"RDA", &energy_info_t::E_RDA},
+	{"REF_2B", &energy_info_t::E_ref_2B},
+	{"REF_AB", &energy_info_t::E_ref_AB},
+	{"REF_DB", &energy_info_t::E_ref_DB},
+	{"REF_PB", &energy_info_t::E_ref_PB},
+	{"REF_SB", &energy_info_t::E_ref_SB},
+	{"WR", &energy_info_t::E_WR},
+	{"WRA", &energy_info_t::E_WRA},
+}};
+
+namespace {
+
+constexpr char BINARY_MAGIC[8] = {'D', 'P', 'R', 'E', 'S', 'U', 'L', 'T'};
+constexpr uint32_t BINARY_VERSION = 1;
+
+bool validate(const util::CLIArchitectureConfig &config, const energy_t &core_energy)
+{
+	return core_energy.bank_energy.size() == config.rankCount * config.deviceCount * config.bankCount;
+}
+
+bool writeJson(OutputBuffer &out, const util::CLIArchitectureConfig &config,
+	const energy_t &core_energy, const interface_energy_info_t &interface_energy, int indent)
+{
+	// The members are written in the key order of the DOM based output
+	JsonStreamWriter writer{out, indent};
+	writer.beginObject();
+	writer.member("BankCount", config.bankCount);
+
+	writer.key("CoreEnergy");
+	writer.beginObject();
+	writer.key(core_energy.get_Bank_energy_keyword());
+	writer.beginArray();
+	std::size_t energy_offset = 0;
+	for ( std::size_t r = 0; r < config.rankCount; r++ ) {
+		for ( std::size_t d = 0; d < config.deviceCount; d++ ) {
+			for ( std::size_t b = 0; b < config.bankCount; b++ ) {
+				const energy_info_t &energy = core_energy.bank_energy[energy_offset++];
+				// Rank,Device,Bank description merged into the sorted energy fields
+				const std::array<std::pair<std::string_view, uint64_t>, 3> description = {{
+					{"Bank", b}, {"Device", d}, {"Rank", r}
+				}};
+				auto next = description.begin();
+				writer.beginObject();
+				for (const auto &field : BANK_ENERGY_FIELDS) {
+					for (; next != description.end() && next->first < field.name; ++next) {
+						writer.member(next->first, next->second);
+					}
+					writer.member(field.name, energy.*field.member);
+				}
+				for (; next != description.end(); ++next) {
+					writer.member(next->first, next->second);
+				}
+				writer.endObject();
+			}
+		}
+	}
+	writer.endArray();
+	writer.member("E_PDNA", core_energy.E_PDNA);
+	writer.member("E_PDNP", core_energy.E_PDNP);
+	writer.member("E_bg_act_shared", core_energy.E_bg_act_shared);
+	writer.member("E_dsm", core_energy.E_dsm);
+	writer.member("E_refab", core_energy.E_refab);
+	writer.member("E_sref", core_energy.E_sref);
+	writer.endObject();
+
+	writer.member("DeviceCount", config.deviceCount);
+
+	writer.key("InterfaceEnergy");
+	writer.beginObject();
+	writer.key("controller");
+	writer.beginObject();
+	writer.member("dynamicEnergy", interface_energy.controller.dynamicEnergy);
+	writer.member("staticEnergy", interface_energy.controller.staticEnergy);
+	writer.endObject();
+	writer.key("dram");
+	writer.beginObject();
+	writer.member("dynamicEnergy", interface_energy.dram.dynamicEnergy);
+	writer.member("staticEnergy", interface_energy.dram.staticEnergy);
+	writer.endObject();
+	writer.endObject();
+
+	writer.member("RankCount", config.rankCount);
+	writer.member("TotalEnergy", core_energy.total() + interface_energy.total());
+	writer.endObject();
+	if (indent >= 0) {
+		out.put('\n');
+	}
+	return true;
+}
+
+bool writeCsv(OutputBuffer &out, const util::CLIArchitectureConfig &config,
+	const energy_t &core_energy, const interface_energy_info_t &interface_energy)
+{
+	char buffer[64];
+	fmt::memory_buffer row;
+	auto writeRow = [&out, &row](std::string_view name, std::string_view index, double value) {
+		row.clear();
+		fmt::format_to(std::back_inserter(row), "{},{},{}\n", name, index, value);
+		out.write(row.data(), row.size());
+	};
+
+	out.write("Name,Rank,Device,Bank,Energy\n");
+	std::size_t energy_offset = 0;
+	for ( std::size_t r = 0; r < config.rankCount; r++ ) {
+		for ( std::size_t d = 0; d < config.deviceCount; d++ ) {
+			for ( std::size_t b = 0; b < config.bankCount; b++ ) {
+				const energy_info_t &energy = core_energy.bank_energy[energy_offset++];
+				auto index = fmt::format_to_n(buffer, sizeof(buffer), "{},{},{}", r, d, b);
+				for (const auto &field : BANK_ENERGY_FIELDS) {
+					writeRow(field.name, std::string_view{buffer, index.size}, energy.*field.member);
+				}
+			}
+		}
+	}
+	writeRow("E_bg_act_shared", ",,", core_energy.E_bg_act_shared);
+	writeRow("E_PDNA", ",,", core_energy.E_PDNA);
+	writeRow("E_PDNP", ",,", core_energy.E_PDNP);
+	writeRow("E_sref", ",,", core_energy.E_sref);
+	writeRow("E_dsm", ",,", core_energy.E_dsm);
+	writeRow("E_refab", ",,", core_energy.E_refab);
+	writeRow("controller.dynamicEnergy", ",,", interface_energy.controller.dynamicEnergy);
+	writeRow("controller.staticEnergy", ",,", interface_energy.controller.staticEnergy);
+	writeRow("dram.dynamicEnergy", ",,", interface_energy.dram.dynamicEnergy);
+	writeRow("dram.staticEnergy", ",,", interface_energy.dram.staticEnergy);
+	writeRow("TotalEnergy", ",,", core_energy.total() + interface_energy.total());
+	return true;
+}
+
+bool writeBinary(OutputBuffer &out, const util::CLIArchitectureConfig &config,
+	const energy_t &core_energy, const interface_energy_info_t &interface_energy)
+{
+	auto writeValue = [&out](auto value) {
+		out.write(&value, sizeof(value));
+	};
+
+	out.write(BINARY_MAGIC, sizeof(BINARY_MAGIC));
+	writeValue(BINARY_VERSION);
+	writeValue(static_cast<uint32_t>(BANK_ENERGY_FIELDS.size()));
+	writeValue(config.rankCount);
+	writeValue(config.deviceCount);
+	writeValue(config.bankCount);
+	for (const energy_info_t &energy : core_energy.bank_energy) {
+		for (const auto &field : BANK_ENERGY_FIELDS) {
+			writeValue(energy.*field.member);
+		}
+	}
+	writeValue(core_energy.E_bg_act_shared);
+	writeValue(core_energy.E_PDNA);
+	writeValue(core_energy.E_PDNP);
+	writeValue(core_energy.E_sref);
+	writeValue(core_energy.E_dsm);
+	writeValue(core_energy.E_refab);
+	writeValue(interface_energy.controller.dynamicEnergy);
+	writeValue(interface_energy.controller.staticEnergy);
+	writeValue(interface_energy.dram.dynamicEnergy);
+	writeValue(interface_energy.dram.staticEnergy);
+	writeValue(core_energy.total() + interface_energy.total());
+	return true;
+}
+
+} // namespace
+
+std::optional<ResultFormat> resultFormatFromString(std::string_view format)
+{
+	if (format == "json") {
+		return ResultFormat::JSON;
+	}
+	if (format == "csv") {
+		return ResultFormat::CSV;
+	}
+	if (format == "binary") {
+		return ResultFormat::Binary;
+	}
+	return std::nullopt;
+}
+
+OutputBuffer::OutputBuffer(const std::string &file)
+	: m_file(std::fopen(file.c_str(), "wb"))
+	, m_buffer(BUFFER_SIZE)
+{
+	if (m_file) {
+		// Buffering is done by this class
+		std::setvbuf(m_file, nullptr, _IONBF, 0);
+	}
+	m_good = is_open();
+}
+
+OutputBuffer::OutputBuffer(std::string &target)
+	: m_target(&target)
+	, m_buffer(BUFFER_SIZE)
+{}
+
+OutputBuffer::~OutputBuffer()
+{
+	close();
+}
+
+void OutputBuffer::write(const void *data, std::size_t size)
+{
+	const char *bytes = static_cast<const char *>(data);
+	while (size > 0) {
+		if (m_size == m_buffer.size()) {
+			flush();
+		}
+		std::size_t chunk = std::min(size, m_buffer.size() - m_size);
+		std::memcpy(m_buffer.data() + m_size, bytes, chunk);
+		m_size += chunk;
+		bytes += chunk;
+		size -= chunk;
+	}
+}
+
+bool OutputBuffer::flush()
+{
+	if (m_file && m_size > 0) {
+		m_good = m_good && m_size == std::fwrite(m_buffer.data(), 1, m_size, m_file);
+	}
+	if (m_target) {
+		m_target->append(m_buffer.data(), m_size);
+	}
+	m_size = 0;
+	return m_good;
+}
+
+bool OutputBuffer::close()
+{
+	if (m_target) {
+		flush();
+		m_target = nullptr;
+		return m_good;
+	}
+	if (!m_file) {
+		return m_good;
+	}
+	flush();
+	m_good = 0 == std::fclose(m_file) && m_good;
+	m_file = nullptr;
+	return m_good;
+}
+
+void JsonStreamWriter::newline(std::size_t depth)
+{
+	if (m_indent < 0) {
+		return;
+	}
+	m_out.put('\n');
+	for (std::size_t i = 0; i < depth * static_cast<std::size_t>(m_indent); ++i) {
+		m_out.put(' ');
+	}
+}
+
+void JsonStreamWriter::element()
+{
+	if (m_afterKey) {
+		m_afterKey = false;
+		return;
+	}
+	if (m_scopes.empty()) {
+		return;
+	}
+	if (m_scopes.back() > 0) {
+		m_out.put(',');
+	}
+	newline(m_scopes.size());
+	++m_scopes.back();
+}
+
+void JsonStreamWriter::open(char bracket)
+{
+	element();
+	m_out.put(bracket);
+	m_scopes.push_back(0);
+}
+
+void JsonStreamWriter::close(char bracket)
+{
+	std::size_t elements = m_scopes.back();
+	m_scopes.pop_back();
+	if (elements > 0) {
+		newline(m_scopes.size());
+	}
+	m_out.put(bracket);
+}
+
+void JsonStreamWriter::key(std::string_view name)
+{
+	element();
+	m_out.put('"');
+	m_out.write(name);
+	m_out.write(m_indent < 0 ? "\":" : "\": ");
+	m_afterKey = true;
+}
+
+void JsonStreamWriter::value(double value)
+{
+	element();
+	// Same conversion as the serializer of nlohmann::json, which appends ".0" to integral values
+	if (!std::isfinite(value)) {
+		m_out.write("null");
+		return;
+	}
+	char buffer[64];
+	char *end = nlohmann::detail::to_chars(buffer, buffer + sizeof(buffer), value);
+	m_out.write(buffer, static_cast<std::size_t>(end - buffer));
+}
+
+void JsonStreamWriter::value(uint64_t value)
+{
+	element();
+	char buffer[32];
+	auto result = fmt::format_to_n(buffer, sizeof(buffer), "{}", value);
+	m_out.write(buffer, result.size);
+}
+
+bool writeResult(OutputBuffer &out, ResultFormat format, const util::CLIArchitectureConfig &config,
+	const energy_t &core_energy, const interface_energy_info_t &interface_energy, int jsonIndent)
+{
+	if (!validate(config, core_energy)) {
+		return false;
+	}
+	switch (format) {
+		case ResultFormat::JSON:
+			return writeJson(out, config, core_energy, interface_energy, jsonIndent);
+		case ResultFormat::CSV:
+			return writeCsv(out, config, core_energy, interface_energy);
+		case ResultFormat::Binary:
+			return writeBinary(out, config, core_energy, interface_energy);
+	}
+	return false;
+}
+
+bool writeResult(const std::string &file, ResultFormat format, const util::CLIArchitectureConfig &config,
+	const energy_t &core_energy, const interface_energy_info_t &interface_energy)
+{
+	if (!validate(config, core_energy)) {
+		return false;
+	}
+	OutputBuffer out(file);
+	if (!out.is_open()) {
+		return false;
+	}
+	bool result = writeResult(out, format, config, core_energy, interface_energy);
+	return out.close() && result;
+}
+
+} // namespace DRAMPower::DRAMPowerCLI
@@ -0,0 +1,128 @@
+#ifndef LIB_DRAMPOWERCLI_RESULT_WRITER_H
+#define LIB_DRAMPOWERCLI_RESULT_WRITER_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <DRAMPower/data/energy.h>
+#include <DRAMPower/util/cli_architecture_config.h>
+
+namespace DRAMPower::DRAMPowerCLI {
+
+enum class ResultFormat {
+	JSON,
+	CSV,
+	Binary,
+};
+
+std::optional<ResultFormat> resultFormatFromString(std::string_view format);
+
+// Buffered file output. The buffer has a fixed size and is flushed when full,
+// so the memory footprint doesn't depend on the size of the written result.
+// The string constructor appends the output to the target string instead of a file.
+class OutputBuffer {
+public:
+	static constexpr std::size_t BUFFER_SIZE = 64 * 1024;
+
+	explicit OutputBuffer(const std::string &file);
+	explicit OutputBuffer(std::string &target);
+	~OutputBuffer();
+
+	OutputBuffer(const OutputBuffer&) = delete;
+	OutputBuffer& operator=(const OutputBuffer&) = delete;
+
+	bool is_open() const { return nullptr != m_file || nullptr != m_target; }
+	bool good() const { return m_good; }
+
+	void put(char c) {
+		if (m_size == m_buffer.size()) {
+			flush();
+		}
+		m_buffer[m_size++] = c;
+	}
+	void write(std::string_view data) { write(data.data(), data.size()); }
+	void write(const void *data, std::size_t size);
+	bool flush();
+	bool close();
+
+private:
+	std::FILE *m_file = nullptr;
+	std::string *m_target = nullptr;
+	std::vector<char> m_buffer;
+	std::size_t m_size = 0;
+	bool m_good = true;
+};
+
+// SAX style JSON writer. The output format matches nlohmann::json::dump(indent),
+// but values are written as soon as they are known instead of building a DOM.
+// A negative indent writes the compact single line format.
+// Keys are written as is and must not need escaping.
+class JsonStreamWriter {
+public:
+	JsonStreamWriter(OutputBuffer &out, int indent = 4)
+		: m_out(out)
+		, m_indent(indent)
+	{}
+
+	void beginObject() { open('{'); }
+	void endObject() { close('}'); }
+	void beginArray() { open('['); }
+	void endArray() { close(']'); }
+
+	void key(std::string_view name);
+	void value(double value);
+	void value(uint64_t value);
+
+	template <typename T>
+	void member(std::string_view name, T v) {
+		key(name);
+		value(v);
+	}
+
+private:
+	void open(char bracket);
+	void close(char bracket);
+	// Separator and indentation before a new array element or object member
+	void element();
+	void newline(std::size_t depth);
+
+	OutputBuffer &m_out;
+	int m_indent;
+	// Number of elements per open scope
+	std::vector<std::size_t> m_scopes;
+	bool m_afterKey = false;
+};
+
+// Energy fields of a bank, sorted by key like the DOM based JSON output
+struct BankEnergyField {
+	std::string_view name;
+	double energy_info_t::* member;
+};
+extern const std::array<BankEnergyField, 15> BANK_ENERGY_FIELDS;
+
+// Streams the result to the file in the given format.
+//
+// JSON:   Same schema as energy_t::to_json with the Rank/Device/Bank description.
+// CSV:    One row per value with the header Name,Rank,Device,Bank,Energy.
+//         Rank, Device and Bank are empty for values that don't belong to a bank.
+// Binary: Native byte order. Header "DPRESULT", uint32_t version, uint32_t number
+//         of bank fields, uint64_t rank, device and bank count. Followed by the
+//         doubles of the bank fields for every bank (rank major, then device and bank),
+//         E_bg_act_shared, E_PDNA, E_PDNP, E_sref, E_dsm, E_refab, controller dynamic
+//         and static, dram dynamic and static interface energy and the total energy.
+bool writeResult(const std::string &file, ResultFormat format, const util::CLIArchitectureConfig &config,
+	const energy_t &core_energy, const interface_energy_info_t &interface_energy);
+// Streams the result to an open buffer. jsonIndent is the indentation of the JSON format,
+// a negative value writes compact JSON without a trailing newline.
+bool writeResult(OutputBuffer &out, ResultFormat format, const util::CLIArchitectureConfig &config,
+	const energy_t &core_energy, const interface_energy_info_t &interface_energy, int jsonIndent = 4);
+
+} // namespace DRAMPower::DRAMPowerCLI
+
+#endif /* LIB_DRAMPOWERCLI_RESULT_WRITER_H */
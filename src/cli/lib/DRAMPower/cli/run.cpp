@@ -9,13 +9,22 @@
 #include <spdlog/spdlog.h>
 #include <spdlog/fmt/ostr.h>
 
+#include <DRAMPower/Exceptions.h>
 #include <DRAMPower/Types.h>
 
 #include <DRAMPower/dram/dram_base.h>
+#include <DRAMPower/dram/static_dram.h>
 
 #include <DRAMPower/data/energy.h>
 
 #include <DRAMPower/util/cli_architecture_config.h>
+#include <DRAMPower/util/command_fan_out.h>
+#include <DRAMPower/util/FastForwardSimulation.h>
+#include <DRAMPower/util/power_down_policy.h>
+#include <DRAMPower/util/profiler.h>
+#include <DRAMPower/util/shm_command_ring.h>
+
+#include <DRAMPower/memspec/MemSpecCache.h>
 
 #include <DRAMPower/standards/ddr4/DDR4.h>
 #include <DRAMPower/memspec/MemSpecDDR4.h>
@@ -37,10 +46,13 @@
 #include <DRAMPower/memspec/MemSpecLPDDR6.h>
 #include <DRAMUtils/memspec/standards/MemSpecLPDDR6.h>
 
+#include <DRAMPower/standards/visit_standard.h>
+
 #include <DRAMUtils/util/json_utils.h>
 #include <DRAMUtils/memspec/MemSpec.h>
 
 #include "csv.hpp"
+#include "result_writer.hpp"
 #include "util.hpp"
 #include "config.h"
 
@@ -48,63 +60,83 @@ namespace DRAMPower::DRAMPowerCLI {
 
 using namespace DRAMPower;
 
-std::unique_ptr<dram_base<CmdType>> getMemory(const std::string_view &data, const DRAMPower::config::SimConfig& simconfig)
+std::optional<MemSpecCache::memspec_t> loadMemSpec(const std::filesystem::path &file, const std::optional<std::filesystem::path> &cacheDir)
 {
 	try
 	{
-		std::unique_ptr<dram_base<CmdType>> result = nullptr;
+		if (cacheDir)
+		{
+			// Get compiled memspec
+			MemSpecCache cache(*cacheDir);
+			return cache.load(file);
+		}
 		// Get memspec
-        auto memspec = DRAMUtils::parse_memspec_from_file(std::filesystem::path(data));
-        if (!memspec) {
-            return result;
+		auto memspec = DRAMUtils::parse_memspec_from_file(file);
+		if (!memspec) {
+			return std::nullopt;
 		}
-		// Get ddr
-		std::visit( [&result, &simconfig] (auto&& arg) {
+		std::optional<MemSpecCache::memspec_t> result;
+		std::visit( [&result] (auto&& arg) {
 			using T = std::decay_t<decltype(arg)>;
 			if constexpr (std::is_same_v<T, DRAMUtils::MemSpec::MemSpecDDR4>)
 			{
-				MemSpecDDR4 ddr (static_cast<DRAMUtils::MemSpec::MemSpecDDR4>(arg));
-				result = std::make_unique<DDR4>(ddr, simconfig);
+				result = MemSpecDDR4(static_cast<DRAMUtils::MemSpec::MemSpecDDR4>(arg));
 			}
 			else if constexpr (std::is_same_v<T, DRAMUtils::MemSpec::MemSpecDDR5>)
 			{
-				MemSpecDDR5 ddr (static_cast<DRAMUtils::MemSpec::MemSpecDDR5>(arg));
-				result = std::make_unique<DDR5>(ddr, simconfig);
+				result = MemSpecDDR5(static_cast<DRAMUtils::MemSpec::MemSpecDDR5>(arg));
 			}
 			else if constexpr (std::is_same_v<T, DRAMUtils::MemSpec::MemSpecLPDDR4>)
 			{
-				MemSpecLPDDR4 ddr (static_cast<DRAMUtils::MemSpec::MemSpecLPDDR4>(arg));
-				result = std::make_unique<LPDDR4>(ddr, simconfig);
+				result = MemSpecLPDDR4(static_cast<DRAMUtils::MemSpec::MemSpecLPDDR4>(arg));
 			}
 			else if constexpr (std::is_same_v<T, DRAMUtils::MemSpec::MemSpecLPDDR5>)
 			{
-				MemSpecLPDDR5 ddr (static_cast<DRAMUtils::MemSpec::MemSpecLPDDR5>(arg));
-				result = std::make_unique<LPDDR5>(ddr, simconfig);
+				result = MemSpecLPDDR5(static_cast<DRAMUtils::MemSpec::MemSpecLPDDR5>(arg));
 			}
 			else if constexpr (std::is_same_v<T, DRAMUtils::MemSpec::MemSpecLPDDR6>)
 			{
-				MemSpecLPDDR6 ddr (static_cast<DRAMUtils::MemSpec::MemSpecLPDDR6>(arg));
-				result = std::make_unique<LPDDR6>(ddr, simconfig);
+				result = MemSpecLPDDR6(static_cast<DRAMUtils::MemSpec::MemSpecLPDDR6>(arg));
 			}
 		}, memspec->getVariant());
-
 		return result;
 	}
 	catch(const std::exception& e)
+	{
+		return std::nullopt;
+	}
+}
+
+std::unique_ptr<dram_base<CmdType>> makeMemory(const MemSpecCache::memspec_t &memspec, const DRAMPower::config::SimConfig& simconfig)
+{
+	try
+	{
+		// Get ddr, with a fixed geometry core if one matches the memspec
+		return std::visit( [&simconfig] (auto&& arg) -> std::unique_ptr<dram_base<CmdType>> {
+			return makeDRAM(arg, simconfig);
+		}, memspec);
+	}
+	catch(const std::exception& e)
 	{
 		return nullptr;
 	}
 }
 
-bool parse_command_list(std::string_view csv_file, std::vector<std::pair<Command, std::unique_ptr<uint8_t[]>>> &commandList)
+std::unique_ptr<dram_base<CmdType>> getMemory(const std::string_view &data, const DRAMPower::config::SimConfig& simconfig, const std::optional<std::filesystem::path> &cacheDir)
 {
-	// Read csv file
-	csv::CSVFormat format;
-	format.no_header();
-	format.trim({ ' ', '\t' });
+	auto memspec = loadMemSpec(std::filesystem::path(data), cacheDir);
+	if (!memspec) {
+		return nullptr;
+	}
+	return makeMemory(*memspec, simconfig);
+}
 
-	csv::CSVReader reader{ csv_file, format };
-	
+namespace {
+
+// Calls emit(Command, std::unique_ptr<uint8_t[]>) for every row. The command data points into the array.
+template <typename Emit>
+bool parse_command_rows(csv::CSVReader &reader, Emit &&emit)
+{
 	// loop variables
 	std::size_t rowidx, size, rank_id, bank_group_id, bank_id, row_id, column_id = 0;
 
@@ -152,62 +184,56 @@ bool parse_command_list(std::string_view csv_file, std::vector<std::pair<Command
 			{
                 return false;
 			}
-			commandList.emplace_back(Command{ timestamp, cmd, { bank_id, bank_group_id, rank_id, row_id, column_id}, arr.get(), size * 8}, std::move(arr));
+			Command command{ timestamp, cmd, { bank_id, bank_group_id, rank_id, row_id, column_id}, arr.get(), size * 8};
+			emit(command, std::move(arr));
 		}
 		else {
-			commandList.emplace_back(Command{ timestamp, cmd, { bank_id, bank_group_id, rank_id, row_id, column_id} }, nullptr);
+			emit(Command{ timestamp, cmd, { bank_id, bank_group_id, rank_id, row_id, column_id} }, nullptr);
 		}
 	}
 
 	return true;
-};
+}
 
-bool jsonFileResult(const std::string &jsonfile, const std::unique_ptr<dram_base<CmdType>> &ddr, const energy_t &core_energy, const interface_energy_info_t &interface_energy)
+csv::CSVFormat commandListFormat()
 {
-	std::ofstream out;
-	out = std::ofstream(jsonfile);
-	if ( !out.is_open() ) {
-        return false;
-	}
-	json_t j;
-	size_t energy_offset = 0;
-	DRAMPower::util::CLIArchitectureConfig cli_config = ddr->getCLIArchitectureConfig();
-	auto bankcount = cli_config.bankCount;
-	auto rankcount = cli_config.rankCount;
-	auto devicecount = cli_config.deviceCount;
+	csv::CSVFormat format;
+	format.no_header();
+	format.trim({ ' ', '\t' });
+	return format;
+}
+
+auto appendTo(std::vector<std::pair<Command, std::unique_ptr<uint8_t[]>>> &commandList)
+{
+	return [&commandList](const Command &command, std::unique_ptr<uint8_t[]> data) {
+		commandList.emplace_back(command, std::move(data));
+	};
+}
 
-	j["RankCount"] = rankcount;
-	j["DeviceCount"] = devicecount;
-	j["BankCount"] = bankcount;
-	j["TotalEnergy"] = core_energy.total() + interface_energy.total();
+} // namespace
 
-	// Energy object to json
-	core_energy.to_json(j["CoreEnergy"]);
-	interface_energy.to_json(j["InterfaceEnergy"]);
+bool parse_command_list(std::string_view csv_file, std::vector<std::pair<Command, std::unique_ptr<uint8_t[]>>> &commandList)
+{
+	// Read csv file
+	csv::CSVReader reader{ csv_file, commandListFormat() };
+	return parse_command_rows(reader, appendTo(commandList));
+}
 
-	// Validate array length
-	if ( !j["CoreEnergy"][core_energy.get_Bank_energy_keyword()].is_array() || j["CoreEnergy"][core_energy.get_Bank_energy_keyword()].size() != rankcount * bankcount * devicecount )
-	{
-		assert(false); // (should not happen)
-        return false;
-	}
-	
-	// Add rank,device,bank description
-	for ( std::size_t r = 0; r < rankcount; r++ ) {
-		for ( std::size_t d = 0; d < devicecount; d++ ) {
-			energy_offset = r * bankcount * devicecount + d * bankcount;
-			for ( std::size_t b = 0; b < bankcount; b++ ) {
-				// Rank,Device,Bank -> bank_energy
-				j["CoreEnergy"][core_energy.get_Bank_energy_keyword()].at(energy_offset + b)["Rank"] = r;
-				j["CoreEnergy"][core_energy.get_Bank_energy_keyword()].at(energy_offset + b)["Device"] = d;
-				j["CoreEnergy"][core_energy.get_Bank_energy_keyword()].at(energy_offset + b)["Bank"] = b;
-			}
-		}
-	}
-	
-	out << j.dump(4) << std::endl;
-	out.close();
-	return true;
+bool parse_command_string(std::string_view csv, std::vector<std::pair<Command, std::unique_ptr<uint8_t[]>>> &commandList)
+{
+	csv::CSVReader reader = csv::parse(csv, commandListFormat());
+	return parse_command_rows(reader, appendTo(commandList));
+}
+
+bool jsonFileResult(const std::string &jsonfile, const std::unique_ptr<dram_base<CmdType>> &ddr, const energy_t &core_energy, const interface_energy_info_t &interface_energy)
+{
+	return fileResult(jsonfile, ResultFormat::JSON, ddr, core_energy, interface_energy);
+}
+
+bool fileResult(const std::string &file, ResultFormat format, const std::unique_ptr<dram_base<CmdType>> &ddr, const energy_t &core_energy, const interface_energy_info_t &interface_energy)
+{
+	// The result is streamed to the file without building a json DOM
+	return writeResult(file, format, ddr->getCLIArchitectureConfig(), core_energy, interface_energy);
 }
 
 bool stdoutResult(const std::unique_ptr<dram_base<CmdType>> &ddr, const energy_t &core_energy, const interface_energy_info_t &interface_energy)
@@ -249,7 +275,16 @@ bool getConfig(const std::string &configfile, config::CLIConfig &config)
             return false;
         }
         json_t json_obj = json_t::parse(file, nullptr, false, true);
-        config = json_obj;
+        return parseConfig(json_obj, config);
+    } catch (std::exception&) {
+        return false;
+    }
+}
+
+bool parseConfig(const json_t &json, config::CLIConfig &config)
+{
+    try {
+        config = json;
         if (!config.useToggleRate) {
             config.simconfig.toggleRateDefinition = std::nullopt;
         }
@@ -263,13 +298,18 @@ bool getConfig(const std::string &configfile, config::CLIConfig &config)
     return true;
 }
 
-bool makeResult(std::optional<std::string> jsonfile, const std::unique_ptr<dram_base<CmdType>> &ddr)
+bool makeResult(std::optional<std::string> outputfile, const std::unique_ptr<dram_base<CmdType>> &ddr, ResultFormat format)
 {
-    energy_t core_energy = ddr->calcCoreEnergy(ddr->getLastCommandTime());
-    interface_energy_info_t interface_energy = ddr->calcInterfaceEnergy(ddr->getLastCommandTime());
-    if(jsonfile)
+    return makeResult(outputfile, ddr, ddr->getWindowStats(ddr->getLastCommandTime()), format);
+}
+
+bool makeResult(std::optional<std::string> outputfile, const std::unique_ptr<dram_base<CmdType>> &ddr, const SimulationStats &stats, ResultFormat format)
+{
+    energy_t core_energy = ddr->calcCoreEnergyStats(stats);
+    interface_energy_info_t interface_energy = ddr->calcInterfaceEnergyStats(stats);
+    if(outputfile)
 	{
-		return jsonFileResult(*jsonfile, std::move(ddr), core_energy, interface_energy);
+		return fileResult(*outputfile, format, ddr, core_energy, interface_energy);
 	}
 	else
 	{
@@ -280,13 +320,286 @@ bool makeResult(std::optional<std::string> jsonfile, const std::unique_ptr<dram_
 bool runCommands(std::unique_ptr<dram_base<CmdType>> &ddr, const std::vector<std::pair<Command, std::unique_ptr<uint8_t[]>>> &commandList)
 {
     try {
+		// Resolve the standard once, the commands are simulated without virtual calls
+		visitStandard(*ddr, [&commandList](auto &dram) {
+			using standard_t = std::decay_t<decltype(dram)>;
+			for (auto &command : commandList ) {
+				StaticDispatch<standard_t>::doCommand(dram, command.first);
+			}
+		});
+	} catch (std::exception &e) {
+		return false;
+	}
+    return true;
+}
+
+bool runFastForwardCommands(std::unique_ptr<dram_base<CmdType>> &ddr, const std::vector<std::pair<Command, std::unique_ptr<uint8_t[]>>> &commandList, SimulationStats &stats, uint64_t &skippedPeriods)
+{
+	try {
+		FastForwardSimulation<dram_base<CmdType>> simulation(*ddr);
 		for (auto &command : commandList ) {
-			ddr->doCommand(command.first);
+			simulation.doCommand(command.first);
 		}
+		stats = simulation.getWindowStats(simulation.getLastCommandTime());
+		skippedPeriods = simulation.getSkippedPeriods();
 	} catch (std::exception &e) {
 		return false;
 	}
-    return true;
+	return true;
+}
+
+bool runFanOut(const std::string &tracefile, const std::string &fanOutFile, const std::optional<std::string> &defaultConfig, const std::optional<std::filesystem::path> &cacheDir, ResultFormat format, std::size_t &commandCount)
+{
+	struct Run {
+		std::string memspec;
+		std::optional<std::string> output;
+		std::unique_ptr<dram_base<CmdType>> ddr;
+	};
+
+	// Create the memories of all configurations
+	std::vector<Run> runs;
+	try {
+		std::ifstream file(fanOutFile);
+		if (!file.is_open()) {
+			spdlog::error("Cannot open fan-out file {}", fanOutFile);
+			return false;
+		}
+		json_t json = json_t::parse(file, nullptr, false, true);
+		if (json.is_discarded() || !json.is_array()) {
+			spdlog::error("The fan-out file must contain an array of configurations");
+			return false;
+		}
+		// Relative paths are relative to the fan-out file
+		const std::filesystem::path base = std::filesystem::path(fanOutFile).parent_path();
+		auto resolve = [&base](const std::string &path) {
+			std::filesystem::path result(path);
+			return (result.is_relative() ? base / result : result).string();
+		};
+		for (const json_t &entry : json) {
+			if (!entry.is_object() || !entry.contains("memspec") || !entry["memspec"].is_string()) {
+				spdlog::error("Configuration {} of the fan-out file has no memspec", runs.size());
+				return false;
+			}
+			config::CLIConfig config{};
+			bool valid = true;
+			if (entry.contains("config")) {
+				const json_t &configJson = entry["config"];
+				valid = configJson.is_string()
+					? getConfig(resolve(configJson.get<std::string>()), config)
+					: configJson.is_object() && parseConfig(configJson, config);
+			} else if (defaultConfig) {
+				valid = getConfig(*defaultConfig, config);
+			}
+			if (!valid) {
+				spdlog::error("Invalid config of configuration {}", runs.size());
+				return false;
+			}
+			Run run;
+			run.memspec = resolve(entry["memspec"].get<std::string>());
+			if (entry.contains("output") && entry["output"].is_string()) {
+				run.output = resolve(entry["output"].get<std::string>());
+			}
+			run.ddr = getMemory(run.memspec, config.simconfig, cacheDir);
+			if (!run.ddr) {
+				spdlog::error("Invalid memory specification {}", run.memspec);
+				return false;
+			}
+			runs.push_back(std::move(run));
+		}
+	} catch (std::exception &e) {
+		spdlog::error("{}", e.what());
+		return false;
+	}
+
+	// Parse the trace once and simulate it on all memories
+	std::vector<dram_base<CmdType> *> drams;
+	for (Run &run : runs) {
+		drams.push_back(run.ddr.get());
+	}
+	DRAMPower::util::FanOutResult result;
+	try {
+		result = DRAMPower::util::fanOut(drams, [&tracefile](auto &emit) {
+			csv::CSVReader reader{ tracefile, commandListFormat() };
+			auto forward = [&emit](const Command &command, std::unique_ptr<uint8_t[]>) {
+				emit(command);
+			};
+			if (!parse_command_rows(reader, forward)) {
+				throw Exception("Error while parsing command list");
+			}
+		});
+	} catch (std::exception &e) {
+		spdlog::error("{}", e.what());
+		return false;
+	}
+	commandCount = result.commandCount;
+
+	// Results per configuration
+	bool success = true;
+	for (std::size_t i = 0; i < runs.size(); ++i) {
+		if (result.errors[i]) {
+			try {
+				std::rethrow_exception(result.errors[i]);
+			} catch (std::exception &e) {
+				spdlog::error("Configuration {} ({}) failed: {}", i, runs[i].memspec, e.what());
+			}
+			success = false;
+			continue;
+		}
+		if (!runs[i].output) {
+			spdlog::info("Configuration {} ({}):", i, runs[i].memspec);
+		}
+		success = makeResult(runs[i].output, runs[i].ddr, format) && success;
+	}
+	return success;
+}
+
+bool runPowerDownSweep(const std::string &tracefile, const std::string &memspecfile, const config::CLIConfig &config, const std::string &sweepFile, const std::optional<std::filesystem::path> &cacheDir, const std::optional<std::string> &outputfile, std::size_t &commandCount)
+{
+	// Parse the policies and create one memory per policy
+	std::vector<DRAMPower::util::PowerDownPolicy> policies;
+	std::vector<std::unique_ptr<dram_base<CmdType>>> ddrs;
+	try {
+		std::ifstream file(sweepFile);
+		if (!file.is_open()) {
+			spdlog::error("Cannot open power down sweep file {}", sweepFile);
+			return false;
+		}
+		json_t json = json_t::parse(file, nullptr, false, true);
+		if (!json.is_discarded() && json.is_object() && json.contains("policies")) {
+			json = json["policies"];
+		}
+		if (json.is_discarded() || !json.is_array() || json.empty()) {
+			spdlog::error("The power down sweep file must contain an array of policies");
+			return false;
+		}
+		policies = json.get<std::vector<DRAMPower::util::PowerDownPolicy>>();
+		for (std::size_t i = 0; i < policies.size(); ++i) {
+			ddrs.push_back(getMemory(memspecfile, config.simconfig, cacheDir));
+			if (!ddrs.back()) {
+				spdlog::error("Invalid memory specification {}", memspecfile);
+				return false;
+			}
+		}
+	} catch (std::exception &e) {
+		spdlog::error("{}", e.what());
+		return false;
+	}
+
+	// Parse the trace once and simulate it for all policies
+	std::vector<dram_base<CmdType> *> drams;
+	for (auto &ddr : ddrs) {
+		drams.push_back(ddr.get());
+	}
+	DRAMPower::util::FanOutResult result;
+	try {
+		result = DRAMPower::util::sweepPowerDownPolicies(drams, policies, [&tracefile](auto &emit) {
+			csv::CSVReader reader{ tracefile, commandListFormat() };
+			auto forward = [&emit](const Command &command, std::unique_ptr<uint8_t[]>) {
+				emit(command);
+			};
+			if (!parse_command_rows(reader, forward)) {
+				throw Exception("Error while parsing command list");
+			}
+		});
+	} catch (std::exception &e) {
+		spdlog::error("{}", e.what());
+		return false;
+	}
+	commandCount = result.commandCount;
+
+	// Energy versus policy
+	bool success = true;
+	json_t energies = json_t::array();
+	for (std::size_t i = 0; i < policies.size(); ++i) {
+		if (result.errors[i]) {
+			try {
+				std::rethrow_exception(result.errors[i]);
+			} catch (std::exception &e) {
+				spdlog::error("Policy {} failed: {}", i, e.what());
+			}
+			success = false;
+			continue;
+		}
+		const timestamp_t timestamp = ddrs[i]->getLastCommandTime();
+		const double core = ddrs[i]->calcCoreEnergy(timestamp).total();
+		const double interface = ddrs[i]->calcInterfaceEnergy(timestamp).total();
+		energies.push_back({
+			{"policy", policies[i]},
+			{"coreEnergy", core},
+			{"interfaceEnergy", interface},
+			{"totalEnergy", core + interface},
+		});
+		if (!outputfile) {
+			spdlog::info("Policy {} ({}): core {} J, interface {} J, total {} J", i, json_t(policies[i]).dump(), core, interface, core + interface);
+		}
+	}
+	if (outputfile) {
+		std::ofstream out(*outputfile);
+		out << energies.dump(4) << '\n';
+		if (!out) {
+			spdlog::error("Cannot write {}", *outputfile);
+			return false;
+		}
+	}
+	return success;
+}
+
+bool runShmCommands(std::unique_ptr<dram_base<CmdType>> &ddr, const std::string &shmName, std::size_t capacity, std::size_t &commandCount)
+{
+	try {
+		DRAMPower::util::ShmCommandRing ring(shmName, DRAMPower::util::ShmCommandRing::Role::Consumer, capacity);
+		commandCount = DRAMPower::util::simulateCommandRing(ring, *ddr);
+	} catch (std::exception &e) {
+		spdlog::error("{}", e.what());
+		return false;
+	}
+	return true;
+}
+
+bool profileResult(const std::vector<std::pair<std::string, std::chrono::nanoseconds>> &phases, std::size_t commandCount)
+{
+	using namespace DRAMPower::util::profiling;
+	using ms_t = std::chrono::duration<double, std::milli>;
+
+	spdlog::info("Profile:");
+	for (const auto &[name, duration] : phases) {
+		spdlog::info("{} -> {:.3f} ms", name, std::chrono::duration_cast<ms_t>(duration).count());
+	}
+	if (!Profiler::enabled()) {
+		spdlog::warn("Hot path counters are not available. Rebuild with -DDRAMPOWER_ENABLE_PROFILING=ON");
+		return true;
+	}
+
+	// The sections are inclusive. Nested sections are also contained in dram_base::doCommand
+	Snapshot snapshot = Profiler::instance().snapshot();
+	const Counter &total = snapshot.sections[static_cast<std::size_t>(Section::DoCommand)];
+	auto share = [&total](uint64_t ticks) {
+		return 0 == total.ticks ? 0.0 : 100.0 * static_cast<double>(ticks) / static_cast<double>(total.ticks);
+	};
+	auto perCall = [](const Counter &counter) {
+		return 0 == counter.calls ? 0.0 : static_cast<double>(counter.ticks) / static_cast<double>(counter.calls);
+	};
+
+	spdlog::info("Section -> calls, {0}, {0}/call, share of doCommand:", Profiler::tickUnit());
+	for (std::size_t i = 0; i < snapshot.sections.size(); ++i) {
+		const Counter &counter = snapshot.sections[i];
+		spdlog::info("{} -> {}, {}, {:.1f}, {:.1f}%",
+			to_string(static_cast<Section>(i)), counter.calls, counter.ticks, perCall(counter), share(counter.ticks));
+	}
+
+	spdlog::info("Command type -> calls, {0}, {0}/call, share of doCommand:", Profiler::tickUnit());
+	for (std::size_t i = 0; i < static_cast<std::size_t>(CmdType::COUNT) && i < snapshot.commands.size(); ++i) {
+		const Counter &counter = snapshot.commands[i];
+		if (0 == counter.calls) {
+			continue;
+		}
+		spdlog::info("{} -> {}, {}, {:.1f}, {:.1f}%",
+			CmdTypeUtil::to_string(static_cast<CmdType>(i)), counter.calls, counter.ticks, perCall(counter), share(counter.ticks));
+	}
+	if (0 != commandCount) {
+		spdlog::info("{}/command -> {:.1f}", Profiler::tickUnit(), static_cast<double>(total.ticks) / static_cast<double>(commandCount));
+	}
+	return true;
 }
 
 } // namespace DRAMPower::DRAMPowerCLI
\ No newline at end of file
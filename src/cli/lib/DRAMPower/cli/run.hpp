@@ -1,28 +1,57 @@
 #ifndef LIB_DRAMPOWERCLI_RUN_H
 #define LIB_DRAMPOWERCLI_RUN_H
 
+#include <chrono>
+#include <filesystem>
 #include <optional>
 #include <vector>
 #include <memory>
 #include <string>
+#include <utility>
 
 #include <DRAMUtils/config/toggling_rate.h>
 #include <DRAMPower/command/Command.h>
 #include <DRAMPower/dram/dram_base.h>
 #include <DRAMPower/command/CmdType.h>
+#include <DRAMPower/memspec/MemSpecCache.h>
 #include <DRAMPower/simconfig/simconfig.h>
 
 #include "config.h"
+#include "result_writer.hpp"
 
 namespace DRAMPower::DRAMPowerCLI {
 
-std::unique_ptr<dram_base<CmdType>> getMemory(const std::string_view &data, const DRAMPower::config::SimConfig& simconfig);
+// The memspec is compiled and cached in cacheDir (next to the json file if empty) if a cacheDir is given
+std::unique_ptr<dram_base<CmdType>> getMemory(const std::string_view &data, const DRAMPower::config::SimConfig& simconfig, const std::optional<std::filesystem::path> &cacheDir = std::nullopt);
+// Derives the memspec of the json file (compiled and cached if a cacheDir is given)
+std::optional<MemSpecCache::memspec_t> loadMemSpec(const std::filesystem::path &file, const std::optional<std::filesystem::path> &cacheDir = std::nullopt);
+std::unique_ptr<dram_base<CmdType>> makeMemory(const MemSpecCache::memspec_t &memspec, const DRAMPower::config::SimConfig& simconfig);
 bool parse_command_list(std::string_view csv_file, std::vector<std::pair<Command, std::unique_ptr<uint8_t[]>>> &commandList);
-bool makeResult(std::optional<std::string> jsonfile, const std::unique_ptr<dram_base<CmdType>> &ddr);
+// Parses commands in the trace file format from memory
+bool parse_command_string(std::string_view csv, std::vector<std::pair<Command, std::unique_ptr<uint8_t[]>>> &commandList);
+bool makeResult(std::optional<std::string> outputfile, const std::unique_ptr<dram_base<CmdType>> &ddr, ResultFormat format = ResultFormat::JSON);
+// Result of the given window stats of ddr
+bool makeResult(std::optional<std::string> outputfile, const std::unique_ptr<dram_base<CmdType>> &ddr, const SimulationStats &stats, ResultFormat format = ResultFormat::JSON);
 bool jsonFileResult(const std::string &jsonfile, const std::unique_ptr<dram_base<CmdType>> &ddr, const energy_t &core_energy, const interface_energy_info_t &interface_energy);
+bool fileResult(const std::string &file, ResultFormat format, const std::unique_ptr<dram_base<CmdType>> &ddr, const energy_t &core_energy, const interface_energy_info_t &interface_energy);
 bool stdoutResult(const std::unique_ptr<dram_base<CmdType>> &ddr, const energy_t &core_energy, const interface_energy_info_t &interface_energy);
 bool getConfig(const std::string &configfile, config::CLIConfig &config);
+bool parseConfig(const json_t &json, config::CLIConfig &config);
 bool runCommands(std::unique_ptr<dram_base<CmdType>> &ddr, const std::vector<std::pair<Command, std::unique_ptr<uint8_t[]>>> &commandList);
+// Simulates the commands and fast forwards periodic refresh and power down stretches (see FastForwardSimulation).
+// The timestamps seen by ddr are shifted, stats are the window stats at the last command.
+bool runFastForwardCommands(std::unique_ptr<dram_base<CmdType>> &ddr, const std::vector<std::pair<Command, std::unique_ptr<uint8_t[]>>> &commandList, SimulationStats &stats, uint64_t &skippedPeriods);
+// Parses the trace once and simulates it in parallel for every configuration of the fan-out file.
+// The file holds an array of {"memspec": <file>, "config": <file> | {<config>}, "output": <file>}.
+// defaultConfig is used for configurations without config, results without output are printed.
+bool runFanOut(const std::string &tracefile, const std::string &fanOutFile, const std::optional<std::string> &defaultConfig, const std::optional<std::filesystem::path> &cacheDir, ResultFormat format, std::size_t &commandCount);
+// Parses the trace once and simulates it in parallel for every power down policy of the sweep file (see sweepPowerDownPolicies).
+// The file holds an array of policies or an object with "policies". The trace must not contain power down commands.
+// The energy per policy is written as json array to outputfile or printed.
+bool runPowerDownSweep(const std::string &tracefile, const std::string &memspecfile, const config::CLIConfig &config, const std::string &sweepFile, const std::optional<std::filesystem::path> &cacheDir, const std::optional<std::string> &outputfile, std::size_t &commandCount);
+// Simulates the commands streamed by another process through the shared memory ring shmName
+bool runShmCommands(std::unique_ptr<dram_base<CmdType>> &ddr, const std::string &shmName, std::size_t capacity, std::size_t &commandCount);
+bool profileResult(const std::vector<std::pair<std::string, std::chrono::nanoseconds>> &phases, std::size_t commandCount);
 
 
 } // namespace DRAMPower::DRAMPowerCLI
@@ -0,0 +1,328 @@
+#include "run_tier.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <exception>
+#include <limits>
+#include <type_traits>
+#include <variant>
+
+#include <spdlog/spdlog.h>
+
+#include <DRAMPower/dram/static_dram.h>
+#include <DRAMPower/standards/visit_standard.h>
+#include <DRAMPower/util/binary_ops.h>
+#include <DRAMPower/util/burst_storage.h>
+#include <DRAMPower/util/packed_burst.h>
+
+#include "run.hpp"
+
+namespace DRAMPower::DRAMPowerCLI {
+
+using namespace DRAMPower;
+using DRAMUtils::Config::ToggleRateDefinition;
+using DRAMUtils::Config::TogglingRateIdlePattern;
+
+std::optional<RunTier> runTierFromString(std::string_view tier)
+{
+	if (tier == "core") {
+		return RunTier::Core;
+	}
+	if (tier == "toggling") {
+		return RunTier::Toggling;
+	}
+	if (tier == "sampled") {
+		return RunTier::Sampled;
+	}
+	if (tier == "exact") {
+		return RunTier::Exact;
+	}
+	return std::nullopt;
+}
+
+std::string_view to_string(RunTier tier)
+{
+	switch (tier) {
+	case RunTier::Core:
+		return "core";
+	case RunTier::Toggling:
+		return "toggling";
+	case RunTier::Sampled:
+		return "sampled";
+	case RunTier::Exact:
+		return "exact";
+	}
+	return "invalid";
+}
+
+namespace {
+
+// Ones and transitions per data bit lane of the sampled bursts
+struct DataActivity {
+	uint64_t bits = 0;
+	uint64_t ones = 0;
+	uint64_t toggles = 0;
+
+	// The bus idles between the commands, the first and the last beat toggle against the idle pattern
+	void add(const Command &command, std::size_t width, TogglingRateIdlePattern idlePattern)
+	{
+		const std::size_t beats = command.sz_bits / width;
+		if (nullptr == command.data || 0 == beats) {
+			return;
+		}
+		const bool idleDriven = TogglingRateIdlePattern::Z != idlePattern;
+		util::packed_burst idle(width);
+		if (TogglingRateIdlePattern::H == idlePattern) {
+			idle.set();
+		}
+		util::packed_burst previous(idle.view());
+		util::packed_burst current(width);
+		const std::size_t n_bytes = (command.sz_bits + 7) / 8;
+		for (std::size_t beat = 0; beat < beats; ++beat) {
+			// Beat n holds the bits [n * width, (n + 1) * width) of the data
+			for (std::size_t word = 0; word < current.num_words(); ++word) {
+				const std::size_t n_bits = std::min<std::size_t>(64, width - word * 64);
+				current.data()[word] = util::BurstStorageInsertHelper::extract_bits(command.data, n_bytes, beat * width + word * 64, n_bits);
+			}
+			ones += current.count();
+			if (0 != beat || idleDriven) {
+				toggles += changes(previous, current);
+			}
+			previous = current.view();
+		}
+		if (idleDriven) {
+			toggles += changes(previous, idle);
+		}
+		bits += beats * width;
+	}
+
+	double togglingRate() const
+	{
+		return 0 == bits ? 0.0 : std::min(1.0, static_cast<double>(toggles) / static_cast<double>(bits));
+	}
+
+	double dutyCycle() const
+	{
+		return 0 == bits ? 0.0 : static_cast<double>(ones) / static_cast<double>(bits);
+	}
+
+	static uint64_t changes(const util::packed_burst &lhs, const util::packed_burst &rhs)
+	{
+		uint64_t n = 0;
+		for (std::size_t word = 0; word < lhs.num_words(); ++word) {
+			n += util::BinaryOps::popcount(lhs.word(word) ^ rhs.word(word));
+		}
+		return n;
+	}
+};
+
+std::size_t dataBusWidth(const MemSpecCache::memspec_t &memspec)
+{
+	return std::visit([](const auto &spec) -> std::size_t {
+		return spec.bitWidth * spec.numberOfDevices;
+	}, memspec);
+}
+
+// Idle pattern of the data bus of the standard in the bus mode
+TogglingRateIdlePattern busIdlePattern(const MemSpecCache::memspec_t &memspec)
+{
+	return std::visit([](const auto &spec) {
+		using T = std::decay_t<decltype(spec)>;
+		if constexpr (std::is_same_v<T, MemSpecDDR4> || std::is_same_v<T, MemSpecDDR5>) {
+			return TogglingRateIdlePattern::H;
+		} else {
+			return TogglingRateIdlePattern::L;
+		}
+	}, memspec);
+}
+
+// The toggling rates are measured on the first half of the calibration prefix and the tiers are
+// scored on the second half, a score on the measured commands would be optimistic
+struct Calibration {
+	std::size_t split = 0;
+	std::size_t count = 0;
+	TierOptions measureOptions;
+
+	Calibration(const std::vector<std::pair<Command, std::unique_ptr<uint8_t[]>>> &commandList, const TierOptions &options)
+		: split(std::min(options.calibrationCommands, commandList.size()) / 2)
+		, count(std::min(options.calibrationCommands, commandList.size()))
+		, measureOptions(options)
+	{
+		measureOptions.calibrationCommands = split;
+	}
+};
+
+// Interface energy of the scored commands simulated in the tier
+std::optional<double> calibrationEnergy(RunTier tier, const MemSpecCache::memspec_t &memspec, const config::CLIConfig &config, const std::vector<std::pair<Command, std::unique_ptr<uint8_t[]>>> &commandList, const Calibration &calibration)
+{
+	// The core tier doesn't calculate any interface energy
+	if (RunTier::Core == tier) {
+		return 0.0;
+	}
+	std::unique_ptr<dram_base<CmdType>> ddr = makeMemory(memspec, tierSimConfig(tier, memspec, config, commandList, calibration.measureOptions));
+	if (!ddr) {
+		return std::nullopt;
+	}
+	double energy = 0.0;
+	visitStandard(*ddr, [&commandList, &calibration, &energy](auto &dram) {
+		using standard_t = std::decay_t<decltype(dram)>;
+		for (std::size_t i = 0; i < calibration.count; ++i) {
+			if (i == calibration.split && 0 != calibration.split) {
+				energy = -dram.calcInterfaceEnergy(commandList[i].first.timestamp).total();
+			}
+			StaticDispatch<standard_t>::doCommand(dram, commandList[i].first);
+		}
+	});
+	return energy + ddr->calcInterfaceEnergy(commandList[calibration.count - 1].first.timestamp).total();
+}
+
+double relativeError(double energy, double reference)
+{
+	if (0.0 != reference) {
+		return std::abs(energy - reference) / std::abs(reference);
+	}
+	return 0.0 == energy ? 0.0 : std::numeric_limits<double>::infinity();
+}
+
+} // namespace
+
+ToggleRateDefinition measureToggleRates(const MemSpecCache::memspec_t &memspec, const config::CLIConfig &config, const std::vector<std::pair<Command, std::unique_ptr<uint8_t[]>>> &commandList, std::size_t count, std::size_t interval)
+{
+	ToggleRateDefinition definition{};
+	if (config.simconfig.toggleRateDefinition) {
+		definition = *config.simconfig.toggleRateDefinition;
+	} else {
+		definition.idlePatternRead = busIdlePattern(memspec);
+		definition.idlePatternWrite = definition.idlePatternRead;
+	}
+
+	const std::size_t width = dataBusWidth(memspec);
+	DataActivity read;
+	DataActivity write;
+	std::size_t dataCommands = 0;
+	count = std::min(count, commandList.size());
+	for (std::size_t i = 0; i < count; ++i) {
+		const Command &command = commandList[i].first;
+		if (!CmdTypeUtil::needs_data(command.type)) {
+			continue;
+		}
+		if (0 == dataCommands++ % std::max<std::size_t>(1, interval)) {
+			if (CmdType::RD == command.type || CmdType::RDA == command.type) {
+				read.add(command, width, definition.idlePatternRead);
+			} else {
+				write.add(command, width, definition.idlePatternWrite);
+			}
+		}
+	}
+
+	definition.togglingRateRead = read.togglingRate();
+	definition.togglingRateWrite = write.togglingRate();
+	definition.dutyCycleRead = read.dutyCycle();
+	definition.dutyCycleWrite = write.dutyCycle();
+	return definition;
+}
+
+DRAMPower::config::SimConfig tierSimConfig(RunTier tier, const MemSpecCache::memspec_t &memspec, const config::CLIConfig &config, const std::vector<std::pair<Command, std::unique_ptr<uint8_t[]>>> &commandList, const TierOptions &options)
+{
+	DRAMPower::config::SimConfig simconfig = config.simconfig;
+	switch (tier) {
+	case RunTier::Core:
+		// The interface isn't simulated
+		break;
+	case RunTier::Toggling:
+		if (!simconfig.toggleRateDefinition) {
+			simconfig.toggleRateDefinition = measureToggleRates(memspec, config, commandList, options.calibrationCommands, 1);
+		}
+		break;
+	case RunTier::Sampled:
+		simconfig.toggleRateDefinition = measureToggleRates(memspec, config, commandList, commandList.size(), options.sampleInterval);
+		break;
+	case RunTier::Exact:
+		simconfig.toggleRateDefinition = std::nullopt;
+		break;
+	}
+	return simconfig;
+}
+
+std::optional<double> calibrationError(RunTier tier, const MemSpecCache::memspec_t &memspec, const config::CLIConfig &config, const std::vector<std::pair<Command, std::unique_ptr<uint8_t[]>>> &commandList, const TierOptions &options)
+{
+	const Calibration calibration(commandList, options);
+	if (0 == calibration.count) {
+		return 0.0;
+	}
+	try {
+		const std::optional<double> reference = calibrationEnergy(RunTier::Exact, memspec, config, commandList, calibration);
+		const std::optional<double> energy = calibrationEnergy(tier, memspec, config, commandList, calibration);
+		if (!reference || !energy) {
+			return std::nullopt;
+		}
+		return relativeError(*energy, *reference);
+	} catch (std::exception &e) {
+		spdlog::error("{}", e.what());
+		return std::nullopt;
+	}
+}
+
+std::optional<RunTier> selectRunTier(const MemSpecCache::memspec_t &memspec, const config::CLIConfig &config, const std::vector<std::pair<Command, std::unique_ptr<uint8_t[]>>> &commandList, double budget, const TierOptions &options, RunTier minTier)
+{
+	const Calibration calibration(commandList, options);
+	if (0 == calibration.count) {
+		return RunTier::Exact;
+	}
+	try {
+		const std::optional<double> reference = calibrationEnergy(RunTier::Exact, memspec, config, commandList, calibration);
+		if (!reference) {
+			return std::nullopt;
+		}
+		spdlog::info("Calibration on {} commands, exact interface energy of the last {} -> {}", calibration.count, calibration.count - calibration.split, *reference);
+		for (RunTier tier : {RunTier::Core, RunTier::Toggling, RunTier::Sampled}) {
+			if (tier < minTier) {
+				continue;
+			}
+			const std::optional<double> energy = calibrationEnergy(tier, memspec, config, commandList, calibration);
+			if (!energy) {
+				return std::nullopt;
+			}
+			const double error = relativeError(*energy, *reference);
+			spdlog::info("Tier {} -> interface energy error {:.3f}%", to_string(tier), 100.0 * error);
+			if (error <= budget) {
+				return tier;
+			}
+		}
+	} catch (std::exception &e) {
+		spdlog::error("{}", e.what());
+		return std::nullopt;
+	}
+	return RunTier::Exact;
+}
+
+bool runTierCommands(std::unique_ptr<dram_base<CmdType>> &ddr, const std::vector<std::pair<Command, std::unique_ptr<uint8_t[]>>> &commandList, RunTier tier)
+{
+	if (RunTier::Core != tier) {
+		return runCommands(ddr, commandList);
+	}
+	try {
+		visitStandard(*ddr, [&commandList](auto &dram) {
+			using standard_t = std::decay_t<decltype(dram)>;
+			for (auto &command : commandList) {
+				StaticDispatch<standard_t>::doCoreCommand(dram, command.first);
+			}
+		});
+	} catch (std::exception &e) {
+		spdlog::error("{}", e.what());
+		return false;
+	}
+	return true;
+}
+
+bool makeCoreResult(std::optional<std::string> outputfile, const std::unique_ptr<dram_base<CmdType>> &ddr, ResultFormat format)
+{
+	energy_t core_energy = ddr->calcCoreEnergy(ddr->getLastCommandTime());
+	interface_energy_info_t interface_energy{};
+	if (outputfile) {
+		return fileResult(*outputfile, format, ddr, core_energy, interface_energy);
+	}
+	return stdoutResult(ddr, core_energy, interface_energy);
+}
+
+} // namespace DRAMPower::DRAMPowerCLI
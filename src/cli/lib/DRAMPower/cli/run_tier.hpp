@@ -0,0 +1,59 @@
+#ifndef LIB_DRAMPOWERCLI_RUN_TIER_H
+#define LIB_DRAMPOWERCLI_RUN_TIER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <DRAMUtils/config/toggling_rate.h>
+#include <DRAMPower/command/Command.h>
+#include <DRAMPower/command/CmdType.h>
+#include <DRAMPower/dram/dram_base.h>
+#include <DRAMPower/memspec/MemSpecCache.h>
+#include <DRAMPower/simconfig/simconfig.h>
+
+#include "config.h"
+#include "result_writer.hpp"
+
+namespace DRAMPower::DRAMPowerCLI {
+
+// Accuracy tiers of a simulation, ordered from the cheapest to the exact one
+enum class RunTier {
+	Core,     // Only the core is simulated, the interface energy is zero
+	Toggling, // Toggling rate interface with the rates of the config or of the calibration prefix
+	Sampled,  // Toggling rate interface with the rates sampled from the data of the whole trace
+	Exact,    // Bus interface, every data burst is simulated
+};
+
+std::optional<RunTier> runTierFromString(std::string_view tier);
+std::string_view to_string(RunTier tier);
+
+struct TierOptions {
+	std::size_t calibrationCommands = 10000; // Length of the calibration prefix of the trace
+	std::size_t sampleInterval = 16;         // Every sampleInterval-th read and write is sampled
+};
+
+// Toggling rates and duty cycles of the data of every interval-th read and write of the first count commands.
+// The idle patterns of the config are kept, without config the bus idle patterns of the standard are used.
+DRAMUtils::Config::ToggleRateDefinition measureToggleRates(const MemSpecCache::memspec_t &memspec, const config::CLIConfig &config, const std::vector<std::pair<Command, std::unique_ptr<uint8_t[]>>> &commandList, std::size_t count, std::size_t interval);
+// Simulation config of the tier
+DRAMPower::config::SimConfig tierSimConfig(RunTier tier, const MemSpecCache::memspec_t &memspec, const config::CLIConfig &config, const std::vector<std::pair<Command, std::unique_ptr<uint8_t[]>>> &commandList, const TierOptions &options);
+// Relative interface energy error of the tier against the exact tier, scored like in selectRunTier
+std::optional<double> calibrationError(RunTier tier, const MemSpecCache::memspec_t &memspec, const config::CLIConfig &config, const std::vector<std::pair<Command, std::unique_ptr<uint8_t[]>>> &commandList, const TierOptions &options);
+// Cheapest tier from minTier on whose interface energy is within the relative error budget of the
+// exact tier. The toggling rates are measured on the first half of the calibration prefix and the
+// tiers are scored on the second half. Falls back to the exact tier.
+std::optional<RunTier> selectRunTier(const MemSpecCache::memspec_t &memspec, const config::CLIConfig &config, const std::vector<std::pair<Command, std::unique_ptr<uint8_t[]>>> &commandList, double budget, const TierOptions &options, RunTier minTier = RunTier::Core);
+// Simulates the commands, the core tier skips the interface
+bool runTierCommands(std::unique_ptr<dram_base<CmdType>> &ddr, const std::vector<std::pair<Command, std::unique_ptr<uint8_t[]>>> &commandList, RunTier tier);
+// Result of a core tier simulation, the interface energy is reported as zero
+bool makeCoreResult(std::optional<std::string> outputfile, const std::unique_ptr<dram_base<CmdType>> &ddr, ResultFormat format = ResultFormat::JSON);
+
+} // namespace DRAMPower::DRAMPowerCLI
+
+#endif /* LIB_DRAMPOWERCLI_RUN_TIER_H */
@@ -0,0 +1,381 @@
+#include "server.hpp"
+
+#include <chrono>
+#include <cstring>
+#include <exception>
+#include <utility>
+
+#include <spdlog/spdlog.h>
+
+#include <DRAMPower/command/Command.h>
+#include <DRAMPower/dram/dram_base.h>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <poll.h>
+#include <unistd.h>
+#include <cerrno>
+
+#include "config.h"
+#include "result_writer.hpp"
+#include "run.hpp"
+
+namespace DRAMPower::DRAMPowerCLI {
+
+namespace {
+
+// Interval in which idle connections check if the server stops
+constexpr int POLL_TIMEOUT_MS = 200;
+
+#ifdef MSG_NOSIGNAL
+constexpr int SEND_FLAGS = MSG_NOSIGNAL;
+#else
+constexpr int SEND_FLAGS = 0;
+#endif
+
+bool sendAll(int fd, std::string_view data)
+{
+	while (!data.empty()) {
+		ssize_t sent = ::send(fd, data.data(), data.size(), SEND_FLAGS);
+		if (sent < 0 && EINTR == errno) {
+			continue;
+		}
+		if (sent <= 0) {
+			return false;
+		}
+		data.remove_prefix(static_cast<std::size_t>(sent));
+	}
+	return true;
+}
+
+bool makeAddress(const std::string &socketPath, sockaddr_un &address)
+{
+	std::memset(&address, 0, sizeof(address));
+	address.sun_family = AF_UNIX;
+	if (socketPath.empty() || socketPath.size() >= sizeof(address.sun_path)) {
+		return false;
+	}
+	std::memcpy(address.sun_path, socketPath.c_str(), socketPath.size() + 1);
+	return true;
+}
+
+std::string errorResponse(const std::string &message)
+{
+	return json_t{{"status", "error"}, {"message", message}}.dump();
+}
+
+} // namespace
+
+Server::Server(Options options)
+	: m_options(std::move(options))
+{
+	if (0 == m_options.workers) {
+		m_options.workers = std::max(1u, std::thread::hardware_concurrency());
+	}
+}
+
+Server::~Server()
+{
+	stop();
+	for (auto &worker : m_workers) {
+		if (worker.joinable()) {
+			worker.join();
+		}
+	}
+}
+
+std::shared_ptr<const MemSpecCache::memspec_t> Server::getMemSpec(const std::filesystem::path &file)
+{
+	std::error_code ec;
+	auto lastWrite = std::filesystem::last_write_time(file, ec);
+	if (ec) {
+		return nullptr;
+	}
+	const std::string key = std::filesystem::absolute(file, ec).string();
+
+	std::lock_guard<std::mutex> lock(m_memspecMutex);
+	auto it = m_memspecs.find(key);
+	if (it != m_memspecs.end() && it->second.lastWrite == lastWrite) {
+		return it->second.memspec;
+	}
+	auto memspec = loadMemSpec(file, m_options.memspecCacheDir);
+	if (!memspec) {
+		return nullptr;
+	}
+	auto result = std::make_shared<const MemSpecCache::memspec_t>(std::move(*memspec));
+	m_memspecs[key] = CachedMemSpec{lastWrite, result};
+	return result;
+}
+
+std::string Server::handle(std::string_view line)
+{
+	json_t request = json_t::parse(line.begin(), line.end(), nullptr, false);
+	if (request.is_discarded() || !request.is_object()) {
+		return errorResponse("Invalid json request");
+	}
+
+	// Control requests
+	if (request.contains("request")) {
+		const std::string type = request["request"].is_string() ? request["request"].get<std::string>() : std::string{};
+		if ("ping" == type) {
+			return json_t{{"status", "ok"}}.dump();
+		}
+		if ("shutdown" == type) {
+			stop();
+			return json_t{{"status", "ok"}}.dump();
+		}
+		return errorResponse("Unknown request " + type);
+	}
+
+	try {
+		const auto start = std::chrono::steady_clock::now();
+
+		// Config
+		config::CLIConfig config{};
+		if (request.contains("config")) {
+			const json_t &configJson = request["config"];
+			bool valid = configJson.is_string()
+				? getConfig(configJson.get<std::string>(), config)
+				: configJson.is_object() && parseConfig(configJson, config);
+			if (!valid) {
+				return errorResponse("Invalid config");
+			}
+		}
+
+		// Commands
+		std::vector<std::pair<Command, std::unique_ptr<uint8_t[]>>> commandList;
+		if (request.contains("trace") && request["trace"].is_string()) {
+			if (!parse_command_list(request["trace"].get<std::string>(), commandList)) {
+				return errorResponse("Invalid trace file");
+			}
+		} else if (request.contains("commands") && request["commands"].is_array()) {
+			std::string csv;
+			for (const json_t &row : request["commands"]) {
+				if (!row.is_string()) {
+					return errorResponse("Commands must be csv rows");
+				}
+				csv += row.get<std::string>();
+				csv += '\n';
+			}
+			if (!parse_command_string(csv, commandList)) {
+				return errorResponse("Invalid commands");
+			}
+		} else {
+			return errorResponse("Missing trace or commands");
+		}
+
+		// Memory
+		if (!request.contains("memspec") || !request["memspec"].is_string()) {
+			return errorResponse("Missing memspec");
+		}
+		auto memspec = getMemSpec(request["memspec"].get<std::string>());
+		if (!memspec) {
+			return errorResponse("Invalid memory specification");
+		}
+		std::unique_ptr<dram_base<CmdType>> ddr = makeMemory(*memspec, config.simconfig);
+		if (!ddr) {
+			return errorResponse("Invalid memory specification");
+		}
+
+		// Simulation
+		if (!runCommands(ddr, commandList)) {
+			return errorResponse("Error while running commands");
+		}
+		energy_t core_energy = ddr->calcCoreEnergy(ddr->getLastCommandTime());
+		interface_energy_info_t interface_energy = ddr->calcInterfaceEnergy(ddr->getLastCommandTime());
+		std::string result;
+		{
+			OutputBuffer out(result);
+			if (!writeResult(out, ResultFormat::JSON, ddr->getCLIArchitectureConfig(), core_energy, interface_energy, -1)) {
+				return errorResponse("Error while creating result");
+			}
+		}
+
+		const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+		return "{\"status\":\"ok\",\"commands\":" + std::to_string(commandList.size())
+			+ ",\"elapsed_us\":" + std::to_string(elapsed.count())
+			+ ",\"result\":" + result + "}";
+	} catch (const std::exception &e) {
+		return errorResponse(e.what());
+	}
+}
+
+void Server::serve(int fd)
+{
+	std::string buffer;
+	char chunk[64 * 1024];
+	while (m_running) {
+		// Answer all complete requests
+		std::size_t newline;
+		while (std::string::npos != (newline = buffer.find('\n'))) {
+			std::string response = handle(std::string_view(buffer.data(), newline));
+			buffer.erase(0, newline + 1);
+			response += '\n';
+			if (!sendAll(fd, response) || !m_running) {
+				return;
+			}
+		}
+
+		pollfd pfd{fd, POLLIN, 0};
+		int ready = ::poll(&pfd, 1, POLL_TIMEOUT_MS);
+		if (0 == ready || (ready < 0 && EINTR == errno)) {
+			continue;
+		}
+		if (ready < 0) {
+			return;
+		}
+		ssize_t received = ::recv(fd, chunk, sizeof(chunk), 0);
+		if (received < 0 && EINTR == errno) {
+			continue;
+		}
+		if (received <= 0) {
+			return;
+		}
+		buffer.append(chunk, static_cast<std::size_t>(received));
+	}
+}
+
+void Server::worker()
+{
+	while (true) {
+		int fd = -1;
+		{
+			std::unique_lock<std::mutex> lock(m_queueMutex);
+			m_queueCondition.wait(lock, [this] { return !m_connections.empty() || !m_running; });
+			if (!m_running) {
+				// Drop pending connections
+				while (!m_connections.empty()) {
+					::close(m_connections.front());
+					m_connections.pop();
+				}
+				return;
+			}
+			fd = m_connections.front();
+			m_connections.pop();
+		}
+		serve(fd);
+		::close(fd);
+	}
+}
+
+bool Server::run()
+{
+	if (!m_running) {
+		// Stopped before it was started, the socket of another server isn't touched
+		return true;
+	}
+	sockaddr_un address;
+	if (!makeAddress(m_options.socketPath, address)) {
+		spdlog::error("Invalid socket path {}", m_options.socketPath);
+		return false;
+	}
+	int listenFd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+	if (listenFd < 0) {
+		spdlog::error("Cannot create socket: {}", std::strerror(errno));
+		return false;
+	}
+	// Remove the socket of a previous server
+	::unlink(m_options.socketPath.c_str());
+	if (0 != ::bind(listenFd, reinterpret_cast<sockaddr *>(&address), sizeof(address))
+		|| 0 != ::listen(listenFd, SOMAXCONN)
+	) {
+		spdlog::error("Cannot listen on {}: {}", m_options.socketPath, std::strerror(errno));
+		::close(listenFd);
+		return false;
+	}
+
+	{
+		// stop() shuts the listening socket down from other threads
+		std::lock_guard<std::mutex> lock(m_queueMutex);
+		if (!m_running) {
+			::close(listenFd);
+			::unlink(m_options.socketPath.c_str());
+			return true;
+		}
+		m_listenFd = listenFd;
+	}
+	for (std::size_t i = 0; i < m_options.workers; ++i) {
+		m_workers.emplace_back(&Server::worker, this);
+	}
+	spdlog::info("Listening on {} with {} workers", m_options.socketPath, m_options.workers);
+
+	while (m_running) {
+		int fd = ::accept(listenFd, nullptr, nullptr);
+		if (fd < 0) {
+			if (EINTR == errno || ECONNABORTED == errno) {
+				continue;
+			}
+			break;
+		}
+		{
+			std::lock_guard<std::mutex> lock(m_queueMutex);
+			m_connections.push(fd);
+		}
+		m_queueCondition.notify_one();
+	}
+
+	stop();
+	for (auto &worker : m_workers) {
+		worker.join();
+	}
+	m_workers.clear();
+	{
+		std::lock_guard<std::mutex> lock(m_queueMutex);
+		::close(m_listenFd);
+		m_listenFd = -1;
+	}
+	::unlink(m_options.socketPath.c_str());
+	return true;
+}
+
+void Server::stop()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_queueMutex);
+		m_running = false;
+		// Wakes up the blocking accept. run() closes the socket under the same lock
+		if (m_listenFd >= 0) {
+			::shutdown(m_listenFd, SHUT_RDWR);
+		}
+	}
+	m_queueCondition.notify_all();
+}
+
+std::optional<std::string> sendRequest(const std::string &socketPath, const std::string &request)
+{
+	sockaddr_un address;
+	if (!makeAddress(socketPath, address)) {
+		return std::nullopt;
+	}
+	int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+	if (fd < 0) {
+		return std::nullopt;
+	}
+	std::optional<std::string> response;
+	if (0 == ::connect(fd, reinterpret_cast<sockaddr *>(&address), sizeof(address))
+		&& sendAll(fd, request + "\n")
+	) {
+		std::string buffer;
+		char chunk[64 * 1024];
+		while (true) {
+			ssize_t received = ::recv(fd, chunk, sizeof(chunk), 0);
+			if (received < 0 && EINTR == errno) {
+				continue;
+			}
+			if (received <= 0) {
+				break;
+			}
+			buffer.append(chunk, static_cast<std::size_t>(received));
+			std::size_t newline = buffer.find('\n');
+			if (std::string::npos != newline) {
+				buffer.resize(newline);
+				response = std::move(buffer);
+				break;
+			}
+		}
+	}
+	::close(fd);
+	return response;
+}
+
+} // namespace DRAMPower::DRAMPowerCLI
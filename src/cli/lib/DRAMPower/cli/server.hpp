@@ -0,0 +1,96 @@
+#ifndef LIB_DRAMPOWERCLI_SERVER_H
+#define LIB_DRAMPOWERCLI_SERVER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <queue>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include <DRAMPower/memspec/MemSpecCache.h>
+#include <DRAMPower/simconfig/simconfig.h>
+
+namespace DRAMPower::DRAMPowerCLI {
+
+// Persistent simulation server on a Unix domain socket.
+// A client sends one job per line as a JSON object and receives one JSON object per line:
+//
+//   {"memspec": "<file>", "config": "<file>" | {<config>}, "trace": "<file>" | "commands": ["<csv row>", ...]}
+//   -> {"status": "ok", "commands": <n>, "elapsed_us": <t>, "result": {<json result>}}
+//   -> {"status": "error", "message": "<text>"}
+//
+// {"request": "ping"} is answered with {"status": "ok"} and {"request": "shutdown"} stops the server.
+// The derived memspecs are kept in memory and reloaded if the json file changes, so a job only
+// pays for the construction of the DRAM and the simulation. The connections are served by a
+// pool of worker threads, every connection can send any number of jobs.
+class Server {
+// Public type definitions
+public:
+	struct Options {
+		std::string socketPath;
+		std::size_t workers = 0; // 0: number of hardware threads
+		std::optional<std::filesystem::path> memspecCacheDir = std::nullopt;
+	};
+
+// Public constructors
+public:
+	explicit Server(Options options);
+	~Server();
+
+	Server(const Server&) = delete;
+	Server& operator=(const Server&) = delete;
+
+// Public member functions
+public:
+	// Serves until stop() or a shutdown request. Returns false if the socket cannot be created.
+	// A server runs once, run() returns immediately if stop() was called before.
+	bool run();
+	void stop();
+
+	// Processes a single request line and returns the response line without the newline.
+	// Thread safe.
+	std::string handle(std::string_view request);
+
+// Private type definitions
+private:
+	struct CachedMemSpec {
+		std::filesystem::file_time_type lastWrite;
+		std::shared_ptr<const MemSpecCache::memspec_t> memspec;
+	};
+
+// Private member functions
+private:
+	std::shared_ptr<const MemSpecCache::memspec_t> getMemSpec(const std::filesystem::path &file);
+	void worker();
+	void serve(int fd);
+
+// Private member variables
+private:
+	Options m_options;
+	int m_listenFd = -1; // Guarded by m_queueMutex
+	// Set from construction so a stop() before run() isn't lost
+	std::atomic<bool> m_running{true};
+
+	std::mutex m_queueMutex;
+	std::condition_variable m_queueCondition;
+	std::queue<int> m_connections;
+	std::vector<std::thread> m_workers;
+
+	std::mutex m_memspecMutex;
+	std::map<std::string, CachedMemSpec> m_memspecs;
+};
+
+// Sends one request line to the server and returns the response line
+std::optional<std::string> sendRequest(const std::string &socketPath, const std::string &request);
+
+} // namespace DRAMPower::DRAMPowerCLI
+
+#endif /* LIB_DRAMPOWERCLI_SERVER_H */
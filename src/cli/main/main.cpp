@@ -1,11 +1,18 @@
 
 #include <stdint.h>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
 #include <utility>
 #include <optional>
 #include <string_view>
 
 #include <DRAMPower/cli/run.hpp>
+#include <DRAMPower/cli/run_tier.hpp>
 #include <DRAMPower/cli/config.h>
+#include <DRAMPower/cli/server.hpp>
+#include <DRAMPower/util/shm_command_ring.h>
 
 #include <CLI/CLI.hpp>
 
@@ -18,31 +25,87 @@
 namespace cli11 = ::CLI; 
 using namespace DRAMPower;
 
-int parseArgs(int argc, char *argv[], std::string &configfile, std::string &tracefile, std::string &memspec, std::optional<std::string> &jsonfile)
+int parseArgs(int argc, char *argv[], std::string &configfile, std::string &tracefile, std::string &shm, std::size_t &shmSize, std::string &memspec, std::optional<std::string> &jsonfile, std::string &format, bool &memspecCache, std::string &memspecCacheDir, bool &profile, bool &fastForward, std::string &fanOut, std::string &powerDownSweep, std::string &serve, std::size_t &workers, std::string &server, std::string &tier, std::optional<double> &autoBudget, DRAMPower::DRAMPowerCLI::TierOptions &tierOptions)
 {
 	// Application description
 	cli11::App app{"DRAMPower v" DRAMPOWER_VERSION_STRING};
 	argv = app.ensure_utf8(argv);
 	
 	// Configfile
-	app.add_option("-c,--config", configfile, "config")
-		->required(true)
+	auto configOption = app.add_option("-c,--config", configfile, "config")
 		->check(cli11::ExistingFile);
 	// Tracefile
-	app.add_option("-t,--trace", tracefile, "csv trace file")
-		->required(true)
+	auto trace = app.add_option("-t,--trace", tracefile, "csv trace file")
 		->check(cli11::ExistingFile);
+	// Shared memory command stream
+	auto shmOption = app.add_option("--shm", shm, "shared memory ring the commands are streamed through by another process");
+	trace->excludes(shmOption);
+	app.add_option("--shm-size", shmSize, "capacity of the shared memory ring in bytes")
+		->required(false)
+		->needs(shmOption);
 	// Memspec
-	app.add_option("-m,--memspec", memspec, "json memspec file")
-		->required(true)
+	auto memspecOption = app.add_option("-m,--memspec", memspec, "json memspec file")
 		->check(cli11::ExistingFile);
 	// JSON output file
-	app.add_option("-j,--json", jsonfile, "json output file path")
+	app.add_option("-j,--json", jsonfile, "output file path")
 		->required(false)
 		->check(validators::EnsureFileExists);
+	// Output format
+	app.add_option("-f,--format", format, "output file format (json, csv or binary)")
+		->required(false)
+		->check(cli11::IsMember({"json", "csv", "binary"}));
+	// Compiled memspec cache
+	app.add_flag("--memspec-cache", memspecCache, "cache the compiled memspec next to the json memspec file");
+	app.add_option("--memspec-cache-dir", memspecCacheDir, "cache the compiled memspec in this directory")
+		->required(false);
+	// Profile
+	app.add_flag("--profile", profile, "print where the simulation time went");
+	// Fast forward
+	app.add_flag("--fast-forward", fastForward, "fast forward periodic refresh and power down stretches of the trace")
+		->excludes(shmOption);
+	// Fan-out
+	auto fanOutOption = app.add_option("--fan-out", fanOut, "json file with the memspecs and configs the trace is simulated for in parallel")
+		->check(cli11::ExistingFile);
+	fanOutOption->excludes(memspecOption)->excludes(shmOption)->excludes("--fast-forward");
+	// Power down policy sweep
+	auto powerDownSweepOption = app.add_option("--power-down-sweep", powerDownSweep, "json file with the power down policies the trace is simulated for in parallel")
+		->check(cli11::ExistingFile);
+	powerDownSweepOption->excludes(shmOption)->excludes(fanOutOption)->excludes("--fast-forward");
+	// Server
+	auto serveOption = app.add_option("--serve", serve, "serve simulation jobs on this unix socket");
+	serveOption->excludes(configOption)->excludes(trace)->excludes(shmOption)->excludes(memspecOption)->excludes(fanOutOption)->excludes(powerDownSweepOption);
+	app.add_option("--workers", workers, "number of worker threads of the server (default: hardware threads)")
+		->required(false)
+		->needs(serveOption);
+	auto serverOption = app.add_option("--server", server, "send the job to the server listening on this unix socket");
+	serverOption->excludes(serveOption)->excludes(shmOption)->excludes(fanOutOption)->excludes(powerDownSweepOption);
+	// Run tiers
+	auto tierOption = app.add_option("--tier", tier, "accuracy tier of the simulation (core, toggling, sampled or exact)")
+		->check(cli11::IsMember({"core", "toggling", "sampled", "exact"}));
+	tierOption->excludes(shmOption)->excludes(fanOutOption)->excludes(powerDownSweepOption)->excludes(serveOption)->excludes(serverOption);
+	auto autoOption = app.add_option("--auto", autoBudget, "select the cheapest tier within this relative interface energy error (e.g. 0.05), scored on the second half of the calibration prefix")
+		->check(cli11::NonNegativeNumber);
+	autoOption->excludes(tierOption)->excludes(shmOption)->excludes(fanOutOption)->excludes(powerDownSweepOption)->excludes(serveOption)->excludes(serverOption);
+	app.add_option("--calibration", tierOptions.calibrationCommands, "number of commands of the calibration prefix of the trace")
+		->required(false)
+		->check(cli11::PositiveNumber);
+	app.add_option("--sample-interval", tierOptions.sampleInterval, "every n-th read and write is sampled in the sampled tier")
+		->required(false)
+		->check(cli11::PositiveNumber);
 	// Parse arguments
 	try { 
 		app.parse(argc, argv); 
+		if (serve.empty()) {
+			if (memspec.empty() && fanOut.empty()) {
+				throw cli11::RequiredError("--memspec");
+			}
+			if (configfile.empty() && server.empty() && fanOut.empty()) {
+				throw cli11::RequiredError("--config");
+			}
+			if (tracefile.empty() && shm.empty()) {
+				throw cli11::RequiredError("--trace or --shm");
+			}
+		}
 	} catch(const cli11::ParseError &e) {
 		return app.exit(e);
 	}
@@ -54,9 +117,24 @@ int main(int argc, char *argv[])
 	// Options
 	std::string configfile;
 	std::string tracefile;
+	std::string shm;
+	std::size_t shmSize = DRAMPower::util::ShmCommandRing::DEFAULT_CAPACITY;
 	std::string memspec;
 	std::optional<std::string> jsonfile = std::nullopt;
-	int res = parseArgs(argc, argv, configfile, tracefile, memspec, jsonfile);
+	std::string format = "json";
+	bool memspecCache = false;
+	std::string memspecCacheDir;
+	bool profile = false;
+	bool fastForward = false;
+	std::string fanOut;
+	std::string powerDownSweep;
+	std::string serve;
+	std::size_t workers = 0;
+	std::string server;
+	std::string tier;
+	std::optional<double> autoBudget = std::nullopt;
+	DRAMPower::DRAMPowerCLI::TierOptions tierOptions;
+	int res = parseArgs(argc, argv, configfile, tracefile, shm, shmSize, memspec, jsonfile, format, memspecCache, memspecCacheDir, profile, fastForward, fanOut, powerDownSweep, serve, workers, server, tier, autoBudget, tierOptions);
 	if(res != 0)
 	{
 		return res;
@@ -65,6 +143,79 @@ int main(int argc, char *argv[])
 	// Set spdlog pattern
 	spdlog::set_pattern("%v");
 
+	std::optional<std::filesystem::path> cacheDir = std::nullopt;
+	if (memspecCache || !memspecCacheDir.empty()) {
+		cacheDir = std::filesystem::path(memspecCacheDir);
+	}
+
+	// Server mode
+	if (!serve.empty())
+	{
+		DRAMPower::DRAMPowerCLI::Server instance({serve, workers, cacheDir});
+		return instance.run() ? 0 : 1;
+	}
+
+	// Client mode
+	if (!server.empty())
+	{
+		if ("json" != format) {
+			spdlog::error("The server only creates json results");
+			return 1;
+		}
+		json_t request{
+			{"memspec", std::filesystem::absolute(memspec).string()},
+			{"trace", std::filesystem::absolute(tracefile).string()},
+		};
+		if (!configfile.empty()) {
+			request["config"] = std::filesystem::absolute(configfile).string();
+		}
+		auto response = DRAMPower::DRAMPowerCLI::sendRequest(server, request.dump());
+		if (!response) {
+			spdlog::error("No response from server {}", server);
+			return 1;
+		}
+		json_t result = json_t::parse(*response, nullptr, false);
+		if (result.is_discarded() || "ok" != result.value("status", "")) {
+			spdlog::error("Server error: {}", result.is_discarded() ? *response : result.value("message", ""));
+			return 1;
+		}
+		if (jsonfile) {
+			std::ofstream out(*jsonfile);
+			out << result["result"].dump(4) << '\n';
+			if (!out) {
+				spdlog::error("Error while creating result. Exiting application");
+				return 1;
+			}
+		} else {
+			std::cout << result["result"].dump(4) << std::endl;
+		}
+		return 0;
+	}
+
+	// Fan-out mode
+	if (!fanOut.empty())
+	{
+		auto resultFormat = DRAMPower::DRAMPowerCLI::resultFormatFromString(format);
+		std::optional<std::string> defaultConfig = std::nullopt;
+		if (!configfile.empty()) {
+			defaultConfig = configfile;
+		}
+		auto start = std::chrono::steady_clock::now();
+		std::size_t commandCount = 0;
+		if (!resultFormat || !DRAMPower::DRAMPowerCLI::runFanOut(tracefile, fanOut, defaultConfig, cacheDir, *resultFormat, commandCount))
+		{
+			spdlog::error("Error while running the fan-out. Exiting application");
+			return 1;
+		}
+		if (profile) {
+			std::vector<std::pair<std::string, std::chrono::nanoseconds>> phases = {
+				{"fan-out", std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start)}
+			};
+			DRAMPower::DRAMPowerCLI::profileResult(phases, commandCount);
+		}
+		return 0;
+	}
+
 	// Read config
 	DRAMPower::DRAMPowerCLI::config::CLIConfig config;
 	if (!DRAMPower::DRAMPowerCLI::getConfig(configfile, config)) {
@@ -72,33 +223,130 @@ int main(int argc, char *argv[])
 		return 1;
 	}
 
+	// Power down policy sweep mode
+	if (!powerDownSweep.empty())
+	{
+		auto start = std::chrono::steady_clock::now();
+		std::size_t commandCount = 0;
+		if (!DRAMPower::DRAMPowerCLI::runPowerDownSweep(tracefile, memspec, config, powerDownSweep, cacheDir, jsonfile, commandCount))
+		{
+			spdlog::error("Error while running the power down sweep. Exiting application");
+			return 1;
+		}
+		if (profile) {
+			std::vector<std::pair<std::string, std::chrono::nanoseconds>> phases = {
+				{"power-down-sweep", std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start)}
+			};
+			DRAMPower::DRAMPowerCLI::profileResult(phases, commandCount);
+		}
+		return 0;
+	}
+
+	// Phase timings for the profile
+	std::vector<std::pair<std::string, std::chrono::nanoseconds>> phases;
+	auto phaseStart = std::chrono::steady_clock::now();
+	auto endPhase = [&phases, &phaseStart](std::string name) {
+		auto now = std::chrono::steady_clock::now();
+		phases.emplace_back(std::move(name), std::chrono::duration_cast<std::chrono::nanoseconds>(now - phaseStart));
+		phaseStart = now;
+	};
+
 	// Parse command list (load command list in memory)
 	std::vector<std::pair<Command, std::unique_ptr<uint8_t[]>>> commandList;
-	if(!DRAMPower::DRAMPowerCLI::parse_command_list(tracefile, commandList))
+	if(shm.empty())
 	{
-		spdlog::error("Error while parsing command list. Exiting application");
-		return 1;
+		if(!DRAMPower::DRAMPowerCLI::parse_command_list(tracefile, commandList))
+		{
+			spdlog::error("Error while parsing command list. Exiting application");
+			return 1;
+		}
+		endPhase("csv parsing");
 	}
 
 	// Initialize memory / Create memory object
-	std::unique_ptr<dram_base<CmdType>> ddr = DRAMPower::DRAMPowerCLI::getMemory(std::string_view(memspec), config.simconfig);
+	std::unique_ptr<dram_base<CmdType>> ddr;
+	std::optional<DRAMPower::DRAMPowerCLI::RunTier> runTier = DRAMPower::DRAMPowerCLI::runTierFromString(tier);
+	if (runTier || autoBudget)
+	{
+		// The tier decides on the interface mode instead of useToggleRate
+		auto memspecData = DRAMPower::DRAMPowerCLI::loadMemSpec(memspec, cacheDir);
+		if (!memspecData) {
+			spdlog::error("Invalid memory specification");
+			return 1;
+		}
+		if (autoBudget) {
+			// The core tier can't be fast forwarded
+			auto minTier = fastForward ? DRAMPower::DRAMPowerCLI::RunTier::Toggling : DRAMPower::DRAMPowerCLI::RunTier::Core;
+			runTier = DRAMPower::DRAMPowerCLI::selectRunTier(*memspecData, config, commandList, *autoBudget, tierOptions, minTier);
+			if (!runTier) {
+				spdlog::error("Error while selecting the run tier. Exiting application");
+				return 1;
+			}
+			spdlog::info("Run tier -> {}", DRAMPower::DRAMPowerCLI::to_string(*runTier));
+			endPhase("calibration");
+		}
+		if (fastForward && DRAMPower::DRAMPowerCLI::RunTier::Core == *runTier) {
+			spdlog::error("The core tier can't be fast forwarded");
+			return 1;
+		}
+		ddr = DRAMPower::DRAMPowerCLI::makeMemory(*memspecData, DRAMPower::DRAMPowerCLI::tierSimConfig(*runTier, *memspecData, config, commandList, tierOptions));
+	}
+	else
+	{
+		ddr = DRAMPower::DRAMPowerCLI::getMemory(std::string_view(memspec), config.simconfig, cacheDir);
+	}
 	if (!ddr) {
 		spdlog::error("Invalid memory specification");
 		return 1;
 	}
+	endPhase("memory creation");
 
 	// Execute commands
-	if(!DRAMPower::DRAMPowerCLI::runCommands(ddr, commandList))
+	std::size_t commandCount = commandList.size();
+	std::optional<SimulationStats> stats = std::nullopt;
+	if(fastForward)
+	{
+		uint64_t skippedPeriods = 0;
+		stats.emplace();
+		if(!DRAMPower::DRAMPowerCLI::runFastForwardCommands(ddr, commandList, *stats, skippedPeriods))
+		{
+			spdlog::error("Error while running commands. Exiting application");
+			return 1;
+		}
+		if (profile) {
+			spdlog::info("Fast forwarded periods -> {}", skippedPeriods);
+		}
+	}
+	else if(shm.empty() && !(runTier
+		? DRAMPower::DRAMPowerCLI::runTierCommands(ddr, commandList, *runTier)
+		: DRAMPower::DRAMPowerCLI::runCommands(ddr, commandList)))
 	{
 		spdlog::error("Error while running commands. Exiting application");
 		return 1;
 	}
+	if(!shm.empty() && !DRAMPower::DRAMPowerCLI::runShmCommands(ddr, shm, shmSize, commandCount))
+	{
+		spdlog::error("Error while streaming commands. Exiting application");
+		return 1;
+	}
+	endPhase("simulation");
 
 	// Calculate energy and stats
-	if(!DRAMPower::DRAMPowerCLI::makeResult(jsonfile, std::move(ddr)))
+	auto resultFormat = DRAMPower::DRAMPowerCLI::resultFormatFromString(format);
+	bool coreOnly = runTier && DRAMPower::DRAMPowerCLI::RunTier::Core == *runTier;
+	if(!resultFormat || !(stats
+		? DRAMPower::DRAMPowerCLI::makeResult(jsonfile, ddr, *stats, *resultFormat)
+		: coreOnly
+		? DRAMPower::DRAMPowerCLI::makeCoreResult(jsonfile, ddr, *resultFormat)
+		: DRAMPower::DRAMPowerCLI::makeResult(jsonfile, std::move(ddr), *resultFormat)))
 	{
 		spdlog::error("Error while creating result. Exiting application");
 		return 1;
 	}
+	endPhase("result");
+
+	if (profile) {
+		DRAMPower::DRAMPowerCLI::profileResult(phases, commandCount);
+	}
 	return 0;
 };
@@ -0,0 +1,124 @@
+#include <gtest/gtest.h>
+
+#include <DRAMPower/cli/run.hpp>
+#include <DRAMPower/cli/run_tier.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <initializer_list>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+using namespace DRAMPower;
+using namespace DRAMPower::DRAMPowerCLI;
+using DRAMUtils::Config::ToggleRateDefinition;
+using DRAMUtils::Config::TogglingRateIdlePattern;
+
+class DramPowerCLITest_RunTier : public ::testing::Test {
+protected:
+    std::optional<MemSpecCache::memspec_t> memspec;
+    std::vector<std::pair<Command, std::unique_ptr<uint8_t[]>>> commandList;
+
+    virtual void SetUp()
+    {
+        // 8 bit data bus
+        memspec = loadMemSpec(std::string(TEST_RESOURCE_DIR) + "ddr4.json");
+    }
+
+    void add(timestamp_t timestamp, CmdType type, std::initializer_list<uint8_t> data = {})
+    {
+        std::unique_ptr<uint8_t[]> bytes;
+        if (0 != data.size()) {
+            bytes = std::make_unique<uint8_t[]>(data.size());
+            std::copy(data.begin(), data.end(), bytes.get());
+        }
+        Command command(timestamp, type, {0, 0, 0}, bytes.get(), data.size() * 8);
+        commandList.emplace_back(command, std::move(bytes));
+    }
+
+    static DRAMPowerCLI::config::CLIConfig idleConfig(TogglingRateIdlePattern read, TogglingRateIdlePattern write)
+    {
+        DRAMPowerCLI::config::CLIConfig config{};
+        config.useToggleRate = true;
+        config.simconfig.toggleRateDefinition = ToggleRateDefinition{0.0, 0.0, 0.0, 0.0, read, write};
+        return config;
+    }
+};
+
+TEST_F(DramPowerCLITest_RunTier, MeasureToggleRates)
+{
+    ASSERT_TRUE(memspec.has_value());
+    // Beats 0xFF 0xFF 0x0F 0x0F: 24 of 32 bits are ones and 4 bits toggle between the beats.
+    // Against the idle pattern L 8 bits toggle into the first and 4 out of the last beat, against H 0 and 4.
+    add(0, CmdType::ACT);
+    add(10, CmdType::WR, {0xFF, 0xFF, 0x0F, 0x0F});
+    add(20, CmdType::RD, {0xFF, 0xFF, 0x0F, 0x0F});
+    add(40, CmdType::PRE);
+
+    ToggleRateDefinition rates = measureToggleRates(*memspec, idleConfig(TogglingRateIdlePattern::L, TogglingRateIdlePattern::H), commandList, commandList.size(), 1);
+    EXPECT_DOUBLE_EQ(rates.togglingRateRead, 16.0 / 32.0);
+    EXPECT_DOUBLE_EQ(rates.togglingRateWrite, 8.0 / 32.0);
+    EXPECT_DOUBLE_EQ(rates.dutyCycleRead, 24.0 / 32.0);
+    EXPECT_DOUBLE_EQ(rates.dutyCycleWrite, 24.0 / 32.0);
+    EXPECT_EQ(rates.idlePatternRead, TogglingRateIdlePattern::L);
+    EXPECT_EQ(rates.idlePatternWrite, TogglingRateIdlePattern::H);
+
+    // The bus floats, only the toggles between the beats count
+    rates = measureToggleRates(*memspec, idleConfig(TogglingRateIdlePattern::Z, TogglingRateIdlePattern::Z), commandList, commandList.size(), 1);
+    EXPECT_DOUBLE_EQ(rates.togglingRateRead, 4.0 / 32.0);
+    EXPECT_DOUBLE_EQ(rates.togglingRateWrite, 4.0 / 32.0);
+    EXPECT_DOUBLE_EQ(rates.dutyCycleRead, 24.0 / 32.0);
+
+    // Without a toggling rate config the DDR4 data bus idles high
+    rates = measureToggleRates(*memspec, DRAMPowerCLI::config::CLIConfig{false, {}}, commandList, commandList.size(), 1);
+    EXPECT_DOUBLE_EQ(rates.togglingRateRead, 8.0 / 32.0);
+    EXPECT_EQ(rates.idlePatternRead, TogglingRateIdlePattern::H);
+
+    // Only every second read and write is sampled
+    rates = measureToggleRates(*memspec, idleConfig(TogglingRateIdlePattern::L, TogglingRateIdlePattern::H), commandList, commandList.size(), 2);
+    EXPECT_DOUBLE_EQ(rates.togglingRateWrite, 8.0 / 32.0);
+    EXPECT_DOUBLE_EQ(rates.togglingRateRead, 0.0);
+}
+
+TEST_F(DramPowerCLITest_RunTier, SelectRunTierBudget)
+{
+    ASSERT_TRUE(memspec.has_value());
+    // The data of the first half is all zeroes, the toggling rates measured on it miss the second half
+    add(0, CmdType::ACT);
+    for (uint8_t i = 0; i < 40; ++i) {
+        const timestamp_t timestamp = 10 + 10 * i;
+        const CmdType type = 0 == i % 2 ? CmdType::WR : CmdType::RD;
+        if (i < 20) {
+            add(timestamp, type, {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00});
+        } else {
+            const uint8_t value = static_cast<uint8_t>(0x5A ^ (i * 37));
+            add(timestamp, type, {value, static_cast<uint8_t>(~value), value, 0x3C, value, 0xC3, value, static_cast<uint8_t>(value + 1)});
+        }
+    }
+    add(500, CmdType::PRE);
+    DRAMPowerCLI::config::CLIConfig config{};
+    config.useToggleRate = false;
+    TierOptions options;
+    options.calibrationCommands = commandList.size();
+    options.sampleInterval = 1;
+
+    // The core tier reports no interface energy
+    std::optional<double> error = calibrationError(RunTier::Core, *memspec, config, commandList, options);
+    ASSERT_TRUE(error.has_value());
+    EXPECT_DOUBLE_EQ(*error, 1.0);
+    EXPECT_EQ(selectRunTier(*memspec, config, commandList, *error, options), RunTier::Core);
+    EXPECT_NE(selectRunTier(*memspec, config, commandList, std::nextafter(*error, 0.0), options), RunTier::Core);
+
+    // The toggling tier is scored on the commands its rates weren't measured on
+    error = calibrationError(RunTier::Toggling, *memspec, config, commandList, options);
+    ASSERT_TRUE(error.has_value());
+    ASSERT_GT(*error, 0.0);
+    EXPECT_EQ(selectRunTier(*memspec, config, commandList, *error, options, RunTier::Toggling), RunTier::Toggling);
+    EXPECT_NE(selectRunTier(*memspec, config, commandList, std::nextafter(*error, 0.0), options, RunTier::Toggling), RunTier::Toggling);
+
+    // No tier is within a negative budget
+    EXPECT_EQ(selectRunTier(*memspec, config, commandList, -1.0, options), RunTier::Exact);
+}
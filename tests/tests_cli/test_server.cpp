@@ -0,0 +1,108 @@
+#include <gtest/gtest.h>
+
+#include <DRAMPower/cli/result_writer.hpp>
+#include <DRAMPower/cli/run.hpp>
+#include <DRAMPower/cli/server.hpp>
+
+#include <DRAMUtils/util/json.h>
+
+#include <chrono>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <unistd.h>
+
+using namespace DRAMPower;
+using namespace DRAMPower::DRAMPowerCLI;
+
+class DramPowerCLITest_Server : public ::testing::Test {
+protected:
+    std::string socketPath;
+    std::string memspec = std::string(TEST_RESOURCE_DIR) + "ddr4.json";
+    std::string trace = std::string(TEST_RESOURCE_DIR) + "ddr4.csv";
+
+    virtual void SetUp()
+    {
+        socketPath = (std::filesystem::temp_directory_path() / ("drampower_test_server_" + std::to_string(::getpid()) + ".sock")).string();
+    }
+
+    // Waits until the server answers a ping
+    bool waitForServer()
+    {
+        for (int i = 0; i < 500; ++i) {
+            if (sendRequest(socketPath, R"({"request": "ping"})")) {
+                return true;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        return false;
+    }
+};
+
+TEST_F(DramPowerCLITest_Server, RoundTrip)
+{
+    Server server({socketPath, 2});
+    std::thread thread([&server] { server.run(); });
+    ASSERT_TRUE(waitForServer());
+
+    json_t request{
+        {"memspec", memspec},
+        {"config", {{"useToggleRate", false}}},
+        {"trace", trace},
+    };
+    std::optional<std::string> response = sendRequest(socketPath, request.dump());
+    server.stop();
+    thread.join();
+    ASSERT_TRUE(response.has_value());
+    json_t result = json_t::parse(*response, nullptr, false);
+    ASSERT_FALSE(result.is_discarded());
+    ASSERT_EQ(result.value("status", ""), "ok");
+
+    // Same simulation without the server
+    DRAMPowerCLI::config::CLIConfig config{};
+    ASSERT_TRUE(parseConfig(request["config"], config));
+    std::vector<std::pair<Command, std::unique_ptr<uint8_t[]>>> commandList;
+    ASSERT_TRUE(parse_command_list(trace, commandList));
+    std::unique_ptr<dram_base<CmdType>> ddr = getMemory(memspec, config.simconfig);
+    ASSERT_NE(ddr, nullptr);
+    ASSERT_TRUE(runCommands(ddr, commandList));
+    const timestamp_t end = ddr->getLastCommandTime();
+    std::string expected;
+    {
+        OutputBuffer out(expected);
+        ASSERT_TRUE(writeResult(out, ResultFormat::JSON, ddr->getCLIArchitectureConfig(), ddr->calcCoreEnergy(end), ddr->calcInterfaceEnergy(end), -1));
+    }
+
+    EXPECT_EQ(result["commands"].get<std::size_t>(), commandList.size());
+    EXPECT_EQ(result["result"], json_t::parse(expected));
+}
+
+TEST_F(DramPowerCLITest_Server, ShutdownRequest)
+{
+    Server server({socketPath, 1});
+    bool served = false;
+    std::thread thread([&server, &served] { served = server.run(); });
+    ASSERT_TRUE(waitForServer());
+
+    std::optional<std::string> response = sendRequest(socketPath, R"({"request": "shutdown"})");
+    thread.join();
+    ASSERT_TRUE(response.has_value());
+    EXPECT_EQ(json_t::parse(*response).value("status", ""), "ok");
+    EXPECT_TRUE(served);
+    EXPECT_FALSE(std::filesystem::exists(socketPath));
+}
+
+TEST_F(DramPowerCLITest_Server, StopBeforeRun)
+{
+    // The stop isn't overwritten by the start of the server
+    Server server({socketPath, 1});
+    server.stop();
+    EXPECT_TRUE(server.run());
+    EXPECT_FALSE(sendRequest(socketPath, R"({"request": "ping"})").has_value());
+    EXPECT_FALSE(std::filesystem::exists(socketPath));
+}
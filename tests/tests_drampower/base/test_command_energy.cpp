@@ -0,0 +1,194 @@
+#include <gtest/gtest.h>
+
+#include <DRAMPower/command/Command.h>
+#include <DRAMPower/data/core_energy_coefficients.h>
+#include <DRAMPower/util/command_energy.h>
+#include <DRAMPower/util/command_observer.h>
+
+#include <DRAMPower/standards/ddr4/DDR4.h>
+#include <DRAMPower/standards/ddr5/DDR5.h>
+#include <DRAMPower/standards/lpddr4/LPDDR4.h>
+#include <DRAMPower/standards/lpddr5/LPDDR5.h>
+#include <DRAMPower/standards/lpddr6/LPDDR6.h>
+
+#include <DRAMUtils/memspec/MemSpec.h>
+
+#include <array>
+#include <cmath>
+#include <filesystem>
+#include <vector>
+
+using namespace DRAMPower;
+using util::CommandEnergyAttribution;
+using util::ObservedDRAM;
+using util::command_energy_t;
+
+class DramPowerTest_CommandEnergy : public ::testing::Test {
+protected:
+    std::array<uint8_t, 64> m_data{};
+    std::vector<Command> m_commands;
+
+    virtual void SetUp()
+    {
+        for (std::size_t i = 0; i < m_data.size(); ++i) {
+            m_data[i] = static_cast<uint8_t>(i * 29 + 7);
+        }
+        const uint8_t *data = m_data.data();
+        m_commands = {
+            {   0, CmdType::ACT,    {0, 0, 0}},
+            {  15, CmdType::ACT,    {1, 0, 0}},
+            {  30, CmdType::RD,     {0, 0, 0, 0, 16}, data, 128},
+            {  40, CmdType::WR,     {1, 0, 0, 0, 16}, data + 8, 128},
+            {  60, CmdType::PRE,    {0, 0, 0}},
+            {  70, CmdType::RDA,    {1, 0, 0, 0, 16}, data + 16, 128},
+            {  75, CmdType::ACT,    {2, 0, 1}},
+            { 120, CmdType::WRA,    {2, 0, 1, 0, 16}, data + 24, 128},
+            { 200, CmdType::PDEP,   {0, 0, 0}},
+            { 260, CmdType::PDXP,   {0, 0, 0}},
+            { 300, CmdType::REFA,   {0, 0, 0}},
+            { 650, CmdType::ACT,    {3, 0, 0}},
+            { 700, CmdType::PDEA,   {0, 0, 0}},
+            { 760, CmdType::PDXA,   {0, 0, 0}},
+            { 800, CmdType::PREA,   {0, 0, 0}},
+            { 850, CmdType::SREFEN, {0, 0, 1}},
+            {1100, CmdType::SREFEX, {0, 0, 1}},
+            {1200, CmdType::ACT,    {3, 0, 1}},
+            {1230, CmdType::WR,     {3, 0, 1, 0, 16}, data + 32, 128},
+            {1300, CmdType::PRE,    {3, 0, 1}},
+            {1500, CmdType::END_OF_SIMULATION},
+        };
+    }
+
+    template <typename Standard, typename MemSpec>
+    void expectMatchesEnergyCalculation(MemSpec memSpec)
+    {
+        memSpec.numberOfRanks = 2;
+        ObservedDRAM<Standard, CommandEnergyAttribution> dram(memSpec);
+        Standard reference(memSpec);
+
+        std::vector<command_energy_t> energies;
+        auto &attribution = dram.template getObserver<CommandEnergyAttribution>();
+        attribution.attach(dram, [&energies](const Command &, const command_energy_t &energy) {
+            energies.push_back(energy);
+        });
+
+        double core = 0.0;
+        double interface = 0.0;
+        for (const Command &command : m_commands) {
+            dram.doCommand(command);
+            reference.doCommand(command);
+            ASSERT_FALSE(energies.empty());
+            core += energies.back().core;
+            interface += energies.back().interface;
+            // The accumulated energy matches the energy calculation of the whole memory
+            const double expectedCore = reference.calcCoreEnergy(command.timestamp).total();
+            const double expectedInterface = reference.calcInterfaceEnergy(command.timestamp).total();
+            ASSERT_NEAR(core, expectedCore, 1e-9 * expectedCore);
+            ASSERT_NEAR(interface, expectedInterface, 1e-9 * expectedInterface + 1e-18);
+        }
+        ASSERT_EQ(energies.size(), m_commands.size());
+        ASSERT_DOUBLE_EQ(attribution.getTotal().core, core);
+        ASSERT_DOUBLE_EQ(attribution.getTotal().interface, interface);
+
+        // The observer doesn't change the simulation
+        const timestamp_t end = m_commands.back().timestamp;
+        ASSERT_EQ(dram.getWindowStats(end), reference.getWindowStats(end));
+    }
+
+    template <typename MemSpec>
+    MemSpec load(const char *file)
+    {
+        auto data = DRAMUtils::parse_memspec_from_file(std::filesystem::path(TEST_RESOURCE_DIR) / file);
+        return MemSpec::from_memspec(*data);
+    }
+};
+
+TEST_F(DramPowerTest_CommandEnergy, DDR4)
+{
+    expectMatchesEnergyCalculation<DDR4>(load<MemSpecDDR4>("ddr4.json"));
+}
+
+TEST_F(DramPowerTest_CommandEnergy, DDR5)
+{
+    // The DDR5 interface has no self refresh exit pattern
+    m_commands.erase(m_commands.begin() + 15, m_commands.begin() + 17);
+    expectMatchesEnergyCalculation<DDR5>(load<MemSpecDDR5>("ddr5.json"));
+}
+
+TEST_F(DramPowerTest_CommandEnergy, LPDDR4)
+{
+    expectMatchesEnergyCalculation<LPDDR4>(load<MemSpecLPDDR4>("lpddr4.json"));
+}
+
+TEST_F(DramPowerTest_CommandEnergy, LPDDR5)
+{
+    // Deep sleep mode in self refresh
+    m_commands.insert(m_commands.begin() + 16, {
+        { 900, CmdType::DSMEN, {0, 0, 1}},
+        {1000, CmdType::DSMEX, {0, 0, 1}},
+    });
+    expectMatchesEnergyCalculation<LPDDR5>(load<MemSpecLPDDR5>("lpddr5.json"));
+}
+
+TEST_F(DramPowerTest_CommandEnergy, LPDDR6)
+{
+    // LPDDR6 bursts are 512 bits
+    for (Command &command : m_commands) {
+        if (nullptr != command.data) {
+            command.data = m_data.data();
+            command.sz_bits = 512;
+        }
+    }
+    expectMatchesEnergyCalculation<LPDDR6>(load<MemSpecLPDDR6>("lpddr6.json"));
+}
+
+TEST_F(DramPowerTest_CommandEnergy, QueriesBetweenCommands)
+{
+    // A stats query on the observed memory executes the pending auto-precharges outside of a command
+    MemSpecDDR4 memSpec = load<MemSpecDDR4>("ddr4.json");
+    memSpec.numberOfRanks = 2;
+    ObservedDRAM<DDR4, CommandEnergyAttribution> dram(memSpec);
+    DDR4 reference(memSpec);
+    auto &attribution = dram.getObserver<CommandEnergyAttribution>();
+    attribution.attach(dram);
+
+    const uint8_t *data = m_data.data();
+    const std::vector<Command> commands = {
+        {  0, CmdType::ACT, {0, 0, 0}},
+        { 10, CmdType::ACT, {0, 0, 1}},
+        { 30, CmdType::RDA, {0, 0, 0, 0, 16}, data, 128},
+        {100, CmdType::RD,  {0, 0, 1, 0, 16}, data + 8, 128},
+        {120, CmdType::WRA, {0, 0, 1, 0, 16}, data + 16, 128},
+        {300, CmdType::ACT, {1, 0, 0}},
+        {350, CmdType::PRE, {1, 0, 0}},
+        {500, CmdType::END_OF_SIMULATION},
+    };
+    for (const Command &command : commands) {
+        const double queried = dram.calcCoreEnergy(command.timestamp).total();
+        ASSERT_DOUBLE_EQ(queried, reference.calcCoreEnergy(command.timestamp).total());
+        dram.doCommand(command);
+        reference.doCommand(command);
+        const double expected = reference.calcCoreEnergy(command.timestamp).total();
+        // The other rank's auto-precharge isn't charged to this command
+        ASSERT_NEAR(attribution.getTotal().core, expected, 1e-9 * expected);
+        ASSERT_NEAR(attribution.getTotal().interface, reference.calcInterfaceEnergy(command.timestamp).total(),
+            1e-9 * attribution.getTotal().interface + 1e-18);
+    }
+}
+
+TEST_F(DramPowerTest_CommandEnergy, Coefficients)
+{
+    const MemSpecDDR4 memSpec = load<MemSpecDDR4>("ddr4.json");
+    DDR4 dram(memSpec);
+    dram.doCommand({0, CmdType::ACT, {0, 0, 0}});
+    dram.doCommand({50, CmdType::PRE, {0, 0, 0}});
+    const SimulationStats stats = dram.getWindowStats(100);
+    const CoreEnergyCoefficients coefficients(dram, stats);
+
+    // A single activate costs E_act
+    const energy_t energy = dram.calcCoreEnergyStats(stats);
+    EXPECT_NEAR(coefficients.getCounterEnergy(&command_stats_t::act), energy.bank_energy[0].E_act,
+        1e-9 * energy.bank_energy[0].E_act);
+    EXPECT_GT(coefficients.getRankCycleEnergy(&cycles_t::act), 0.0);
+    EXPECT_EQ(coefficients.getBankCycleEnergy(&cycles_t::deepSleepMode), 0.0);
+}
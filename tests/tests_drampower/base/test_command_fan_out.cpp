@@ -0,0 +1,195 @@
+#include <gtest/gtest.h>
+
+#include <DRAMPower/Exceptions.h>
+#include <DRAMPower/command/Command.h>
+#include <DRAMPower/util/command_fan_out.h>
+
+#include <DRAMPower/standards/ddr4/DDR4.h>
+#include <DRAMPower/standards/lpddr4/LPDDR4.h>
+
+#include <DRAMUtils/memspec/MemSpec.h>
+
+#include <algorithm>
+#include <array>
+#include <filesystem>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+using namespace DRAMPower;
+using DRAMPower::util::CommandBatch;
+using DRAMPower::util::fanOut;
+
+class DramPowerTest_CommandFanOut : public ::testing::Test {
+protected:
+    using data_t = std::array<uint8_t, 8>;
+
+    // Counts the commands and fails at the given command
+    struct CountingDram {
+        std::size_t failAt = 0;
+        std::size_t count = 0;
+        uint64_t dataSum = 0;
+
+        void doCommand(const Command &command) {
+            if (0 != failAt && count == failAt) {
+                throw std::runtime_error("failure");
+            }
+            ++count;
+            for (std::size_t i = 0; nullptr != command.data && i < command.sz_bits / 8; ++i) {
+                dataSum += command.data[i];
+            }
+        }
+    };
+
+    std::vector<data_t> m_data;
+    std::vector<Command> m_pattern;
+
+    virtual void SetUp()
+    {
+        constexpr std::size_t iterations = 200;
+        m_data.resize(2 * iterations);
+        for (std::size_t i = 0; i < iterations; ++i) {
+            const timestamp_t t = i * 40;
+            const std::size_t bank = i % 4;
+            for (std::size_t b = 0; b < 8; ++b) {
+                m_data[2 * i][b] = static_cast<uint8_t>(i * 7 + b * 31);
+                m_data[2 * i + 1][b] = static_cast<uint8_t>(i * 13 + b * 3);
+            }
+            m_pattern.push_back({t, CmdType::ACT, {bank, 0, 0}});
+            m_pattern.push_back({t + 10, CmdType::WR, {bank, 0, 0, 0, 16}, m_data[2 * i].data(), 64});
+            m_pattern.push_back({t + 20, CmdType::RD, {bank, 0, 0, 0, 16}, m_data[2 * i + 1].data(), 64});
+            m_pattern.push_back({t + 30, CmdType::PRE, {bank, 0, 0}});
+        }
+        m_pattern.push_back({iterations * 40, CmdType::END_OF_SIMULATION});
+    }
+
+    auto producer()
+    {
+        return [this](auto &emit) {
+            for (const Command &command : m_pattern) {
+                emit(command);
+            }
+        };
+    }
+
+    uint64_t dataSum() const
+    {
+        uint64_t sum = 0;
+        for (const data_t &data : m_data) {
+            for (uint8_t byte : data) {
+                sum += byte;
+            }
+        }
+        return sum;
+    }
+};
+
+TEST_F(DramPowerTest_CommandFanOut, Batch)
+{
+    CommandBatch batch;
+    for (const Command &command : m_pattern) {
+        batch.push(command);
+    }
+    batch.seal();
+    ASSERT_EQ(batch.size(), m_pattern.size());
+    for (std::size_t i = 0; i < m_pattern.size(); ++i) {
+        const Command &expected = m_pattern[i];
+        const Command &command = batch.commands()[i];
+        ASSERT_EQ(command.timestamp, expected.timestamp);
+        ASSERT_EQ(command.type, expected.type);
+        if (nullptr == expected.data) {
+            ASSERT_EQ(command.data, nullptr);
+            continue;
+        }
+        // The batch owns a copy of the data
+        ASSERT_NE(command.data, expected.data);
+        ASSERT_TRUE(std::equal(expected.data, expected.data + expected.sz_bits / 8, command.data));
+    }
+    batch.clear();
+    ASSERT_TRUE(batch.empty());
+}
+
+TEST_F(DramPowerTest_CommandFanOut, MatchesSeparateSimulations)
+{
+    auto ddr4Spec = DRAMUtils::parse_memspec_from_file(std::filesystem::path(TEST_RESOURCE_DIR) / "ddr4.json");
+    auto lpddr4Spec = DRAMUtils::parse_memspec_from_file(std::filesystem::path(TEST_RESOURCE_DIR) / "lpddr4.json");
+    MemSpecDDR4 memSpecDDR4 = MemSpecDDR4::from_memspec(*ddr4Spec);
+    MemSpecLPDDR4 memSpecLPDDR4 = MemSpecLPDDR4::from_memspec(*lpddr4Spec);
+
+    config::SimConfig toggling;
+    toggling.toggleRateDefinition = DRAMUtils::Config::ToggleRateDefinition {
+        0.5, 0.5, 0.5, 0.5,
+        DRAMUtils::Config::TogglingRateIdlePattern::L,
+        DRAMUtils::Config::TogglingRateIdlePattern::L,
+    };
+
+    std::vector<std::unique_ptr<dram_base<CmdType>>> drams;
+    drams.push_back(std::make_unique<DDR4>(memSpecDDR4));
+    drams.push_back(std::make_unique<DDR4>(memSpecDDR4, toggling));
+    drams.push_back(std::make_unique<LPDDR4>(memSpecLPDDR4));
+    std::vector<dram_base<CmdType> *> targets;
+    for (auto &dram : drams) {
+        targets.push_back(dram.get());
+    }
+
+    // Small batches and ring to wrap around the ring many times
+    auto result = fanOut(targets, producer(), 7, 2);
+    ASSERT_EQ(result.commandCount, m_pattern.size());
+    ASSERT_EQ(result.errors.size(), drams.size());
+
+    std::vector<std::unique_ptr<dram_base<CmdType>>> references;
+    references.push_back(std::make_unique<DDR4>(memSpecDDR4));
+    references.push_back(std::make_unique<DDR4>(memSpecDDR4, toggling));
+    references.push_back(std::make_unique<LPDDR4>(memSpecLPDDR4));
+    const timestamp_t end = m_pattern.back().timestamp;
+    for (std::size_t i = 0; i < drams.size(); ++i) {
+        ASSERT_FALSE(result.errors[i]);
+        for (const Command &command : m_pattern) {
+            references[i]->doCommand(command);
+        }
+        ASSERT_EQ(drams[i]->getWindowStats(end), references[i]->getWindowStats(end));
+        ASSERT_EQ(drams[i]->getTotalEnergy(end), references[i]->getTotalEnergy(end));
+    }
+}
+
+TEST_F(DramPowerTest_CommandFanOut, FailingDram)
+{
+    std::vector<CountingDram> drams(4);
+    drams[1].failAt = 100;
+    std::vector<CountingDram *> targets;
+    for (auto &dram : drams) {
+        targets.push_back(&dram);
+    }
+
+    auto result = fanOut(targets, producer(), 16, 1);
+    ASSERT_EQ(result.commandCount, m_pattern.size());
+    ASSERT_TRUE(result.errors[1]);
+    ASSERT_THROW(std::rethrow_exception(result.errors[1]), std::runtime_error);
+    ASSERT_EQ(drams[1].count, 100u);
+    for (std::size_t i : {0, 2, 3}) {
+        ASSERT_FALSE(result.errors[i]);
+        ASSERT_EQ(drams[i].count, m_pattern.size());
+        ASSERT_EQ(drams[i].dataSum, dataSum());
+    }
+}
+
+TEST_F(DramPowerTest_CommandFanOut, FailingProducer)
+{
+    std::vector<CountingDram> drams(2);
+    std::vector<CountingDram *> targets = {&drams[0], &drams[1]};
+    auto failing = [this](auto &emit) {
+        for (std::size_t i = 0; i < 50; ++i) {
+            emit(m_pattern[i]);
+        }
+        throw Exception("parse error");
+    };
+    ASSERT_THROW(fanOut(targets, failing, 16, 1), Exception);
+    // The complete batches were delivered
+    ASSERT_EQ(drams[0].count, 48u);
+    ASSERT_EQ(drams[1].count, 48u);
+}
+
+TEST_F(DramPowerTest_CommandFanOut, InvalidRing)
+{
+    ASSERT_THROW(util::CommandBatchRing(1, 0), Exception);
+}
@@ -0,0 +1,200 @@
+#include <gtest/gtest.h>
+
+#include <DRAMPower/command/Command.h>
+#include <DRAMPower/util/command_observer.h>
+
+#include <DRAMPower/standards/ddr4/DDR4.h>
+#include <DRAMPower/standards/lpddr4/LPDDR4.h>
+#include <DRAMPower/standards/lpddr6/LPDDR6.h>
+
+#include <DRAMUtils/memspec/MemSpec.h>
+
+#include <array>
+#include <filesystem>
+#include <memory>
+#include <vector>
+
+using namespace DRAMPower;
+using util::CommandHook;
+using util::ObservedDRAM;
+
+namespace {
+
+// Counts the activates per bank before the core sees them
+class BankActivity {
+public:
+    static constexpr CommandHook getSupportedHooks() {
+        return CommandHook::PreCommand | CommandHook::PostCore;
+    }
+
+    void preCommand(const Command& command) {
+        if (CmdType::ACT == command.type) {
+            ++activates[command.targetCoordinate.bank];
+        }
+        ++pending;
+    }
+
+    template <typename Core>
+    void postCore(const Command&, const Core&) {
+        --pending;
+    }
+
+    std::array<uint64_t, 16> activates{};
+    int64_t pending = 0;
+};
+
+// Records the implicit commands executed by the core
+class ImplicitEvents {
+public:
+    static constexpr CommandHook getSupportedHooks() {
+        return CommandHook::ImplicitEvent | CommandHook::PostCore;
+    }
+
+    template <typename Core>
+    void implicitEvent(timestamp_t timestamp, const Core& core) {
+        timestamps.push_back(timestamp);
+        lastCommandTimes.push_back(core.getLastCommandTime());
+    }
+
+    template <typename Core>
+    void postCore(const Command& command, const Core&) {
+        commandTimestamps.push_back(command.timestamp);
+    }
+
+    std::vector<timestamp_t> timestamps;
+    std::vector<timestamp_t> lastCommandTimes;
+    std::vector<timestamp_t> commandTimestamps;
+};
+
+// Counts the transferred bits
+class Traffic {
+public:
+    static constexpr CommandHook getSupportedHooks() {
+        return CommandHook::PostInterface;
+    }
+
+    template <typename Interface>
+    void postInterface(const Command& command, const Interface&) {
+        bits += command.sz_bits;
+    }
+
+    uint64_t bits = 0;
+};
+
+} // namespace
+
+class DramPowerTest_CommandObserver : public ::testing::Test {
+protected:
+    using data_t = std::array<uint8_t, 8>;
+
+    std::vector<data_t> m_data;
+    std::vector<Command> m_commands;
+    std::unique_ptr<MemSpecDDR4> m_memSpecDDR4;
+    std::unique_ptr<MemSpecLPDDR4> m_memSpecLPDDR4;
+
+    virtual void SetUp()
+    {
+        auto ddr4 = DRAMUtils::parse_memspec_from_file(std::filesystem::path(TEST_RESOURCE_DIR) / "ddr4.json");
+        m_memSpecDDR4 = std::make_unique<MemSpecDDR4>(MemSpecDDR4::from_memspec(*ddr4));
+        auto lpddr4 = DRAMUtils::parse_memspec_from_file(std::filesystem::path(TEST_RESOURCE_DIR) / "lpddr4.json");
+        m_memSpecLPDDR4 = std::make_unique<MemSpecLPDDR4>(MemSpecLPDDR4::from_memspec(*lpddr4));
+
+        constexpr std::size_t iterations = 40;
+        m_data.resize(iterations);
+        for (std::size_t i = 0; i < iterations; ++i) {
+            const timestamp_t t = i * 100;
+            const std::size_t bank = i % 4;
+            for (std::size_t b = 0; b < 8; ++b) {
+                m_data[i][b] = static_cast<uint8_t>(i * 5 + b * 17);
+            }
+            m_commands.push_back({t, CmdType::ACT, {bank, 0, 0}});
+            m_commands.push_back({t + 20, CmdType::WR, {bank, 0, 0, 0, 16}, m_data[i].data(), 64});
+            // Every other row closes with an implicit precharge
+            if (0 == i % 2) {
+                m_commands.push_back({t + 40, CmdType::RDA, {bank, 0, 0, 0, 16}, m_data[i].data(), 64});
+            } else {
+                m_commands.push_back({t + 40, CmdType::RD, {bank, 0, 0, 0, 16}, m_data[i].data(), 64});
+                m_commands.push_back({t + 80, CmdType::PRE, {bank, 0, 0}});
+            }
+        }
+        m_commands.push_back({iterations * 100, CmdType::END_OF_SIMULATION});
+    }
+
+    template <typename DRAM, typename Reference>
+    void expectSameAsReference(DRAM &dram, Reference &reference)
+    {
+        for (const Command &command : m_commands) {
+            dram.doCommand(command);
+            reference.doCommand(command);
+        }
+        const timestamp_t end = m_commands.back().timestamp;
+        ASSERT_EQ(dram.getWindowStats(end), reference.getWindowStats(end));
+        ASSERT_EQ(dram.getTotalEnergy(end), reference.getTotalEnergy(end));
+    }
+
+    template <typename Standard, typename MemSpec>
+    void expectObservers(const MemSpec &memSpec)
+    {
+        ObservedDRAM<Standard, BankActivity, ImplicitEvents, Traffic> dram(memSpec);
+        Standard reference(memSpec);
+        expectSameAsReference(dram, reference);
+
+        const auto &activity = dram.template getObserver<BankActivity>();
+        ASSERT_EQ(activity.pending, 0);
+        for (std::size_t bank = 0; bank < 4; ++bank) {
+            ASSERT_EQ(activity.activates[bank], 10u);
+        }
+        ASSERT_EQ(activity.activates[4], 0u);
+
+        // One implicit precharge per RDA, executed before the next command
+        const auto &events = dram.template getObserver<ImplicitEvents>();
+        ASSERT_EQ(events.timestamps.size(), 20u);
+        for (std::size_t i = 0; i < events.timestamps.size(); ++i) {
+            ASSERT_EQ(events.lastCommandTimes[i], events.timestamps[i]);
+            ASSERT_GT(events.timestamps[i], 200 * i + 40);
+            ASSERT_LE(events.timestamps[i], 200 * i + 100);
+        }
+        ASSERT_EQ(events.commandTimestamps.size(), m_commands.size());
+
+        ASSERT_EQ(dram.template getObserver<Traffic>().bits, 80u * 64u);
+    }
+};
+
+TEST_F(DramPowerTest_CommandObserver, DDR4)
+{
+    expectObservers<DDR4>(*m_memSpecDDR4);
+}
+
+TEST_F(DramPowerTest_CommandObserver, LPDDR4)
+{
+    expectObservers<LPDDR4>(*m_memSpecLPDDR4);
+}
+
+TEST_F(DramPowerTest_CommandObserver, WithoutObservers)
+{
+    ObservedDRAM<DDR4> dram(*m_memSpecDDR4);
+    DDR4 reference(*m_memSpecDDR4);
+    static_assert(!ObservedDRAM<DDR4>::hasObserver<BankActivity>());
+    expectSameAsReference(dram, reference);
+}
+
+TEST_F(DramPowerTest_CommandObserver, LPDDR6)
+{
+    auto data = DRAMUtils::parse_memspec_from_file(std::filesystem::path(TEST_RESOURCE_DIR) / "lpddr6.json");
+    const MemSpecLPDDR6 memSpec = MemSpecLPDDR6::from_memspec(*data);
+    ObservedDRAM<LPDDR6, BankActivity> dram(memSpec);
+    LPDDR6 reference(memSpec);
+    std::vector<Command> commands = {
+        {0, CmdType::ACT, {1, 0, 0}},
+        {20, CmdType::PRE, {1, 0, 0}},
+        {40, CmdType::ACT, {1, 0, 0}},
+        {60, CmdType::PRE, {1, 0, 0}},
+        {100, CmdType::END_OF_SIMULATION},
+    };
+    for (const Command &command : commands) {
+        dram.doCommand(command);
+        reference.doCommand(command);
+    }
+    ASSERT_EQ(dram.getWindowStats(100), reference.getWindowStats(100));
+    ASSERT_EQ(dram.getObserver<BankActivity>().activates[1], 2u);
+}
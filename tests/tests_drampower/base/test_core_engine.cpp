@@ -0,0 +1,74 @@
+#include <gtest/gtest.h>
+
+#include <DRAMPower/command/Command.h>
+#include <DRAMPower/dram/Core.h>
+
+#include <DRAMPower/standards/ddr4/DDR4Core.h>
+#include <DRAMPower/standards/ddr5/DDR5Core.h>
+#include <DRAMPower/standards/lpddr4/LPDDR4Core.h>
+#include <DRAMPower/standards/lpddr5/LPDDR5Core.h>
+#include <DRAMPower/standards/lpddr6/LPDDR6Core.h>
+
+#include <DRAMUtils/memspec/MemSpec.h>
+
+#include <filesystem>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+using namespace DRAMPower;
+
+// The standard cores are instances of the shared engine
+static_assert(std::is_same_v<DDR4Core, BasicCore<DDR4CorePolicy, DynamicGeometry>>);
+static_assert(std::is_same_v<BasicLPDDR5Core<FixedGeometry<1, 16, 4>>, BasicCore<LPDDR5CorePolicy, FixedGeometry<1, 16, 4>>>);
+static_assert(DDR5CorePolicy::sameBankRefresh && !DDR5CorePolicy::perBankRefresh);
+static_assert(LPDDR5CorePolicy::perTwoBankRefresh && LPDDR5CorePolicy::deepSleepMode);
+static_assert(LPDDR6CorePolicy::dualBankRefresh && !LPDDR6CorePolicy::deepSleepMode);
+
+// DDR4 with per bank refresh and deep sleep mode
+struct ExtendedDDR4CorePolicy : DDR4CorePolicy {
+    static constexpr bool perBankRefresh = true;
+    static constexpr bool deepSleepMode = true;
+
+    static uint64_t tRFCbank(const timings_t& t) { return t.tRFC / 4; }
+};
+
+class DramPowerTest_CoreEngine : public ::testing::Test {
+protected:
+    std::vector<Command> testPattern = {
+        {   0, CmdType::ACT,    { 0, 0, 0 }},
+        {  20, CmdType::PRE,    { 0, 0, 0 }},
+        {  40, CmdType::REFB,   { 3, 0, 0 }},
+        { 200, CmdType::SREFEN, { 0, 0, 0 }},
+        { 600, CmdType::DSMEN,  { 0, 0, 0 }},
+        { 800, CmdType::DSMEX,  { 0, 0, 0 }},
+        { 900, CmdType::SREFEX, { 0, 0, 0 }},
+        {1000, CmdType::END_OF_SIMULATION },
+    };
+
+    std::unique_ptr<MemSpecDDR4> memSpec;
+
+    virtual void SetUp()
+    {
+        auto data = DRAMUtils::parse_memspec_from_file(std::filesystem::path(TEST_RESOURCE_DIR) / "ddr4.json");
+        memSpec = std::make_unique<MemSpecDDR4>(MemSpecDDR4::from_memspec(*data));
+    }
+};
+
+TEST_F(DramPowerTest_CoreEngine, CustomPolicy)
+{
+    BasicCore<ExtendedDDR4CorePolicy> core(*memSpec);
+    for (const auto &command : testPattern) {
+        core.doCommand(command);
+    }
+
+    SimulationStats stats;
+    core.getWindowStats(1000, stats);
+    ASSERT_EQ(stats.bank[3].counter.refPerBank, 1u);
+    ASSERT_EQ(stats.bank[3].counter.refAllBank, 1u);
+    ASSERT_EQ(stats.rank_total[0].cycles.deepSleepMode, 200u);
+    ASSERT_EQ(stats.bank[0].cycles.deepSleepMode, 200u);
+    // Deep sleep is counted separately from the self-refresh cycles
+    const uint64_t selfRefreshStart = 200 + memSpec->memTimingSpec.tRFC;
+    ASSERT_EQ(stats.rank_total[0].cycles.selfRefresh, 900 - selfRefreshStart - 200);
+}
@@ -0,0 +1,331 @@
+#include <gtest/gtest.h>
+
+#include <DRAMPower/command/Command.h>
+
+#include <DRAMPower/standards/ddr4/DDR4Core.h>
+#include <DRAMPower/standards/ddr5/DDR5Core.h>
+#include <DRAMPower/standards/lpddr4/LPDDR4Core.h>
+#include <DRAMPower/standards/lpddr5/LPDDR5Core.h>
+#include <DRAMPower/standards/lpddr6/LPDDR6Core.h>
+
+#include <DRAMUtils/memspec/MemSpec.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <initializer_list>
+#include <random>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+using namespace DRAMPower;
+
+// Random command sequences on the shared core engine, compared field by field with a reference
+// recorded with the per-standard cores which the engine replaced (resources/core_equivalence).
+// The cores only read the timings set below. resources/core_equivalence/record.sh builds this test
+// against another commit and records the reference with its cores.
+namespace {
+
+const std::array<const char *, 22> referenceColumns = {
+    "seed", "timestamp", "idle", "rank", "bank",
+    "act", "pre", "reads", "writes", "refAllBank", "refPerBank", "refPerTwoBanks", "refDualBanks",
+    "refSameBank", "readAuto", "writeAuto",
+    "cycles.act", "cycles.pre", "cycles.powerDownAct", "cycles.powerDownPre", "cycles.selfRefresh",
+    "cycles.deepSleepMode",
+};
+
+using row_t = std::vector<std::string>;
+
+void appendStats(row_t &row, const command_stats_t &counter, const cycles_t &cycles)
+{
+    for (uint64_t value : {counter.act, counter.pre, counter.reads, counter.writes, counter.refAllBank,
+        counter.refPerBank, counter.refPerTwoBanks, counter.refDualBanks, counter.refSameBank, counter.readAuto,
+        counter.writeAuto, cycles.act, cycles.pre, cycles.powerDownAct, cycles.powerDownPre, cycles.selfRefresh,
+        cycles.deepSleepMode}) {
+        row.push_back(std::to_string(value));
+    }
+}
+
+// One row per rank with the counters summed over its banks and the rank cycles.
+// With banks one row per bank follows the rows of the ranks.
+template <typename Core>
+void appendWindow(std::vector<row_t> &rows, Core &core, uint32_t seed, timestamp_t timestamp, bool banks)
+{
+    SimulationStats stats;
+    core.getWindowStats(timestamp, stats);
+    const std::string idle = core.isIdle(timestamp) ? "1" : "0";
+    const std::size_t banksPerRank = stats.bank.size() / stats.rank_total.size();
+    for (std::size_t rank = 0; rank < stats.rank_total.size(); ++rank) {
+        command_stats_t counter;
+        for (std::size_t bank = 0; bank < banksPerRank; ++bank) {
+            counter += stats.bank[rank * banksPerRank + bank].counter;
+        }
+        rows.push_back({std::to_string(seed), std::to_string(timestamp), idle, std::to_string(rank), "all"});
+        appendStats(rows.back(), counter, stats.rank_total[rank].cycles);
+    }
+    for (std::size_t bank = 0; banks && bank < stats.bank.size(); ++bank) {
+        rows.push_back({std::to_string(seed), std::to_string(timestamp), idle, std::to_string(bank / banksPerRank),
+            std::to_string(bank % banksPerRank)});
+        appendStats(rows.back(), stats.bank[bank].counter, stats.bank[bank].cycles);
+    }
+}
+
+struct SequenceSpec {
+    std::vector<CmdType> commands; // Bank and rank commands besides power-down and self-refresh
+    std::size_t banks;
+    uint64_t tRFC;
+    bool deepSleepMode;
+};
+
+// Random command sequence of 2 ranks. Power-down, self-refresh and deep sleep are entered and left
+// in order with enough time in between, so that the entry is completed before the exit. All-bank
+// refreshes and self-refresh start with all banks precharged and no other refresh running, and no
+// command is issued during an all-bank refresh.
+template <typename Core, typename Cmd>
+void simulateRandomSequence(std::vector<row_t> &rows, Core &core, const SequenceSpec &spec, uint32_t seed, std::size_t length)
+{
+    std::mt19937 rng(seed);
+    timestamp_t timestamp = 0;
+    auto issue = [&core, &rng, &spec](timestamp_t timestamp, CmdType type, std::size_t rank) {
+        Cmd cmd(Command(timestamp, type, TargetCoordinate(rng() % spec.banks, rng() % 4, rank)));
+        if constexpr (std::is_same_v<Cmd, LPDDR6Command>) {
+            cmd.targetCoordinate.dbank = rng() % spec.banks;
+        }
+        core.doCommand(cmd);
+    };
+    // The pending auto-precharges and per-bank refreshes end within tRFC
+    auto precharge = [&issue, &timestamp, &spec](std::size_t rank) {
+        timestamp += spec.tRFC;
+        issue(timestamp, CmdType::PREA, rank);
+    };
+    for (std::size_t i = 0; i < length; ++i) {
+        timestamp += 1 + rng() % 40;
+        const std::size_t rank = rng() % 2;
+        switch (rng() % 10) {
+        case 8:
+            if (rng() % 2) {
+                issue(timestamp, CmdType::PDEA, rank);
+                timestamp += 100 + rng() % 100;
+                issue(timestamp, CmdType::PDXA, rank);
+            } else {
+                issue(timestamp, CmdType::PDEP, rank);
+                timestamp += 100 + rng() % 100;
+                issue(timestamp, CmdType::PDXP, rank);
+            }
+            break;
+        case 9:
+            precharge(rank);
+            issue(timestamp, CmdType::SREFEN, rank);
+            timestamp += spec.tRFC + 1 + rng() % 100;
+            if (spec.deepSleepMode && rng() % 2) {
+                issue(timestamp, CmdType::DSMEN, rank);
+                timestamp += 1 + rng() % 100;
+                issue(timestamp, CmdType::DSMEX, rank);
+                timestamp += 1 + rng() % 50;
+            }
+            issue(timestamp, CmdType::SREFEX, rank);
+            break;
+        default: {
+            const CmdType type = spec.commands[rng() % spec.commands.size()];
+            if (CmdType::REFA == type) {
+                precharge(rank);
+            }
+            issue(timestamp, type, rank);
+            if (CmdType::REFA == type) {
+                timestamp += spec.tRFC;
+            }
+            break;
+        }
+        }
+        if (0 == rng() % 10) {
+            appendWindow(rows, core, seed, timestamp, false);
+        }
+    }
+    appendWindow(rows, core, seed, timestamp + 1000, true);
+}
+
+// Rows of the random sequences of all seeds, the timings are drawn per seed
+template <typename Core, typename Cmd, typename MemSpec>
+std::vector<row_t> simulateStandard(MemSpec &memSpec, const SequenceSpec &spec)
+{
+    std::vector<row_t> rows;
+    for (uint32_t seed = 0; seed < 10; ++seed) {
+        std::mt19937 rng(seed);
+        memSpec.prechargeOffsetRD = 3 + rng() % 5;
+        memSpec.prechargeOffsetWR = 7 + rng() % 9;
+        memSpec.memTimingSpec.tRAS = 20 + rng() % 10;
+        memSpec.memTimingSpec.tRP = 8 + rng() % 6;
+        Core core(memSpec);
+        simulateRandomSequence<Core, Cmd>(rows, core, spec, seed, 300);
+    }
+    return rows;
+}
+
+const std::vector<CmdType> baseCommands{
+    CmdType::ACT, CmdType::ACT, CmdType::ACT, CmdType::PRE, CmdType::PREA,
+    CmdType::RD, CmdType::RDA, CmdType::WR, CmdType::WRA, CmdType::REFA,
+};
+
+std::vector<CmdType> withCommands(std::vector<CmdType> commands, std::initializer_list<CmdType> extra)
+{
+    commands.insert(commands.end(), extra);
+    return commands;
+}
+
+std::vector<row_t> simulate(MemSpecDDR4 &memSpec)
+{
+    memSpec.numberOfRanks = 2;
+    memSpec.numberOfBanks = 16;
+    memSpec.numberOfBankGroups = 4;
+    memSpec.memTimingSpec.tRFC = 50;
+    memSpec.memTimingSpec.tRCD = 9;
+    return simulateStandard<DDR4Core, Command>(memSpec, {baseCommands, 16, 50, false});
+}
+
+std::vector<row_t> simulate(MemSpecDDR5 &memSpec)
+{
+    memSpec.numberOfRanks = 2;
+    memSpec.numberOfBanks = 16;
+    memSpec.numberOfBankGroups = 4;
+    memSpec.banksPerGroup = 4;
+    memSpec.memTimingSpec.tRFC = 50;
+    memSpec.memTimingSpec.tRFCsb = 20;
+    memSpec.memTimingSpec.tRCD = 9;
+    return simulateStandard<DDR5Core, Command>(memSpec, {withCommands(baseCommands, {CmdType::REFSB, CmdType::PRESB}), 16, 50, false});
+}
+
+std::vector<row_t> simulate(MemSpecLPDDR4 &memSpec)
+{
+    memSpec.numberOfRanks = 2;
+    memSpec.numberOfBanks = 8;
+    memSpec.numberOfBankGroups = 1;
+    memSpec.memTimingSpec.tRFC = 50;
+    memSpec.memTimingSpec.tRFCPB = 20;
+    memSpec.memTimingSpec.tRCD = 9;
+    return simulateStandard<LPDDR4Core, Command>(memSpec, {withCommands(baseCommands, {CmdType::REFB}), 8, 50, false});
+}
+
+std::vector<row_t> simulate(MemSpecLPDDR5 &memSpec)
+{
+    memSpec.numberOfRanks = 2;
+    memSpec.numberOfBanks = 16;
+    memSpec.numberOfBankGroups = 4;
+    memSpec.banksPerGroup = 4;
+    memSpec.bank_arch = MemSpecLPDDR5::MBG;
+    memSpec.perTwoBankOffset = 8;
+    memSpec.memTimingSpec.tRFC = 50;
+    memSpec.memTimingSpec.tRFCPB = 20;
+    memSpec.memTimingSpec.tRCD = 9;
+    return simulateStandard<LPDDR5Core, Command>(memSpec, {withCommands(baseCommands, {CmdType::REFB, CmdType::REFP2B}), 16, 50, true});
+}
+
+std::vector<row_t> simulate(MemSpecLPDDR6 &memSpec)
+{
+    memSpec.numberOfRanks = 2;
+    memSpec.numberOfBanks = 16;
+    memSpec.numberOfBankGroups = 4;
+    memSpec.memTimingSpec.tRFCAB = 50;
+    memSpec.memTimingSpec.tRFCDB = 20;
+    memSpec.memTimingSpec.tRCDR = 9;
+    memSpec.memTimingSpec.tRCDW = 11;
+    return simulateStandard<LPDDR6Core, LPDDR6Command>(memSpec, {withCommands(baseCommands, {CmdType::REFDB}), 16, 50, false});
+}
+
+} // namespace
+
+class DramPowerTest_CoreEquivalence : public ::testing::Test {
+protected:
+    template <typename MemSpec>
+    MemSpec load(const char *file)
+    {
+        auto data = DRAMUtils::parse_memspec_from_file(std::filesystem::path(TEST_RESOURCE_DIR) / file);
+        return MemSpec::from_memspec(*data);
+    }
+
+    // Compares the rows with resources/core_equivalence/<name>.csv. With DRAMPOWER_CORE_EQUIVALENCE_RECORD
+    // set to a directory the rows are written to <directory>/<name>.csv instead.
+    void expectMatchesReference(const std::vector<row_t> &rows, const std::string &name)
+    {
+        if (const char *directory = std::getenv("DRAMPOWER_CORE_EQUIVALENCE_RECORD")) {
+            const std::filesystem::path path = std::filesystem::path(directory) / (name + ".csv");
+            std::ofstream file(path);
+            ASSERT_TRUE(file.is_open()) << "Cannot write " << path;
+            for (std::size_t i = 0; i < referenceColumns.size(); ++i) {
+                file << (0 == i ? "" : ",") << referenceColumns[i];
+            }
+            file << '\n';
+            for (const row_t &row : rows) {
+                for (std::size_t i = 0; i < row.size(); ++i) {
+                    file << (0 == i ? "" : ",") << row[i];
+                }
+                file << '\n';
+            }
+            GTEST_SKIP() << "Recorded " << path;
+        }
+
+        const std::filesystem::path path = std::filesystem::path(TEST_RESOURCE_DIR) / "core_equivalence" / (name + ".csv");
+        std::ifstream file(path);
+        ASSERT_TRUE(file.is_open()) << "Cannot read " << path;
+        std::vector<row_t> reference;
+        std::string line;
+        std::getline(file, line); // Header
+        while (std::getline(file, line)) {
+            row_t &row = reference.emplace_back();
+            std::istringstream cells(line);
+            for (std::string cell; std::getline(cells, cell, ',');) {
+                row.push_back(cell);
+            }
+        }
+
+        ASSERT_EQ(rows.size(), reference.size()) << "Different number of rows than " << path;
+        // Report the first differences with the window and the field
+        std::size_t failures = 0;
+        for (std::size_t i = 0; i < rows.size() && failures < 10; ++i) {
+            ASSERT_EQ(rows[i].size(), reference[i].size()) << path << " row " << i + 2;
+            for (std::size_t column = 0; column < rows[i].size() && failures < 10; ++column) {
+                if (rows[i][column] != reference[i][column]) {
+                    ADD_FAILURE() << name << " seed " << reference[i][0] << " at " << reference[i][1]
+                        << ", rank " << reference[i][3] << ", bank " << reference[i][4] << ": "
+                        << referenceColumns[column] << " is " << rows[i][column]
+                        << ", the reference " << reference[i][column] << " (" << path << " row " << i + 2 << ")";
+                    ++failures;
+                }
+            }
+        }
+    }
+};
+
+TEST_F(DramPowerTest_CoreEquivalence, Test_DDR4)
+{
+    MemSpecDDR4 memSpec = load<MemSpecDDR4>("ddr4.json");
+    expectMatchesReference(simulate(memSpec), "ddr4");
+}
+
+TEST_F(DramPowerTest_CoreEquivalence, Test_DDR5)
+{
+    MemSpecDDR5 memSpec = load<MemSpecDDR5>("ddr5.json");
+    expectMatchesReference(simulate(memSpec), "ddr5");
+}
+
+TEST_F(DramPowerTest_CoreEquivalence, Test_LPDDR4)
+{
+    MemSpecLPDDR4 memSpec = load<MemSpecLPDDR4>("lpddr4.json");
+    expectMatchesReference(simulate(memSpec), "lpddr4");
+}
+
+TEST_F(DramPowerTest_CoreEquivalence, Test_LPDDR5)
+{
+    MemSpecLPDDR5 memSpec = load<MemSpecLPDDR5>("lpddr5.json");
+    expectMatchesReference(simulate(memSpec), "lpddr5");
+}
+
+TEST_F(DramPowerTest_CoreEquivalence, Test_LPDDR6)
+{
+    MemSpecLPDDR6 memSpec = load<MemSpecLPDDR6>("lpddr6.json");
+    expectMatchesReference(simulate(memSpec), "lpddr6");
+}
@@ -0,0 +1,152 @@
+#include <gtest/gtest.h>
+
+#include <DRAMPower/Exceptions.h>
+#include <DRAMPower/command/Command.h>
+#include <DRAMPower/util/delta_checkpoint.h>
+
+#include <DRAMPower/standards/ddr4/DDR4.h>
+#include <DRAMPower/standards/lpddr4/LPDDR4.h>
+
+#include <DRAMUtils/memspec/MemSpec.h>
+
+#include <array>
+#include <filesystem>
+#include <memory>
+#include <sstream>
+#include <vector>
+
+using namespace DRAMPower;
+
+class DramPowerTest_DeltaCheckpoint : public ::testing::Test {
+protected:
+    using data_t = std::array<uint8_t, 8>;
+
+    std::vector<data_t> m_data;
+    std::vector<Command> m_commands;
+    std::unique_ptr<MemSpecDDR4> m_memSpecDDR4;
+    std::unique_ptr<MemSpecLPDDR4> m_memSpecLPDDR4;
+
+    virtual void SetUp()
+    {
+        auto ddr4 = DRAMUtils::parse_memspec_from_file(std::filesystem::path(TEST_RESOURCE_DIR) / "ddr4.json");
+        m_memSpecDDR4 = std::make_unique<MemSpecDDR4>(MemSpecDDR4::from_memspec(*ddr4));
+        m_memSpecDDR4->numberOfRanks = 2;
+        auto lpddr4 = DRAMUtils::parse_memspec_from_file(std::filesystem::path(TEST_RESOURCE_DIR) / "lpddr4.json");
+        m_memSpecLPDDR4 = std::make_unique<MemSpecLPDDR4>(MemSpecLPDDR4::from_memspec(*lpddr4));
+        m_memSpecLPDDR4->numberOfRanks = 2;
+
+        constexpr std::size_t iterations = 60;
+        m_data.resize(iterations);
+        for (std::size_t i = 0; i < iterations; ++i) {
+            const timestamp_t t = i * 100;
+            const std::size_t bank = i % 4;
+            const std::size_t rank = (i / 4) % 2;
+            for (std::size_t b = 0; b < 8; ++b) {
+                m_data[i][b] = static_cast<uint8_t>(i * 11 + b * 37);
+            }
+            m_commands.push_back({t, CmdType::ACT, {bank, 0, rank}});
+            m_commands.push_back({t + 20, CmdType::WR, {bank, 0, rank, 0, 16}, m_data[i].data(), 64});
+            m_commands.push_back({t + 40, CmdType::RD, {bank, 0, rank, 0, 16}, m_data[i].data(), 64});
+            m_commands.push_back({t + 80, CmdType::PRE, {bank, 0, rank}});
+        }
+    }
+
+    // Writes a base after the first segment and a delta after every further segment.
+    // A second instance restores the chain and is compared at every checkpoint.
+    template <typename DRAM, typename MemSpec>
+    void expectChainRestores(const MemSpec &memSpec, std::size_t segmentLength)
+    {
+        DRAM reference(memSpec);
+        DRAM restored(memSpec);
+        std::size_t checkpoints = 0;
+        std::size_t restoredCommands = 0;
+        for (std::size_t i = 0; i < m_commands.size(); ++i) {
+            reference.doCommand(m_commands[i]);
+            if (0 != (i + 1) % segmentLength) {
+                continue;
+            }
+            std::stringstream stream;
+            if (0 == checkpoints) {
+                reference.serializeBase(stream);
+                restored.deserialize(stream);
+            } else {
+                reference.serializeDelta(stream);
+                restored.deserializeDelta(stream);
+            }
+            ++checkpoints;
+            restoredCommands = i + 1;
+            const timestamp_t timestamp = m_commands[i].timestamp;
+            ASSERT_EQ(restored.getLastCommandTime(), timestamp);
+            ASSERT_EQ(restored.getWindowStats(timestamp), reference.getWindowStats(timestamp));
+        }
+        ASSERT_GT(checkpoints, 2u);
+
+        // The restored instance continues like the reference
+        for (std::size_t i = restoredCommands; i < m_commands.size(); ++i) {
+            restored.doCommand(m_commands[i]);
+        }
+        const timestamp_t end = m_commands.back().timestamp + 1000;
+        reference.doCommand({end, CmdType::END_OF_SIMULATION});
+        restored.doCommand({end, CmdType::END_OF_SIMULATION});
+        ASSERT_EQ(restored.getWindowStats(end), reference.getWindowStats(end));
+        ASSERT_EQ(restored.getTotalEnergy(end), reference.getTotalEnergy(end));
+    }
+};
+
+TEST_F(DramPowerTest_DeltaCheckpoint, DDR4)
+{
+    expectChainRestores<DDR4>(*m_memSpecDDR4, 12);
+}
+
+TEST_F(DramPowerTest_DeltaCheckpoint, LPDDR4)
+{
+    expectChainRestores<LPDDR4>(*m_memSpecLPDDR4, 9);
+}
+
+TEST_F(DramPowerTest_DeltaCheckpoint, DeltaIsSmallerThanBase)
+{
+    DDR4 dram(*m_memSpecDDR4);
+    std::stringstream base;
+    dram.serializeBase(base);
+
+    dram.doCommand({100, CmdType::ACT, {0, 0, 0}});
+    dram.doCommand({200, CmdType::PRE, {0, 0, 0}});
+    std::stringstream delta;
+    dram.serializeDelta(delta);
+    EXPECT_LT(delta.str().size(), base.str().size());
+
+    // Without commands only the small interface state is written
+    std::stringstream empty;
+    dram.serializeDelta(empty);
+    EXPECT_LT(empty.str().size(), delta.str().size());
+}
+
+TEST_F(DramPowerTest_DeltaCheckpoint, PendingImplicitCommands)
+{
+    DDR4 dram(*m_memSpecDDR4);
+    dram.doCommand({0, CmdType::ACT, {0, 0, 0}});
+    dram.doCommand({20, CmdType::RDA, {0, 0, 0, 0, 16}, m_data[0].data(), 64});
+    std::stringstream stream;
+    ASSERT_THROW(dram.serializeBase(stream), Exception);
+    ASSERT_THROW(dram.serializeDelta(stream), Exception);
+}
+
+TEST_F(DramPowerTest_DeltaCheckpoint, Tracker)
+{
+    util::RankDeltaTracker tracker(2, 4);
+    std::vector<Rank> ranks(2, Rank(4));
+    std::stringstream all;
+    tracker.serializeDelta(all, ranks);
+
+    tracker.markCommand(Command{0, CmdType::ACT, {1, 0, 1}});
+    std::stringstream single;
+    tracker.serializeDelta(single, ranks);
+    EXPECT_LT(single.str().size(), all.str().size());
+
+    // Out of range targets are ignored
+    tracker.markCommand(Command{0, CmdType::ACT, {7, 0, 1}});
+    tracker.markCommand(Command{0, CmdType::REFA, {0, 0, 5}});
+    std::stringstream none;
+    tracker.serializeDelta(none, ranks);
+    EXPECT_EQ(none.str().size(), 2 * sizeof(uint64_t));
+}
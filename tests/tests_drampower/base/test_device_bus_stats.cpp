@@ -0,0 +1,237 @@
+#include <gtest/gtest.h>
+
+#include <DRAMPower/command/Command.h>
+#include <DRAMPower/util/bus.h>
+#include <DRAMPower/util/device_stats.h>
+#include <DRAMPower/util/pin_group.h>
+
+#include <DRAMPower/standards/ddr4/DDR4.h>
+#include <DRAMPower/standards/ddr5/DDR5.h>
+#include <DRAMPower/standards/lpddr4/LPDDR4.h>
+#include <DRAMPower/standards/lpddr5/LPDDR5.h>
+#include <DRAMPower/standards/lpddr6/LPDDR6.h>
+
+#include <DRAMUtils/memspec/MemSpec.h>
+
+#include <cmath>
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+
+using namespace DRAMPower;
+
+class DramPowerTest_DeviceBusStats : public ::testing::Test {
+protected:
+    std::vector<uint8_t> m_data;
+
+    virtual void SetUp()
+    {
+        m_data.resize(1024);
+        for (std::size_t i = 0; i < m_data.size(); ++i) {
+            m_data[i] = static_cast<uint8_t>(i * 29 + 7 + (i >> 3));
+        }
+    }
+
+    // Lane lane of every burst of data as separate bus data
+    static std::vector<uint8_t> slice(const uint8_t *data, std::size_t width, std::size_t laneWidth, std::size_t lane, std::size_t bursts)
+    {
+        std::vector<uint8_t> result((bursts * laneWidth + 7) / 8, 0);
+        for (std::size_t burst = 0; burst < bursts; ++burst) {
+            for (std::size_t bit = 0; bit < laneWidth; ++bit) {
+                const std::size_t src = burst * width + lane * laneWidth + bit;
+                const std::size_t dst = burst * laneWidth + bit;
+                if ((data[src / 8] >> (src % 8)) & 1) {
+                    result[dst / 8] |= static_cast<uint8_t>(1 << (dst % 8));
+                }
+            }
+        }
+        return result;
+    }
+
+    // The stats of every lane equal the stats of a bus of the lane width with the lane data
+    void expectLanesMatchSeparateBuses(std::size_t width, std::size_t laneWidth, util::BusIdlePatternSpec idle)
+    {
+        const std::size_t bursts = 8;
+        const std::vector<timestamp_t> loads = {3, 11, 15, 40};
+        util::Bus bus(width, 2, idle, true, laneWidth);
+        std::vector<util::Bus> lanes;
+        for (std::size_t lane = 0; lane < width / laneWidth; ++lane) {
+            lanes.emplace_back(laneWidth, 2, idle);
+        }
+        const auto expectEqualAt = [&bus, &lanes](timestamp_t t) {
+            const std::vector<util::bus_stats_t> stats = bus.get_lane_stats(t);
+            ASSERT_EQ(stats.size(), lanes.size());
+            util::bus_stats_t total;
+            for (std::size_t lane = 0; lane < lanes.size(); ++lane) {
+                EXPECT_EQ(stats[lane], lanes[lane].get_stats(t)) << "lane " << lane << " at " << t;
+                total += stats[lane];
+            }
+            EXPECT_EQ(total, bus.get_stats(t));
+        };
+        for (std::size_t i = 0; i < loads.size(); ++i) {
+            const uint8_t *data = m_data.data() + i * 16;
+            bus.load(loads[i], data, width * bursts);
+            for (std::size_t lane = 0; lane < lanes.size(); ++lane) {
+                const std::vector<uint8_t> sliced = slice(data, width, laneWidth, lane, bursts);
+                lanes[lane].load(loads[i], sliced.data(), laneWidth * bursts);
+            }
+            // Within the burst, at its end and after it
+            for (timestamp_t t : {loads[i], loads[i] + 1, loads[i] + 4}) {
+                expectEqualAt(t);
+            }
+        }
+        expectEqualAt(100);
+    }
+
+    template <typename Standard, typename MemSpec>
+    void expectDevicesSumToBus(MemSpec memSpec, bool dbi, std::size_t devices = 4, std::size_t n_bits = 0)
+    {
+        memSpec.numberOfDevices = devices;
+        config::SimConfig simConfig;
+        simConfig.deviceBusStats = true;
+        Standard dram(memSpec, simConfig);
+        Standard reference(memSpec);
+        if (dbi) {
+            dram.getExtensionManager().template withExtension<extensions::DBI>([](extensions::DBI &ext) {
+                ext.enable(0, true);
+            });
+        }
+
+        if (0 == n_bits) {
+            n_bits = memSpec.bitWidth * memSpec.numberOfDevices * memSpec.burstLength;
+        }
+        ASSERT_LE(n_bits / 8 + 48, m_data.size());
+        const uint8_t *data = m_data.data();
+        const std::vector<Command> commands = {
+            {  0, CmdType::ACT, {0, 0, 0}},
+            { 30, CmdType::RD,  {0, 0, 0, 0, 16}, data, n_bits},
+            { 45, CmdType::WR,  {0, 0, 0, 0, 16}, data + 16, n_bits},
+            { 70, CmdType::RD,  {0, 0, 0, 0, 16}, data + 32, n_bits},
+            { 90, CmdType::WR,  {0, 0, 0, 0, 16}, data + 48, n_bits},
+            {120, CmdType::PRE, {0, 0, 0}},
+            {200, CmdType::END_OF_SIMULATION},
+        };
+        for (const Command &command : commands) {
+            dram.doCommand(command);
+            if (!dbi) {
+                reference.doCommand(command);
+            }
+        }
+
+        const SimulationStats stats = dram.getWindowStats(200);
+        ASSERT_EQ(stats.devices.size(), memSpec.numberOfDevices);
+        DeviceStats total;
+        for (const DeviceStats &device : stats.devices) {
+            total += device;
+        }
+        EXPECT_EQ(total.readBus, stats.readBus);
+        EXPECT_EQ(total.writeBus, stats.writeBus);
+        EXPECT_GT(total.readBus.bit_changes, 0u);
+        EXPECT_GT(total.writeBus.bit_changes, 0u);
+        if (dbi) {
+            EXPECT_GT(total.readDBI.zeroes + total.writeDBI.zeroes, 0u);
+            EXPECT_EQ(total.readDBI, stats.readDBI);
+            EXPECT_EQ(total.writeDBI, stats.writeDBI);
+        } else {
+            // The device stats don't change the simulation
+            SimulationStats referenceStats = reference.getWindowStats(200);
+            referenceStats.devices = stats.devices;
+            EXPECT_EQ(stats, referenceStats);
+        }
+
+        // The interface energy is linear in the stats, the device energy sums to the data bus energy
+        SimulationStats busStats;
+        busStats.readBus = stats.readBus;
+        busStats.writeBus = stats.writeBus;
+        busStats.readDBI = stats.readDBI;
+        busStats.writeDBI = stats.writeDBI;
+        const double expected = dram.calcInterfaceEnergyStats(busStats).total();
+        double energy = 0.0;
+        for (const interface_energy_info_t &device : dram.calcDeviceInterfaceEnergy(200)) {
+            energy += device.total();
+        }
+        EXPECT_NEAR(energy, expected, 1e-9 * expected);
+    }
+
+    template <typename MemSpec>
+    MemSpec load(const char *file)
+    {
+        auto data = DRAMUtils::parse_memspec_from_file(std::filesystem::path(TEST_RESOURCE_DIR) / file);
+        return MemSpec::from_memspec(*data);
+    }
+};
+
+TEST_F(DramPowerTest_DeviceBusStats, LanesWordParallel)
+{
+    expectLanesMatchSeparateBuses(64, 8, util::BusIdlePatternSpec::L);
+    expectLanesMatchSeparateBuses(32, 4, util::BusIdlePatternSpec::H);
+    expectLanesMatchSeparateBuses(64, 16, util::BusIdlePatternSpec::H);
+    expectLanesMatchSeparateBuses(64, 64, util::BusIdlePatternSpec::L);
+}
+
+TEST_F(DramPowerTest_DeviceBusStats, LanesMasked)
+{
+    expectLanesMatchSeparateBuses(48, 12, util::BusIdlePatternSpec::L);
+    expectLanesMatchSeparateBuses(48, 12, util::BusIdlePatternSpec::H);
+    expectLanesMatchSeparateBuses(9, 1, util::BusIdlePatternSpec::L);
+}
+
+TEST_F(DramPowerTest_DeviceBusStats, InvalidLaneWidth)
+{
+    EXPECT_THROW((util::Bus(48, 1, util::BusIdlePatternSpec::L, true, 10)), Exception);
+}
+
+TEST_F(DramPowerTest_DeviceBusStats, DBIPinsPerDevice)
+{
+    // Up to all 64 pins of a group belong to one device
+    util::PinGroup<8> dbi(64, util::PinState::L, util::PinState::L);
+    dbi.set(3, 0x00FF00FF0F0F3C3Cull, 2);
+    dbi.set(4, 0xFFFF0000FFFF0000ull, 2);
+    for (std::size_t count : {1, 2, 8, 64}) {
+        std::vector<DeviceStats> devices(count);
+        util::addDeviceDBIStats(dbi, dbi, 20, 2, devices);
+        util::bus_stats_t total;
+        for (const DeviceStats &device : devices) {
+            total += device.readDBI;
+        }
+        EXPECT_GT(total.ones, 0u);
+        EXPECT_EQ(total, dbi.get_stats_at(20, 2)) << "devices: " << count;
+    }
+}
+
+TEST_F(DramPowerTest_DeviceBusStats, DisabledByDefault)
+{
+    DDR4 dram(load<MemSpecDDR4>("ddr4.json"));
+    dram.doCommand({0, CmdType::ACT, {0, 0, 0}});
+    dram.doCommand({30, CmdType::RD, {0, 0, 0, 0, 16}, m_data.data(), 64});
+    EXPECT_TRUE(dram.getWindowStats(100).devices.empty());
+    EXPECT_TRUE(dram.calcDeviceInterfaceEnergy(100).empty());
+}
+
+TEST_F(DramPowerTest_DeviceBusStats, DDR4)
+{
+    expectDevicesSumToBus<DDR4>(load<MemSpecDDR4>("ddr4.json"), false);
+}
+
+TEST_F(DramPowerTest_DeviceBusStats, DDR5)
+{
+    expectDevicesSumToBus<DDR5>(load<MemSpecDDR5>("ddr5.json"), false);
+}
+
+TEST_F(DramPowerTest_DeviceBusStats, LPDDR4)
+{
+    expectDevicesSumToBus<LPDDR4>(load<MemSpecLPDDR4>("lpddr4.json"), false);
+    expectDevicesSumToBus<LPDDR4>(load<MemSpecLPDDR4>("lpddr4.json"), true);
+}
+
+TEST_F(DramPowerTest_DeviceBusStats, LPDDR5)
+{
+    expectDevicesSumToBus<LPDDR5>(load<MemSpecLPDDR5>("lpddr5.json"), false);
+    expectDevicesSumToBus<LPDDR5>(load<MemSpecLPDDR5>("lpddr5.json"), true);
+}
+
+TEST_F(DramPowerTest_DeviceBusStats, LPDDR6)
+{
+    // The LPDDR6 burst format has a fixed width, x12 lanes of several devices are covered by LanesMasked
+    expectDevicesSumToBus<LPDDR6>(load<MemSpecLPDDR6>("lpddr6.json"), false, 1, 256);
+}
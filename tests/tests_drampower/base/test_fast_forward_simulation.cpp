@@ -0,0 +1,173 @@
+#include <gtest/gtest.h>
+
+#include <DRAMPower/command/Command.h>
+#include <DRAMPower/util/FastForwardSimulation.h>
+
+#include <DRAMPower/standards/ddr4/DDR4.h>
+#include <DRAMPower/standards/lpddr4/LPDDR4.h>
+
+#include <DRAMUtils/memspec/MemSpec.h>
+
+#include <array>
+#include <filesystem>
+#include <memory>
+#include <vector>
+
+using namespace DRAMPower;
+
+class DramPowerTest_FastForwardSimulation : public ::testing::Test {
+protected:
+    std::array<uint8_t, 8> m_data = {0x01, 0x23, 0x45, 0x67, 0x89, 0xAB, 0xCD, 0xEF};
+    std::unique_ptr<MemSpecDDR4> m_memSpecDDR4;
+    std::unique_ptr<MemSpecLPDDR4> m_memSpecLPDDR4;
+
+    virtual void SetUp()
+    {
+        auto ddr4 = DRAMUtils::parse_memspec_from_file(std::filesystem::path(TEST_RESOURCE_DIR) / "ddr4.json");
+        m_memSpecDDR4 = std::make_unique<MemSpecDDR4>(MemSpecDDR4::from_memspec(*ddr4));
+        auto lpddr4 = DRAMUtils::parse_memspec_from_file(std::filesystem::path(TEST_RESOURCE_DIR) / "lpddr4.json");
+        m_memSpecLPDDR4 = std::make_unique<MemSpecLPDDR4>(MemSpecLPDDR4::from_memspec(*lpddr4));
+    }
+
+    void addTraffic(std::vector<Command> &commands, timestamp_t t)
+    {
+        commands.push_back({t, CmdType::ACT, {0, 0, 0}});
+        commands.push_back({t + 20, CmdType::WR, {0, 0, 0, 0, 8}, m_data.data(), 64});
+        commands.push_back({t + 40, CmdType::RD, {0, 0, 0, 0, 8}, m_data.data(), 64});
+        commands.push_back({t + 80, CmdType::PRE, {0, 0, 0}});
+    }
+
+    template <typename DRAM>
+    void expectIdentical(DRAM &fastForwarded, DRAM &reference, const std::vector<Command> &commands)
+    {
+        FastForwardSimulation<DRAM> simulation(fastForwarded);
+        for (const Command &command : commands) {
+            simulation.doCommand(command);
+            reference.doCommand(command);
+        }
+        const timestamp_t end = commands.back().timestamp;
+        EXPECT_EQ(simulation.getLastCommandTime(), end);
+        EXPECT_EQ(simulation.getWindowStats(end), reference.getWindowStats(end));
+        EXPECT_DOUBLE_EQ(simulation.getTotalEnergy(end), reference.getTotalEnergy(end));
+        m_skippedPeriods = simulation.getSkippedPeriods();
+    }
+
+    uint64_t m_skippedPeriods = 0;
+};
+
+TEST_F(DramPowerTest_FastForwardSimulation, PeriodicRefresh)
+{
+    std::vector<Command> commands;
+    addTraffic(commands, 0);
+    timestamp_t t = 1000;
+    for (std::size_t i = 0; i < 1000; ++i, t += 6000) {
+        commands.push_back({t, CmdType::REFA, {0, 0, 0}});
+    }
+    addTraffic(commands, t);
+    t += 1000;
+    for (std::size_t i = 0; i < 500; ++i, t += 6000) {
+        commands.push_back({t, CmdType::REFA, {0, 0, 0}});
+    }
+    commands.push_back({t, CmdType::END_OF_SIMULATION});
+
+    DDR4 fastForwarded(*m_memSpecDDR4);
+    DDR4 reference(*m_memSpecDDR4);
+    expectIdentical(fastForwarded, reference, commands);
+    // Detection and confirmation take four periods per stretch
+    EXPECT_EQ(m_skippedPeriods, 1000u - 4u + 500u - 4u);
+}
+
+TEST_F(DramPowerTest_FastForwardSimulation, PowerDownAndRefresh)
+{
+    std::vector<Command> commands;
+    addTraffic(commands, 0);
+    timestamp_t t = 1000;
+    for (std::size_t i = 0; i < 200; ++i, t += 8000) {
+        commands.push_back({t, CmdType::REFA, {0, 0, 0}});
+        commands.push_back({t + 500, CmdType::PDEP, {0, 0, 0}});
+        commands.push_back({t + 7000, CmdType::PDXP, {0, 0, 0}});
+    }
+    commands.push_back({t, CmdType::SREFEN, {0, 0, 0}});
+    commands.push_back({t + 100000, CmdType::SREFEX, {0, 0, 0}});
+    addTraffic(commands, t + 101000);
+    commands.push_back({t + 102000, CmdType::END_OF_SIMULATION});
+
+    DDR4 fastForwarded(*m_memSpecDDR4);
+    DDR4 reference(*m_memSpecDDR4);
+    expectIdentical(fastForwarded, reference, commands);
+    EXPECT_GT(m_skippedPeriods, 190u);
+}
+
+TEST_F(DramPowerTest_FastForwardSimulation, PerBankRefresh)
+{
+    std::vector<Command> commands;
+    timestamp_t t = 0;
+    for (std::size_t i = 0; i < 400; ++i, t += 1000) {
+        commands.push_back({t, CmdType::REFB, {i % 8, 0, 0}});
+    }
+    addTraffic(commands, t);
+    commands.push_back({t + 1000, CmdType::END_OF_SIMULATION});
+
+    LPDDR4 fastForwarded(*m_memSpecLPDDR4);
+    LPDDR4 reference(*m_memSpecLPDDR4);
+    expectIdentical(fastForwarded, reference, commands);
+    EXPECT_GT(m_skippedPeriods, 40u);
+}
+
+TEST_F(DramPowerTest_FastForwardSimulation, DeviationInsidePeriod)
+{
+    std::vector<Command> commands;
+    timestamp_t t = 0;
+    for (std::size_t i = 0; i < 100; ++i, t += 8000) {
+        commands.push_back({t, CmdType::REFA, {0, 0, 0}});
+        commands.push_back({t + 500, CmdType::PDEP, {0, 0, 0}});
+        commands.push_back({t + 7000, CmdType::PDXP, {0, 0, 0}});
+    }
+    // Period interrupted after its first command and traffic before the period ends
+    commands.push_back({t, CmdType::REFA, {0, 0, 0}});
+    addTraffic(commands, t + 1000);
+    // Power down exits earlier than in the pattern
+    t += 8000;
+    for (std::size_t i = 0; i < 100; ++i, t += 8000) {
+        commands.push_back({t, CmdType::REFA, {0, 0, 0}});
+        commands.push_back({t + 500, CmdType::PDEP, {0, 0, 0}});
+        commands.push_back({t + 7000, CmdType::PDXP, {0, 0, 0}});
+    }
+    commands.push_back({t, CmdType::REFA, {0, 0, 0}});
+    commands.push_back({t + 500, CmdType::PDEP, {0, 0, 0}});
+    commands.push_back({t + 6000, CmdType::PDXP, {0, 0, 0}});
+    commands.push_back({t + 8000, CmdType::END_OF_SIMULATION});
+
+    DDR4 fastForwarded(*m_memSpecDDR4);
+    DDR4 reference(*m_memSpecDDR4);
+    expectIdentical(fastForwarded, reference, commands);
+    EXPECT_GT(m_skippedPeriods, 180u);
+}
+
+TEST_F(DramPowerTest_FastForwardSimulation, SkipUntil)
+{
+    constexpr timestamp_t period = 6000;
+    constexpr std::size_t periods = 10000;
+
+    DDR4 fastForwarded(*m_memSpecDDR4);
+    DDR4 reference(*m_memSpecDDR4);
+    FastForwardSimulation<DDR4> simulation(fastForwarded);
+
+    // Not confirmed yet
+    ASSERT_EQ(simulation.skipUntil(period), 0u);
+    for (std::size_t i = 0; i < periods; ++i) {
+        const Command command{i * period, CmdType::REFA, {0, 0, 0}};
+        if (i < 5) {
+            simulation.doCommand(command);
+        }
+        reference.doCommand(command);
+    }
+    // The first skipped period already started, the rest is skipped analytically
+    ASSERT_EQ(simulation.skipUntil(periods * period), periods - 5 + 1);
+
+    const Command end{periods * period, CmdType::END_OF_SIMULATION};
+    simulation.doCommand(end);
+    reference.doCommand(end);
+    ASSERT_EQ(simulation.getWindowStats(end.timestamp), reference.getWindowStats(end.timestamp));
+    ASSERT_EQ(simulation.getSkippedTime(), (periods - 4) * period);
+}
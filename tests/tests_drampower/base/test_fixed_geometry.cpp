@@ -0,0 +1,137 @@
+#include <gtest/gtest.h>
+
+#include <DRAMPower/Exceptions.h>
+#include <DRAMPower/command/Command.h>
+#include <DRAMPower/dram/Geometry.h>
+
+#include <DRAMPower/standards/ddr4/DDR4.h>
+#include <DRAMPower/standards/ddr5/DDR5.h>
+#include <DRAMPower/standards/lpddr4/LPDDR4.h>
+#include <DRAMPower/standards/lpddr5/LPDDR5.h>
+
+#include <DRAMUtils/memspec/MemSpec.h>
+
+#include <array>
+#include <filesystem>
+#include <memory>
+#include <vector>
+
+using namespace DRAMPower;
+
+class DramPowerTest_FixedGeometry : public ::testing::Test {
+protected:
+    std::array<uint8_t, 32> m_data{};
+    std::vector<Command> m_trace;
+
+    virtual void SetUp()
+    {
+        for (std::size_t i = 0; i < m_data.size(); ++i) {
+            m_data[i] = static_cast<uint8_t>(i * 29 + 7);
+        }
+        const uint8_t *data = m_data.data();
+        m_trace = {
+            {   0, CmdType::ACT,  {0, 0, 0}},
+            {  10, CmdType::ACT,  {7, 1, 1}},
+            {  20, CmdType::RD,   {0, 0, 0, 0, 16}, data, 64},
+            {  30, CmdType::WRA,  {7, 1, 1, 0, 16}, data + 8, 64},
+            {  40, CmdType::PRE,  {0, 0, 0}},
+            { 100, CmdType::PDEP, {0, 0, 0}},
+            { 120, CmdType::REFA, {0, 0, 1}},
+            { 200, CmdType::PDXP, {0, 0, 0}},
+            { 220, CmdType::ACT,  {3, 0, 0}},
+            { 240, CmdType::RDA,  {3, 0, 0, 0, 16}, data + 16, 64},
+            { 300, CmdType::SREFEN, {0, 0, 1}},
+            { 500, CmdType::SREFEX, {0, 0, 1}},
+            { 600, CmdType::END_OF_SIMULATION},
+        };
+    }
+
+    template <typename MemSpec>
+    MemSpec load(const char *file)
+    {
+        auto data = DRAMUtils::parse_memspec_from_file(std::filesystem::path(TEST_RESOURCE_DIR) / file);
+        MemSpec memSpec = MemSpec::from_memspec(*data);
+        memSpec.numberOfRanks = 2;
+        return memSpec;
+    }
+
+    // The fixed geometry core computes the same stats as the core sized at runtime
+    template <typename Fixed, typename Dynamic, typename MemSpec>
+    void expectSameStats(const MemSpec &memSpec)
+    {
+        Fixed fixed(memSpec);
+        Dynamic dynamic(memSpec);
+        for (const Command &command : m_trace) {
+            fixed.doCommand(command);
+            dynamic.doCommand(command);
+        }
+        const timestamp_t end = m_trace.back().timestamp;
+        const SimulationStats stats = fixed.getWindowStats(end);
+        const SimulationStats expected = dynamic.getWindowStats(end);
+        EXPECT_EQ(stats.bank.size(), expected.bank.size());
+        EXPECT_TRUE(stats == expected);
+        EXPECT_DOUBLE_EQ(fixed.getTotalEnergy(end), dynamic.getTotalEnergy(end));
+    }
+};
+
+TEST_F(DramPowerTest_FixedGeometry, DispatchGeometry)
+{
+    using List = GeometryList<FixedGeometry<1, 16, 4>, FixedGeometry<2, 16, 4>>;
+    auto fixed = [](auto geometry) { return decltype(geometry)::isFixed ? decltype(geometry)::ranks(0) : 0; };
+    EXPECT_EQ(dispatchGeometry(List{}, 1, 16, 4, fixed), 1u);
+    EXPECT_EQ(dispatchGeometry(List{}, 2, 16, 4, fixed), 2u);
+    EXPECT_EQ(dispatchGeometry(List{}, 2, 16, 2, fixed), 0u);
+    EXPECT_EQ(dispatchGeometry(List{}, 4, 16, 4, fixed), 0u);
+}
+
+TEST_F(DramPowerTest_FixedGeometry, MismatchThrows)
+{
+    MemSpecDDR4 memSpec = load<MemSpecDDR4>("ddr4.json");
+    memSpec.numberOfBankGroups = 2;
+    EXPECT_THROW((BasicDDR4Core<FixedGeometry<2, 16, 4>>(memSpec)), Exception);
+}
+
+TEST_F(DramPowerTest_FixedGeometry, Test_DDR4)
+{
+    MemSpecDDR4 memSpec = load<MemSpecDDR4>("ddr4.json");
+    memSpec.numberOfBankGroups = 4;
+    expectSameStats<BasicDDR4<FixedGeometry<2, 16, 4>>, DDR4>(memSpec);
+}
+
+TEST_F(DramPowerTest_FixedGeometry, Test_LPDDR4)
+{
+    MemSpecLPDDR4 memSpec = load<MemSpecLPDDR4>("lpddr4.json");
+    memSpec.numberOfBanks = 8;
+    expectSameStats<BasicLPDDR4<FixedGeometry<2, 8, 1>>, LPDDR4>(memSpec);
+}
+
+TEST_F(DramPowerTest_FixedGeometry, Test_DDR5)
+{
+    MemSpecDDR5 memSpec = load<MemSpecDDR5>("ddr5.json");
+    memSpec.numberOfBankGroups = 4;
+    memSpec.banksPerGroup = 4;
+    expectSameStats<BasicDDR5<FixedGeometry<2, 16, 4>>, DDR5>(memSpec);
+}
+
+TEST_F(DramPowerTest_FixedGeometry, Test_LPDDR5)
+{
+    MemSpecLPDDR5 memSpec = load<MemSpecLPDDR5>("lpddr5.json");
+    memSpec.numberOfBankGroups = 4;
+    memSpec.banksPerGroup = 4;
+    memSpec.bank_arch = MemSpecLPDDR5::MBG;
+    expectSameStats<BasicLPDDR5<FixedGeometry<2, 16, 4>>, LPDDR5>(memSpec);
+}
+
+TEST_F(DramPowerTest_FixedGeometry, FactorySelectsGeometry)
+{
+    MemSpecDDR4 memSpec = load<MemSpecDDR4>("ddr4.json");
+    memSpec.numberOfBankGroups = 4;
+    std::unique_ptr<dram_base<CmdType>> fixed = makeDRAM(memSpec);
+    using FixedDDR4 = BasicDDR4<FixedGeometry<2, 16, 4>>;
+    EXPECT_NE(dynamic_cast<FixedDDR4 *>(fixed.get()), nullptr);
+
+    // No fixed geometry with 4 ranks
+    memSpec.numberOfRanks = 4;
+    std::unique_ptr<dram_base<CmdType>> dynamic = makeDRAM(memSpec);
+    EXPECT_NE(dynamic_cast<DDR4 *>(dynamic.get()), nullptr);
+}
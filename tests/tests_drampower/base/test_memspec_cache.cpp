@@ -0,0 +1,167 @@
+#include <gtest/gtest.h>
+
+#include <DRAMPower/command/Command.h>
+#include <DRAMPower/memspec/MemSpecCache.h>
+
+#include <DRAMPower/standards/ddr4/DDR4.h>
+#include <DRAMPower/standards/ddr5/DDR5.h>
+#include <DRAMPower/standards/lpddr4/LPDDR4.h>
+#include <DRAMPower/standards/lpddr5/LPDDR5.h>
+#include <DRAMPower/standards/lpddr6/LPDDR6.h>
+
+#include <DRAMUtils/memspec/MemSpec.h>
+
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+
+using namespace DRAMPower;
+
+template <typename Standard, typename MemSpec>
+class DramPowerTest_MemSpecCache : public ::testing::Test {
+protected:
+    std::filesystem::path m_dir;
+    std::filesystem::path m_json;
+
+    virtual std::string name() const = 0;
+
+    virtual void SetUp()
+    {
+        m_dir = std::filesystem::temp_directory_path() / ("drampower_memspec_cache_" + name());
+        std::filesystem::remove_all(m_dir);
+        std::filesystem::create_directories(m_dir);
+        m_json = m_dir / (name() + ".json");
+        std::filesystem::copy_file(std::filesystem::path(TEST_RESOURCE_DIR) / (name() + ".json"), m_json);
+    }
+
+    virtual void TearDown()
+    {
+        std::filesystem::remove_all(m_dir);
+    }
+
+    static std::string serialize(const MemSpec &memspec)
+    {
+        std::ostringstream stream;
+        memspec.serialize(stream);
+        return stream.str();
+    }
+
+    static double simulate(const MemSpec &memspec)
+    {
+        Standard ddr(memspec);
+        for (const Command &command : std::vector<Command>{
+            {  0, CmdType::ACT, { 0, 0, 0 }},
+            { 30, CmdType::PRE, { 0, 0, 0 }},
+            {100, CmdType::END_OF_SIMULATION},
+        }) {
+            ddr.doCoreCommand(command);
+            ddr.doInterfaceCommand(command);
+        }
+        return ddr.calcCoreEnergy(100).total() + ddr.calcInterfaceEnergy(100).total();
+    }
+
+    void run()
+    {
+        MemSpec reference = MemSpec::from_memspec(*DRAMUtils::parse_memspec_from_file(m_json));
+        MemSpecCache cache;
+        ASSERT_EQ(cache.cacheFile(m_json), std::filesystem::path(m_json.string() + MemSpecCache::FILE_EXTENSION));
+
+        // First load compiles the memspec
+        auto miss = cache.load(m_json);
+        ASSERT_TRUE(miss.has_value());
+        ASSERT_EQ(cache.lastStatus(), MemSpecCache::Status::Miss);
+        ASSERT_TRUE(std::filesystem::exists(cache.cacheFile(m_json)));
+
+        // Second load uses the compiled memspec
+        auto hit = cache.load(m_json);
+        ASSERT_TRUE(hit.has_value());
+        ASSERT_EQ(cache.lastStatus(), MemSpecCache::Status::Hit);
+        ASSERT_TRUE(std::holds_alternative<MemSpec>(*hit));
+        const MemSpec &cached = std::get<MemSpec>(*hit);
+        ASSERT_EQ(cached.numberOfBanks, reference.numberOfBanks);
+        ASSERT_EQ(cached.numberOfDevices, reference.numberOfDevices);
+        ASSERT_EQ(cached.memoryId, reference.memoryId);
+        ASSERT_EQ(cached.memTimingSpec.tRAS, reference.memTimingSpec.tRAS);
+        ASSERT_EQ(cached.memPowerSpec.size(), reference.memPowerSpec.size());
+        ASSERT_EQ(simulate(cached), simulate(reference));
+
+        // Round trip
+        std::istringstream stream(serialize(cached));
+        ASSERT_EQ(serialize(MemSpec::from_stream(stream)), serialize(cached));
+
+        // Changed json invalidates the compiled memspec
+        {
+            std::ofstream json(m_json, std::ios::app);
+            json << "\n";
+        }
+        ASSERT_TRUE(cache.load(m_json).has_value());
+        ASSERT_EQ(cache.lastStatus(), MemSpecCache::Status::Miss);
+        ASSERT_TRUE(cache.load(m_json).has_value());
+        ASSERT_EQ(cache.lastStatus(), MemSpecCache::Status::Hit);
+
+        // Truncated compiled memspec
+        std::filesystem::resize_file(cache.cacheFile(m_json), std::filesystem::file_size(cache.cacheFile(m_json)) - 1);
+        ASSERT_TRUE(cache.load(m_json).has_value());
+        ASSERT_EQ(cache.lastStatus(), MemSpecCache::Status::Miss);
+
+        // Cache directory
+        MemSpecCache dirCache(m_dir / "cache");
+        ASSERT_EQ(dirCache.cacheFile(m_json).parent_path(), m_dir / "cache");
+        ASSERT_TRUE(dirCache.load(m_json).has_value());
+        ASSERT_EQ(dirCache.lastStatus(), MemSpecCache::Status::Miss);
+        ASSERT_TRUE(dirCache.load(m_json).has_value());
+        ASSERT_EQ(dirCache.lastStatus(), MemSpecCache::Status::Hit);
+
+        // Invalid json file
+        ASSERT_FALSE(cache.load(m_dir / "missing.json").has_value());
+        ASSERT_EQ(cache.lastStatus(), MemSpecCache::Status::Failed);
+    }
+};
+
+class DramPowerTest_MemSpecCache_DDR4 : public DramPowerTest_MemSpecCache<DDR4, MemSpecDDR4> {
+protected:
+    std::string name() const override { return "ddr4"; }
+};
+class DramPowerTest_MemSpecCache_DDR5 : public DramPowerTest_MemSpecCache<DDR5, MemSpecDDR5> {
+protected:
+    std::string name() const override { return "ddr5"; }
+};
+class DramPowerTest_MemSpecCache_LPDDR4 : public DramPowerTest_MemSpecCache<LPDDR4, MemSpecLPDDR4> {
+protected:
+    std::string name() const override { return "lpddr4"; }
+};
+class DramPowerTest_MemSpecCache_LPDDR5 : public DramPowerTest_MemSpecCache<LPDDR5, MemSpecLPDDR5> {
+protected:
+    std::string name() const override { return "lpddr5"; }
+};
+class DramPowerTest_MemSpecCache_LPDDR6 : public DramPowerTest_MemSpecCache<LPDDR6, MemSpecLPDDR6> {
+protected:
+    std::string name() const override { return "lpddr6"; }
+};
+
+TEST_F(DramPowerTest_MemSpecCache_DDR4, Test0)
+{
+    run();
+}
+
+TEST_F(DramPowerTest_MemSpecCache_DDR5, Test0)
+{
+    run();
+}
+
+TEST_F(DramPowerTest_MemSpecCache_LPDDR4, Test0)
+{
+    run();
+}
+
+TEST_F(DramPowerTest_MemSpecCache_LPDDR5, Test0)
+{
+    run();
+}
+
+TEST_F(DramPowerTest_MemSpecCache_LPDDR6, Test0)
+{
+    run();
+}
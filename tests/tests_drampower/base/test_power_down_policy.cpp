@@ -0,0 +1,226 @@
+#include <gtest/gtest.h>
+
+#include <DRAMPower/Exceptions.h>
+#include <DRAMPower/command/Command.h>
+#include <DRAMPower/util/power_down_policy.h>
+
+#include <DRAMPower/standards/ddr4/DDR4.h>
+#include <DRAMPower/standards/lpddr4/LPDDR4.h>
+
+#include <DRAMUtils/memspec/MemSpec.h>
+
+#include <array>
+#include <filesystem>
+#include <memory>
+#include <vector>
+
+using namespace DRAMPower;
+using util::PowerDownMode;
+using util::PowerDownPolicy;
+using util::PowerDownPolicyFilter;
+
+class DramPowerTest_PowerDownPolicy : public ::testing::Test {
+protected:
+    std::array<uint8_t, 32> m_data{};
+    // Trace without power down commands, rank 1 idles until 300
+    std::vector<Command> m_trace;
+
+    virtual void SetUp()
+    {
+        for (std::size_t i = 0; i < m_data.size(); ++i) {
+            m_data[i] = static_cast<uint8_t>(i * 29 + 7);
+        }
+        const uint8_t *data = m_data.data();
+        m_trace = {
+            {   0, CmdType::ACT,  {0, 0, 0}},
+            {  20, CmdType::RD,   {0, 0, 0, 0, 16}, data, 64},
+            {  30, CmdType::PRE,  {0, 0, 0}},
+            { 200, CmdType::ACT,  {1, 0, 0}},
+            { 220, CmdType::WR,   {1, 0, 0, 0, 16}, data + 8, 64},
+            { 300, CmdType::ACT,  {2, 0, 1}},
+            { 320, CmdType::RDA,  {2, 0, 1, 0, 16}, data + 16, 64},
+            { 400, CmdType::PRE,  {1, 0, 0}},
+            { 600, CmdType::END_OF_SIMULATION},
+        };
+    }
+
+    static std::vector<Command> filter(const std::vector<Command> &trace, const PowerDownPolicy &policy,
+        const util::CLIArchitectureConfig &architecture)
+    {
+        PowerDownPolicyFilter filter(policy, architecture);
+        std::vector<Command> result;
+        for (const Command &command : trace) {
+            filter.push(command, [&result](const Command &filtered) {
+                result.push_back(filtered);
+                // The data is only valid during the call
+                result.back().data = nullptr;
+            });
+        }
+        filter.finish([](const Command &) { FAIL() << "The trace was completed by END_OF_SIMULATION"; });
+        return result;
+    }
+
+    template <typename MemSpec>
+    MemSpec load(const char *file)
+    {
+        auto data = DRAMUtils::parse_memspec_from_file(std::filesystem::path(TEST_RESOURCE_DIR) / file);
+        MemSpec memSpec = MemSpec::from_memspec(*data);
+        memSpec.numberOfRanks = 2;
+        return memSpec;
+    }
+
+    // The policy powers the ranks down without changing the commands of the trace
+    template <typename Standard, typename MemSpec>
+    void expectSavesEnergy(const MemSpec &memSpec, const PowerDownPolicy &policy)
+    {
+        Standard dram(memSpec);
+        Standard baseline(memSpec);
+        PowerDownPolicyFilter filter(policy, dram.getCLIArchitectureConfig());
+        for (const Command &command : m_trace) {
+            filter.push(command, [&dram](const Command &filtered) { dram.doCommand(filtered); });
+            baseline.doCommand(command);
+        }
+        EXPECT_GT(filter.getEntryCount(), 0u);
+
+        const timestamp_t end = m_trace.back().timestamp;
+        const SimulationStats stats = dram.getWindowStats(end);
+        const SimulationStats baselineStats = baseline.getWindowStats(end);
+        uint64_t powerDown = 0;
+        for (const auto &rank : stats.rank_total) {
+            powerDown += rank.cycles.powerDownAct + rank.cycles.powerDownPre + rank.cycles.selfRefresh;
+        }
+        EXPECT_GT(powerDown, 0u);
+        for (std::size_t bank = 0; bank < stats.bank.size(); ++bank) {
+            EXPECT_EQ(stats.bank[bank].counter.act, baselineStats.bank[bank].counter.act);
+            EXPECT_EQ(stats.bank[bank].counter.reads, baselineStats.bank[bank].counter.reads);
+            EXPECT_EQ(stats.bank[bank].counter.writes, baselineStats.bank[bank].counter.writes);
+        }
+        EXPECT_LT(dram.calcCoreEnergy(end).total(), baseline.calcCoreEnergy(end).total());
+    }
+};
+
+TEST_F(DramPowerTest_PowerDownPolicy, InsertsCommands)
+{
+    const PowerDownPolicy policy{10, PowerDownMode::PowerDown, 5, 10};
+    const std::vector<Command> filtered = filter(m_trace, policy, {1, 2, 16, 4});
+
+    const std::vector<std::pair<timestamp_t, CmdType>> expected = {
+        {   0, CmdType::ACT},
+        {  10, CmdType::PDEP},  // rank 1
+        {  20, CmdType::RD},
+        {  30, CmdType::PRE},
+        {  40, CmdType::PDEP},
+        { 195, CmdType::PDXP},
+        { 200, CmdType::ACT},
+        { 220, CmdType::WR},
+        { 230, CmdType::PDEA},
+        { 295, CmdType::PDXP},  // rank 1
+        { 300, CmdType::ACT},
+        { 320, CmdType::RDA},
+        { 330, CmdType::PDEP},  // rank 1
+        { 395, CmdType::PDXA},
+        { 400, CmdType::PRE},
+        { 410, CmdType::PDEP},
+        { 600, CmdType::END_OF_SIMULATION},
+    };
+    ASSERT_EQ(filtered.size(), expected.size());
+    for (std::size_t i = 0; i < expected.size(); ++i) {
+        EXPECT_EQ(filtered[i].timestamp, expected[i].first) << i;
+        EXPECT_EQ(filtered[i].type, expected[i].second) << i;
+    }
+    EXPECT_EQ(filtered[1].targetCoordinate.rank, 1u);
+    EXPECT_EQ(filtered[9].targetCoordinate.rank, 1u);
+}
+
+TEST_F(DramPowerTest_PowerDownPolicy, ShortGapsStayActive)
+{
+    // The gaps are shorter than idleCycles + minCycles + exitCycles
+    const PowerDownPolicy policy{100, PowerDownMode::PowerDown, 50, 200};
+    const std::vector<Command> filtered = filter(m_trace, policy, {1, 2, 16, 4});
+    ASSERT_EQ(filtered.size(), m_trace.size());
+    for (std::size_t i = 0; i < m_trace.size(); ++i) {
+        EXPECT_EQ(filtered[i].type, m_trace[i].type);
+    }
+}
+
+TEST_F(DramPowerTest_PowerDownPolicy, SelfRefreshDropsRefresh)
+{
+    m_trace.insert(m_trace.begin() + 3, {100, CmdType::REFA, {0, 0, 0}});
+    // minCycles covers tRFC
+    const PowerDownPolicy policy{10, PowerDownMode::SelfRefresh, 5, 30};
+    const std::vector<Command> filtered = filter(m_trace, policy, {1, 2, 16, 4});
+
+    std::vector<CmdType> types;
+    for (const Command &command : filtered) {
+        types.push_back(command.type);
+    }
+    // Rank 0 has an open bank at 230 and enters the active power down
+    const std::vector<CmdType> expected = {
+        CmdType::ACT, CmdType::SREFEN, CmdType::RD, CmdType::PRE, CmdType::SREFEN, CmdType::SREFEX, CmdType::ACT,
+        CmdType::WR, CmdType::PDEA, CmdType::SREFEX, CmdType::ACT, CmdType::RDA, CmdType::SREFEN, CmdType::PDXA,
+        CmdType::PRE, CmdType::SREFEN, CmdType::END_OF_SIMULATION,
+    };
+    EXPECT_EQ(types, expected);
+}
+
+TEST_F(DramPowerTest_PowerDownPolicy, RejectsPowerDownCommands)
+{
+    PowerDownPolicyFilter filter({10, PowerDownMode::PowerDown, 0, 0}, {1, 1, 16, 4});
+    filter.push({0, CmdType::ACT, {0, 0, 0}}, [](const Command &) {});
+    EXPECT_THROW(filter.push({50, CmdType::PDEA, {0, 0, 0}}, [](const Command &) {}), Exception);
+}
+
+TEST_F(DramPowerTest_PowerDownPolicy, DDR4SavesEnergy)
+{
+    expectSavesEnergy<DDR4>(load<MemSpecDDR4>("ddr4.json"), PowerDownPolicy{10, PowerDownMode::PowerDown, 5, 10});
+    expectSavesEnergy<DDR4>(load<MemSpecDDR4>("ddr4.json"), PowerDownPolicy{10, PowerDownMode::SelfRefresh, 5, 30});
+}
+
+TEST_F(DramPowerTest_PowerDownPolicy, LPDDR4SavesEnergy)
+{
+    expectSavesEnergy<LPDDR4>(load<MemSpecLPDDR4>("lpddr4.json"), PowerDownPolicy{10, PowerDownMode::PowerDown, 5, 10});
+    expectSavesEnergy<LPDDR4>(load<MemSpecLPDDR4>("lpddr4.json"), PowerDownPolicy{10, PowerDownMode::SelfRefresh, 5, 30});
+}
+
+TEST_F(DramPowerTest_PowerDownPolicy, SweepMatchesSeparateSimulations)
+{
+    const MemSpecLPDDR4 memSpec = load<MemSpecLPDDR4>("lpddr4.json");
+    const std::vector<PowerDownPolicy> policies = {
+        {1000, PowerDownMode::PowerDown, 0, 0},
+        {10, PowerDownMode::PowerDown, 5, 10},
+        {50, PowerDownMode::PowerDown, 5, 10},
+        {10, PowerDownMode::SelfRefresh, 5, 30},
+    };
+    std::vector<std::unique_ptr<LPDDR4>> drams;
+    std::vector<LPDDR4 *> targets;
+    for (std::size_t i = 0; i < policies.size(); ++i) {
+        drams.push_back(std::make_unique<LPDDR4>(memSpec));
+        targets.push_back(drams.back().get());
+    }
+    const auto producer = [this](auto &&emit) {
+        for (const Command &command : m_trace) {
+            emit(command);
+        }
+    };
+    const util::FanOutResult result = util::sweepPowerDownPolicies(targets, policies, producer, 3, 2);
+    ASSERT_EQ(result.commandCount, m_trace.size());
+
+    const timestamp_t end = m_trace.back().timestamp;
+    std::vector<double> energies;
+    for (std::size_t i = 0; i < policies.size(); ++i) {
+        ASSERT_FALSE(result.errors[i]);
+        LPDDR4 reference(memSpec);
+        PowerDownPolicyFilter filter(policies[i], reference.getCLIArchitectureConfig());
+        for (const Command &command : m_trace) {
+            filter.push(command, [&reference](const Command &filtered) { reference.doCommand(filtered); });
+        }
+        EXPECT_EQ(drams[i]->getWindowStats(end), reference.getWindowStats(end));
+        energies.push_back(drams[i]->calcCoreEnergy(end).total());
+    }
+    // Powering down saves background energy, earlier entries save more
+    EXPECT_LT(energies[1], energies[0]);
+    EXPECT_LT(energies[1], energies[2]);
+    EXPECT_LT(energies[3], energies[0]);
+
+    EXPECT_THROW(util::sweepPowerDownPolicies(targets, {policies[0]}, producer), Exception);
+}
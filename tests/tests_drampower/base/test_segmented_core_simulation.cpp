@@ -0,0 +1,146 @@
+#include <gtest/gtest.h>
+
+#include <DRAMPower/command/Command.h>
+
+#include <DRAMPower/standards/ddr4/DDR4Core.h>
+#include <DRAMPower/util/SegmentedCoreSimulation.h>
+
+#include <DRAMPower/memspec/MemSpec.h>
+#include <DRAMUtils/memspec/standards/MemSpecDDR4.h>
+
+#include <memory>
+#include <stdexcept>
+
+using namespace DRAMPower;
+
+class DramPowerTest_SegmentedCoreSimulation : public ::testing::Test {
+protected:
+    // Test pattern
+    std::vector<Command> testPattern = {
+        // Timestamp,   Cmd,  { Bank, BG, Rank}
+            {    0, CmdType::ACT,    { 0, 0, 0 } },
+            {   15, CmdType::RD,     { 0, 0, 0 } },
+            {   40, CmdType::PRE,    { 0, 0, 0 } },
+            {  100, CmdType::ACT,    { 1, 0, 0 } },
+            {  120, CmdType::WR,     { 1, 0, 0 } },
+            {  150, CmdType::PRE,    { 1, 0, 0 } },
+            {  200, CmdType::REFA,   { 0, 0, 0 } },
+        // Inside the refresh -> boundary must be reconciled
+            {  205, CmdType::ACT,    { 2, 0, 1 } },
+            {  230, CmdType::RDA,    { 2, 0, 1 } },
+        // Pending auto precharge -> boundary must be reconciled
+            {  231, CmdType::ACT,    { 3, 0, 0 } },
+            {  260, CmdType::PRE,    { 3, 0, 0 } },
+            {  400, CmdType::ACT,    { 0, 0, 1 } },
+            {  420, CmdType::PDEA,   { 0, 0, 1 } },
+            {  450, CmdType::PDXA,   { 0, 0, 1 } },
+            {  480, CmdType::PREA,   { 0, 0, 1 } },
+            {  600, CmdType::PDEP,   { 0, 0, 0 } },
+            {  650, CmdType::PDXP,   { 0, 0, 0 } },
+            {  700, CmdType::ACT,    { 4, 0, 0 } },
+            {  720, CmdType::WRA,    { 4, 0, 0 } },
+            {  900, CmdType::SREFEN, { 0, 0, 1 } },
+            { 1000, CmdType::SREFEX, { 0, 0, 1 } },
+            { 1100, CmdType::ACT,    { 5, 0, 1 } },
+            { 1150, CmdType::PRE,    { 5, 0, 1 } },
+            { 1300, CmdType::END_OF_SIMULATION },
+    };
+
+    // Test variables
+    std::unique_ptr<DRAMPower::MemSpecDDR4> memSpec;
+
+    virtual void SetUp()
+    {
+        auto data = DRAMUtils::parse_memspec_from_file(std::filesystem::path(TEST_RESOURCE_DIR) / "ddr4.json");
+        memSpec = std::make_unique<DRAMPower::MemSpecDDR4>(DRAMPower::MemSpecDDR4::from_memspec(*data));
+        memSpec->numberOfRanks = 2;
+    }
+
+    SimulationStats runSequential() {
+        DDR4Core core(*memSpec);
+        for (const auto& command : testPattern) {
+            core.doCommand(command);
+        }
+        SimulationStats stats;
+        core.getWindowStats(testPattern.back().timestamp, stats);
+        return stats;
+    }
+
+    virtual void TearDown()
+    {
+    }
+};
+
+TEST_F(DramPowerTest_SegmentedCoreSimulation, SingleSegment)
+{
+    SegmentedCoreSimulation<DDR4Core> simulation(DDR4Core(*memSpec), 1, 1);
+    auto stats = simulation.run(testPattern, testPattern.back().timestamp);
+
+    ASSERT_EQ(stats, runSequential());
+    ASSERT_EQ(simulation.getReconciledSegmentCount(), 0);
+}
+
+TEST_F(DramPowerTest_SegmentedCoreSimulation, MatchesSequential)
+{
+    auto sequential = runSequential();
+    for (std::size_t segments = 2; segments <= testPattern.size(); ++segments) {
+        for (std::size_t threads : {1, 2, 4}) {
+            SegmentedCoreSimulation<DDR4Core> simulation(DDR4Core(*memSpec), segments, threads);
+            auto stats = simulation.run(testPattern, testPattern.back().timestamp);
+            ASSERT_EQ(stats, sequential) << "segments: " << segments << " threads: " << threads;
+        }
+    }
+}
+
+TEST_F(DramPowerTest_SegmentedCoreSimulation, Reconciliation)
+{
+    // One segment per command -> the boundaries inside the refresh and before the
+    // pending auto precharge cannot be simulated independently
+    SegmentedCoreSimulation<DDR4Core> simulation(DDR4Core(*memSpec), testPattern.size(), 2);
+    auto stats = simulation.run(testPattern, testPattern.back().timestamp);
+
+    ASSERT_EQ(stats, runSequential());
+    ASSERT_GT(simulation.getReconciledSegmentCount(), 0);
+}
+
+TEST_F(DramPowerTest_SegmentedCoreSimulation, GuardInterval)
+{
+    // Only gaps of at least 100 cycles are considered as segment boundaries
+    SegmentedCoreSimulation<DDR4Core> simulation(DDR4Core(*memSpec), testPattern.size(), 2, 100);
+    auto stats = simulation.run(testPattern, testPattern.back().timestamp);
+
+    ASSERT_EQ(stats, runSequential());
+    ASSERT_EQ(simulation.getReconciledSegmentCount(), 0);
+}
+
+namespace {
+
+// Throws on the command at the given timestamp
+class ThrowingCore : public DDR4Core {
+public:
+    ThrowingCore(const MemSpecDDR4& memSpec, timestamp_t failure)
+        : DDR4Core(memSpec)
+        , m_failure(failure)
+    {}
+
+    void doCommand(const Command& command) {
+        if (command.timestamp == m_failure) {
+            throw std::runtime_error("failing command");
+        }
+        DDR4Core::doCommand(command);
+    }
+
+private:
+    timestamp_t m_failure;
+};
+
+} // namespace
+
+TEST_F(DramPowerTest_SegmentedCoreSimulation, WorkerException)
+{
+    // The exception of a worker thread is rethrown by run instead of terminating
+    for (timestamp_t failure : {15, 700, 1150}) {
+        SegmentedCoreSimulation<ThrowingCore> simulation(ThrowingCore(*memSpec, failure), testPattern.size(), 4);
+        ASSERT_THROW(simulation.run(testPattern, testPattern.back().timestamp), std::runtime_error);
+    }
+}
@@ -0,0 +1,164 @@
+#include <gtest/gtest.h>
+
+#include <DRAMPower/Exceptions.h>
+#include <DRAMPower/command/Command.h>
+#include <DRAMPower/util/shm_command_ring.h>
+
+#include <DRAMPower/standards/ddr4/DDR4.h>
+
+#include <DRAMUtils/memspec/MemSpec.h>
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace DRAMPower;
+using DRAMPower::util::ShmCommandRing;
+
+class DramPowerTest_ShmCommandRing : public ::testing::Test {
+protected:
+    using data_t = std::array<uint8_t, 8>;
+
+    std::string m_name;
+    std::vector<data_t> m_data;
+    std::vector<Command> m_pattern;
+    std::unique_ptr<MemSpecDDR4> m_memSpec;
+
+    virtual void SetUp()
+    {
+        m_name = "/drampower_test_ring_" + std::to_string(::getpid());
+        ShmCommandRing::unlink(m_name);
+
+        auto data = DRAMUtils::parse_memspec_from_file(std::filesystem::path(TEST_RESOURCE_DIR) / "ddr4.json");
+        m_memSpec = std::make_unique<MemSpecDDR4>(MemSpecDDR4::from_memspec(*data));
+
+        // Enough commands to wrap around the smallest ring several times
+        constexpr std::size_t iterations = 500;
+        m_data.resize(2 * iterations);
+        for (std::size_t i = 0; i < iterations; ++i) {
+            const timestamp_t t = i * 40;
+            const std::size_t bank = i % 4;
+            for (std::size_t b = 0; b < 8; ++b) {
+                m_data[2 * i][b] = static_cast<uint8_t>(i * 7 + b * 31);
+                m_data[2 * i + 1][b] = static_cast<uint8_t>(i * 13 + b * 3);
+            }
+            m_pattern.push_back({t, CmdType::ACT, {bank, 0, 0}});
+            m_pattern.push_back({t + 10, CmdType::WR, {bank, 0, 0, 0, 16}, m_data[2 * i].data(), 64});
+            m_pattern.push_back({t + 20, CmdType::RD, {bank, 0, 0, 0, 16}, m_data[2 * i + 1].data(), 64});
+            m_pattern.push_back({t + 30, CmdType::PRE, {bank, 0, 0}});
+        }
+        m_pattern.push_back({iterations * 40, CmdType::END_OF_SIMULATION});
+    }
+
+    virtual void TearDown()
+    {
+        ShmCommandRing::unlink(m_name);
+    }
+};
+
+TEST_F(DramPowerTest_ShmCommandRing, StreamMatchesDirectSimulation)
+{
+    ShmCommandRing consumer(m_name, ShmCommandRing::Role::Consumer, 0);
+    ASSERT_EQ(consumer.capacity(), 4096u);
+
+    std::thread producerThread([this]() {
+        ShmCommandRing producer(m_name, ShmCommandRing::Role::Producer);
+        for (const Command &command : m_pattern) {
+            producer.push(command);
+        }
+        producer.close();
+    });
+
+    DDR4 ddr(*m_memSpec);
+    const uint64_t count = util::simulateCommandRing(consumer, ddr);
+    producerThread.join();
+    ASSERT_EQ(count, m_pattern.size());
+    ASSERT_TRUE(consumer.finished());
+    ASSERT_FALSE(consumer.acquire().has_value());
+
+    DDR4 reference(*m_memSpec);
+    for (const Command &command : m_pattern) {
+        reference.doCommand(command);
+    }
+    const timestamp_t end = m_pattern.back().timestamp;
+    ASSERT_EQ(ddr.getWindowStats(end), reference.getWindowStats(end));
+    ASSERT_EQ(ddr.getTotalEnergy(end), reference.getTotalEnergy(end));
+}
+
+TEST_F(DramPowerTest_ShmCommandRing, Backpressure)
+{
+    ShmCommandRing producer(m_name, ShmCommandRing::Role::Producer, 0);
+    ShmCommandRing consumer(m_name, ShmCommandRing::Role::Consumer);
+    ASSERT_EQ(consumer.capacity(), producer.capacity());
+
+    // Fill the ring
+    std::size_t pushed = 0;
+    while (producer.tryPush(m_pattern[pushed])) {
+        ++pushed;
+    }
+    ASSERT_GT(pushed, 0u);
+
+    // Commands and data arrive in order
+    std::size_t received = 0;
+    auto receive = [this, &consumer, &received]() {
+        const Command &expected = m_pattern[received++];
+        auto command = consumer.acquire();
+        ASSERT_TRUE(command.has_value());
+        ASSERT_EQ(command->timestamp, expected.timestamp);
+        ASSERT_EQ(command->type, expected.type);
+        ASSERT_EQ(command->targetCoordinate.bank, expected.targetCoordinate.bank);
+        ASSERT_EQ(command->targetCoordinate.column, expected.targetCoordinate.column);
+        if (nullptr != expected.data) {
+            ASSERT_EQ(command->sz_bits, expected.sz_bits);
+            ASSERT_TRUE(std::equal(expected.data, expected.data + expected.sz_bits / 8, command->data));
+        } else {
+            ASSERT_EQ(command->data, nullptr);
+        }
+        consumer.release();
+    };
+
+    // Space becomes available when the consumer releases records
+    while (!producer.tryPush(m_pattern[pushed])) {
+        ASSERT_LT(received, pushed);
+        receive();
+    }
+    ++pushed;
+    while (received < pushed) {
+        receive();
+    }
+    producer.close();
+    ASSERT_FALSE(consumer.acquire().has_value());
+}
+
+TEST_F(DramPowerTest_ShmCommandRing, InvalidUse)
+{
+    ShmCommandRing consumer(m_name, ShmCommandRing::Role::Consumer, 0);
+    ASSERT_THROW(consumer.push(m_pattern[0]), Exception);
+    ASSERT_THROW(ShmCommandRing(m_name, ShmCommandRing::Role::Consumer), Exception);
+
+    ShmCommandRing producer(m_name, ShmCommandRing::Role::Producer);
+    ASSERT_THROW(producer.acquire(), Exception);
+
+    // Data larger than the ring
+    std::vector<uint8_t> data(producer.maxDataBytes() + 1);
+    ASSERT_THROW(producer.push({0, CmdType::WR, {0, 0, 0}, data.data(), data.size() * 8}), Exception);
+}
+
+TEST_F(DramPowerTest_ShmCommandRing, ProducerDetached)
+{
+    ShmCommandRing consumer(m_name, ShmCommandRing::Role::Consumer, 0);
+    {
+        ShmCommandRing producer(m_name, ShmCommandRing::Role::Producer);
+        producer.push(m_pattern[0]);
+    }
+    // The pending command is still delivered
+    ASSERT_TRUE(consumer.acquire().has_value());
+    consumer.release();
+    ASSERT_THROW(consumer.acquire(), Exception);
+}
@@ -0,0 +1,100 @@
+#include <gtest/gtest.h>
+
+#include <DRAMPower/command/Command.h>
+#include <DRAMPower/data/stats_publisher.h>
+#include <DRAMPower/dram/static_dram.h>
+#include <DRAMPower/standards/visit_standard.h>
+#include <DRAMPower/util/command_observer.h>
+
+#include <DRAMPower/standards/ddr4/DDR4.h>
+
+#include <DRAMUtils/memspec/MemSpec.h>
+
+#include <filesystem>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+using namespace DRAMPower;
+
+class DramPowerTest_StaticDRAM : public ::testing::Test {
+protected:
+    std::vector<Command> testPattern = {
+        {   0, CmdType::ACT, { 0, 0, 0 }},
+        {  15, CmdType::ACT, { 1, 0, 0 }},
+        {  20, CmdType::RDA, { 1, 0, 0 }},
+        {  35, CmdType::PRE, { 0, 0, 0 }},
+        {  60, CmdType::ACT, { 2, 0, 0 }},
+        {  70, CmdType::WR,  { 2, 0, 0 }},
+        {  80, CmdType::PRE, { 2, 0, 0 }},
+        { 100, CmdType::REFA, { 0, 0, 0 }},
+        { 200, CmdType::END_OF_SIMULATION },
+    };
+
+    std::unique_ptr<MemSpecDDR4> memSpec;
+
+    virtual void SetUp()
+    {
+        auto data = DRAMUtils::parse_memspec_from_file(std::filesystem::path(TEST_RESOURCE_DIR) / "ddr4.json");
+        memSpec = std::make_unique<MemSpecDDR4>(MemSpecDDR4::from_memspec(*data));
+    }
+};
+
+struct CommandCounter {
+    static constexpr util::CommandHook getSupportedHooks() { return util::CommandHook::PreCommand; }
+    void preCommand(const Command&) { ++commands; }
+    uint64_t commands = 0;
+};
+
+TEST_F(DramPowerTest_StaticDRAM, SameStatsAsVirtual)
+{
+    StaticDRAM<DDR4> ddr(*memSpec);
+    DDR4 reference(*memSpec);
+
+    ddr.doCommands(testPattern);
+    for (const auto &command : testPattern) {
+        reference.doCommand(command);
+    }
+
+    ASSERT_EQ(ddr->getWindowStats(200), reference.getWindowStats(200));
+    ASSERT_EQ(ddr->getTotalEnergy(200), reference.getTotalEnergy(200));
+    ASSERT_EQ(ddr->getLastCommandTime(), reference.getLastCommandTime());
+}
+
+TEST_F(DramPowerTest_StaticDRAM, PublishesStats)
+{
+    auto publisher = std::make_shared<StatsPublisher>(StatsPublisher::Config{3, 0});
+    StaticDRAM<DDR4> ddr(*memSpec);
+    ddr->setStatsPublisher(publisher);
+    ddr.doCommands(testPattern.begin(), testPattern.end());
+    ASSERT_EQ(publisher->publications(), testPattern.size() / 3);
+}
+
+TEST_F(DramPowerTest_StaticDRAM, Observers)
+{
+    StaticDRAM<util::ObservedDRAM<DDR4, CommandCounter>> ddr(*memSpec);
+    ddr.doCommands(testPattern);
+    ASSERT_EQ(ddr->getObserver<CommandCounter>().commands, testPattern.size());
+}
+
+TEST_F(DramPowerTest_StaticDRAM, VisitStandard)
+{
+    std::unique_ptr<dram_base<CmdType>> ddr = std::make_unique<DDR4>(*memSpec);
+    bool isDDR4 = visitStandard(*ddr, [](auto &dram) {
+        return std::is_same_v<std::decay_t<decltype(dram)>, DDR4>;
+    });
+    ASSERT_TRUE(isDDR4);
+
+    // Derived types are not matched and use the virtual command path
+    std::unique_ptr<dram_base<CmdType>> observed = std::make_unique<util::ObservedDRAM<DDR4, CommandCounter>>(*memSpec);
+    bool isBase = visitStandard(*observed, [this](auto &dram) {
+        using standard_t = std::decay_t<decltype(dram)>;
+        for (const auto &command : testPattern) {
+            StaticDispatch<standard_t>::doCommand(dram, command);
+        }
+        return std::is_same_v<standard_t, dram_base<CmdType>>;
+    });
+    ASSERT_TRUE(isBase);
+    auto &counter = static_cast<util::ObservedDRAM<DDR4, CommandCounter> &>(*observed).getObserver<CommandCounter>();
+    ASSERT_EQ(counter.commands, testPattern.size());
+}
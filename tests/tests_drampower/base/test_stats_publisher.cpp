@@ -0,0 +1,168 @@
+#include <gtest/gtest.h>
+
+#include <DRAMPower/command/Command.h>
+#include <DRAMPower/data/stats_publisher.h>
+
+#include <DRAMPower/standards/ddr4/DDR4.h>
+
+#include <DRAMUtils/memspec/MemSpec.h>
+
+#include <atomic>
+#include <filesystem>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace DRAMPower;
+
+class DramPowerTest_StatsPublisher : public ::testing::Test {
+protected:
+    std::vector<Command> testPattern = {
+        {   0, CmdType::ACT, { 0, 0, 0 }},
+        {  15, CmdType::ACT, { 1, 0, 0 }},
+        {  35, CmdType::PRE, { 0, 0, 0 }},
+        {  45, CmdType::PRE, { 1, 0, 0 }},
+        {  60, CmdType::ACT, { 2, 0, 0 }},
+        {  80, CmdType::PRE, { 2, 0, 0 }},
+        { 100, CmdType::REFA, { 0, 0, 0 }},
+        { 200, CmdType::END_OF_SIMULATION },
+    };
+
+    std::unique_ptr<MemSpecDDR4> memSpec;
+
+    virtual void SetUp()
+    {
+        auto data = DRAMUtils::parse_memspec_from_file(std::filesystem::path(TEST_RESOURCE_DIR) / "ddr4.json");
+        memSpec = std::make_unique<MemSpecDDR4>(MemSpecDDR4::from_memspec(*data));
+    }
+
+    // Stats in which every counter equals value
+    static SimulationStats uniformStats(uint64_t value)
+    {
+        SimulationStats stats;
+        for (util::bus_stats_t *bus : {
+            &stats.commandBus, &stats.readBus, &stats.writeBus, &stats.clockStats, &stats.wClockStats,
+            &stats.readDBI, &stats.writeDBI, &stats.togglingStats.read, &stats.togglingStats.write,
+            &stats.readDQSStats, &stats.writeDQSStats
+        }) {
+            bus->ones = value;
+            bus->zeroes = value;
+            bus->bit_changes = value;
+            bus->ones_to_zeroes = value;
+            bus->zeroes_to_ones = value;
+        }
+        stats.bank.resize(4);
+        stats.rank_total.resize(1);
+        for (auto *cycleStats : {&stats.bank, &stats.rank_total}) {
+            for (auto &entry : *cycleStats) {
+                entry.counter.act = value;
+                entry.counter.reads = value;
+                entry.cycles.act = value;
+                entry.cycles.pre = value;
+                entry.prepos.readMerged = value;
+            }
+        }
+        return stats;
+    }
+};
+
+TEST_F(DramPowerTest_StatsPublisher, NoPublication)
+{
+    StatsPublisher publisher;
+    ASSERT_EQ(publisher.publications(), 0u);
+    ASSERT_FALSE(publisher.latest().has_value());
+    ASSERT_FALSE(publisher.due(1000, 1000));
+}
+
+TEST_F(DramPowerTest_StatsPublisher, CommandInterval)
+{
+    auto publisher = std::make_shared<StatsPublisher>(StatsPublisher::Config{3, 0});
+    DDR4 ddr(*memSpec);
+    DDR4 reference(*memSpec);
+    ddr.setStatsPublisher(publisher);
+
+    for (std::size_t i = 0; i < testPattern.size(); ++i) {
+        ddr.doCommand(testPattern[i]);
+        reference.doCommand(testPattern[i]);
+        if (0 == (i + 1) % 3) {
+            auto snapshot = publisher->latest();
+            ASSERT_TRUE(snapshot.has_value());
+            ASSERT_EQ(snapshot->sequence, (i + 1) / 3);
+            ASSERT_EQ(snapshot->commandCount, i + 1);
+            ASSERT_EQ(snapshot->timestamp, testPattern[i].timestamp);
+            ASSERT_EQ(snapshot->stats, reference.getWindowStats(testPattern[i].timestamp));
+            ASSERT_EQ(ddr.calcCoreEnergyStats(snapshot->stats).total(),
+                reference.calcCoreEnergy(testPattern[i].timestamp).total());
+        }
+    }
+    ASSERT_EQ(publisher->publications(), testPattern.size() / 3);
+    // Publishing doesn't change the simulation
+    ASSERT_EQ(ddr.getWindowStats(200), reference.getWindowStats(200));
+}
+
+TEST_F(DramPowerTest_StatsPublisher, TimeInterval)
+{
+    auto publisher = std::make_shared<StatsPublisher>(StatsPublisher::Config{0, 50});
+    DDR4 ddr(*memSpec);
+    ddr.setStatsPublisher(publisher);
+    for (const auto &command : testPattern) {
+        ddr.doCommand(command);
+    }
+    // Published at 60 and 200
+    ASSERT_EQ(publisher->publications(), 2u);
+    auto snapshot = publisher->latest();
+    ASSERT_TRUE(snapshot.has_value());
+    ASSERT_EQ(snapshot->timestamp, 200u);
+    ASSERT_EQ(snapshot->commandCount, testPattern.size());
+}
+
+TEST_F(DramPowerTest_StatsPublisher, ConcurrentReader)
+{
+    constexpr uint64_t publications = 20000;
+    StatsPublisher publisher;
+    std::atomic<bool> done{false};
+    std::atomic<uint64_t> torn{0};
+    std::atomic<uint64_t> reads{0};
+
+    std::thread reader([&]() {
+        uint64_t lastSequence = 0;
+        while (!done.load(std::memory_order_acquire)) {
+            auto snapshot = publisher.latest();
+            if (!snapshot) {
+                continue;
+            }
+            // Every counter of a snapshot has the same value
+            if (!(snapshot->stats == uniformStats(snapshot->sequence))
+                || snapshot->commandCount != snapshot->sequence
+                || snapshot->timestamp != snapshot->sequence
+                || snapshot->sequence < lastSequence
+            ) {
+                torn.fetch_add(1, std::memory_order_relaxed);
+            }
+            lastSequence = snapshot->sequence;
+            reads.fetch_add(1, std::memory_order_relaxed);
+        }
+    });
+
+    for (uint64_t i = 1; i <= publications; ++i) {
+        publisher.publish(uniformStats(i), i, i);
+    }
+    done.store(true, std::memory_order_release);
+    reader.join();
+
+    ASSERT_EQ(torn.load(), 0u);
+    ASSERT_EQ(publisher.publications(), publications);
+    auto snapshot = publisher.latest();
+    ASSERT_TRUE(snapshot.has_value());
+    ASSERT_EQ(snapshot->sequence, publications);
+    ASSERT_EQ(snapshot->stats, uniformStats(publications));
+}
+
+TEST_F(DramPowerTest_StatsPublisher, GrowingStats)
+{
+    StatsPublisher publisher;
+    publisher.publish(uniformStats(1), 1, 1);
+    SimulationStats stats = uniformStats(2);
+    stats.bank.resize(8);
+    ASSERT_THROW(publisher.publish(stats, 2, 2), Exception);
+}
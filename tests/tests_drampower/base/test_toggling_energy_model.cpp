@@ -0,0 +1,148 @@
+#include <gtest/gtest.h>
+
+#include <DRAMPower/Exceptions.h>
+#include <DRAMPower/command/Command.h>
+#include <DRAMPower/data/toggling_energy_model.h>
+#include <DRAMPower/simconfig/simconfig.h>
+
+#include <DRAMPower/standards/ddr4/DDR4.h>
+#include <DRAMPower/standards/lpddr4/LPDDR4.h>
+
+#include <DRAMUtils/config/toggling_rate.h>
+#include <DRAMUtils/memspec/MemSpec.h>
+
+#include <filesystem>
+#include <memory>
+#include <vector>
+
+using namespace DRAMPower;
+using namespace DRAMUtils::Config;
+
+class DramPowerTest_TogglingEnergyModel : public ::testing::Test {
+protected:
+    std::vector<Command> m_commands;
+    std::vector<ToggleRateDefinition> m_definitions;
+    std::unique_ptr<MemSpecDDR4> m_memSpecDDR4;
+    std::unique_ptr<MemSpecLPDDR4> m_memSpecLPDDR4;
+
+    virtual void SetUp()
+    {
+        auto ddr4 = DRAMUtils::parse_memspec_from_file(std::filesystem::path(TEST_RESOURCE_DIR) / "ddr4.json");
+        m_memSpecDDR4 = std::make_unique<MemSpecDDR4>(MemSpecDDR4::from_memspec(*ddr4));
+        auto lpddr4 = DRAMUtils::parse_memspec_from_file(std::filesystem::path(TEST_RESOURCE_DIR) / "lpddr4.json");
+        m_memSpecLPDDR4 = std::make_unique<MemSpecLPDDR4>(MemSpecLPDDR4::from_memspec(*lpddr4));
+
+        for (std::size_t i = 0; i < 500; ++i) {
+            const timestamp_t t = i * 100;
+            const std::size_t bank = i % 4;
+            m_commands.push_back({t, CmdType::ACT, {bank, 0, 0}});
+            m_commands.push_back({t + 20, CmdType::WR, {bank, 0, 0, 0, 16}, nullptr, 64});
+            if (0 == i % 3) {
+                m_commands.push_back({t + 40, CmdType::RD, {bank, 0, 0, 0, 16}, nullptr, 64});
+            }
+            m_commands.push_back({t + 80, CmdType::PRE, {bank, 0, 0}});
+        }
+        m_commands.push_back({50000, CmdType::END_OF_SIMULATION});
+
+        m_definitions = {
+            {0.5, 0.5, 0.5, 0.5, TogglingRateIdlePattern::L, TogglingRateIdlePattern::L},
+            {0.7, 0.3, 0.6, 0.4, TogglingRateIdlePattern::L, TogglingRateIdlePattern::H},
+            {0.1, 0.9, 0.2, 0.8, TogglingRateIdlePattern::H, TogglingRateIdlePattern::L},
+            {1.0, 0.0, 1.0, 0.0, TogglingRateIdlePattern::H, TogglingRateIdlePattern::H},
+        };
+    }
+
+    template <typename DRAM, typename MemSpec>
+    SimulationStats run(const MemSpec &memSpec, const ToggleRateDefinition &definition, double &energy)
+    {
+        DRAM dram(memSpec, config::SimConfig{definition});
+        for (const Command &command : m_commands) {
+            dram.doCommand(command);
+        }
+        const timestamp_t end = m_commands.back().timestamp;
+        energy = dram.calcInterfaceEnergy(end).total();
+        return dram.getWindowStats(end);
+    }
+
+    template <typename DRAM, typename MemSpec>
+    void expectMatchesSimulation(const MemSpec &memSpec)
+    {
+        double energy = 0.0;
+        const SimulationStats stats = run<DRAM>(memSpec, m_definitions.front(), energy);
+        ASSERT_GT(stats.togglingStats.readActivity.bits, 0u);
+        ASSERT_GT(stats.togglingStats.writeActivity.bits, 0u);
+
+        DRAM dram(memSpec, config::SimConfig{m_definitions.front()});
+        TogglingEnergyModel model(dram, stats);
+        EXPECT_NEAR(model.evaluateTotal(m_definitions.front()), energy, 1e-6 * energy);
+
+        TogglingSweep sweep;
+        for (const ToggleRateDefinition &definition : m_definitions) {
+            sweep.push_back(definition);
+        }
+        const std::vector<double> totals = model.evaluateTotal(sweep);
+        ASSERT_EQ(totals.size(), m_definitions.size());
+        for (std::size_t i = 0; i < m_definitions.size(); ++i) {
+            double expected = 0.0;
+            const SimulationStats rerun = run<DRAM>(memSpec, m_definitions[i], expected);
+            // The activity doesn't depend on the toggling rate definition
+            ASSERT_EQ(rerun.togglingStats.readActivity, stats.togglingStats.readActivity);
+            ASSERT_EQ(rerun.togglingStats.writeActivity, stats.togglingStats.writeActivity);
+            // The simulated counters are rounded down to whole bit times per line
+            EXPECT_NEAR(totals[i], expected, 1e-3 * expected);
+            EXPECT_NEAR(model.evaluate(m_definitions[i]).total(), totals[i], 1e-9 * totals[i]);
+        }
+    }
+};
+
+TEST_F(DramPowerTest_TogglingEnergyModel, DDR4)
+{
+    expectMatchesSimulation<DDR4>(*m_memSpecDDR4);
+}
+
+TEST_F(DramPowerTest_TogglingEnergyModel, LPDDR4)
+{
+    expectMatchesSimulation<LPDDR4>(*m_memSpecLPDDR4);
+}
+
+TEST_F(DramPowerTest_TogglingEnergyModel, Grid)
+{
+    const TogglingSweep sweep = TogglingSweep::grid({0.0, 0.25, 0.5, 1.0}, {0.25, 0.5},
+        {TogglingRateIdlePattern::L, TogglingRateIdlePattern::H});
+    ASSERT_EQ(sweep.size(), 16u);
+    EXPECT_EQ(sweep.togglingRateRead[15], 1.0);
+    EXPECT_EQ(sweep.dutyCycleWrite[15], 0.5);
+    EXPECT_EQ(sweep.idlePatternWrite[15], TogglingRateIdlePattern::H);
+
+    double energy = 0.0;
+    const SimulationStats stats = run<DDR4>(*m_memSpecDDR4, m_definitions.front(), energy);
+    DDR4 dram(*m_memSpecDDR4);
+    TogglingEnergyModel model(dram, stats);
+    const std::vector<double> totals = model.evaluateTotal(sweep);
+    for (std::size_t i = 0; i < sweep.size(); ++i) {
+        const ToggleRateDefinition definition {
+            sweep.togglingRateRead[i], sweep.togglingRateWrite[i],
+            sweep.dutyCycleRead[i], sweep.dutyCycleWrite[i],
+            sweep.idlePatternRead[i], sweep.idlePatternWrite[i],
+        };
+        EXPECT_NEAR(totals[i], model.evaluateTotal(definition), 1e-9 * totals[i]);
+        EXPECT_GE(totals[i], model.getFixedEnergy().total());
+    }
+}
+
+TEST_F(DramPowerTest_TogglingEnergyModel, InvalidSweep)
+{
+    double energy = 0.0;
+    const SimulationStats stats = run<DDR4>(*m_memSpecDDR4, m_definitions.front(), energy);
+    DDR4 dram(*m_memSpecDDR4);
+    TogglingEnergyModel model(dram, stats);
+
+    TogglingSweep sweep;
+    sweep.push_back(m_definitions.front());
+    sweep.dutyCycleRead.push_back(0.5);
+    ASSERT_THROW(model.evaluateTotal(sweep), Exception);
+
+    ToggleRateDefinition invalid = m_definitions.front();
+    invalid.idlePatternWrite = TogglingRateIdlePattern::Invalid;
+    ASSERT_THROW(model.evaluate(invalid), Exception);
+}
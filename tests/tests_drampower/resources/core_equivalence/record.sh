@@ -0,0 +1,30 @@
+#!/bin/sh
+# Records the reference of base/test_core_equivalence.cpp with the cores of another commit.
+# The test is built against a worktree of the commit and writes <standard>.csv into this directory.
+#
+#   record.sh [commit]
+#
+# The default commit holds the per-standard cores before the shared core engine replaced them.
+
+set -e
+
+resources=$(cd "$(dirname "$0")" && pwd)
+repo=$(git -C "$resources" rev-parse --show-toplevel)
+commit=${1:-$(git -C "$repo" log -1 --format=%H --grep='Share one policy-based core engine')~1}
+
+worktree=$(mktemp -d)
+git -C "$repo" worktree add --detach "$worktree" "$commit"
+trap 'git -C "$repo" worktree remove --force "$worktree"' EXIT
+
+cp "$repo/tests/tests_drampower/base/test_core_equivalence.cpp" "$worktree/tests/tests_drampower/base/"
+cat >> "$worktree/tests/tests_drampower/CMakeLists.txt" <<'EOF'
+
+add_executable(core_equivalence_record base/test_core_equivalence.cpp)
+target_compile_definitions(core_equivalence_record PUBLIC TEST_RESOURCE_DIR="${CMAKE_CURRENT_SOURCE_DIR}/resources/")
+target_include_directories(core_equivalence_record PUBLIC ${PROJECT_SOURCE_DIR})
+target_link_libraries(core_equivalence_record DRAMPower::DRAMPower gtest gtest_main)
+EOF
+
+cmake -S "$worktree" -B "$worktree/build" -DDRAMPOWER_BUILD_TESTS=ON -DDRAMPOWER_BUILD_CLI=OFF
+cmake --build "$worktree/build" --target core_equivalence_record -j"$(nproc)"
+DRAMPOWER_CORE_EQUIVALENCE_RECORD="$resources" "$worktree/build/tests/tests_drampower/core_equivalence_record"
@@ -1,18 +1,12 @@
 #include <gtest/gtest.h>
+#include <array>
 #include <bitset>
+#include <sstream>
 
 #include <DRAMPower/util/bus.h>
 
 using namespace DRAMPower;
 
-using Bus_512 = util::Bus<512>;
-using Bus_128 = util::Bus<128>;
-using Bus_64 = util::Bus<64>;
-using Bus_16 = util::Bus<16>;
-using Bus_8 = util::Bus<8>;
-using Bus_6 = util::Bus<6>;
-using Bus_4 = util::Bus<4>;
-
 class BusTest : public ::testing::Test {
 protected:
 	virtual void SetUp()
@@ -28,17 +22,17 @@ protected:
 
 TEST_F(BusTest, EmptyTest)
 {
-	Bus_8 bus(8, 1, util::BusIdlePatternSpec::L);
+	util::Bus bus(8, 1, util::BusIdlePatternSpec::L);
 
 	// auto [hasData, data] = bus.at(0);
 
-	ASSERT_EQ(bus.at(0), Bus_8::burst_t(0b0000'0000));
+	ASSERT_EQ(bus.at(0), util::Bus::burst_t(8));
 	ASSERT_EQ_BITSET(8, bus.at(1), 0b0000'0000);
 };
 
 TEST_F(BusTest, Load_Width_8_Single)
 {
-	Bus_8 bus(8, 1, util::BusIdlePatternSpec::L);
+	util::Bus bus(8, 1, util::BusIdlePatternSpec::L);
 
 	bus.load(0, 0b1010'1111, 1);
 	ASSERT_EQ_BITSET(8, bus.at(0), 0b1010'1111);
@@ -47,7 +41,7 @@ TEST_F(BusTest, Load_Width_8_Single)
 
 TEST_F(BusTest, Load_Width_4)
 {
-	Bus_4 bus(4, 1, util::BusIdlePatternSpec::L);
+	util::Bus bus(4, 1, util::BusIdlePatternSpec::L);
 
 	bus.load(0, 0b1010'1111, 2);
 	ASSERT_EQ_BITSET(4, bus.at(0), 0b1010);
@@ -56,7 +50,7 @@ TEST_F(BusTest, Load_Width_4)
 
 TEST_F(BusTest, Load_Width_8)
 {
-	Bus_8 bus(8, 1, util::BusIdlePatternSpec::L);
+	util::Bus bus(8, 1, util::BusIdlePatternSpec::L);
 
 	bus.load(0, 0b0010'1010'1001'0110, 2);
 	ASSERT_EQ_BITSET(8, bus.at(0), 0b0010'1010);
@@ -66,7 +60,7 @@ TEST_F(BusTest, Load_Width_8)
 
 TEST_F(BusTest, Load_Width_4_Cont)
 {
-	Bus_4 bus(4, 1, util::BusIdlePatternSpec::L);
+	util::Bus bus(4, 1, util::BusIdlePatternSpec::L);
 
 	bus.load(0, 0b1010'1111, 2);
 	ASSERT_EQ_BITSET(4, bus.at(0), 0b1010);
@@ -87,7 +81,7 @@ TEST_F(BusTest, Load_Width_4_Cont)
 
 TEST_F(BusTest, Stats_Empty_1)
 {
-	Bus_4 bus(4, 1, util::BusIdlePatternSpec::L);
+	util::Bus bus(4, 1, util::BusIdlePatternSpec::L);
 	auto stats = bus.get_stats(0);
 	ASSERT_EQ(stats.ones, 0);
 	ASSERT_EQ(stats.zeroes, 0);
@@ -98,7 +92,7 @@ TEST_F(BusTest, Stats_Empty_1)
 
 TEST_F(BusTest, Stats_Empty_2)
 {
-	Bus_4 bus(4, 1, util::BusIdlePatternSpec::L);
+	util::Bus bus(4, 1, util::BusIdlePatternSpec::L);
 	bus.load(0, 0b1010'1111, 2);
 	auto stats = bus.get_stats(0);
 	ASSERT_EQ(stats.ones, 0);
@@ -110,7 +104,7 @@ TEST_F(BusTest, Stats_Empty_2)
 
 TEST_F(BusTest, Stats_Basic_1)
 {
-	Bus_4 bus(4, 1, util::BusIdlePatternSpec::L);
+	util::Bus bus(4, 1, util::BusIdlePatternSpec::L);
 
 	auto stats = bus.get_stats(0);
 	ASSERT_EQ(stats.ones, 0);
@@ -151,7 +145,7 @@ TEST_F(BusTest, Stats_Basic_1)
 
 TEST_F(BusTest, Stats_Basic_2)
 {
-	Bus_4 bus(4, 1, util::BusIdlePatternSpec::L);
+	util::Bus bus(4, 1, util::BusIdlePatternSpec::L);
 
 	auto stats = bus.get_stats(0);
 	ASSERT_EQ(stats.ones, 0);
@@ -192,7 +186,7 @@ TEST_F(BusTest, Stats_Basic_2)
 
 TEST_F(BusTest, Stats_Basic_3)
 {
-	Bus_4 bus(4, 1, util::BusIdlePatternSpec::L);
+	util::Bus bus(4, 1, util::BusIdlePatternSpec::L);
 
 	auto stats = bus.get_stats(0);
 	ASSERT_EQ(stats.ones, 0);
@@ -233,7 +227,7 @@ TEST_F(BusTest, Stats_Basic_3)
 
 TEST_F(BusTest, Stats_4)
 {
-	Bus_4 bus(4, 1, util::BusIdlePatternSpec::L);
+	util::Bus bus(4, 1, util::BusIdlePatternSpec::L);
 
 	bus.load(0, 0b1010'1111, 2);
 
@@ -268,7 +262,7 @@ TEST_F(BusTest, Stats_4)
 
 TEST_F(BusTest, Stats_4_Idle)
 {
-	Bus_4 bus(4, 1, util::BusIdlePatternSpec::L);
+	util::Bus bus(4, 1, util::BusIdlePatternSpec::L);
 
 	bus.load(0, 0b1010'1111, 2);
 
@@ -297,7 +291,7 @@ TEST_F(BusTest, Stats_4_Idle)
 
 TEST_F(BusTest, Stats_8)
 {
-	Bus_8 bus(8, 1, util::BusIdlePatternSpec::L);
+	util::Bus bus(8, 1, util::BusIdlePatternSpec::L);
 
 	bus.load(0, 0b1010'1111'0110'1001, 2);
 	// 1010'1111
@@ -320,7 +314,7 @@ TEST_F(BusTest, Stats_8)
 
 TEST_F(BusTest, Stats_Second_Load_4)
 {
-	Bus_4 bus(4, 1, util::BusIdlePatternSpec::L);
+	util::Bus bus(4, 1, util::BusIdlePatternSpec::L);
 
 	bus.load(0, 0b1010'1111, 2);
 
@@ -350,7 +344,7 @@ TEST_F(BusTest, Stats_Second_Load_4)
 
 TEST_F(BusTest, Load_4_cycles)
 {
-	Bus_4 bus(4, 1, util::BusIdlePatternSpec::L);
+	util::Bus bus(4, 1, util::BusIdlePatternSpec::L);
 
 	bus.load(0, 0b1010'1111'1001'0011, 4);
 
@@ -411,7 +405,7 @@ TEST_F(BusTest, Load_Data)
 		0, 0b0000'0001,
 	};
 
-	Bus_16 bus{16, 1, util::BusIdlePatternSpec::L};
+	util::Bus bus{16, 1, util::BusIdlePatternSpec::L};
 
 	bus.load(0, data, sizeof(data) * 8);
 
@@ -497,7 +491,7 @@ TEST_F(BusTest, Test_001)
 	*/
 
 
-	Bus_6 bus{6, 1, util::BusIdlePatternSpec::L};
+	util::Bus bus{6, 1, util::BusIdlePatternSpec::L};
 
 	bus.load(0, cmd_1.to_ulong(), 4);
 
@@ -566,4 +560,65 @@ TEST_F(BusTest, Test_001)
 	ASSERT_EQ(stats.zeroes, 55);
 	ASSERT_EQ(stats.zeroes_to_ones, 10);
 	ASSERT_EQ(stats.ones_to_zeroes, 8);
-};
\ No newline at end of file
+};
+
+TEST_F(BusTest, Load_Width_144)
+{
+	// Wider than the inline storage of a burst
+	util::Bus bus(144, 1, util::BusIdlePatternSpec::L);
+	std::array<uint8_t, 36> data;
+	for (std::size_t i = 0; i < data.size(); ++i) {
+		data[i] = static_cast<uint8_t>(i * 37 + 11);
+	}
+	bus.load(0, data.data(), 288);
+
+	// The last burst of the load is at(0)
+	for (std::size_t burst = 0; burst < 2; ++burst) {
+		util::Bus::burst_t expected(144);
+		for (std::size_t i = 0; i < 144; ++i) {
+			const std::size_t bit = (1 - burst) * 144 + i;
+			expected.set(i, (data[bit / 8] >> (bit % 8)) & 1);
+		}
+		ASSERT_EQ(bus.at(burst), expected);
+	}
+	ASSERT_EQ(bus.at(2), util::Bus::burst_t(144));
+};
+
+TEST_F(BusTest, Stats_Width_144)
+{
+	util::Bus bus(144, 1, util::BusIdlePatternSpec::L);
+	std::array<uint8_t, 18> data;
+	data.fill(0xFF);
+	bus.load(0, data.data(), 144);
+
+	auto stats = bus.get_stats(2);
+	ASSERT_EQ(stats.ones, 144);
+	ASSERT_EQ(stats.zeroes, 144);
+	ASSERT_EQ(stats.bit_changes, 288);
+	ASSERT_EQ(stats.zeroes_to_ones, 144);
+	ASSERT_EQ(stats.ones_to_zeroes, 144);
+
+	stats = bus.get_stats(3);
+	ASSERT_EQ(stats.ones, 144);
+	ASSERT_EQ(stats.zeroes, 288);
+	ASSERT_EQ(stats.bit_changes, 288);
+};
+
+TEST_F(BusTest, Serialize_Width_144)
+{
+	util::Bus bus(144, 2, util::BusIdlePatternSpec::H);
+	std::array<uint8_t, 72> data;
+	for (std::size_t i = 0; i < data.size(); ++i) {
+		data[i] = static_cast<uint8_t>(i * 13 + 5);
+	}
+	bus.load(0, data.data(), 576);
+
+	std::stringstream stream;
+	bus.serialize(stream);
+	util::Bus restored(144, 2, util::BusIdlePatternSpec::H);
+	restored.deserialize(stream);
+	for (timestamp_t t : {1, 2, 5}) {
+		ASSERT_EQ(restored.get_stats(t), bus.get_stats(t));
+	}
+	ASSERT_EQ(restored.at(1), bus.at(1));
+};
@@ -7,23 +7,18 @@
 #include <array>
 
 using namespace DRAMPower;
-using Bus_512 = util::Bus<512>;
-using Bus_128 = util::Bus<128>;
-using Bus_64 = util::Bus<64>;
-using Bus_8 = util::Bus<8>;
 
 class ExtendedBusIdlePatternTest : public ::testing::Test {
 protected:
 
-	template<size_t N>
 	void Init(
-		typename util::Bus<N>::burst_t& burst_ones,
-		typename util::Bus<N>::burst_t& burst_zeroes,
-		typename util::Bus<N>::burst_t& burst_custom
+		util::Bus::burst_t& burst_ones,
+		util::Bus::burst_t& burst_zeroes,
+		util::Bus::burst_t& burst_custom
 	) {
 		burst_ones.set();
 		burst_zeroes.reset();
-		for(size_t i = 0; i < N; i++)
+		for(size_t i = 0; i < burst_custom.size(); i++)
 		{
 			burst_custom.set(i, (i % 3) ? true : false);
 		}
@@ -43,11 +38,11 @@ protected:
 
 TEST_F(ExtendedBusIdlePatternTest, EmptyIdleLow_1)
 {
-	Bus_8::burst_t burst_ones;
-	Bus_8::burst_t burst_zeroes;
-	Bus_8::burst_t burst_custom;
-	Init<8>(burst_ones, burst_zeroes, burst_custom);
-	Bus_8 bus(8, 1, util::BusIdlePatternSpec::L);
+	util::Bus::burst_t burst_ones{8};
+	util::Bus::burst_t burst_zeroes{8};
+	util::Bus::burst_t burst_custom{8};
+	Init(burst_ones, burst_zeroes, burst_custom);
+	util::Bus bus(8, 1, util::BusIdlePatternSpec::L);
 
 	ASSERT_EQ_BURST(bus.at(0), burst_zeroes);
 	ASSERT_EQ_BURST(bus.at(1), burst_zeroes);
@@ -55,11 +50,11 @@ TEST_F(ExtendedBusIdlePatternTest, EmptyIdleLow_1)
 
 TEST_F(ExtendedBusIdlePatternTest, EmptyIdleLow_2)
 {
-	Bus_8::burst_t burst_ones;
-	Bus_8::burst_t burst_zeroes;
-	Bus_8::burst_t burst_custom;
-	Init<8>(burst_ones, burst_zeroes, burst_custom);
-	Bus_8 bus(8, 1, util::BusIdlePatternSpec::L);
+	util::Bus::burst_t burst_ones{8};
+	util::Bus::burst_t burst_zeroes{8};
+	util::Bus::burst_t burst_custom{8};
+	Init(burst_ones, burst_zeroes, burst_custom);
+	util::Bus bus(8, 1, util::BusIdlePatternSpec::L);
 
 	ASSERT_EQ_BURST(bus.at(0), burst_zeroes);
 	ASSERT_EQ_BURST(bus.at(1), burst_zeroes);
@@ -67,11 +62,11 @@ TEST_F(ExtendedBusIdlePatternTest, EmptyIdleLow_2)
 
 TEST_F(ExtendedBusIdlePatternTest, EmptyIdleLow_3)
 {
-	Bus_8::burst_t burst_ones;
-	Bus_8::burst_t burst_zeroes;
-	Bus_8::burst_t burst_custom;
-	Init<8>(burst_ones, burst_zeroes, burst_custom);
-	Bus_8 bus(8, 1, util::BusIdlePatternSpec::L, true);
+	util::Bus::burst_t burst_ones{8};
+	util::Bus::burst_t burst_zeroes{8};
+	util::Bus::burst_t burst_custom{8};
+	Init(burst_ones, burst_zeroes, burst_custom);
+	util::Bus bus(8, 1, util::BusIdlePatternSpec::L, true);
 
 	ASSERT_EQ_BURST(bus.at(0), burst_zeroes);
 	ASSERT_EQ_BURST(bus.at(1), burst_zeroes);
@@ -79,11 +74,11 @@ TEST_F(ExtendedBusIdlePatternTest, EmptyIdleLow_3)
 
 TEST_F(ExtendedBusIdlePatternTest, EmptyIdleHigh_1)
 {
-	Bus_8::burst_t burst_ones;
-	Bus_8::burst_t burst_zeroes;
-	Bus_8::burst_t burst_custom;
-	Init<8>(burst_ones, burst_zeroes, burst_custom);
-	Bus_8 bus(8, 1, util::BusIdlePatternSpec::H);
+	util::Bus::burst_t burst_ones{8};
+	util::Bus::burst_t burst_zeroes{8};
+	util::Bus::burst_t burst_custom{8};
+	Init(burst_ones, burst_zeroes, burst_custom);
+	util::Bus bus(8, 1, util::BusIdlePatternSpec::H);
 
 	ASSERT_EQ_BURST(bus.at(0), burst_ones);
 	ASSERT_EQ_BURST(bus.at(1), burst_ones);
@@ -91,11 +86,11 @@ TEST_F(ExtendedBusIdlePatternTest, EmptyIdleHigh_1)
 
 TEST_F(ExtendedBusIdlePatternTest, EmptyIdleHigh_2)
 {
-	Bus_8::burst_t burst_ones;
-	Bus_8::burst_t burst_zeroes;
-	Bus_8::burst_t burst_custom;
-	Init<8>(burst_ones, burst_zeroes, burst_custom);
-	Bus_8 bus(8, 1, util::BusIdlePatternSpec::H);
+	util::Bus::burst_t burst_ones{8};
+	util::Bus::burst_t burst_zeroes{8};
+	util::Bus::burst_t burst_custom{8};
+	Init(burst_ones, burst_zeroes, burst_custom);
+	util::Bus bus(8, 1, util::BusIdlePatternSpec::H);
 
 	ASSERT_EQ_BURST(bus.at(0), burst_ones);
 	ASSERT_EQ_BURST(bus.at(1), burst_ones);
@@ -103,11 +98,11 @@ TEST_F(ExtendedBusIdlePatternTest, EmptyIdleHigh_2)
 
 TEST_F(ExtendedBusIdlePatternTest, EmptyIdleHigh_3)
 {
-	Bus_8::burst_t burst_ones;
-	Bus_8::burst_t burst_zeroes;
-	Bus_8::burst_t burst_custom;
-	Init<8>(burst_ones, burst_zeroes, burst_custom);
-	Bus_8 bus(8, 1, util::BusIdlePatternSpec::H, true);
+	util::Bus::burst_t burst_ones{8};
+	util::Bus::burst_t burst_zeroes{8};
+	util::Bus::burst_t burst_custom{8};
+	Init(burst_ones, burst_zeroes, burst_custom);
+	util::Bus bus(8, 1, util::BusIdlePatternSpec::H, true);
 
 	ASSERT_EQ_BURST(bus.at(0), burst_ones);
 	ASSERT_EQ_BURST(bus.at(1), burst_ones);
@@ -115,11 +110,11 @@ TEST_F(ExtendedBusIdlePatternTest, EmptyIdleHigh_3)
 
 TEST_F(ExtendedBusIdlePatternTest, Load_Width_8)
 {
-	Bus_8::burst_t burst_ones;
-	Bus_8::burst_t burst_zeroes;
-	Bus_8::burst_t burst_custom;
-	Init<8>(burst_ones, burst_zeroes, burst_custom);
-	Bus_8 bus(8, 1, util::BusIdlePatternSpec::L);
+	util::Bus::burst_t burst_ones{8};
+	util::Bus::burst_t burst_zeroes{8};
+	util::Bus::burst_t burst_custom{8};
+	Init(burst_ones, burst_zeroes, burst_custom);
+	util::Bus bus(8, 1, util::BusIdlePatternSpec::L);
 
 	// Init load overrides init pattern
 	bus.load(0, 0b0010'1010'1001'0110, 2);
@@ -129,17 +124,17 @@ TEST_F(ExtendedBusIdlePatternTest, Load_Width_8)
 
 TEST_F(ExtendedBusIdlePatternTest, Load_Width_64)
 {
-	Bus_64::burst_t burst_ones;
-	Bus_64::burst_t burst_zeroes;
-	Bus_64::burst_t burst_custom;
-	Init<64>(burst_ones, burst_zeroes, burst_custom);
+	util::Bus::burst_t burst_ones{64};
+	util::Bus::burst_t burst_zeroes{64};
+	util::Bus::burst_t burst_custom{64};
+	Init(burst_ones, burst_zeroes, burst_custom);
 	const uint32_t buswidth = 8 * 8;
 	const uint32_t number_bytes = (buswidth + 7) / 8;
 
-	Bus_64 bus(64, 1, util::BusIdlePatternSpec::L);
+	util::Bus bus(64, 1, util::BusIdlePatternSpec::L);
 	std::array<uint8_t, number_bytes> data = { 0 }; 
 	
-	auto expected = Bus_64::burst_t(64);
+	auto expected = util::Bus::burst_t(64);
 
 	auto pattern_gen = [] (size_t i) -> uint8_t {
 		return static_cast<uint8_t>(i);
@@ -169,10 +164,10 @@ TEST_F(ExtendedBusIdlePatternTest, Load_Width_512)
 	const uint32_t buswidth = 64 * 8;
 	const uint32_t number_bytes = (buswidth + 7) / 8;
 
-	Bus_512 bus(512, 1, util::BusIdlePatternSpec::L);
+	util::Bus bus(512, 1, util::BusIdlePatternSpec::L);
 	std::array<uint8_t, number_bytes> data = { 0 }; 
 	
-	auto expected = Bus_512::burst_t(512);
+	auto expected = util::Bus::burst_t(512);
 
 	auto pattern_gen = [] (size_t i) -> uint8_t {
 		return static_cast<uint8_t>(i);
@@ -207,15 +202,14 @@ protected:
 	const static constexpr size_t bus_array_size = (buswidth + 7) / 8;
 
 	
-	template<size_t N>
 	void Init(
-		typename util::Bus<N>::burst_t& burst_ones,
-		typename util::Bus<N>::burst_t& burst_zeroes,
-		typename util::Bus<N>::burst_t& burst_custom
+		util::Bus::burst_t& burst_ones,
+		util::Bus::burst_t& burst_zeroes,
+		util::Bus::burst_t& burst_custom
 	) {
 		burst_ones.set();
 		burst_zeroes.reset();
-		for(size_t i = 0; i < N; i++)
+		for(size_t i = 0; i < burst_custom.size(); i++)
 		{
 			burst_custom.set(i, (i % 3 ? true : false));
 		}
@@ -234,7 +228,7 @@ TEST_F(ExtendedBusStatsTest, Stats_Pattern_Datarate_1)
 {
 	uint_fast8_t datarate = 2;
 	timestamp_t timestamp = 3;
-	Bus_128 bus(128, datarate, util::BusIdlePatternSpec::L);
+	util::Bus bus(128, datarate, util::BusIdlePatternSpec::L);
 
 	auto stats = bus.get_stats(timestamp); // 3 cycles with double data rate
 	ASSERT_EQ(stats.ones, 0);
@@ -248,7 +242,7 @@ TEST_F(ExtendedBusStatsTest, Stats_Pattern_Datarate_2)
 {
 	uint_fast8_t datarate = 13;
 	timestamp_t timestamp = 47;
-	Bus_128 bus(128, datarate, util::BusIdlePatternSpec::L);
+	util::Bus bus(128, datarate, util::BusIdlePatternSpec::L);
 
 
 	auto stats = bus.get_stats(timestamp); // 3 cycles with double data rate
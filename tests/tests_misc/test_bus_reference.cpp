@@ -0,0 +1,193 @@
+#include <gtest/gtest.h>
+
+#include <DRAMPower/util/bus.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <random>
+#include <sstream>
+#include <vector>
+
+using namespace DRAMPower;
+
+// Byte-wise model of the bus. Every bit is stored in a byte and every cycle of the timeline holds
+// its beat, cycles while the bus is disabled hold the idle pattern and aren't counted.
+class ReferenceBus {
+public:
+	using beat_t = std::vector<uint8_t>;
+
+	ReferenceBus(std::size_t width, uint64_t datarate, util::BusIdlePatternSpec idle_pattern, bool enabled, std::size_t lane_width)
+		: width(width)
+		, datarate(datarate)
+		, lane_width(lane_width)
+		, enabled(enabled)
+		, idle(width, util::BusIdlePatternSpec::H == idle_pattern ? 1 : 0)
+	{}
+
+	void load(timestamp_t timestamp, const uint8_t *data, std::size_t n_bits) {
+		if (!enabled) {
+			return;
+		}
+		// The burst storage puts out the last burst of the data first
+		const timestamp_t start = timestamp * datarate;
+		const std::size_t n_bursts = n_bits / width;
+		extend(start);
+		for (std::size_t n = 0; n < n_bursts; ++n) {
+			extend(start + n + 1);
+			for (std::size_t i = 0; i < width; ++i) {
+				const std::size_t bit = (n_bursts - 1 - n) * width + i;
+				beats[start + n][i] = (data[bit / 8] >> (bit % 8)) & 1;
+			}
+		}
+	}
+
+	void disable(timestamp_t timestamp) {
+		// The beats of a load after the disable timestamp are dropped
+		const timestamp_t end = timestamp * datarate;
+		extend(end);
+		beats.resize(end);
+		counted.resize(end);
+		enabled = false;
+	}
+
+	void enable(timestamp_t timestamp) {
+		extend(timestamp * datarate);
+		enabled = true;
+	}
+
+	util::bus_stats_t get_stats(timestamp_t timestamp) const {
+		return stats(timestamp, 0, width);
+	}
+
+	std::vector<util::bus_stats_t> get_lane_stats(timestamp_t timestamp) const {
+		std::vector<util::bus_stats_t> lanes;
+		for (std::size_t lane = 0; 0 != lane_width && lane < width / lane_width; ++lane) {
+			lanes.push_back(stats(timestamp, lane * lane_width, (lane + 1) * lane_width));
+		}
+		return lanes;
+	}
+
+private:
+	std::size_t width;
+	uint64_t datarate;
+	std::size_t lane_width;
+	bool enabled;
+	beat_t idle;
+	std::vector<beat_t> beats;
+	std::vector<bool> counted;
+
+	void extend(timestamp_t end) {
+		while (beats.size() < end) {
+			beats.push_back(idle);
+			counted.push_back(enabled);
+		}
+	}
+
+	// Stats of the bits [first, last) of the cycles before timestamp
+	util::bus_stats_t stats(timestamp_t timestamp, std::size_t first, std::size_t last) const {
+		util::bus_stats_t stats;
+		for (timestamp_t t = 0; t < timestamp * datarate; ++t) {
+			const bool stored = t < beats.size();
+			if (stored ? !counted[t] : !enabled) {
+				continue;
+			}
+			const beat_t &beat = stored ? beats[t] : idle;
+			const beat_t &previous = 0 != t && t - 1 < beats.size() ? beats[t - 1] : idle;
+			for (std::size_t i = first; i < last; ++i) {
+				stats.ones += beat[i];
+				stats.zeroes += 1 - beat[i];
+				stats.bit_changes += beat[i] != previous[i];
+				stats.ones_to_zeroes += previous[i] && !beat[i];
+				stats.zeroes_to_ones += !previous[i] && beat[i];
+			}
+		}
+		return stats;
+	}
+};
+
+class BusReferenceTest : public ::testing::Test {
+protected:
+	std::mt19937_64 rng{42};
+
+	template <typename Bus>
+	static void expectSameStats(const Bus &bus, const ReferenceBus &reference, timestamp_t timestamp) {
+		ASSERT_EQ(bus.get_stats(timestamp), reference.get_stats(timestamp));
+		ASSERT_EQ(bus.get_lane_stats(timestamp), reference.get_lane_stats(timestamp));
+	}
+};
+
+// Random widths, lane widths, data rates, loads and disable/enable sequences, the stats are compared
+// after every operation. A checkpoint restored into a new bus continues with the same stats.
+TEST_F(BusReferenceTest, RandomSequences)
+{
+	const std::size_t widths[] = {1, 5, 8, 16, 27, 63, 64, 65, 72, 100, 128, 144, 200, 256, 1000};
+	const std::size_t lane_widths[] = {1, 2, 3, 4, 8, 9, 16, 32, 64, 72};
+	for (int sequence = 0; sequence < 100; ++sequence) {
+		const std::size_t width = widths[rng() % std::size(widths)];
+		std::size_t lane_width = 0;
+		if (rng() % 2) {
+			const std::size_t candidate = lane_widths[rng() % std::size(lane_widths)];
+			lane_width = 0 == width % candidate ? candidate : 0;
+		}
+		const uint64_t datarate = 1 + rng() % 4;
+		const util::BusIdlePatternSpec idle_pattern = rng() % 2 ? util::BusIdlePatternSpec::H : util::BusIdlePatternSpec::L;
+		bool enabled = 0 != rng() % 4;
+		SCOPED_TRACE(::testing::Message() << "sequence " << sequence << ", width " << width << ", lane width " << lane_width << ", data rate " << datarate);
+
+		util::Bus bus(width, datarate, idle_pattern, enabled, lane_width);
+		ReferenceBus reference(width, datarate, idle_pattern, enabled, lane_width);
+		timestamp_t timestamp = rng() % 5;
+		timestamp_t next_load = 0; // The bursts of the last load end before next_load
+		timestamp_t last_switch = 0;
+		std::vector<uint8_t> data;
+		for (int op = 0; op < 60; ++op) {
+			switch (rng() % 8) {
+			case 0: case 1: case 2: case 3: {
+				// Loads start after the end of the last load and after an enable
+				timestamp = std::max({timestamp, next_load, last_switch + 1}) + rng() % 4;
+				const std::size_t burst_length = 1 + rng() % 16;
+				data.resize((burst_length * width + 7) / 8);
+				std::generate(data.begin(), data.end(), [this] { return static_cast<uint8_t>(rng()); });
+				bus.load(timestamp, data.data(), burst_length * width);
+				reference.load(timestamp, data.data(), burst_length * width);
+				if (enabled) {
+					next_load = (timestamp * datarate + burst_length + datarate - 1) / datarate;
+				}
+				break;
+			}
+			case 4:
+				if (enabled) {
+					// Disable after the last load, possibly in the middle of its bursts
+					timestamp = std::max(timestamp, last_switch) + 1 + rng() % 6;
+					bus.disable(timestamp);
+					reference.disable(timestamp);
+					enabled = false;
+					last_switch = timestamp;
+					next_load = timestamp;
+				}
+				break;
+			case 5:
+				if (!enabled) {
+					timestamp = std::max(timestamp, last_switch) + 1 + rng() % 6;
+					bus.enable(timestamp);
+					reference.enable(timestamp);
+					enabled = true;
+					last_switch = timestamp;
+				}
+				break;
+			case 6: {
+				std::stringstream stream;
+				bus.serialize(stream);
+				util::Bus restored(width, datarate, idle_pattern, !enabled, lane_width);
+				restored.deserialize(stream);
+				expectSameStats(restored, reference, timestamp + rng() % 20);
+				break;
+			}
+			default:
+				break;
+			}
+			expectSameStats(bus, reference, timestamp + rng() % 20);
+		}
+	}
+}
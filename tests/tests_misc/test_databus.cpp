@@ -0,0 +1,168 @@
+#include <gtest/gtest.h>
+
+#include <array>
+#include <sstream>
+#include <string>
+
+#include <DRAMPower/dram/Interface.h>
+#include <DRAMPower/util/bus.h>
+#include <DRAMPower/util/databus.h>
+
+using namespace DRAMPower;
+using DRAMUtils::Config::TogglingRateIdlePattern;
+
+// The DataBus only allocates the half of the active mode. The reference holds both halves from
+// the start like the DataBus before the lazy allocation, its checkpoint is the DataBus format.
+class DataBusTest : public ::testing::Test {
+protected:
+	static constexpr std::size_t width = 16;
+	static constexpr std::size_t dataRate = 2;
+
+	DRAMUtils::Config::ToggleRateDefinition toggleRate{0.5, 0.25, 0.75, 0.5, TogglingRateIdlePattern::L, TogglingRateIdlePattern::H};
+	std::array<uint8_t, 8> data{0x12, 0xF0, 0x0F, 0xAA, 0x55, 0x00, 0xFF, 0x3C};
+
+	struct Reference {
+		util::Bus busRead;
+		util::Bus busWrite;
+		TogglingHandle togglingRead;
+		TogglingHandle togglingWrite;
+		util::DataBusMode mode;
+
+		void stats(timestamp_t timestamp, util::bus_stats_t &busReadStats, util::bus_stats_t &busWriteStats, util::bus_stats_t &togglingReadStats, util::bus_stats_t &togglingWriteStats) const {
+			busReadStats += busRead.get_stats(timestamp);
+			busWriteStats += busWrite.get_stats(timestamp);
+			togglingReadStats += togglingRead.get_stats(timestamp);
+			togglingWriteStats += togglingWrite.get_stats(timestamp);
+		}
+
+		std::string checkpoint() const {
+			std::stringstream stream;
+			busRead.serialize(stream);
+			busWrite.serialize(stream);
+			togglingRead.serialize(stream);
+			togglingWrite.serialize(stream);
+			stream.write(reinterpret_cast<const char*>(&mode), sizeof(mode));
+			return stream.str();
+		}
+	};
+
+	util::DataBus makeDataBus(util::DataBusMode mode) const {
+		return util::DataBus{util::DataBusConfig{width, dataRate, toggleRate}, mode};
+	}
+
+	Reference makeReference(util::DataBusMode mode) const {
+		const bool bus = util::DataBusMode::Bus == mode;
+		return Reference{
+			util::Bus{width, dataRate, util::BusIdlePatternSpec::L, bus},
+			util::Bus{width, dataRate, util::BusIdlePatternSpec::H, bus},
+			TogglingHandle{width, dataRate, toggleRate.togglingRateRead, toggleRate.dutyCycleRead, toggleRate.idlePatternRead, !bus},
+			TogglingHandle{width, dataRate, toggleRate.togglingRateWrite, toggleRate.dutyCycleWrite, toggleRate.idlePatternWrite, !bus},
+			mode,
+		};
+	}
+
+	static std::string checkpoint(const util::DataBus &dataBus) {
+		std::stringstream stream;
+		dataBus.serialize(stream);
+		return stream.str();
+	}
+
+	static void expectSameStats(const util::DataBus &dataBus, const Reference &reference, timestamp_t timestamp) {
+		util::bus_stats_t busRead, busWrite, togglingRead, togglingWrite;
+		dataBus.get_stats(timestamp, busRead, busWrite, togglingRead, togglingWrite);
+		util::bus_stats_t expectedBusRead, expectedBusWrite, expectedTogglingRead, expectedTogglingWrite;
+		reference.stats(timestamp, expectedBusRead, expectedBusWrite, expectedTogglingRead, expectedTogglingWrite);
+		EXPECT_EQ(busRead, expectedBusRead);
+		EXPECT_EQ(busWrite, expectedBusWrite);
+		EXPECT_EQ(togglingRead, expectedTogglingRead);
+		EXPECT_EQ(togglingWrite, expectedTogglingWrite);
+	}
+};
+
+TEST_F(DataBusTest, CheckpointOfSingleMode)
+{
+	util::DataBus bus = makeDataBus(util::DataBusMode::Bus);
+	Reference busReference = makeReference(util::DataBusMode::Bus);
+	bus.loadRead(2, 64, data.data());
+	busReference.busRead.load(2, data.data(), 64);
+	EXPECT_EQ(checkpoint(bus), busReference.checkpoint());
+
+	util::DataBus toggling = makeDataBus(util::DataBusMode::TogglingRate);
+	Reference togglingReference = makeReference(util::DataBusMode::TogglingRate);
+	toggling.loadWrite(2, 64, data.data());
+	togglingReference.togglingWrite.incCountBitLength(2, 64);
+	EXPECT_EQ(checkpoint(toggling), togglingReference.checkpoint());
+}
+
+TEST_F(DataBusTest, LazyModeSwitch)
+{
+	util::DataBus bus = makeDataBus(util::DataBusMode::Bus);
+	Reference reference = makeReference(util::DataBusMode::Bus);
+
+	// Bus
+	bus.loadRead(2, 64, data.data());
+	reference.busRead.load(2, data.data(), 64);
+	bus.loadWrite(10, 32, data.data() + 4);
+	reference.busWrite.load(10, data.data() + 4, 32);
+	expectSameStats(bus, reference, 15);
+
+	// Toggling rate, the toggling half is created
+	bus.enableTogglingRate(20);
+	reference.busRead.disable(20);
+	reference.busWrite.disable(20);
+	reference.togglingRead.enable(20);
+	reference.togglingWrite.enable(20);
+	reference.mode = util::DataBusMode::TogglingRate;
+	bus.loadRead(24, 64, data.data());
+	reference.togglingRead.incCountBitLength(24, 64);
+	expectSameStats(bus, reference, 30);
+	EXPECT_EQ(checkpoint(bus), reference.checkpoint());
+
+	// Bus again
+	bus.enableBus(40);
+	reference.togglingRead.disable(40);
+	reference.togglingWrite.disable(40);
+	reference.busRead.enable(40);
+	reference.busWrite.enable(40);
+	reference.mode = util::DataBusMode::Bus;
+	bus.loadWrite(44, 64, data.data());
+	reference.busWrite.load(44, data.data(), 64);
+	expectSameStats(bus, reference, 60);
+	EXPECT_EQ(checkpoint(bus), reference.checkpoint());
+
+	// Both halves hold state and are restored
+	std::stringstream stream(checkpoint(bus));
+	util::DataBus restored = makeDataBus(util::DataBusMode::TogglingRate);
+	restored.deserialize(stream);
+	EXPECT_TRUE(restored.isBus());
+	expectSameStats(restored, reference, 60);
+	EXPECT_EQ(checkpoint(restored), reference.checkpoint());
+}
+
+TEST_F(DataBusTest, RestoreKeepsSingleMode)
+{
+	util::DataBus bus = makeDataBus(util::DataBusMode::Bus);
+	bus.loadRead(2, 64, data.data());
+	const std::string saved = checkpoint(bus);
+
+	// The restored toggling half is in its initial state and not kept, switching creates it again
+	std::stringstream stream(saved);
+	util::DataBus restored = makeDataBus(util::DataBusMode::TogglingRate);
+	restored.deserialize(stream);
+	EXPECT_TRUE(restored.isBus());
+	EXPECT_EQ(checkpoint(restored), saved);
+
+	util::DataBus expected = makeDataBus(util::DataBusMode::Bus);
+	expected.loadRead(2, 64, data.data());
+	restored.enableTogglingRate(20);
+	expected.enableTogglingRate(20);
+	restored.loadWrite(24, 64, data.data());
+	expected.loadWrite(24, 64, data.data());
+	EXPECT_EQ(checkpoint(restored), checkpoint(expected));
+	util::bus_stats_t busRead, busWrite, togglingRead, togglingWrite;
+	restored.get_stats(30, busRead, busWrite, togglingRead, togglingWrite);
+	util::bus_stats_t expectedBusRead, expectedBusWrite, expectedTogglingRead, expectedTogglingWrite;
+	expected.get_stats(30, expectedBusRead, expectedBusWrite, expectedTogglingRead, expectedTogglingWrite);
+	EXPECT_EQ(busRead, expectedBusRead);
+	EXPECT_EQ(togglingWrite, expectedTogglingWrite);
+}
@@ -0,0 +1,110 @@
+#include <gtest/gtest.h>
+
+#include <DRAMPower/util/dbi.h>
+#include <DRAMPower/util/dbialgos.h>
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+using namespace DRAMPower;
+using namespace DRAMPower::util;
+
+
+class DBITest : public ::testing::Test {
+protected:
+	std::vector<uint8_t> createData(std::size_t n, unsigned seed)
+	{
+		std::mt19937 gen(seed);
+		std::uniform_int_distribution<int> dist(0, 255);
+		std::vector<uint8_t> data(n);
+		for (auto &byte : data) {
+			byte = static_cast<uint8_t>(dist(gen));
+		}
+		return data;
+	}
+
+	virtual void SetUp()
+	{
+	}
+
+	virtual void TearDown()
+	{
+	}
+};
+
+TEST_F(DBITest, BurstDBIMatchesPerChunk)
+{
+	for (PinState idle : {PinState::L, PinState::H}) {
+		// 8 byte blocks and a tail
+		auto data = createData(77, 42);
+		auto reference = data;
+		std::vector<bool> referenceInvert(data.size(), false);
+		for (std::size_t i = 0; i < reference.size(); ++i) {
+			std::size_t ones = BinaryOps::popcount(reference[i]);
+			referenceInvert[i] = (PinState::L == idle && ones > 4) || (PinState::H == idle && ones < 4);
+			if (referenceInvert[i]) {
+				reference[i] = static_cast<uint8_t>(~reference[i]);
+			}
+		}
+
+		std::vector<uint64_t> mask;
+		StaticDBI::computeBurstDBI(data.data(), data.size(), idle, mask);
+
+		ASSERT_EQ(mask.size(), 2);
+		ASSERT_EQ(data, reference);
+		for (std::size_t i = 0; i < data.size(); ++i) {
+			ASSERT_EQ(static_cast<bool>((mask[i / 64] >> (i % 64)) & 1), referenceInvert[i]) << "chunk: " << i;
+		}
+	}
+}
+
+TEST_F(DBITest, BurstDBIIdleZ)
+{
+	auto data = createData(16, 1);
+	auto reference = data;
+	std::vector<uint64_t> mask;
+	StaticDBI::computeBurstDBI(data.data(), data.size(), PinState::Z, mask);
+
+	ASSERT_EQ(data, reference);
+	ASSERT_EQ(mask, std::vector<uint64_t>{0});
+}
+
+TEST_F(DBITest, BurstCallback)
+{
+	using DBI_t = DBI<uint8_t, 1, PinState::H, StaticDBI>;
+	// 16 bit bus -> 2 chunks per beat, 8 beats
+	const std::size_t width = 16;
+	auto data = createData(16, 7);
+
+	std::vector<std::pair<std::size_t, bool>> changes;
+	DBI_t reference(width, 8, [&changes](timestamp_t, timestamp_t, std::size_t pin, bool state, bool) {
+		changes.emplace_back(pin, state);
+	}, true);
+
+	std::vector<uint64_t> beatMasks;
+	std::size_t calls = 0;
+	DBI_t burst(width, 8, nullptr, true);
+	burst.setBurstCallback([&beatMasks, &calls](timestamp_t, const std::vector<uint64_t>& masks, bool) {
+		beatMasks = masks;
+		++calls;
+	});
+
+	auto referenceResult = reference.updateDBI(0, data.size() * 8, data.data(), false);
+	auto burstResult = burst.updateDBI(0, data.size() * 8, data.data(), false);
+
+	ASSERT_TRUE(referenceResult.has_value());
+	ASSERT_TRUE(burstResult.has_value());
+	ASSERT_EQ(std::vector<uint8_t>(*referenceResult, *referenceResult + data.size()),
+		std::vector<uint8_t>(*burstResult, *burstResult + data.size()));
+	ASSERT_EQ(burst.getInversionStateWrite(), reference.getInversionStateWrite());
+
+	ASSERT_EQ(calls, 1);
+	ASSERT_EQ(beatMasks.size(), 8);
+	ASSERT_EQ(changes.size(), 16);
+	for (std::size_t i = 0; i < changes.size(); ++i) {
+		std::size_t beat = i / 2;
+		ASSERT_EQ(changes[i].first, i % 2);
+		ASSERT_EQ(static_cast<bool>((beatMasks[beat] >> changes[i].first) & 1), changes[i].second);
+	}
+}
@@ -10,8 +10,7 @@
 
 using namespace DRAMPower;	
 
-template <std::size_t n>
-using burst_storage_t = util::burst_storage<util::BusContainer<n>>;
+using burst_storage_t = util::burst_storage<util::BusContainer>;
 
 class MiscTest : public ::testing::Test {
 protected:
@@ -85,7 +84,7 @@ TEST_F(MiscTest, TestChunking)
 
 	// Test setup
 	constexpr std::size_t width = 6;
-	burst_storage_t<width> burst_storage{width};
+	burst_storage_t burst_storage{width};
 
 	util::BurstStorageInsertHelper::insert_data(burst_storage, 0, width, data.data(), data.size() * 8);
 
@@ -119,7 +118,7 @@ TEST_F(MiscTest, TestBurstLoad_Uneven)
 
 	// Test setup
 	constexpr std::size_t width = 4;
-	burst_storage_t<width> burst_storage{width};
+	burst_storage_t burst_storage{width};
 
 	util::BurstStorageInsertHelper::insert_data(burst_storage, 0, width, data.data(), 12);
 
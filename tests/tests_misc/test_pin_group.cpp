@@ -0,0 +1,116 @@
+#include <gtest/gtest.h>
+
+#include <DRAMPower/util/pin.h>
+#include <DRAMPower/util/pin_group.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <sstream>
+#include <vector>
+
+using namespace DRAMPower;
+using namespace DRAMPower::util;
+
+class PinGroupTest : public ::testing::Test {
+protected:
+	static constexpr std::size_t MaxBurstLength = 16;
+	using pin_t = Pin<MaxBurstLength>;
+	using group_t = PinGroup<MaxBurstLength>;
+
+	void compare(const group_t& group, const std::vector<pin_t>& pins, timestamp_t t, std::size_t dataRate)
+	{
+		bus_stats_t total;
+		for (std::size_t pin = 0; pin < pins.size(); ++pin) {
+			auto expected = pins[pin].get_stats_at(t, dataRate);
+			ASSERT_EQ(group.get_pin_stats_at(pin, t, dataRate), expected) << "pin: " << pin << " t: " << t;
+			total += expected;
+		}
+		ASSERT_EQ(group.get_stats_at(t, dataRate), total) << "t: " << t;
+	}
+
+	// Random bursts on all pins with additional single pin loads like the DBI reset
+	void runRandom(PinState idle, std::size_t n_pins, unsigned seed)
+	{
+		std::mt19937 gen(seed);
+		std::vector<pin_t> pins(n_pins, pin_t{idle, idle});
+		group_t group(n_pins, idle, idle);
+
+		timestamp_t t = 0;
+		for (std::size_t burst = 0; burst < 200; ++burst) {
+			if (0 == gen() % 4) {
+				std::size_t pin = gen() % n_pins;
+				PinState state = (gen() % 2) ? PinState::H : PinState::L;
+				pins[pin].set(t, state);
+				group.set_pin(pin, t, state);
+			}
+			std::size_t beats = 1 + gen() % 8;
+			for (std::size_t beat = 0; beat < beats; ++beat) {
+				uint64_t high = (static_cast<uint64_t>(gen()) << 32) | gen();
+				for (std::size_t pin = 0; pin < n_pins; ++pin) {
+					pins[pin].set(t, ((high >> pin) & 1) ? PinState::H : PinState::L);
+				}
+				group.set(t, high);
+			}
+			compare(group, pins, t + 9, 1);
+			compare(group, pins, t + 9, 2);
+			// Seamless or gap
+			t += 9 + gen() % 3 * (gen() % 20);
+		}
+
+		// Serialization format equals consecutive pins
+		std::stringstream groupStream;
+		std::stringstream pinStream;
+		group.serialize(groupStream);
+		for (const auto& pin : pins) {
+			pin.serialize(pinStream);
+		}
+		ASSERT_EQ(groupStream.str(), pinStream.str());
+
+		group_t restored(n_pins, idle, idle);
+		restored.deserialize(groupStream);
+		compare(restored, pins, t + 100, 1);
+	}
+
+	virtual void SetUp()
+	{
+	}
+
+	virtual void TearDown()
+	{
+	}
+};
+
+TEST_F(PinGroupTest, IdleLow)
+{
+	runRandom(PinState::L, 8, 1);
+}
+
+TEST_F(PinGroupTest, IdleHigh)
+{
+	runRandom(PinState::H, 4, 2);
+}
+
+TEST_F(PinGroupTest, FullWidth)
+{
+	runRandom(PinState::L, 64, 3);
+}
+
+TEST_F(PinGroupTest, InitState)
+{
+	// Init state differs from the idle state
+	std::vector<pin_t> pins(3, pin_t{PinState::Z, PinState::L});
+	group_t group(3, PinState::Z, PinState::L);
+	compare(group, pins, 0, 1);
+	compare(group, pins, 5, 1);
+
+	pins[1].set(10, PinState::H);
+	group.set_pin(1, 10, PinState::H);
+	compare(group, pins, 12, 1);
+
+	for (auto& pin : pins) {
+		pin.set(20, PinState::H);
+	}
+	group.set(20, 0b111);
+	compare(group, pins, 30, 1);
+}
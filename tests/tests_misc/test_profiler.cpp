@@ -0,0 +1,60 @@
+#include <gtest/gtest.h>
+
+#include <DRAMPower/command/CmdType.h>
+#include <DRAMPower/util/profiler.h>
+
+using namespace DRAMPower;
+using namespace DRAMPower::util::profiling;
+
+class ProfilerTest : public ::testing::Test {
+protected:
+	virtual void SetUp()
+	{
+		Profiler::instance().reset();
+	}
+
+	virtual void TearDown()
+	{
+		Profiler::instance().reset();
+	}
+};
+
+TEST_F(ProfilerTest, ScopedTimer)
+{
+	{
+		ScopedTimer timer{Section::BusLoad};
+	}
+	{
+		ScopedTimer timer{Section::DoCommand, static_cast<std::size_t>(CmdType::ACT)};
+	}
+	{
+		ScopedTimer timer{Section::DoCommand, static_cast<std::size_t>(CmdType::ACT)};
+	}
+
+	Snapshot snapshot = Profiler::instance().snapshot();
+	ASSERT_EQ(snapshot.sections[static_cast<std::size_t>(Section::BusLoad)].calls, 1);
+	ASSERT_EQ(snapshot.sections[static_cast<std::size_t>(Section::DoCommand)].calls, 2);
+	ASSERT_EQ(snapshot.sections[static_cast<std::size_t>(Section::DBIUpdate)].calls, 0);
+	ASSERT_EQ(snapshot.commands[static_cast<std::size_t>(CmdType::ACT)].calls, 2);
+	ASSERT_EQ(snapshot.commands[static_cast<std::size_t>(CmdType::PRE)].calls, 0);
+	ASSERT_EQ(snapshot.commands[static_cast<std::size_t>(CmdType::ACT)].ticks,
+		snapshot.sections[static_cast<std::size_t>(Section::DoCommand)].ticks);
+
+	Profiler::instance().reset();
+	snapshot = Profiler::instance().snapshot();
+	ASSERT_EQ(snapshot.sections[static_cast<std::size_t>(Section::BusLoad)].calls, 0);
+	ASSERT_EQ(snapshot.commands[static_cast<std::size_t>(CmdType::ACT)].calls, 0);
+}
+
+TEST_F(ProfilerTest, Macros)
+{
+	{
+		DRAMPOWER_PROFILE_SCOPE(Section::CommandPattern);
+		DRAMPOWER_PROFILE_COMMAND_SCOPE(Section::DoCommand, CmdType::RD);
+	}
+	Snapshot snapshot = Profiler::instance().snapshot();
+	// The macros are compiled out without DRAMPOWER_PROFILING
+	const uint64_t expected = Profiler::enabled() ? 1 : 0;
+	ASSERT_EQ(snapshot.sections[static_cast<std::size_t>(Section::CommandPattern)].calls, expected);
+	ASSERT_EQ(snapshot.commands[static_cast<std::size_t>(CmdType::RD)].calls, expected);
+}
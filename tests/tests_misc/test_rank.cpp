@@ -0,0 +1,94 @@
+#include <gtest/gtest.h>
+
+#include <DRAMPower/dram/Rank.h>
+
+#include <sstream>
+#include <vector>
+
+using namespace DRAMPower;
+
+
+class RankTest : public ::testing::Test {
+protected:
+	virtual void SetUp()
+	{
+	}
+
+	virtual void TearDown()
+	{
+	}
+};
+
+TEST_F(RankTest, ActiveBankMask)
+{
+	Rank rank(130);
+
+	ASSERT_FALSE(rank.isActive(0));
+	ASSERT_EQ(rank.countActiveBanks(), 0);
+
+	rank.setBankActive(0);
+	rank.setBankActive(63);
+	rank.setBankActive(64);
+	rank.setBankActive(129);
+
+	ASSERT_TRUE(rank.isActive(0));
+	ASSERT_EQ(rank.countActiveBanks(), 4);
+	ASSERT_TRUE(rank.isBankActive(64));
+	ASSERT_FALSE(rank.isBankActive(65));
+	ASSERT_EQ(rank.banks[129].bankState, Bank::BankState::BANK_ACTIVE);
+	ASSERT_EQ(rank.bankIndex(rank.banks[64]), 64);
+
+	std::vector<std::size_t> visited;
+	rank.forEachActiveBank([&rank, &visited](std::size_t bank_idx) {
+		visited.push_back(bank_idx);
+		rank.setBankPrecharged(bank_idx);
+	});
+	ASSERT_EQ(visited, (std::vector<std::size_t>{0, 63, 64, 129}));
+	ASSERT_FALSE(rank.isActive(0));
+	ASSERT_EQ(rank.banks[0].bankState, Bank::BankState::BANK_PRECHARGED);
+};
+
+TEST_F(RankTest, EarliestPowerDownEntryTime)
+{
+	Rank rank(70);
+	const uint64_t tRCD = 10;
+	const uint64_t tRP = 20;
+
+	ASSERT_EQ(rank.earliestPowerDownEntryTime(tRCD, tRP), 0);
+
+	// Activate at 0 -> tRCD
+	rank.banks[69].counter.act = 1;
+	rank.banks[69].cycles.act.start_interval(0);
+	rank.updateBankTimestamps(69);
+	ASSERT_EQ(rank.earliestPowerDownEntryTime(tRCD, tRP), 10);
+
+	// Interval started by a refresh doesn't count without an activate
+	rank.banks[3].cycles.act.start_interval(100);
+	rank.banks[3].refreshEndTime = 50;
+	rank.updateBankTimestamps(3);
+	ASSERT_EQ(rank.earliestPowerDownEntryTime(tRCD, tRP), 50);
+
+	rank.banks[1].counter.pre = 1;
+	rank.banks[1].latestPre = 40;
+	rank.updateBankTimestamps(1);
+	ASSERT_EQ(rank.earliestPowerDownEntryTime(tRCD, tRP), 60);
+};
+
+TEST_F(RankTest, Deserialize)
+{
+	Rank rank(70);
+	rank.setBankActive(66);
+	rank.banks[66].counter.act = 1;
+	rank.banks[66].cycles.act.start_interval(30);
+	rank.updateBankTimestamps(66);
+
+	std::stringstream stream;
+	rank.serialize(stream);
+
+	Rank restored(70);
+	restored.deserialize(stream);
+
+	ASSERT_TRUE(restored.isBankActive(66));
+	ASSERT_EQ(restored.countActiveBanks(), 1);
+	ASSERT_EQ(restored.earliestPowerDownEntryTime(10, 20), 40);
+};